@@ -5,6 +5,9 @@
 #include "panels/capacity_panel.h"
 #include "panels/setup_panel.h"
 #include "panels/variables_panel.h"
+#include "panels/compare_panel.h"
+#include "panels/verify_panel.h"
+#include "result_load_worker.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -14,14 +17,29 @@
 #include <QTabWidget>
 #include <QFileDialog>
 #include <QMessageBox>
-#include <QFile>
-#include <QJsonDocument>
-#include <QJsonParseError>
+#include <QProgressBar>
+#include <QSpinBox>
+#include <QThread>
 #include <QFileInfo>
 
-AnalysisWidget::AnalysisWidget(QWidget* parent)
-    : QWidget(parent) {
+AnalysisWidget::AnalysisWidget(const ResultCachePtr& cache, QWidget* parent)
+    : QWidget(parent)
+    , cache_(cache)
+    , load_thread_(nullptr)
+    , load_worker_(nullptr)
+    , load_request_id_(0)
+    , source_request_id_(0) {
     SetupUi();
+    SetupWorker();
+    UpdateCacheLabel();
+}
+
+AnalysisWidget::~AnalysisWidget() {
+    if (load_thread_) {
+        load_worker_->RequestCancel(load_request_id_);
+        load_thread_->quit();
+        load_thread_->wait();
+    }
 }
 
 void AnalysisWidget::SetupUi() {
@@ -35,12 +53,32 @@ void AnalysisWidget::SetupUi() {
     file_layout->setSpacing(4);
 
     auto* button_layout = new QHBoxLayout();
-    open_button_ = new QPushButton(QString::fromUtf8("打开JSON..."), this);
+    open_button_ = new QPushButton(QString::fromUtf8("打开结果..."), this);
     clear_button_ = new QPushButton(QString::fromUtf8("清除"), this);
     clear_button_->setEnabled(false);
+    cancel_button_ = new QPushButton(QString::fromUtf8("取消加载"), this);
+    cancel_button_->setVisible(false);
+    compare_button_ = new QPushButton(QString::fromUtf8("加入对比"), this);
+    compare_button_->setEnabled(false);
 
     button_layout->addWidget(open_button_);
     button_layout->addWidget(clear_button_);
+    button_layout->addWidget(compare_button_);
+    button_layout->addWidget(cancel_button_);
+    button_layout->addStretch();
+
+    // Recently opened results stay in memory up to this budget
+    cache_label_ = new QLabel(this);
+    cache_label_->setStyleSheet("color: #6c757d; font-size: 9pt;");
+    cache_limit_spin_ = new QSpinBox(this);
+    cache_limit_spin_->setRange(64, 65536);
+    cache_limit_spin_->setSingleStep(256);
+    cache_limit_spin_->setSuffix(" MB");
+    cache_limit_spin_->setValue(static_cast<int>(cache_->ByteLimit() / (1024 * 1024)));
+    cache_limit_spin_->setToolTip(QString::fromUtf8("已打开结果的内存缓存上限"));
+    button_layout->addWidget(cache_label_);
+    button_layout->addWidget(new QLabel(QString::fromUtf8("缓存上限:"), this));
+    button_layout->addWidget(cache_limit_spin_);
     file_layout->addLayout(button_layout);
 
     file_label_ = new QLabel(QString::fromUtf8("未加载文件"), this);
@@ -48,6 +86,12 @@ void AnalysisWidget::SetupUi() {
     file_label_->setWordWrap(true);
     file_layout->addWidget(file_label_);
 
+    progress_bar_ = new QProgressBar(this);
+    progress_bar_->setRange(0, 100);
+    progress_bar_->setTextVisible(true);
+    progress_bar_->setVisible(false);
+    file_layout->addWidget(progress_bar_);
+
     layout->addWidget(file_group);
 
     // Analysis tabs
@@ -57,17 +101,56 @@ void AnalysisWidget::SetupUi() {
     capacity_panel_ = new CapacityPanel(this);
     setup_panel_ = new SetupPanel(this);
     variables_panel_ = new VariablesPanel(this);
+    compare_panel_ = new ComparePanel(cache_, this);
+    verify_panel_ = new VerifyPanel(this);
 
     tabs_->addTab(overview_panel_, QString::fromUtf8("求解结果概览"));
     tabs_->addTab(capacity_panel_, QString::fromUtf8("产能利用概览"));
     tabs_->addTab(setup_panel_, QString::fromUtf8("启动/跨期情况"));
     tabs_->addTab(variables_panel_, QString::fromUtf8("决策变量结果"));
+    tabs_->addTab(compare_panel_, QString::fromUtf8("多结果对比"));
+    tabs_->addTab(verify_panel_, QString::fromUtf8("可行性校验"));
 
     layout->addWidget(tabs_, 1);
 
     // Connections
     connect(open_button_, &QPushButton::clicked, this, &AnalysisWidget::OnOpenFile);
     connect(clear_button_, &QPushButton::clicked, this, &AnalysisWidget::OnClearData);
+    connect(cancel_button_, &QPushButton::clicked, this, &AnalysisWidget::OnCancelLoad);
+    connect(compare_button_, &QPushButton::clicked, this, &AnalysisWidget::OnAddToCompare);
+    connect(cache_limit_spin_, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, &AnalysisWidget::OnCacheLimitChanged);
+    connect(setup_panel_, &SetupPanel::VariableRequested,
+            this, &AnalysisWidget::OnVariableRequested);
+    connect(variables_panel_, &VariablesPanel::VariableRequested,
+            this, &AnalysisWidget::OnVariableRequested);
+    connect(variables_panel_, &VariablesPanel::ExportAllRequested,
+            this, &AnalysisWidget::OnExportAllRequested);
+}
+
+void AnalysisWidget::SetupWorker() {
+    load_thread_ = new QThread(this);
+    load_worker_ = new ResultLoadWorker(cache_);
+    load_worker_->moveToThread(load_thread_);
+
+    connect(this, &AnalysisWidget::RequestLoad, load_worker_, &ResultLoadWorker::LoadFile);
+    connect(load_worker_, &ResultLoadWorker::LoadProgress, this, &AnalysisWidget::OnLoadProgress);
+    connect(load_worker_, &ResultLoadWorker::SummaryLoaded, this, &AnalysisWidget::OnSummaryLoaded);
+    connect(load_worker_, &ResultLoadWorker::SourceLoaded, this, &AnalysisWidget::OnSourceLoaded);
+    connect(load_worker_, &ResultLoadWorker::LoadFinished, this, &AnalysisWidget::OnLoadFinished);
+    connect(load_worker_, &ResultLoadWorker::MetricsDerived,
+            this, &AnalysisWidget::OnMetricsDerived);
+    connect(load_worker_, &ResultLoadWorker::LoadCancelled,
+            this, &AnalysisWidget::OnLoadCancelled);
+    connect(this, &AnalysisWidget::RequestVariable, load_worker_, &ResultLoadWorker::DecodeVariable);
+    connect(load_worker_, &ResultLoadWorker::VariableDecoded,
+            this, &AnalysisWidget::OnVariableDecoded);
+    connect(this, &AnalysisWidget::RequestExportCsv, load_worker_, &ResultLoadWorker::ExportCsv);
+    connect(load_worker_, &ResultLoadWorker::ExportFinished,
+            this, &AnalysisWidget::OnExportFinished);
+
+    connect(load_thread_, &QThread::finished, load_worker_, &QObject::deleteLater);
+    load_thread_->start();
 }
 
 void AnalysisWidget::OnOpenFile() {
@@ -76,7 +159,8 @@ void AnalysisWidget::OnOpenFile() {
         this,
         QString::fromUtf8("打开结果文件"),
         default_dir,
-        "JSON files (*.json);;All files (*)");
+        "Result files (*.json *.lsrb);;JSON files (*.json);;"
+        "Binary results (*.lsrb);;All files (*)");
 
     if (path.isEmpty()) {
         return;
@@ -86,54 +170,45 @@ void AnalysisWidget::OnOpenFile() {
 }
 
 bool AnalysisWidget::LoadJsonFile(const QString& path) {
-    QFile file(path);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    if (!QFileInfo::exists(path)) {
         QMessageBox::warning(this, QString::fromUtf8("错误"),
                              QString::fromUtf8("无法打开文件: %1").arg(path));
         return false;
     }
 
-    QByteArray data = file.readAll();
-    file.close();
-
-    QJsonParseError error;
-    QJsonDocument doc = QJsonDocument::fromJson(data, &error);
-
-    if (error.error != QJsonParseError::NoError) {
-        QMessageBox::warning(this, QString::fromUtf8("JSON 解析错误"),
-                             QString::fromUtf8("位置 %1: %2")
-                                 .arg(error.offset)
-                                 .arg(error.errorString()));
-        return false;
-    }
-
-    if (!doc.isObject()) {
-        QMessageBox::warning(this, QString::fromUtf8("错误"),
-                             QString::fromUtf8("JSON 文件格式不正确"));
-        return false;
-    }
-
-    json_data_ = doc.object();
-    current_file_ = path;
+    // Supersede any load still in flight
+    load_worker_->RequestCancel(load_request_id_);
+    ++load_request_id_;
+    loading_file_ = path;
 
-    // Update UI
     QFileInfo info(path);
-    file_label_->setText(info.fileName());
+    file_label_->setText(QString::fromUtf8("加载中: %1").arg(info.fileName()));
     file_label_->setToolTip(path);
-    clear_button_->setEnabled(true);
+    SetLoading(true);
 
-    UpdateAllPanels();
+    emit RequestLoad(load_request_id_, path);
     return true;
 }
 
 void AnalysisWidget::Clear() {
-    json_data_ = QJsonObject();
+    load_worker_->RequestCancel(load_request_id_);
+    SetLoading(false);
+
+    model_.reset();
+    source_.reset();
     current_file_.clear();
+    loading_file_.clear();
 
     file_label_->setText(QString::fromUtf8("未加载文件"));
     file_label_->setToolTip("");
     clear_button_->setEnabled(false);
+    compare_button_->setEnabled(false);
+    verify_panel_->SetCurrentResult(QString());
+
+    ClearPanels();
+}
 
+void AnalysisWidget::ClearPanels() {
     overview_panel_->Clear();
     capacity_panel_->Clear();
     setup_panel_->Clear();
@@ -144,13 +219,153 @@ void AnalysisWidget::OnClearData() {
     Clear();
 }
 
-void AnalysisWidget::UpdateAllPanels() {
-    if (json_data_.isEmpty()) {
+void AnalysisWidget::OnCancelLoad() {
+    load_worker_->RequestCancel(load_request_id_);
+}
+
+void AnalysisWidget::OnAddToCompare() {
+    if (!source_ || current_file_.isEmpty()) return;
+
+    // The comparison needs every variable; its worker reads the file itself
+    compare_panel_->AddResult(current_file_);
+    tabs_->setCurrentWidget(compare_panel_);
+}
+
+void AnalysisWidget::OnExportAllRequested(const QString& dir) {
+    if (!source_) {
+        variables_panel_->SetExportAllFinished();
         return;
     }
+    emit RequestExportCsv(source_request_id_, source_, dir);
+}
+
+void AnalysisWidget::OnExportFinished(int request_id, bool success, const QString& message) {
+    Q_UNUSED(request_id);
+    // The files are written whether or not another result is shown by now
+    variables_panel_->SetExportAllFinished();
+    if (success) {
+        QMessageBox::information(this, QString::fromUtf8("成功"), message);
+    } else {
+        QMessageBox::warning(this, QString::fromUtf8("错误"), message);
+    }
+}
+
+void AnalysisWidget::OnCacheLimitChanged(int megabytes) {
+    cache_->SetByteLimit(static_cast<size_t>(megabytes) * 1024 * 1024);
+    UpdateCacheLabel();
+}
+
+void AnalysisWidget::UpdateCacheLabel() {
+    cache_label_->setText(QString::fromUtf8("缓存: %1 个结果, %2 MB")
+        .arg(cache_->Count())
+        .arg(static_cast<double>(cache_->ByteSize()) / (1024.0 * 1024.0), 0, 'f', 1));
+}
 
-    overview_panel_->LoadData(json_data_);
-    capacity_panel_->LoadData(json_data_);
-    setup_panel_->LoadData(json_data_);
-    variables_panel_->LoadData(json_data_);
+void AnalysisWidget::AddToComparison(const QStringList& paths) {
+    if (paths.isEmpty()) return;
+    compare_panel_->AddResults(paths);
+    tabs_->setCurrentWidget(compare_panel_);
+}
+
+void AnalysisWidget::VerifyResults(const QStringList& paths) {
+    if (paths.isEmpty()) return;
+    verify_panel_->VerifyPaths(paths);
+    tabs_->setCurrentWidget(verify_panel_);
+}
+
+void AnalysisWidget::SetLoading(bool loading) {
+    progress_bar_->setVisible(loading);
+    progress_bar_->setValue(0);
+    cancel_button_->setVisible(loading);
+    cancel_button_->setEnabled(loading);
+}
+
+void AnalysisWidget::OnLoadProgress(int request_id, int percent, const QString& stage) {
+    if (request_id != load_request_id_) return;
+    progress_bar_->setValue(percent);
+    progress_bar_->setFormat(QString("%1 %p%").arg(stage));
+}
+
+void AnalysisWidget::OnSummaryLoaded(int request_id, const ResultModelPtr& model) {
+    if (request_id != load_request_id_) return;
+
+    // New file: drop previous data before the first panels refill
+    model_ = model;
+    source_.reset();
+    current_file_ = loading_file_;
+    setup_panel_->Clear();
+    variables_panel_->Clear();
+
+    overview_panel_->LoadData(model_);
+    capacity_panel_->LoadData(model_);
+}
+
+void AnalysisWidget::OnSourceLoaded(int request_id, const ResultSourcePtr& source) {
+    if (request_id != load_request_id_) return;
+
+    // Panels ask for the variables they show; nothing is decoded here
+    source_ = source;
+    source_request_id_ = request_id;
+    setup_panel_->LoadData(source_);
+    variables_panel_->LoadData(source_);
+}
+
+void AnalysisWidget::OnVariableRequested(const QString& name) {
+    if (!source_) return;
+    emit RequestVariable(source_request_id_, source_, name);
+}
+
+void AnalysisWidget::OnVariableDecoded(int request_id, const QString& name,
+                                       const ResultVariablePtr& var, const QString& error) {
+    // Answers for a file that has since been replaced
+    if (!source_ || request_id != source_request_id_) return;
+
+    setup_panel_->ShowVariable(name, var, error);
+    variables_panel_->ShowVariable(name, var, error);
+    UpdateCacheLabel();
+}
+
+void AnalysisWidget::OnLoadFinished(int request_id, bool success, const QString& message) {
+    if (request_id != load_request_id_) return;
+    SetLoading(false);
+
+    if (!success) {
+        file_label_->setText(current_file_.isEmpty() ?
+            QString::fromUtf8("未加载文件") : QFileInfo(current_file_).fileName());
+        file_label_->setToolTip(current_file_);
+        QMessageBox::warning(this, QString::fromUtf8("错误"), message);
+        return;
+    }
+
+    QFileInfo info(current_file_);
+    file_label_->setText(info.fileName());
+    file_label_->setToolTip(current_file_);
+    clear_button_->setEnabled(true);
+    compare_button_->setEnabled(true);
+    verify_panel_->SetCurrentResult(current_file_);
+    UpdateCacheLabel();
+}
+
+void AnalysisWidget::OnMetricsDerived(int request_id, const ResultModelPtr& model) {
+    if (request_id != load_request_id_ || !model_) return;
+
+    // Same result, metrics filled in from the variables
+    model_ = model;
+    overview_panel_->LoadData(model_);
+    capacity_panel_->LoadData(model_);
+}
+
+void AnalysisWidget::OnLoadCancelled(int request_id) {
+    if (request_id != load_request_id_) return;
+    SetLoading(false);
+
+    // Partially filled panels would mix two files; keep only a complete result
+    if (current_file_ == loading_file_) {
+        Clear();
+    } else {
+        file_label_->setText(current_file_.isEmpty() ?
+            QString::fromUtf8("未加载文件") : QFileInfo(current_file_).fileName());
+        file_label_->setToolTip(current_file_);
+    }
+    loading_file_.clear();
 }
@@ -1,48 +1,103 @@
 // analysis_widget.h - Main analysis widget for result analysis tab
-// Loads JSON result files and displays analysis in multiple panels
+// Opens result files in the background and displays analysis in multiple panels,
+// plus a comparison tab for several results at once. Only the summary is read up
+// front; variables are decoded on demand when a panel first shows them.
 
 #ifndef ANALYSIS_WIDGET_H_
 #define ANALYSIS_WIDGET_H_
 
 #include <QWidget>
-#include <QJsonObject>
 #include <QString>
+#include <QStringList>
+#include "core/result_cache.h"
+#include "core/result_model.h"
+#include "core/result_source.h"
 
 class QPushButton;
 class QLabel;
 class QTabWidget;
+class QProgressBar;
+class QSpinBox;
+class QThread;
+class ResultLoadWorker;
 class OverviewPanel;
 class CapacityPanel;
 class SetupPanel;
 class VariablesPanel;
+class ComparePanel;
+class VerifyPanel;
 
 class AnalysisWidget : public QWidget {
     Q_OBJECT
 
 public:
-    explicit AnalysisWidget(QWidget* parent = nullptr);
+    // |cache| keeps opened results across loads (shared with the results browser)
+    explicit AnalysisWidget(const ResultCachePtr& cache, QWidget* parent = nullptr);
+    ~AnalysisWidget() override;
 
-    // Load a JSON result file
+    // Start loading a JSON result file in the background.
+    // Returns false if the file does not exist.
     bool LoadJsonFile(const QString& path);
 
-    // Clear all data
+    // Clear all data (cancels a pending load)
     void Clear();
 
     // Check if data is loaded
-    bool HasData() const { return !json_data_.isEmpty(); }
+    bool HasData() const { return model_ != nullptr; }
+
+    // Currently displayed result without variables (shared, read-only)
+    ResultModelPtr Model() const { return model_; }
+
+    // Variables of the currently displayed result, decoded on access
+    ResultSourcePtr Source() const { return source_; }
+
+    // Add result files to the comparison tab and show it
+    void AddToComparison(const QStringList& paths);
+
+    // Check result files for feasibility in the verification tab and show it
+    void VerifyResults(const QStringList& paths);
+
+signals:
+    void RequestLoad(int request_id, const QString& path);
+    void RequestVariable(int request_id, const ResultSourcePtr& source, const QString& name);
+    void RequestExportCsv(int request_id, const ResultSourcePtr& source, const QString& dir);
 
 private slots:
     void OnOpenFile();
     void OnClearData();
+    void OnCancelLoad();
+    void OnAddToCompare();
+    void OnCacheLimitChanged(int megabytes);
+
+    // Slots for load worker signals
+    void OnLoadProgress(int request_id, int percent, const QString& stage);
+    void OnSummaryLoaded(int request_id, const ResultModelPtr& model);
+    void OnSourceLoaded(int request_id, const ResultSourcePtr& source);
+    void OnLoadFinished(int request_id, bool success, const QString& message);
+    void OnMetricsDerived(int request_id, const ResultModelPtr& model);
+    void OnLoadCancelled(int request_id);
+    void OnVariableRequested(const QString& name);
+    void OnVariableDecoded(int request_id, const QString& name, const ResultVariablePtr& var,
+                           const QString& error);
+    void OnExportAllRequested(const QString& dir);
+    void OnExportFinished(int request_id, bool success, const QString& message);
 
 private:
     void SetupUi();
-    void UpdateAllPanels();
+    void SetupWorker();
+    void SetLoading(bool loading);
+    void ClearPanels();
+    void UpdateCacheLabel();
 
     // Top controls
     QPushButton* open_button_;
     QPushButton* clear_button_;
+    QPushButton* cancel_button_;
+    QPushButton* compare_button_;
     QLabel* file_label_;
+    QProgressBar* progress_bar_;
+    QSpinBox* cache_limit_spin_;
+    QLabel* cache_label_;
 
     // Tab widget for different views
     QTabWidget* tabs_;
@@ -52,9 +107,20 @@ private:
     CapacityPanel* capacity_panel_;
     SetupPanel* setup_panel_;
     VariablesPanel* variables_panel_;
+    ComparePanel* compare_panel_;
+    VerifyPanel* verify_panel_;
+
+    // Background loading
+    ResultCachePtr cache_;
+    QThread* load_thread_;
+    ResultLoadWorker* load_worker_;
+    int load_request_id_;
+    QString loading_file_;
 
     // Data
-    QJsonObject json_data_;
+    ResultModelPtr model_;
+    ResultSourcePtr source_;
+    int source_request_id_;  // load request that produced source_
     QString current_file_;
 };
 
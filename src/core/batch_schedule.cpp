@@ -0,0 +1,56 @@
+// batch_schedule.cpp - Longest-job-first batch dispatch implementation
+
+#include "batch_schedule.h"
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <queue>
+
+std::vector<double> EstimatedSeconds(const std::vector<BatchJobEstimate>& jobs) {
+    // Calibrated on the jobs that have both a prediction and a size
+    double predicted = 0.0;
+    double size = 0.0;
+    for (const BatchJobEstimate& job : jobs) {
+        if (job.seconds > 0.0 && job.size_key > 0.0) {
+            predicted += job.seconds;
+            size += job.size_key;
+        }
+    }
+    const double rate = size > 0.0 ? predicted / size : kFallbackSecondsPerUnit;
+
+    std::vector<double> seconds(jobs.size());
+    for (size_t i = 0; i < jobs.size(); ++i) {
+        seconds[i] = jobs[i].seconds > 0.0 ? jobs[i].seconds :
+                     std::max(jobs[i].size_key, 0.0) * rate;
+    }
+    return seconds;
+}
+
+std::vector<int> LongestFirstOrder(const std::vector<BatchJobEstimate>& jobs) {
+    const std::vector<double> seconds = EstimatedSeconds(jobs);
+    std::vector<int> order(jobs.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&seconds](int a, int b) {
+        return seconds[a] > seconds[b];
+    });
+    return order;
+}
+
+double DispatchMakespan(const std::vector<BatchJobEstimate>& jobs,
+                        const std::vector<int>& order, int slots) {
+    const std::vector<double> seconds = EstimatedSeconds(jobs);
+
+    // Finish times of the busy slots, earliest on top
+    std::priority_queue<double, std::vector<double>, std::greater<double>> free_at;
+    for (int i = 0; i < std::max(slots, 1); ++i) free_at.push(0.0);
+    double makespan = 0.0;
+    for (int index : order) {
+        const double start = free_at.top();
+        free_at.pop();
+        const double end = start + seconds[index];
+        makespan = std::max(makespan, end);
+        free_at.push(end);
+    }
+    return makespan;
+}
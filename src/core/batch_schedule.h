@@ -0,0 +1,31 @@
+// batch_schedule.h - Longest-job-first dispatch of a batch over parallel slots
+// Jobs are started longest first and each one goes to the first slot that
+// becomes free (the online form of LPT scheduling: the long jobs overlap, the
+// short ones fill the gaps at the end). Jobs without a predicted duration get a
+// time estimate from their size key, scaled by the seconds per size unit of the
+// predicted jobs in the batch, so all jobs are ordered on one scale.
+
+#ifndef BATCH_SCHEDULE_H_
+#define BATCH_SCHEDULE_H_
+
+#include <vector>
+
+struct BatchJobEstimate {
+    double seconds = 0.0;       // predicted wall time; <= 0 if unknown
+    double size_key = 0.0;      // size the fallback estimate scales with (model columns)
+};
+
+// Wall time of every job: its prediction, else size_key times the batch's
+// seconds per size unit (kFallbackSecondsPerUnit if no job is predicted)
+std::vector<double> EstimatedSeconds(const std::vector<BatchJobEstimate>& jobs);
+
+constexpr double kFallbackSecondsPerUnit = 0.01;
+
+// Indices of |jobs| in start order, longest estimate first
+std::vector<int> LongestFirstOrder(const std::vector<BatchJobEstimate>& jobs);
+
+// Completion time of dispatching |order| over |slots|, from EstimatedSeconds
+double DispatchMakespan(const std::vector<BatchJobEstimate>& jobs,
+                        const std::vector<int>& order, int slots);
+
+#endif  // BATCH_SCHEDULE_H_
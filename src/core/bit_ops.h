@@ -0,0 +1,31 @@
+// bit_ops.h - Portable 64-bit popcount / count-trailing-zeros helpers
+
+#ifndef BIT_OPS_H_
+#define BIT_OPS_H_
+
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+inline int PopCount64(uint64_t x) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt64(x));
+#else
+    return __builtin_popcountll(x);
+#endif
+}
+
+// Undefined for x == 0
+inline int CountTrailingZeros64(uint64_t x) {
+#if defined(_MSC_VER)
+    unsigned long index = 0;
+    _BitScanForward64(&index, x);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+#endif  // BIT_OPS_H_
@@ -0,0 +1,174 @@
+// csv_stream_writer.cpp - Streaming CSV writer implementation
+
+#include "csv_stream_writer.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <new>
+
+namespace fs = std::filesystem;
+
+char* FormatCsvInt(char* p, long long value) {
+    return std::to_chars(p, p + kMaxCellChars, value).ptr;
+}
+
+char* FormatCsvFixed(char* p, double value, int precision) {
+    const auto result = std::to_chars(p, p + kMaxCellChars, value, std::chars_format::fixed,
+                                      precision);
+    if (result.ec != std::errc()) {
+        *p = '0';
+        return p + 1;
+    }
+    return result.ptr;
+}
+
+void CsvStreamWriter::AlignedDelete::operator()(char* p) const {
+    ::operator delete[](p, std::align_val_t(kBufferAlignment));
+}
+
+CsvStreamWriter::CsvStreamWriter()
+    : current_(0)
+    , pos_(0)
+    , submitted_(0)
+    , closing_(false)
+    , failed_(false) {
+}
+
+CsvStreamWriter::~CsvStreamWriter() {
+    Abort();
+}
+
+bool CsvStreamWriter::Open(const std::string& path) {
+    Abort();
+    path_ = path;
+    temp_path_ = path + ".tmp";
+    out_.clear();
+    out_.open(fs::u8path(temp_path_), std::ios::binary | std::ios::trunc);
+    if (!out_) return false;
+
+    if (buffers_.empty()) {
+        for (size_t i = 0; i < kBufferCount; ++i) {
+            buffers_.emplace_back(static_cast<char*>(
+                ::operator new[](kBufferSize, std::align_val_t(kBufferAlignment))));
+        }
+    }
+    current_ = 0;
+    pos_ = 0;
+    submitted_ = 0;
+    full_.clear();
+    free_.clear();
+    for (size_t i = 1; i < kBufferCount; ++i) free_.push_back(i);
+    closing_ = false;
+    failed_ = false;
+    io_thread_ = std::thread(&CsvStreamWriter::WriterLoop, this);
+    return true;
+}
+
+bool CsvStreamWriter::Close() {
+    if (!io_thread_.joinable()) return false;
+    Stop();
+    out_.close();
+
+    std::error_code ec;
+    bool ok = !failed_ && !out_.fail();
+    if (ok) {
+        fs::rename(fs::u8path(temp_path_), fs::u8path(path_), ec);
+        ok = !ec;
+    }
+    if (!ok) fs::remove(fs::u8path(temp_path_), ec);
+    return ok;
+}
+
+void CsvStreamWriter::Abort() {
+    if (!io_thread_.joinable()) return;
+    Stop();
+    out_.close();
+    std::error_code ec;
+    fs::remove(fs::u8path(temp_path_), ec);
+}
+
+void CsvStreamWriter::Int(long long value) {
+    Reserve(24);
+    pos_ = static_cast<size_t>(FormatCsvInt(buffers_[current_].get() + pos_, value) -
+                               buffers_[current_].get());
+}
+
+void CsvStreamWriter::Fixed(double value, int precision) {
+    Reserve(kMaxCellChars);
+    pos_ = static_cast<size_t>(FormatCsvFixed(buffers_[current_].get() + pos_, value, precision) -
+                               buffers_[current_].get());
+}
+
+void CsvStreamWriter::Char(char c) {
+    Reserve(1);
+    buffers_[current_][pos_++] = c;
+}
+
+void CsvStreamWriter::Text(std::string_view text) {
+    while (!text.empty()) {
+        const size_t n = std::min(text.size(), kBufferSize - pos_);
+        if (n == 0) {
+            Submit();
+            continue;
+        }
+        std::memcpy(buffers_[current_].get() + pos_, text.data(), n);
+        pos_ += n;
+        text.remove_prefix(n);
+    }
+}
+
+void CsvStreamWriter::Submit() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    full_.emplace_back(current_, pos_);
+    submitted_ += pos_;
+    full_cv_.notify_one();
+
+    // Blocks only while the I/O thread holds every other buffer
+    free_cv_.wait(lock, [this]() { return !free_.empty(); });
+    current_ = free_.front();
+    free_.pop_front();
+    pos_ = 0;
+}
+
+void CsvStreamWriter::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pos_ > 0) {
+            full_.emplace_back(current_, pos_);
+            submitted_ += pos_;
+            pos_ = 0;
+        }
+        closing_ = true;
+    }
+    full_cv_.notify_one();
+    io_thread_.join();
+}
+
+void CsvStreamWriter::WriterLoop() {
+    while (true) {
+        std::pair<size_t, size_t> item;
+        bool skip = false;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            full_cv_.wait(lock, [this]() { return !full_.empty() || closing_; });
+            if (full_.empty()) return;
+            item = full_.front();
+            full_.pop_front();
+            skip = failed_;
+        }
+
+        // After a failed write buffers are still recycled, so the producer never stalls
+        bool ok = true;
+        if (!skip) {
+            ok = static_cast<bool>(out_.write(buffers_[item.first].get(),
+                                              static_cast<std::streamsize>(item.second)));
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        failed_ = failed_ || !ok;
+        free_.push_back(item.first);
+        free_cv_.notify_one();
+    }
+}
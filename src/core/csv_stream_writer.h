@@ -0,0 +1,89 @@
+// csv_stream_writer.h - Streaming CSV output with a background I/O thread
+// Cells are formatted with std::to_chars straight into large aligned buffers.
+// A full buffer is handed to an I/O thread while the next one fills, so
+// formatting and disk writes overlap and memory stays at kBufferCount buffers
+// however much is written. The file is written as <path>.tmp and only renamed
+// to <path> by a successful Close(), so readers never see a partial file.
+
+#ifndef CSV_STREAM_WRITER_H_
+#define CSV_STREAM_WRITER_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Number formatting shared with in-memory writers; |p| must have room for
+// kMaxCellChars. Returns the end of the written characters.
+constexpr size_t kMaxCellChars = 352;    // fixed notation of any double
+char* FormatCsvInt(char* p, long long value);
+char* FormatCsvFixed(char* p, double value, int precision);
+
+class CsvStreamWriter {
+public:
+    static constexpr size_t kBufferSize = 1 << 20;
+    static constexpr size_t kBufferCount = 4;
+    static constexpr size_t kBufferAlignment = 4096;
+
+    CsvStreamWriter();
+    ~CsvStreamWriter();     // an unclosed file is discarded
+
+    CsvStreamWriter(const CsvStreamWriter&) = delete;
+    CsvStreamWriter& operator=(const CsvStreamWriter&) = delete;
+
+    bool Open(const std::string& path);
+
+    // Flush, wait for the I/O thread and publish the file; false on any error
+    bool Close();
+
+    // Stop and delete the partial file
+    void Abort();
+
+    void Int(long long value);
+    void Fixed(double value, int precision);
+    void Char(char c);
+    void Text(std::string_view text);
+
+    uint64_t BytesWritten() const { return submitted_ + pos_; }
+
+private:
+    struct AlignedDelete {
+        void operator()(char* p) const;
+    };
+    using Buffer = std::unique_ptr<char[], AlignedDelete>;
+
+    // Room for |bytes| more characters in the current buffer
+    void Reserve(size_t bytes) {
+        if (pos_ + bytes > kBufferSize) Submit();
+    }
+    void Submit();
+    void Stop();
+    void WriterLoop();
+
+    std::string path_;
+    std::string temp_path_;
+    std::ofstream out_;
+    std::thread io_thread_;
+
+    std::vector<Buffer> buffers_;
+    size_t current_;
+    size_t pos_;
+    uint64_t submitted_;
+
+    std::mutex mutex_;
+    std::condition_variable full_cv_;
+    std::condition_variable free_cv_;
+    std::deque<std::pair<size_t, size_t>> full_;    // buffer, bytes
+    std::deque<size_t> free_;
+    bool closing_;
+    bool failed_;
+};
+
+#endif  // CSV_STREAM_WRITER_H_
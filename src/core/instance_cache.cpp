@@ -0,0 +1,328 @@
+// instance_cache.cpp - Binary snapshots of parsed instances implementation
+
+#include "instance_cache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+
+constexpr uint32_t kSnapshotMagic = 0x5349534C;  // "LSIS"
+constexpr uint32_t kSnapshotVersion = 1;
+constexpr uint32_t kRefMagic = 0x4652534C;       // "LSRF"
+constexpr size_t kSnapshotAlign = 8;
+
+struct SnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    int32_t n;
+    int32_t t;
+    int32_t f;
+    int32_t g;
+    double capacity;
+    uint32_t column_count;
+    uint32_t reserved;
+    uint64_t file_size;
+    uint8_t hash[16];        // MD5 of the CSV content
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "SnapshotHeader must be 64 bytes");
+
+// One per column, in the order of kDoubleColumns then kIndexColumns
+struct SnapshotColumn {
+    uint64_t offset;
+    uint64_t count;
+};
+
+struct RefRecord {
+    uint32_t magic;
+    uint32_t reserved;
+    int64_t file_size;
+    int64_t modified;
+    uint8_t hash[16];
+};
+
+std::vector<double> InstanceData::* const kDoubleColumns[] = {
+    &InstanceData::demand,
+    &InstanceData::unit_cost,
+    &InstanceData::unit_time,
+    &InstanceData::setup_cost,
+    &InstanceData::setup_time,
+    &InstanceData::holding_cost
+};
+
+std::vector<int> InstanceData::* const kIndexColumns[] = {
+    &InstanceData::flow,
+    &InstanceData::group,
+    &InstanceData::earliest,
+    &InstanceData::latest
+};
+
+constexpr uint32_t kColumnCount = 10;
+
+size_t Padding(size_t size) {
+    return (kSnapshotAlign - size % kSnapshotAlign) % kSnapshotAlign;
+}
+
+bool Stat(const QString& path, qint64* size, qint64* modified) {
+    QFileInfo info(path);
+    if (!info.isFile()) return false;
+    *size = info.size();
+    *modified = info.lastModified().toMSecsSinceEpoch();
+    return true;
+}
+
+// Content hash of a record (file names use its hex form)
+QByteArray HashFromRecord(const uint8_t* bytes) {
+    return QByteArray(reinterpret_cast<const char*>(bytes), 16);
+}
+
+bool ReadRef(const QString& path, RefRecord* ref) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    return file.read(reinterpret_cast<char*>(ref), sizeof(RefRecord)) == sizeof(RefRecord) &&
+           ref->magic == kRefMagic;
+}
+
+void WriteRef(const QString& path, qint64 file_size, qint64 modified, const QByteArray& hash) {
+    RefRecord ref = {};
+    ref.magic = kRefMagic;
+    ref.file_size = file_size;
+    ref.modified = modified;
+    std::memcpy(ref.hash, hash.constData(), sizeof(ref.hash));
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return;
+    file.write(reinterpret_cast<const char*>(&ref), sizeof(ref));
+    file.commit();
+}
+
+// Map |path| and copy every column out in one block. nullptr if the snapshot is
+// missing, damaged or of another version.
+InstanceDataPtr ReadSnapshot(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return nullptr;
+    const qint64 size = file.size();
+    const size_t table_end = sizeof(SnapshotHeader) + kColumnCount * sizeof(SnapshotColumn);
+    if (size < static_cast<qint64>(table_end)) return nullptr;
+    const uchar* data = file.map(0, size);
+    if (!data) return nullptr;
+
+    SnapshotHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != kSnapshotMagic || header.version != kSnapshotVersion ||
+        header.column_count != kColumnCount || header.file_size != static_cast<uint64_t>(size)) {
+        return nullptr;
+    }
+    SnapshotColumn columns[kColumnCount];
+    std::memcpy(columns, data + sizeof(header), sizeof(columns));
+
+    auto instance = std::make_shared<InstanceData>();
+    instance->n = header.n;
+    instance->t = header.t;
+    instance->f = header.f;
+    instance->g = header.g;
+    instance->capacity = header.capacity;
+
+    // Columns start on 8-byte boundaries of a page-aligned mapping
+    auto in_bounds = [size](const SnapshotColumn& column, size_t element) {
+        return column.offset % kSnapshotAlign == 0 &&
+               column.count <= static_cast<uint64_t>(size) / element &&
+               column.offset + column.count * element <= static_cast<uint64_t>(size);
+    };
+    uint32_t c = 0;
+    for (auto column : kDoubleColumns) {
+        const SnapshotColumn& record = columns[c++];
+        if (!in_bounds(record, sizeof(double))) return nullptr;
+        const double* first = reinterpret_cast<const double*>(data + record.offset);
+        (instance.get()->*column).assign(first, first + record.count);
+    }
+    for (auto column : kIndexColumns) {
+        const SnapshotColumn& record = columns[c++];
+        if (!in_bounds(record, sizeof(int32_t))) return nullptr;
+        const int32_t* first = reinterpret_cast<const int32_t*>(data + record.offset);
+        (instance.get()->*column).assign(first, first + record.count);
+    }
+    return instance->IsValid() ? instance : nullptr;
+}
+
+bool WriteSnapshot(const QString& path, const InstanceData& instance, const QByteArray& hash) {
+    SnapshotHeader header = {};
+    header.magic = kSnapshotMagic;
+    header.version = kSnapshotVersion;
+    header.n = instance.n;
+    header.t = instance.t;
+    header.f = instance.f;
+    header.g = instance.g;
+    header.capacity = instance.capacity;
+    header.column_count = kColumnCount;
+    std::memcpy(header.hash, hash.constData(), sizeof(header.hash));
+
+    // Layout first, then one write per column
+    SnapshotColumn columns[kColumnCount];
+    uint64_t offset = sizeof(header) + sizeof(columns);
+    uint32_t c = 0;
+    for (auto column : kDoubleColumns) {
+        columns[c] = {offset, (instance.*column).size()};
+        offset += columns[c++].count * sizeof(double);
+    }
+    for (auto column : kIndexColumns) {
+        columns[c] = {offset, (instance.*column).size()};
+        const size_t bytes = columns[c++].count * sizeof(int32_t);
+        offset += bytes + Padding(bytes);
+    }
+    header.file_size = offset;
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) return false;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(columns), sizeof(columns));
+    for (auto column : kDoubleColumns) {
+        const std::vector<double>& values = instance.*column;
+        file.write(reinterpret_cast<const char*>(values.data()),
+                   static_cast<qint64>(values.size() * sizeof(double)));
+    }
+    static const char kZeros[kSnapshotAlign] = {};
+    for (auto column : kIndexColumns) {
+        static_assert(sizeof(int) == sizeof(int32_t), "index columns are stored as int32");
+        const std::vector<int>& values = instance.*column;
+        const size_t bytes = values.size() * sizeof(int32_t);
+        file.write(reinterpret_cast<const char*>(values.data()), static_cast<qint64>(bytes));
+        file.write(kZeros, static_cast<qint64>(Padding(bytes)));
+    }
+    return file.commit();
+}
+
+}  // namespace
+
+InstanceCache::InstanceCache(const QString& dir)
+    : dir_(dir) {
+}
+
+InstanceCache& InstanceCache::Shared() {
+    static InstanceCache cache(
+        QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) +
+        "/instance_cache");
+    return cache;
+}
+
+QString InstanceCache::RefPath(const QString& path) const {
+    QString canonical = QDir::cleanPath(QFileInfo(path).absoluteFilePath());
+    QByteArray key = QCryptographicHash::hash(canonical.toUtf8(), QCryptographicHash::Md5).toHex();
+    return QString("%1/%2.ref").arg(dir_, QString::fromLatin1(key));
+}
+
+QString InstanceCache::SnapshotPath(const QByteArray& hash) const {
+    return QString("%1/%2.lsis").arg(dir_, QString::fromLatin1(hash.toHex()));
+}
+
+InstanceDataPtr InstanceCache::Load(const QString& path, QString* error, bool* hit) {
+    if (hit) *hit = false;
+    qint64 size = 0;
+    qint64 modified = 0;
+    if (!Stat(path, &size, &modified)) {
+        if (error) *error = QString::fromUtf8("无法读取文件: %1").arg(path);
+        return nullptr;
+    }
+
+    // Still in use elsewhere and unchanged
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = entries_.find(path);
+        if (it != entries_.end() && it->second.file_size == size &&
+            it->second.modified == modified) {
+            if (InstanceDataPtr instance = it->second.instance.lock()) {
+                if (hit) *hit = true;
+                return instance;
+            }
+        }
+    }
+
+    auto remember = [&](const InstanceDataPtr& instance, bool from_cache) {
+        if (hit) *hit = from_cache;
+        std::lock_guard<std::mutex> lock(mutex_);
+        Entry& entry = entries_[path];
+        entry.file_size = size;
+        entry.modified = modified;
+        entry.instance = instance;
+        return instance;
+    };
+
+    // Size and mtime match the last look at this path: no need to read the CSV
+    const QString ref_path = RefPath(path);
+    RefRecord ref;
+    const bool has_ref = ReadRef(ref_path, &ref);
+    if (has_ref && ref.file_size == size && ref.modified == modified) {
+        if (InstanceDataPtr instance = ReadSnapshot(SnapshotPath(HashFromRecord(ref.hash)))) {
+            return remember(instance, true);
+        }
+    }
+
+    // Hash the content; unchanged content keeps its snapshot
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (error) *error = QString::fromUtf8("无法读取文件: %1").arg(path);
+        return nullptr;
+    }
+    const uchar* mapped = size > 0 ? file.map(0, size) : nullptr;
+    QByteArray buffer;
+    if (!mapped) buffer = file.readAll();
+    const char* data = mapped ? reinterpret_cast<const char*>(mapped) : buffer.constData();
+    const size_t data_size = mapped ? static_cast<size_t>(size) : static_cast<size_t>(buffer.size());
+
+    const QByteArray hash = QCryptographicHash::hash(
+        QByteArray::fromRawData(data, static_cast<qsizetype>(data_size)), QCryptographicHash::Md5);
+    const QString snapshot_path = SnapshotPath(hash);
+    QDir().mkpath(dir_);
+
+    if (InstanceDataPtr instance = ReadSnapshot(snapshot_path)) {
+        WriteRef(ref_path, size, modified, hash);
+        return remember(instance, true);
+    }
+
+    auto instance = std::make_shared<InstanceData>();
+    if (!ParseInstanceCsv(data, data_size, instance.get())) {
+        if (error) *error = InstanceParseError(path, *instance);
+        return nullptr;
+    }
+    file.close();
+
+    // The file was edited: its previous snapshot is dropped (another path with
+    // the same old content would simply parse again)
+    if (has_ref && HashFromRecord(ref.hash) != hash) {
+        QFile::remove(SnapshotPath(HashFromRecord(ref.hash)));
+    }
+    // Snapshots hold only the columns: a file with unrecognised columns is parsed
+    // each time so that they are still reported
+    if (instance->unknown_columns.isEmpty() && WriteSnapshot(snapshot_path, *instance, hash)) {
+        WriteRef(ref_path, size, modified, hash);
+    }
+    return remember(instance, false);
+}
+
+QByteArray InstanceCache::ContentHash(const QString& path) const {
+    qint64 size = 0;
+    qint64 modified = 0;
+    if (!Stat(path, &size, &modified)) return QByteArray();
+
+    RefRecord ref;
+    if (ReadRef(RefPath(path), &ref) && ref.file_size == size && ref.modified == modified) {
+        return HashFromRecord(ref.hash);
+    }
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return QByteArray();
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    if (!hash.addData(&file)) return QByteArray();
+    return hash.result();
+}
+
+InstanceDataPtr LoadInstanceCached(const QString& path, QString* error) {
+    return InstanceCache::Shared().Load(path, error);
+}
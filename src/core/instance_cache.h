@@ -0,0 +1,65 @@
+// instance_cache.h - Binary snapshots of parsed instances
+// Parsing a large instance CSV again for every preview, verification or batch job
+// is avoided by keeping each parsed instance as a binary snapshot in a local cache
+// directory, named by the MD5 of the CSV content:
+//
+//   <dir>/<content md5>.lsis   header + one aligned typed array per column
+//   <dir>/<path md5>.ref       size, mtime and content md5 last seen for a path
+//
+// A lookup first compares the CSV's size and modification time with its .ref, so
+// an unchanged file is reopened without reading or hashing it: the snapshot is
+// mapped and each column copied out in one block. A changed file is hashed; the
+// same content under another name or a touched file still hits, anything else
+// is parsed and snapshotted. Instances still in use are shared in memory.
+
+#ifndef INSTANCE_CACHE_H_
+#define INSTANCE_CACHE_H_
+
+#include <QByteArray>
+#include <QString>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "instance_data.h"
+
+class InstanceCache {
+public:
+    explicit InstanceCache(const QString& dir);
+
+    InstanceCache(const InstanceCache&) = delete;
+    InstanceCache& operator=(const InstanceCache&) = delete;
+
+    // Process-wide cache under AppLocalData/instance_cache
+    static InstanceCache& Shared();
+
+    // Parsed instance of the CSV at |path|. |hit| (optional) is set if it came
+    // from memory or a snapshot. Returns nullptr and sets |error| if the file
+    // cannot be read or parsed. Thread-safe; disk work runs without the lock.
+    // Failing to write the cache is not an error.
+    InstanceDataPtr Load(const QString& path, QString* error, bool* hit = nullptr);
+
+    // MD5 of the CSV content at |path|, empty if it cannot be read. An unchanged
+    // file reuses the hash its last Load() recorded instead of reading it again.
+    QByteArray ContentHash(const QString& path) const;
+
+    QString Dir() const { return dir_; }
+
+private:
+    struct Entry {
+        qint64 file_size = 0;
+        qint64 modified = 0;   // ms since epoch
+        std::weak_ptr<const InstanceData> instance;
+    };
+
+    QString RefPath(const QString& path) const;
+    QString SnapshotPath(const QByteArray& hash) const;
+
+    QString dir_;
+    std::mutex mutex_;
+    std::map<QString, Entry> entries_;
+};
+
+// Read |path| through the shared instance cache
+InstanceDataPtr LoadInstanceCached(const QString& path, QString* error);
+
+#endif  // INSTANCE_CACHE_H_
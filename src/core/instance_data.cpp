@@ -0,0 +1,316 @@
+// instance_data.cpp - Problem instance CSV reader implementation
+
+#include "instance_data.h"
+
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace {
+
+enum class Field {
+    Unknown,
+    Skip,
+    Flow,
+    Group,
+    Demand,
+    Earliest,
+    Latest,
+    UnitCost,
+    UnitTime,
+    SetupCost,
+    SetupTime,
+    HoldingCost
+};
+
+enum class Table {
+    None,
+    Orders,
+    Groups,
+    Flows
+};
+
+std::string_view Trim(std::string_view text) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+// Lower case without separators: "Setup_Cost" -> "setupcost"
+std::string NormalizeName(std::string_view cell) {
+    std::string name;
+    name.reserve(cell.size());
+    for (char c : Trim(cell)) {
+        if (c == '_' || c == ' ' || c == '-') continue;
+        name.push_back((c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c);
+    }
+    return name;
+}
+
+// Column names of the generator layout (instance_data.h), normalized
+Field FieldFromName(const std::string& name) {
+    if (name == "order") return Field::Skip;
+    if (name == "flow") return Field::Flow;
+    if (name == "group") return Field::Group;
+    if (name == "demand") return Field::Demand;
+    if (name == "earliest") return Field::Earliest;
+    if (name == "latest") return Field::Latest;
+    if (name == "unitcost") return Field::UnitCost;
+    if (name == "unittime") return Field::UnitTime;
+    if (name == "setupcost") return Field::SetupCost;
+    if (name == "setuptime") return Field::SetupTime;
+    if (name == "holdingcost") return Field::HoldingCost;
+    return Field::Unknown;
+}
+
+// Whole cell as a number (std::from_chars: no locale, no allocation). Ids,
+// periods and most quantities are short unsigned integers and take the digit loop.
+bool ParseNumber(std::string_view cell, double* value) {
+    cell = Trim(cell);
+    if (!cell.empty() && cell.front() == '+') cell.remove_prefix(1);
+    if (cell.empty()) return false;
+    if (cell.size() <= 9) {
+        uint32_t digits = 0;
+        size_t k = 0;
+        for (; k < cell.size() && static_cast<unsigned>(cell[k] - '0') < 10u; ++k) {
+            digits = digits * 10 + static_cast<uint32_t>(cell[k] - '0');
+        }
+        if (k == cell.size()) {
+            *value = static_cast<double>(digits);
+            return true;
+        }
+    }
+    const auto result = std::from_chars(cell.data(), cell.data() + cell.size(), *value);
+    return result.ec == std::errc() && result.ptr == cell.data() + cell.size();
+}
+
+void SplitCells(std::string_view line, std::vector<std::string_view>* cells) {
+    cells->clear();
+    size_t start = 0;
+    while (true) {
+        const size_t comma = line.find(',', start);
+        if (comma == std::string_view::npos) {
+            cells->push_back(line.substr(start));
+            return;
+        }
+        cells->push_back(line.substr(start, comma - start));
+        start = comma + 1;
+    }
+}
+
+void ReadScalar(std::string_view key, double value, InstanceData* data) {
+    const std::string name = NormalizeName(key);
+    if (name == "tnum") {
+        data->t = static_cast<int>(value);
+    } else if (name == "fnum") {
+        data->f = static_cast<int>(value);
+    } else if (name == "gnum") {
+        data->g = static_cast<int>(value);
+    } else if (name == "ordernum") {
+        data->n = static_cast<int>(value);
+    } else if (name == "capacity") {
+        data->capacity = value;
+    }
+}
+
+std::vector<double>* DoubleColumn(Field field, InstanceData* data) {
+    switch (field) {
+        case Field::Demand: return &data->demand;
+        case Field::UnitCost: return &data->unit_cost;
+        case Field::UnitTime: return &data->unit_time;
+        case Field::SetupCost: return &data->setup_cost;
+        case Field::SetupTime: return &data->setup_time;
+        case Field::HoldingCost: return &data->holding_cost;
+        default: return nullptr;
+    }
+}
+
+std::vector<int>* IndexColumn(Field field, InstanceData* data) {
+    switch (field) {
+        case Field::Flow: return &data->flow;
+        case Field::Group: return &data->group;
+        case Field::Earliest: return &data->earliest;
+        case Field::Latest: return &data->latest;
+        default: return nullptr;
+    }
+}
+
+// Order_Num is known before the order table in generator files
+void ReserveColumns(const std::vector<Field>& columns, Table table, InstanceData* data) {
+    const int count = table == Table::Orders ? data->n :
+                      table == Table::Groups ? data->g : data->f;
+    if (count <= 0) return;
+    for (Field field : columns) {
+        if (std::vector<double>* column = DoubleColumn(field, data)) {
+            column->reserve(static_cast<size_t>(count));
+        } else if (std::vector<int>* index = IndexColumn(field, data)) {
+            index->reserve(static_cast<size_t>(count));
+        }
+    }
+}
+
+// A column is either complete or absent: partial columns are dropped
+template <typename T>
+void KeepIfComplete(std::vector<T>* column, int count) {
+    if (column->size() != static_cast<size_t>(count)) {
+        column->clear();
+        column->shrink_to_fit();
+    }
+}
+
+}  // namespace
+
+size_t InstanceData::ByteSize() const {
+    return (demand.capacity() + unit_cost.capacity() + unit_time.capacity() +
+            setup_cost.capacity() + setup_time.capacity() + holding_cost.capacity()) *
+               sizeof(double) +
+           (flow.capacity() + group.capacity() + earliest.capacity() + latest.capacity()) *
+               sizeof(int);
+}
+
+bool ParseInstanceCsv(const char* data, size_t size, InstanceData* instance) {
+    *instance = InstanceData();
+    std::string_view text(data, size);
+    if (text.size() >= 3 && text.compare(0, 3, "\xEF\xBB\xBF") == 0) text.remove_prefix(3);
+
+    Table table = Table::None;
+    std::vector<Field> columns;
+    std::vector<std::string_view> cells;
+    cells.reserve(16);
+
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t eol = text.find('\n', pos);
+        if (eol == std::string_view::npos) eol = text.size();
+        const std::string_view line = Trim(text.substr(pos, eol - pos));
+        pos = eol + 1;
+
+        if (line.empty()) {
+            table = Table::None;
+            continue;
+        }
+        SplitCells(line, &cells);
+
+        double value = 0.0;
+        if (ParseNumber(cells[0], &value)) {
+            // Data row of the current table
+            if (table == Table::None) continue;
+            for (size_t c = 0; c < columns.size(); ++c) {
+                if (columns[c] == Field::Skip) continue;
+                double cell = 0.0;
+                const bool present = c < cells.size() && ParseNumber(cells[c], &cell);
+                if (std::vector<double>* column = DoubleColumn(columns[c], instance)) {
+                    column->push_back(present ? cell : 0.0);
+                } else if (std::vector<int>* index = IndexColumn(columns[c], instance)) {
+                    // 1-based in the file
+                    index->push_back(present ? static_cast<int>(cell) - 1 : -1);
+                }
+            }
+            continue;
+        }
+
+        if (cells.size() >= 2 && ParseNumber(cells[1], &value)) {
+            table = Table::None;
+            ReadScalar(cells[0], value, instance);
+            continue;
+        }
+
+        // Header row: the column names decide which table follows
+        columns.clear();
+        bool has_demand = false;
+        for (std::string_view cell : cells) {
+            columns.push_back(FieldFromName(NormalizeName(cell)));
+            has_demand = has_demand || columns.back() == Field::Demand;
+            if (columns.back() == Field::Unknown) {
+                const std::string_view name = Trim(cell);
+                instance->unknown_columns << QString::fromUtf8(name.data(),
+                                                               static_cast<int>(name.size()));
+                columns.back() = Field::Skip;
+            }
+        }
+        if (has_demand) {
+            table = Table::Orders;
+        } else if (columns[0] == Field::Group) {
+            table = Table::Groups;
+            columns[0] = Field::Skip;   // the id column itself
+        } else if (columns[0] == Field::Flow) {
+            table = Table::Flows;
+            columns[0] = Field::Skip;
+        } else {
+            table = Table::None;
+        }
+        if (table != Table::None) ReserveColumns(columns, table, instance);
+    }
+
+    if (instance->n <= 0) instance->n = static_cast<int>(instance->demand.size());
+    if (instance->g <= 0) instance->g = static_cast<int>(instance->setup_cost.size());
+    if (instance->f <= 0) instance->f = static_cast<int>(instance->holding_cost.size());
+
+    KeepIfComplete(&instance->demand, instance->n);
+    KeepIfComplete(&instance->flow, instance->n);
+    KeepIfComplete(&instance->group, instance->n);
+    KeepIfComplete(&instance->earliest, instance->n);
+    KeepIfComplete(&instance->latest, instance->n);
+    KeepIfComplete(&instance->unit_cost, instance->n);
+    KeepIfComplete(&instance->unit_time, instance->n);
+    KeepIfComplete(&instance->setup_cost, instance->g);
+    KeepIfComplete(&instance->setup_time, instance->g);
+    KeepIfComplete(&instance->holding_cost, instance->f);
+    return instance->IsValid() && instance->HasOrderColumns();
+}
+
+QString InstanceParseError(const QString& path, const InstanceData& instance) {
+    if (!instance.IsValid()) {
+        return QString::fromUtf8("无法解析文件 (缺少 Order_Num / T_num): %1").arg(path);
+    }
+    QString error = QString::fromUtf8("算例中没有可识别的订单表: %1").arg(path);
+    if (!instance.unknown_columns.isEmpty()) {
+        error += QString::fromUtf8(" (未识别的列: %1)").arg(instance.unknown_columns.join(", "));
+    }
+    return error;
+}
+
+bool LoadInstanceCsv(const QString& path, InstanceData* data, QString* error) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (error) *error = QString::fromUtf8("无法读取文件: %1").arg(path);
+        return false;
+    }
+
+    // Parsed straight from the mapping; a plain read where mapping is not possible
+    const qint64 size = file.size();
+    const uchar* mapped = size > 0 ? file.map(0, size) : nullptr;
+    QByteArray buffer;
+    if (!mapped) buffer = file.readAll();
+    const bool ok = mapped ?
+        ParseInstanceCsv(reinterpret_cast<const char*>(mapped), static_cast<size_t>(size), data) :
+        ParseInstanceCsv(buffer.constData(), static_cast<size_t>(buffer.size()), data);
+    file.close();
+
+    if (!ok) {
+        if (error) *error = InstanceParseError(path, *data);
+        return false;
+    }
+    return true;
+}
+
+QString FindInstanceFile(const QString& input_file, const QString& result_path) {
+    if (input_file.isEmpty()) return QString();
+    if (QFileInfo::exists(input_file)) return input_file;
+
+    const QString name = QFileInfo(input_file).fileName();
+    QDir dir = QFileInfo(result_path).dir();
+    for (int level = 0; level < 2; ++level) {
+        const QString candidate = dir.filePath(name);
+        if (QFileInfo::exists(candidate)) return candidate;
+        if (!dir.cdUp()) break;
+    }
+    return QString();
+}
@@ -0,0 +1,88 @@
+// instance_data.h - Problem instance read from the generator CSV
+// Struct-of-arrays view of an LS-NTGF instance (orders, groups, flows) for the
+// analysis code. The file is a sequence of scalar lines ("T_num,30") and tables
+// introduced by a header row; tables are recognised by their column names, and
+// any column the file does not have (or does not fill for every row) is left
+// empty. Only the names below are read; any other header cell is listed in
+// unknown_columns rather than guessed at. A file whose order table fills none of
+// the per-order columns is rejected: its columns are in a layout this reader
+// does not know, and a scalar-only instance would silently turn off everything
+// built on the order data. Ids and periods are 1-based in the file and 0-based
+// here.
+//
+// The file is parsed in place from a memory mapping: lines and cells are views
+// into the mapping, numbers go through std::from_chars and each column is
+// reserved from the scalar counts, so a 10^6-order instance costs one pass and
+// one allocation per column.
+//
+//   T_num,30 / F_num,5 / G_num,5 / Order_Num,300 / Capacity,1440
+//   Order,Flow,Group,Demand,Earliest,Latest,UnitCost,UnitTime   (order table)
+//   Group,SetupCost,SetupTime                                    (group table)
+//   Flow,HoldingCost                                             (flow table)
+
+#ifndef INSTANCE_DATA_H_
+#define INSTANCE_DATA_H_
+
+#include <QString>
+#include <QStringList>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+struct InstanceData {
+    int n = 0;                // orders
+    int t = 0;                // periods
+    int f = 0;                // flows
+    int g = 0;                // groups
+    double capacity = 0.0;    // per period, 0 if the file does not state it
+
+    // Orders (n entries each when present)
+    std::vector<double> demand;
+    std::vector<int> flow;
+    std::vector<int> group;
+    std::vector<int> earliest;
+    std::vector<int> latest;
+    std::vector<double> unit_cost;
+    std::vector<double> unit_time;
+
+    // Groups (g entries each when present)
+    std::vector<double> setup_cost;
+    std::vector<double> setup_time;
+
+    // Flows (f entries when present)
+    std::vector<double> holding_cost;
+
+    // Header cells that name no known column, as written in the file
+    QStringList unknown_columns;
+
+    bool IsValid() const { return n > 0 && t > 0; }
+    // At least one per-order column was read
+    bool HasOrderColumns() const {
+        return !demand.empty() || !flow.empty() || !group.empty() || !earliest.empty() ||
+               !latest.empty() || !unit_cost.empty() || !unit_time.empty();
+    }
+
+    // Heap bytes held by the columns
+    size_t ByteSize() const;
+};
+
+using InstanceDataPtr = std::shared_ptr<const InstanceData>;
+
+// Parse instance CSV text (|size| bytes, need not be NUL-terminated) into
+// |instance|. Returns false if the order count / period count are missing or no
+// per-order column was recognised; |instance| keeps what was read either way.
+bool ParseInstanceCsv(const char* data, size_t size, InstanceData* instance);
+
+// Why ParseInstanceCsv rejected |path|, given what it left in |instance|
+QString InstanceParseError(const QString& path, const InstanceData& instance);
+
+// Read |path| into |data|. Returns false and sets |error| if the file cannot be
+// read or ParseInstanceCsv rejects it.
+bool LoadInstanceCsv(const QString& path, InstanceData* data, QString* error);
+
+// Instance file of a result: |input_file| as recorded by the solver, or a file of
+// the same name next to |result_path| or one level up (results copied from
+// another machine). Empty if none exists.
+QString FindInstanceFile(const QString& input_file, const QString& result_path);
+
+#endif  // INSTANCE_DATA_H_
@@ -0,0 +1,432 @@
+// instance_generator.cpp - Native instance generator implementation
+
+#include "instance_generator.h"
+#include "csv_stream_writer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <string_view>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kMinDemandWeight = 0.1;
+
+uint64_t SplitMix64(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t Rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+double Round2(double value) {
+    return std::round(value * 100.0) / 100.0;
+}
+
+// In-memory counterpart of CsvStreamWriter: same formatting, same bytes
+class StringCsvOut {
+public:
+    explicit StringCsvOut(std::string* out) : out_(out) {}
+
+    void Int(long long value) {
+        char buffer[kMaxCellChars];
+        out_->append(buffer, FormatCsvInt(buffer, value));
+    }
+    void Fixed(double value, int precision) {
+        char buffer[kMaxCellChars];
+        out_->append(buffer, FormatCsvFixed(buffer, value, precision));
+    }
+    void Char(char c) { out_->push_back(c); }
+    void Text(std::string_view text) { out_->append(text.data(), text.size()); }
+
+private:
+    std::string* out_;
+};
+
+// Scalars up to and including the order table header
+template <typename Out>
+void WriteHead(Out& out, int t, int f, int g, int n, double capacity) {
+    out.Text("T_num,");
+    out.Int(t);
+    out.Text("\nF_num,");
+    out.Int(f);
+    out.Text("\nG_num,");
+    out.Int(g);
+    out.Text("\nOrder_Num,");
+    out.Int(n);
+    out.Text("\nCapacity,");
+    out.Int(std::llround(capacity));
+    out.Text("\n\nOrder,Flow,Group,Demand,Earliest,Latest,UnitCost,UnitTime\n");
+}
+
+// One order; indices are 0-based here and 1-based in the file
+template <typename Out>
+void WriteOrder(Out& out, int order, int flow, int group, double demand, int earliest,
+                int latest, double unit_cost, double unit_time) {
+    out.Int(order + 1);
+    out.Char(',');
+    out.Int(flow + 1);
+    out.Char(',');
+    out.Int(group + 1);
+    out.Char(',');
+    out.Int(std::llround(demand));
+    out.Char(',');
+    out.Int(earliest + 1);
+    out.Char(',');
+    out.Int(latest + 1);
+    out.Char(',');
+    out.Fixed(unit_cost, 2);
+    out.Char(',');
+    out.Fixed(unit_time, 2);
+    out.Char('\n');
+}
+
+template <typename Out>
+void WriteTail(Out& out, const std::vector<double>& setup_cost,
+               const std::vector<double>& setup_time, const std::vector<double>& holding_cost) {
+    out.Text("\nGroup,SetupCost,SetupTime\n");
+    for (size_t k = 0; k < setup_cost.size(); ++k) {
+        out.Int(static_cast<long long>(k) + 1);
+        out.Char(',');
+        out.Int(std::llround(setup_cost[k]));
+        out.Char(',');
+        out.Int(std::llround(setup_time[k]));
+        out.Char('\n');
+    }
+    out.Text("\nFlow,HoldingCost\n");
+    for (size_t k = 0; k < holding_cost.size(); ++k) {
+        out.Int(static_cast<long long>(k) + 1);
+        out.Char(',');
+        out.Fixed(holding_cost[k], 2);
+        out.Char('\n');
+    }
+}
+
+// Everything drawn before the orders: groups, flows and peak periods
+struct InstanceFrame {
+    int n = 0;
+    int t = 0;
+    int f = 0;
+    int g = 0;
+    double capacity = 0.0;
+    std::vector<double> setup_time;
+    std::vector<double> setup_cost;
+    std::vector<double> holding_cost;
+    std::vector<uint8_t> is_peak;
+};
+
+struct OrderDraw {
+    int flow = 0;
+    int group = 0;
+    int earliest = 0;
+    int latest = 0;
+    double unit_time = 0.0;
+    double unit_cost = 0.0;
+    double weight = 0.0;    // relative demand, before scaling to the target load
+};
+
+void DrawFrame(const InstanceGenParams& params, InstanceRng* rng, InstanceFrame* frame) {
+    InstanceFrame& fr = *frame;
+    fr.n = std::max(1, params.n);
+    fr.t = std::max(1, params.t);
+    fr.f = std::max(1, params.f);
+    fr.g = std::max(1, params.g);
+    fr.capacity = std::max(1, params.zoom) * 24.0;
+
+    // Groups: setup times are absolute, so a smaller zoom makes them weigh more
+    fr.setup_time.resize(fr.g);
+    fr.setup_cost.resize(fr.g);
+    for (int k = 0; k < fr.g; ++k) {
+        fr.setup_time[k] = rng->Int(20, 60);
+        fr.setup_cost[k] = params.cost_correlation
+                               ? std::round(fr.setup_time[k] * rng->Uniform(8.0, 12.0))
+                               : rng->Int(200, 600);
+    }
+
+    fr.holding_cost.resize(fr.f);
+    for (int k = 0; k < fr.f; ++k) fr.holding_cost[k] = Round2(rng->Uniform(0.5, 2.0));
+
+    // Peak periods: a random subset of round(peak_ratio * T)
+    std::vector<int> periods(fr.t);
+    std::iota(periods.begin(), periods.end(), 0);
+    const int peaks = std::clamp(static_cast<int>(std::lround(params.peak_ratio * fr.t)), 0, fr.t);
+    fr.is_peak.assign(fr.t, 0);
+    for (int k = 0; k < peaks; ++k) {
+        std::swap(periods[k], periods[rng->Int(k, fr.t - 1)]);
+        fr.is_peak[periods[k]] = 1;
+    }
+}
+
+// Next order: window around a due period, demand as a relative weight
+OrderDraw DrawOrder(const InstanceGenParams& params, const InstanceFrame& frame,
+                    InstanceRng* rng) {
+    OrderDraw o;
+    o.flow = rng->Int(0, frame.f - 1);
+    o.group = rng->Int(0, frame.g - 1);
+
+    const int offset = std::max(0, params.time_window_offset);
+    const double kind = rng->Uniform();
+    const int half = kind < params.urgent_ratio ? 0
+                   : kind < params.urgent_ratio + params.flexible_ratio ? 2 * offset
+                   : offset;
+    const int center = rng->Int(0, frame.t - 1);
+    o.earliest = std::max(0, center - half);
+    o.latest = std::min(frame.t - 1, center + half);
+
+    o.unit_time = Round2(rng->Uniform(0.5, 1.5));
+    o.unit_cost = Round2(params.cost_correlation ? o.unit_time * rng->Uniform(8.0, 12.0)
+                                                 : rng->Uniform(5.0, 15.0));
+
+    o.weight = std::max(kMinDemandWeight, 1.0 + params.demand_cv * rng->Normal());
+    if (frame.is_peak[o.latest]) o.weight *= params.peak_multiplier;
+    return o;
+}
+
+// Scale the weights so processing alone fills the target share of capacity
+double DemandScale(const InstanceGenParams& params, const InstanceFrame& frame, double load) {
+    const double target = params.capacity_utilization * frame.capacity * frame.t;
+    return load > 0.0 ? target / load : 0.0;
+}
+
+double ScaledDemand(double weight, double scale) {
+    return std::max(1.0, std::round(weight * scale));
+}
+
+// Written next to the target and renamed, so a scan never sees half a file
+bool WriteFileAtomic(const std::string& path, const std::string& text) {
+    const fs::path target = fs::u8path(path);
+    fs::path temp = target;
+    temp += ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out || !out.write(text.data(), static_cast<std::streamsize>(text.size()))) return false;
+    }
+    std::error_code ec;
+    fs::rename(temp, target, ec);
+    if (ec) fs::remove(temp, ec);
+    return !ec;
+}
+
+}  // namespace
+
+InstanceRng::InstanceRng(uint64_t seed)
+    : has_spare_(false)
+    , spare_(0.0) {
+    for (uint64_t& s : s_) s = SplitMix64(&seed);
+}
+
+uint64_t InstanceRng::Next() {
+    const uint64_t result = Rotl(s_[1] * 5, 7) * 9;
+    const uint64_t t = s_[1] << 17;
+    s_[2] ^= s_[0];
+    s_[3] ^= s_[1];
+    s_[1] ^= s_[2];
+    s_[0] ^= s_[3];
+    s_[2] ^= t;
+    s_[3] = Rotl(s_[3], 45);
+    return result;
+}
+
+double InstanceRng::Uniform() {
+    return static_cast<double>(Next() >> 11) * 0x1.0p-53;
+}
+
+double InstanceRng::Uniform(double lo, double hi) {
+    return lo + (hi - lo) * Uniform();
+}
+
+int InstanceRng::Int(int lo, int hi) {
+    if (hi <= lo) return lo;
+    // Rejection keeps every value equally likely
+    const uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(hi) - lo) + 1;
+    const uint64_t limit = UINT64_MAX - UINT64_MAX % range;
+    uint64_t x = Next();
+    while (x >= limit) x = Next();
+    return lo + static_cast<int>(x % range);
+}
+
+double InstanceRng::Normal() {
+    if (has_spare_) {
+        has_spare_ = false;
+        return spare_;
+    }
+    double u1 = Uniform();
+    while (u1 <= 0.0) u1 = Uniform();
+    const double u2 = Uniform();
+    const double r = std::sqrt(-2.0 * std::log(u1));
+    spare_ = r * std::sin(2.0 * kPi * u2);
+    has_spare_ = true;
+    return r * std::cos(2.0 * kPi * u2);
+}
+
+double InstanceDifficultyScore(const InstanceGenParams& params) {
+    // Weights from the difficulty analysis: utilization 0.30, window tightness
+    // 0.20, scale 0.20, demand peaks 0.15, groups 0.15
+    double score = 0.0;
+    score += 0.30 * (params.capacity_utilization / 0.70);
+    const double avg_window = 2.0 * params.time_window_offset + 1.0;
+    score += 0.20 * (1.0 - avg_window / params.t);
+    score += 0.20 * (static_cast<double>(params.n) * params.t / 3000.0);
+    score += 0.15 * (params.peak_multiplier / 2.0);
+    score += 0.15 * (static_cast<double>(params.g) / 5.0);
+    return score;
+}
+
+std::string InstanceBaseName(const InstanceGenParams& params, const std::string& stamp) {
+    char buffer[96];
+    std::snprintf(buffer, sizeof(buffer), "N%d_T%d_G%d_F%d_%.2f_", params.n, params.t, params.g,
+                  params.f, InstanceDifficultyScore(params));
+    return buffer + stamp;
+}
+
+uint64_t InstanceSeed(uint64_t batch_seed, int index) {
+    uint64_t state = batch_seed;
+    const uint64_t base = SplitMix64(&state);
+    state = base ^ (static_cast<uint64_t>(index) * 0xD1B54A32D192ED03ULL);
+    return SplitMix64(&state);
+}
+
+void GenerateInstance(const InstanceGenParams& params, uint64_t seed, InstanceData* instance) {
+    InstanceRng rng(seed);
+    InstanceFrame frame;
+    DrawFrame(params, &rng, &frame);
+
+    InstanceData& d = *instance;
+    d = InstanceData();
+    d.n = frame.n;
+    d.t = frame.t;
+    d.f = frame.f;
+    d.g = frame.g;
+    d.capacity = frame.capacity;
+    d.setup_time = frame.setup_time;
+    d.setup_cost = frame.setup_cost;
+    d.holding_cost = frame.holding_cost;
+
+    const size_t n = static_cast<size_t>(d.n);
+    d.flow.resize(n);
+    d.group.resize(n);
+    d.earliest.resize(n);
+    d.latest.resize(n);
+    d.unit_time.resize(n);
+    d.unit_cost.resize(n);
+    d.demand.resize(n);
+    double load = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        const OrderDraw o = DrawOrder(params, frame, &rng);
+        d.flow[i] = o.flow;
+        d.group[i] = o.group;
+        d.earliest[i] = o.earliest;
+        d.latest[i] = o.latest;
+        d.unit_time[i] = o.unit_time;
+        d.unit_cost[i] = o.unit_cost;
+        d.demand[i] = o.weight;
+        load += o.weight * o.unit_time;
+    }
+
+    const double scale = DemandScale(params, frame, load);
+    for (double& demand : d.demand) demand = ScaledDemand(demand, scale);
+}
+
+std::string FormatInstanceCsv(const InstanceData& d) {
+    std::string text;
+    text.reserve(128 + static_cast<size_t>(d.n) * 48 + static_cast<size_t>(d.g + d.f) * 24);
+    StringCsvOut out(&text);
+    WriteHead(out, d.t, d.f, d.g, d.n, d.capacity);
+    for (int i = 0; i < d.n; ++i) {
+        WriteOrder(out, i, d.flow[i], d.group[i], d.demand[i], d.earliest[i], d.latest[i],
+                   d.unit_cost[i], d.unit_time[i]);
+    }
+    WriteTail(out, d.setup_cost, d.setup_time, d.holding_cost);
+    return text;
+}
+
+bool StreamInstanceCsv(const InstanceGenParams& params, uint64_t seed, const std::string& path,
+                       const CancelCheck& cancelled) {
+    InstanceRng rng(seed);
+    InstanceFrame frame;
+    DrawFrame(params, &rng, &frame);
+
+    // Pass 1: total load of the order stream, which fixes the demand scale. The
+    // stream is replayed from this state for pass 2 instead of being stored.
+    const InstanceRng orders_start = rng;
+    double load = 0.0;
+    for (int i = 0; i < frame.n; ++i) {
+        const OrderDraw o = DrawOrder(params, frame, &rng);
+        load += o.weight * o.unit_time;
+    }
+    const double scale = DemandScale(params, frame, load);
+
+    // Pass 2: draw a chunk, format it into the writer's buffers, repeat
+    CsvStreamWriter out;
+    if (!out.Open(path)) return false;
+    WriteHead(out, frame.t, frame.f, frame.g, frame.n, frame.capacity);
+    rng = orders_start;
+    std::vector<OrderDraw> chunk;
+    chunk.reserve(kGenOrderChunk);
+    for (int first = 0; first < frame.n; first += kGenOrderChunk) {
+        if (cancelled && cancelled()) {
+            out.Abort();
+            return false;
+        }
+        const int count = std::min(kGenOrderChunk, frame.n - first);
+        chunk.clear();
+        for (int k = 0; k < count; ++k) chunk.push_back(DrawOrder(params, frame, &rng));
+        for (int k = 0; k < count; ++k) {
+            const OrderDraw& o = chunk[k];
+            WriteOrder(out, first + k, o.flow, o.group, ScaledDemand(o.weight, scale), o.earliest,
+                       o.latest, o.unit_cost, o.unit_time);
+        }
+    }
+    WriteTail(out, frame.setup_cost, frame.setup_time, frame.holding_cost);
+    return out.Close();
+}
+
+bool GenerateInstances(InstanceGenBatch* batch, int threads, const CancelCheck& cancelled,
+                       const GenWrittenFn& written) {
+    const int count = std::max(0, batch->count);
+    batch->files.assign(static_cast<size_t>(count), std::string());
+    batch->written.assign(static_cast<size_t>(count), 0);
+    if (count == 0) return true;
+
+    std::error_code ec;
+    fs::create_directories(fs::u8path(batch->output_dir), ec);
+    const fs::path dir = fs::u8path(batch->output_dir);
+    for (int i = 0; i < count; ++i) {
+        std::string name = batch->base_name;
+        if (count > 1) {
+            char suffix[16];
+            std::snprintf(suffix, sizeof(suffix), "_%03d", i + 1);
+            name += suffix;
+        }
+        batch->files[i] = (dir / fs::u8path(name + ".csv")).generic_u8string();
+    }
+
+    // Instances are claimed in any order; each depends on its index alone
+    const bool complete = RunParallel(static_cast<size_t>(count), threads, [&](size_t i) {
+        // Large instances go straight to disk; both paths write the same bytes
+        const uint64_t seed = InstanceSeed(batch->seed, static_cast<int>(i));
+        bool ok = false;
+        if (batch->params.n >= kStreamingOrderThreshold) {
+            ok = StreamInstanceCsv(batch->params, seed, batch->files[i], cancelled);
+        } else {
+            InstanceData instance;
+            GenerateInstance(batch->params, seed, &instance);
+            ok = WriteFileAtomic(batch->files[i], FormatInstanceCsv(instance));
+        }
+        if (!ok) return;
+        batch->written[i] = 1;
+        if (written) written(static_cast<int>(i), batch->files[i]);
+    }, cancelled);
+    return complete && std::all_of(batch->written.begin(), batch->written.end(),
+                                   [](uint8_t w) { return w != 0; });
+}
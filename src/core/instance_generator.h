@@ -0,0 +1,108 @@
+// instance_generator.h - Native LS-NTGF instance generator (experimental)
+// Builds instances in the generator CSV layout that InstanceData reads, from the
+// same difficulty model the generator page exposes (utilization, time windows,
+// demand variability and peaks, urgent/flexible orders, cost correlation, zoom).
+// Opt-in on the generator page; OrderGenCap remains the default generator.
+//
+// Every instance draws from its own random stream, seeded from the batch seed
+// and its index only. Streams and distributions are implemented here (xoshiro256**
+// seeded through SplitMix64, no <random> distributions), so a batch is
+// bit-identical for a given seed no matter how many threads produce it or in
+// which order they finish.
+//
+// Instances from kStreamingOrderThreshold orders on (stress tests go to 10^6
+// orders and 365 periods) are never held in memory: the order stream is drawn
+// twice, once to total the load that fixes the demand scale and once to write
+// it in chunks through a CsvStreamWriter. Both paths write the same bytes.
+
+#ifndef INSTANCE_GENERATOR_H_
+#define INSTANCE_GENERATOR_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "instance_data.h"
+#include "parallel.h"
+
+struct InstanceGenParams {
+    int n = 100;                        // orders
+    int t = 30;                         // periods
+    int f = 5;                          // flows
+    int g = 5;                          // groups
+    double capacity_utilization = 0.70; // processing load / total capacity
+    int time_window_offset = 5;         // half width of a regular window, periods
+    double demand_cv = 0.25;            // coefficient of variation of order demand
+    double peak_ratio = 0.15;           // share of peak periods
+    double peak_multiplier = 2.0;       // demand factor of orders due in a peak
+    double urgent_ratio = 0.10;         // orders with a single-period window
+    double flexible_ratio = 0.20;       // orders with a doubled window
+    bool cost_correlation = true;       // costs follow the times they pay for
+    int zoom = 60;                      // capacity per period = zoom * 24
+};
+
+// Random stream of one instance (xoshiro256**)
+class InstanceRng {
+public:
+    explicit InstanceRng(uint64_t seed);
+
+    uint64_t Next();
+    double Uniform();                           // [0, 1), 53 bits
+    double Uniform(double lo, double hi);       // [lo, hi)
+    int Int(int lo, int hi);                    // [lo, hi], unbiased
+    double Normal();                            // standard normal (Box-Muller)
+
+private:
+    uint64_t s_[4];
+    bool has_spare_;
+    double spare_;
+};
+
+// Difficulty score (0.0-2.5) of the parameters, as shown on the generator page
+// and written into file names
+double InstanceDifficultyScore(const InstanceGenParams& params);
+
+// Generator file name without extension: N<n>_T<t>_G<g>_F<f>_<score>_<stamp>
+std::string InstanceBaseName(const InstanceGenParams& params, const std::string& stamp);
+
+// Seed of instance |index| of a batch started with |batch_seed|
+uint64_t InstanceSeed(uint64_t batch_seed, int index);
+
+// One instance from |seed|; |instance| is overwritten
+void GenerateInstance(const InstanceGenParams& params, uint64_t seed, InstanceData* instance);
+
+// Generator CSV text of |instance| (ids and periods 1-based)
+std::string FormatInstanceCsv(const InstanceData& instance);
+
+constexpr int kStreamingOrderThreshold = 50000;
+constexpr int kGenOrderChunk = 8192;
+
+// Same file as FormatInstanceCsv(GenerateInstance(params, seed)), written to
+// |path| with memory independent of the order count. False if cancelled (checked
+// per chunk; the partial file is removed) or on a write error.
+bool StreamInstanceCsv(const InstanceGenParams& params, uint64_t seed, const std::string& path,
+                       const CancelCheck& cancelled = {});
+
+// A batch of instances written to disk. files[i] is <output_dir>/<name>.csv with
+// name = base_name, or base_name_<i+1> (3 digits) when count > 1.
+struct InstanceGenBatch {
+    InstanceGenParams params;
+    uint64_t seed = 1;
+    int count = 1;
+    std::string output_dir;     // UTF-8, created if missing
+    std::string base_name;
+
+    std::vector<std::string> files;     // filled by GenerateInstances
+    std::vector<uint8_t> written;       // 1 once files[i] is complete
+};
+
+// Called from worker threads as each file is written
+using GenWrittenFn = std::function<void(int index, const std::string& path)>;
+
+// Generate and write every instance of |batch| on |threads| workers (<= 0:
+// hardware concurrency). Returns false if cancelled or any file failed.
+bool GenerateInstances(InstanceGenBatch* batch, int threads,
+                       const CancelCheck& cancelled = {},
+                       const GenWrittenFn& written = {});
+
+#endif  // INSTANCE_GENERATOR_H_
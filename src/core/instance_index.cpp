@@ -0,0 +1,333 @@
+// instance_index.cpp - Instance library index implementation
+
+#include "instance_index.h"
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr uint32_t kInstanceIndexMagic = 0x4949534C;  // "LSII"
+constexpr uint32_t kInstanceIndexVersion = 2;
+constexpr size_t kProgressInterval = 64;
+constexpr size_t kReadChunk = 1 << 20;
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+constexpr size_t kNpos = std::string_view::npos;
+
+bool IsInstanceFileName(const std::string& name) {
+    // Result CSVs may sit next to the data; they are never instances
+    if (name.find("_result_") != std::string::npos) return false;
+    return name.size() > 4 && name.compare(name.size() - 4, 4, ".csv") == 0;
+}
+
+// "0.93": digits, one dot, digits
+bool ParseDecimalToken(std::string_view token, double* value) {
+    const size_t dot = token.find('.');
+    if (dot == kNpos || dot == 0 || dot + 1 == token.size()) return false;
+    for (size_t i = 0; i < token.size(); ++i) {
+        if (i != dot && static_cast<unsigned>(token[i] - '0') >= 10u) return false;
+    }
+    const auto result = std::from_chars(token.data(), token.data() + token.size(), *value);
+    return result.ec == std::errc() && result.ptr == token.data() + token.size();
+}
+
+// Scalar lines anywhere in the file, as the solver page reads them
+struct ScalarCounts {
+    int n = 0;
+    int t = 0;
+    int g = 0;
+    int f = 0;
+    double capacity = 0.0;
+
+    bool Complete() const { return n > 0 && t > 0 && g > 0 && f > 0 && capacity > 0.0; }
+};
+
+template <typename T>
+void ReadScalarValue(std::string_view line, std::string_view key, T* value) {
+    if (line.size() <= key.size() || line.compare(0, key.size(), key) != 0) return;
+    line.remove_prefix(key.size());
+    while (!line.empty() && line.front() == ' ') line.remove_prefix(1);
+    T parsed = 0;
+    const auto result = std::from_chars(line.data(), line.data() + line.size(), parsed);
+    if (result.ptr != line.data() && parsed > 0) *value = parsed;
+}
+
+void ReadScalarLine(std::string_view line, ScalarCounts* counts) {
+    while (!line.empty() && (line.front() == ' ' || line.front() == '\t')) line.remove_prefix(1);
+    if (line.empty()) return;
+    switch (line[0]) {
+        case 'T': ReadScalarValue(line, "T_num,", &counts->t); break;
+        case 'F': ReadScalarValue(line, "F_num,", &counts->f); break;
+        case 'G': ReadScalarValue(line, "G_num,", &counts->g); break;
+        case 'O': ReadScalarValue(line, "Order_Num,", &counts->n); break;
+        case 'C': ReadScalarValue(line, "Capacity,", &counts->capacity); break;
+        default: break;
+    }
+}
+
+//---------------------------------------
+// Index file I/O
+//---------------------------------------
+
+template <typename T>
+void WritePod(std::ofstream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadPod(std::ifstream& in, T* value) {
+    in.read(reinterpret_cast<char*>(value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+void WriteString(std::ofstream& out, const std::string& s) {
+    WritePod<uint32_t>(out, static_cast<uint32_t>(s.size()));
+    out.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+bool ReadString(std::ifstream& in, std::string* s) {
+    uint32_t size = 0;
+    if (!ReadPod(in, &size)) return false;
+    s->resize(size);
+    if (size > 0) in.read(&(*s)[0], size);
+    return static_cast<bool>(in);
+}
+
+}  // namespace
+
+InstanceIndexEntry::InstanceIndexEntry()
+    : capacity(kNaN)
+    , difficulty(kNaN) {
+}
+
+bool ReadInstanceSummary(const std::string& path, InstanceIndexEntry* entry) {
+    const fs::path file_path = fs::u8path(path);
+    ParseInstanceFileName(file_path.stem().u8string(), entry);
+
+    std::ifstream in(file_path, std::ios::binary);
+    if (!in) return false;
+
+    // One pass: every chunk is hashed and, until all of them are found, searched
+    // line by line for the scalar lines, which need not precede the tables
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    std::vector<char> buffer(kReadChunk);
+    ScalarCounts counts;
+    std::string partial;    // line cut at the previous chunk end
+    bool first = true;
+    while (in) {
+        in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        const size_t got = static_cast<size_t>(in.gcount());
+        if (got == 0) break;
+        hash.addData(QByteArray::fromRawData(buffer.data(), static_cast<qsizetype>(got)));
+        if (counts.Complete()) continue;
+
+        std::string_view chunk(buffer.data(), got);
+        if (first && chunk.compare(0, 3, "\xEF\xBB\xBF") == 0) chunk.remove_prefix(3);
+        first = false;
+        size_t eol = chunk.find('\n');
+        if (!partial.empty()) {
+            if (eol == kNpos) {
+                partial.append(chunk.data(), chunk.size());
+                continue;
+            }
+            partial.append(chunk.data(), eol);
+            ReadScalarLine(partial, &counts);
+            partial.clear();
+            chunk.remove_prefix(eol + 1);
+            eol = chunk.find('\n');
+        }
+        while (eol != kNpos) {
+            ReadScalarLine(chunk.substr(0, eol), &counts);
+            chunk.remove_prefix(eol + 1);
+            eol = chunk.find('\n');
+        }
+        partial.assign(chunk.data(), chunk.size());
+    }
+    ReadScalarLine(partial, &counts);
+    entry->hash = hash.result().toHex().toStdString();
+
+    if (counts.n > 0) entry->n = counts.n;
+    if (counts.t > 0) entry->t = counts.t;
+    if (counts.g > 0) entry->g = counts.g;
+    if (counts.f > 0) entry->f = counts.f;
+    if (counts.capacity > 0.0) entry->capacity = counts.capacity;
+    return counts.n > 0 && counts.t > 0;
+}
+
+bool ParseInstanceFileName(std::string_view name, InstanceIndexEntry* entry) {
+    bool found = false;
+    size_t start = 0;
+    while (start <= name.size()) {
+        size_t sep = name.find('_', start);
+        if (sep == kNpos) sep = name.size();
+        const std::string_view token = name.substr(start, sep - start);
+        start = sep + 1;
+
+        double value = 0.0;
+        if (!std::isfinite(entry->difficulty) && ParseDecimalToken(token, &value)) {
+            entry->difficulty = value;
+            found = true;
+            continue;
+        }
+
+        // N300 / T30 / G5 / F5 tokens, or the same run concatenated (N300T30G5F5):
+        // letter followed by digits, any order
+        if (token.size() < 2) continue;
+        int sizes[4] = {0, 0, 0, 0};     // N T G F
+        bool valid = true;
+        for (size_t i = 0; i < token.size() && valid;) {
+            const char letter = token[i++];
+            int number = 0;
+            auto result = std::from_chars(token.data() + i, token.data() + token.size(), number);
+            if (result.ptr == token.data() + i) {
+                valid = false;
+                break;
+            }
+            i = static_cast<size_t>(result.ptr - token.data());
+            switch (letter) {
+                case 'N': sizes[0] = number; break;
+                case 'T': sizes[1] = number; break;
+                case 'G': sizes[2] = number; break;
+                case 'F': sizes[3] = number; break;
+                default: valid = false; break;
+            }
+        }
+        if (!valid) continue;
+        if (entry->n == 0) entry->n = sizes[0];
+        if (entry->t == 0) entry->t = sizes[1];
+        if (entry->g == 0) entry->g = sizes[2];
+        if (entry->f == 0) entry->f = sizes[3];
+        found = true;
+    }
+    return found;
+}
+
+bool InstanceIndex::Load(const std::string& path) {
+    entries_.clear();
+    std::ifstream in(fs::u8path(path), std::ios::binary);
+    if (!in) return false;
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t count = 0;
+    if (!ReadPod(in, &magic) || !ReadPod(in, &version) || !ReadPod(in, &count) ||
+        magic != kInstanceIndexMagic || version != kInstanceIndexVersion) {
+        return false;
+    }
+
+    std::vector<InstanceIndexEntry> entries(count);
+    for (auto& e : entries) {
+        uint8_t ok = 0;
+        bool good = ReadString(in, &e.path) && ReadPod(in, &e.mtime) && ReadPod(in, &e.size) &&
+                    ReadPod(in, &ok) && ReadPod(in, &e.n) && ReadPod(in, &e.t) &&
+                    ReadPod(in, &e.g) && ReadPod(in, &e.f) && ReadPod(in, &e.capacity) &&
+                    ReadPod(in, &e.difficulty) && ReadString(in, &e.hash);
+        if (!good) return false;
+        e.ok = ok != 0;
+    }
+    entries_ = std::move(entries);
+    std::sort(entries_.begin(), entries_.end(),
+              [](const InstanceIndexEntry& a, const InstanceIndexEntry& b) { return a.path < b.path; });
+    return true;
+}
+
+bool InstanceIndex::Save(const std::string& path) const {
+    std::ofstream out(fs::u8path(path), std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    WritePod<uint32_t>(out, kInstanceIndexMagic);
+    WritePod<uint32_t>(out, kInstanceIndexVersion);
+    WritePod<uint32_t>(out, static_cast<uint32_t>(entries_.size()));
+    for (const auto& e : entries_) {
+        WriteString(out, e.path);
+        WritePod(out, e.mtime);
+        WritePod(out, e.size);
+        WritePod<uint8_t>(out, e.ok ? 1 : 0);
+        WritePod(out, e.n);
+        WritePod(out, e.t);
+        WritePod(out, e.g);
+        WritePod(out, e.f);
+        WritePod(out, e.capacity);
+        WritePod(out, e.difficulty);
+        WriteString(out, e.hash);
+    }
+    return static_cast<bool>(out);
+}
+
+InstanceScanStats InstanceIndex::Scan(const std::string& root, int threads,
+                                      const CancelCheck& cancelled, const ProgressFn& progress) {
+    InstanceScanStats stats;
+
+    // Walk the tree; directory entries carry mtime/size without opening files
+    std::vector<InstanceIndexEntry> found;
+    std::error_code ec;
+    fs::recursive_directory_iterator it(fs::u8path(root),
+                                        fs::directory_options::skip_permission_denied, ec);
+    for (; !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        if (cancelled && cancelled()) {
+            stats.cancelled = true;
+            return stats;
+        }
+        std::error_code entry_ec;
+        if (!it->is_regular_file(entry_ec)) continue;
+        if (!IsInstanceFileName(it->path().filename().u8string())) continue;
+
+        InstanceIndexEntry entry;
+        entry.path = it->path().u8string();
+        entry.mtime = static_cast<int64_t>(it->last_write_time(entry_ec).time_since_epoch().count());
+        entry.size = static_cast<uint64_t>(it->file_size(entry_ec));
+        found.push_back(std::move(entry));
+    }
+    std::sort(found.begin(), found.end(),
+              [](const InstanceIndexEntry& a, const InstanceIndexEntry& b) { return a.path < b.path; });
+    stats.files = found.size();
+
+    // Reuse unchanged entries (both lists are sorted by path)
+    std::vector<size_t> pending;
+    auto old = entries_.begin();
+    for (size_t i = 0; i < found.size(); ++i) {
+        InstanceIndexEntry& entry = found[i];
+        old = std::lower_bound(old, entries_.end(), entry.path,
+                               [](const InstanceIndexEntry& e, const std::string& p) { return e.path < p; });
+        if (old != entries_.end() && old->path == entry.path &&
+            old->mtime == entry.mtime && old->size == entry.size) {
+            entry = *old;
+            ++stats.reused;
+        } else {
+            pending.push_back(i);
+        }
+    }
+
+    // Hash changed files on a worker pool
+    const size_t count = pending.size();
+    std::atomic<size_t> done(0);
+    const bool complete = RunParallel(count, threads, [&](size_t k) {
+        InstanceIndexEntry& entry = found[pending[k]];
+        entry.ok = ReadInstanceSummary(entry.path, &entry);
+        size_t finished = ++done;
+        if (progress && (finished % kProgressInterval == 0 || finished == count)) {
+            progress(finished, count);
+        }
+    }, cancelled);
+
+    if (!complete) {
+        stats.cancelled = true;
+        return stats;
+    }
+
+    stats.parsed = count;
+    for (size_t i : pending) {
+        if (!found[i].ok) ++stats.failed;
+    }
+    entries_ = std::move(found);
+    return stats;
+}
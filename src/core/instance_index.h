@@ -0,0 +1,78 @@
+// instance_index.h - Instance library index
+// Scans a data tree for instance CSVs, reads their scalar lines (N/T/G/F,
+// capacity), the difficulty token of the generator file name and an MD5 of the
+// content, and keeps them in a persistent index keyed by path + mtime + size so
+// rescans only touch changed files. The hash is the one the instance snapshot
+// cache names its files by, so identical copies are recognisable.
+//
+//   N300_T30_G5_F5_1.33_20260106_143012.csv   (generator output)
+//   N300T30G5F5_1.33_20260106_143012.csv      (older, concatenated sizes)
+
+#ifndef INSTANCE_INDEX_H_
+#define INSTANCE_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "parallel.h"
+
+// Summary of one instance file. Unknown numbers stay NaN, unknown counts stay 0.
+struct InstanceIndexEntry {
+    std::string path;        // UTF-8
+    int64_t mtime = 0;       // filesystem clock ticks
+    uint64_t size = 0;
+    bool ok = false;         // scalar header could be read
+
+    int n = 0;
+    int t = 0;
+    int g = 0;
+    int f = 0;
+    double capacity;
+    double difficulty;       // from the file name
+    std::string hash;        // MD5 of the content, hex
+
+    InstanceIndexEntry();
+};
+
+struct InstanceScanStats {
+    size_t files = 0;        // CSV files found
+    size_t reused = 0;       // taken from the index unchanged
+    size_t parsed = 0;       // (re)read from disk
+    size_t failed = 0;       // not an instance (no counts in the header)
+    bool cancelled = false;
+};
+
+// Hash the whole file and read the scalar lines (T_num, F_num, G_num, Order_Num,
+// Capacity) wherever they are in it. False without order and period counts.
+bool ReadInstanceSummary(const std::string& path, InstanceIndexEntry* entry);
+
+// N300_T30_G5_F5_1.33_<date>_<time> (or N300T30G5F5_1.33_...) -> N/T/G/F (where
+// still 0) and difficulty
+bool ParseInstanceFileName(std::string_view name, InstanceIndexEntry* entry);
+
+class InstanceIndex {
+public:
+    using ProgressFn = std::function<void(size_t done, size_t total)>;
+
+    // Persistent index (binary, see instance_index.cpp). Load() of a missing or
+    // outdated file leaves the index empty and returns false.
+    bool Load(const std::string& path);
+    bool Save(const std::string& path) const;
+
+    // Rescan |root| recursively for *.csv. Unchanged files are taken from the
+    // current entries, everything else is read on |threads| workers (<= 0:
+    // hardware concurrency). Entries of files that disappeared are dropped.
+    InstanceScanStats Scan(const std::string& root, int threads,
+                           const CancelCheck& cancelled = {}, const ProgressFn& progress = {});
+
+    const std::vector<InstanceIndexEntry>& Entries() const { return entries_; }
+    void Clear() { entries_.clear(); }
+
+private:
+    std::vector<InstanceIndexEntry> entries_;  // sorted by path
+};
+
+#endif  // INSTANCE_INDEX_H_
@@ -0,0 +1,340 @@
+// json_partial_reader.cpp - Streaming reader for selected top-level JSON members
+
+#include "json_partial_reader.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace {
+
+constexpr size_t kReadChunkSize = 64 * 1024;
+
+// Bytes that change the scanner state inside a container outside of strings;
+// everything else (digits, commas, whitespace) is skipped in a tight loop
+constexpr std::array<bool, 256> MakeStructuralTable() {
+    std::array<bool, 256> table{};
+    table[static_cast<unsigned char>('"')] = true;
+    table[static_cast<unsigned char>('{')] = true;
+    table[static_cast<unsigned char>('}')] = true;
+    table[static_cast<unsigned char>('[')] = true;
+    table[static_cast<unsigned char>(']')] = true;
+    return table;
+}
+
+constexpr std::array<bool, 256> kStructural = MakeStructuralTable();
+
+// s[i] == '"'; returns the index past the closing quote, kJsonNpos if truncated
+size_t SkipString(std::string_view s, size_t i) {
+    for (++i; i < s.size(); ++i) {
+        if (s[i] == '\\') {
+            ++i;
+        } else if (s[i] == '"') {
+            return i + 1;
+        }
+    }
+    return kJsonNpos;
+}
+
+}  // namespace
+
+size_t JsonSkipValue(std::string_view s, size_t i, const JsonScanHook& hook) {
+    if (i >= s.size()) return kJsonNpos;
+    const char c = s[i];
+    if (c == '"') return SkipString(s, i);
+    if (c == '{' || c == '[') {
+        // Blocks of kJsonScanStep bytes with the hook in between, so the inner
+        // loop stays a plain table lookup
+        int depth = 0;
+        size_t next = hook ? i + kJsonScanStep : s.size();
+        while (true) {
+            const size_t limit = std::min(next, s.size());
+            for (; i < limit; ++i) {
+                const char ch = s[i];
+                if (!kStructural[static_cast<unsigned char>(ch)]) continue;
+                if (ch == '"') {
+                    size_t end = SkipString(s, i);
+                    if (end == kJsonNpos) return kJsonNpos;
+                    i = end - 1;
+                } else if (ch == '{' || ch == '[') {
+                    ++depth;
+                } else if (--depth == 0) {
+                    return i + 1;
+                }
+            }
+            if (i >= s.size()) return kJsonNpos;
+            if (!hook(i)) return kJsonStopped;
+            next = i + kJsonScanStep;
+        }
+    }
+    while (i < s.size() && s[i] != ',' && s[i] != '}' && s[i] != ']' && !IsJsonSpace(s[i])) ++i;
+    return i < s.size() ? i : kJsonNpos;
+}
+
+double JsonToDouble(std::string_view raw) {
+    double value = std::numeric_limits<double>::quiet_NaN();
+    std::from_chars(raw.data(), raw.data() + raw.size(), value);
+    return value;
+}
+
+int JsonToInt(std::string_view raw) {
+    double value = JsonToDouble(raw);
+    return std::isfinite(value) ? static_cast<int>(value) : 0;
+}
+
+std::string JsonToText(std::string_view raw) {
+    if (raw.size() < 2 || raw.front() != '"') return std::string();
+    raw = raw.substr(1, raw.size() - 2);
+    std::string text;
+    text.reserve(raw.size());
+    for (size_t i = 0; i < raw.size(); ++i) {
+        char c = raw[i];
+        if (c != '\\' || i + 1 >= raw.size()) {
+            text += c;
+            continue;
+        }
+        char e = raw[++i];
+        switch (e) {
+            case 'n': text += '\n'; break;
+            case 't': text += '\t'; break;
+            case 'r': text += '\r'; break;
+            case 'b': text += '\b'; break;
+            case 'f': text += '\f'; break;
+            case 'u': text += "\\u"; break;
+            default: text += e; break;
+        }
+    }
+    return text;
+}
+
+//---------------------------------------
+// PartialJsonReader
+//---------------------------------------
+
+PartialJsonReader::PartialJsonReader(std::vector<std::string> keys)
+    : remaining_(keys.size())
+    , state_(State::Start)
+    , capture_(-1)
+    , depth_(0)
+    , in_string_(false)
+    , escape_(false)
+    , consumed_(0) {
+    slots_.reserve(keys.size());
+    for (auto& key : keys) {
+        Slot slot;
+        slot.key = std::move(key);
+        slots_.push_back(std::move(slot));
+    }
+    if (remaining_ == 0) state_ = State::End;
+}
+
+bool PartialJsonReader::Feed(std::string_view chunk) {
+    size_t i = 0;
+    while (i < chunk.size() && !Finished()) {
+        i = Step(chunk, i);
+    }
+    consumed_ += i;
+    return !Finished();
+}
+
+bool PartialJsonReader::ReadBuffer(std::string_view text) {
+    Feed(text);
+    return state_ == State::End;
+}
+
+bool PartialJsonReader::ReadFile(const std::string& path) {
+    std::ifstream in(std::filesystem::u8path(path), std::ios::binary);
+    if (!in) return false;
+
+    std::string buffer(kReadChunkSize, '\0');
+    while (!Finished()) {
+        in.read(&buffer[0], static_cast<std::streamsize>(buffer.size()));
+        const size_t got = static_cast<size_t>(in.gcount());
+        if (got == 0) break;
+        Feed(std::string_view(buffer.data(), got));
+    }
+    return state_ == State::End;
+}
+
+const std::string* PartialJsonReader::Member(std::string_view key) const {
+    for (const auto& slot : slots_) {
+        if (slot.found && slot.key == key) return &slot.raw;
+    }
+    return nullptr;
+}
+
+std::string PartialJsonReader::MembersAsObject() const {
+    std::string text = "{";
+    for (const auto& slot : slots_) {
+        if (!slot.found) continue;
+        if (text.size() > 1) text += ',';
+        text += '"';
+        text += slot.key;
+        text += "\":";
+        text += slot.raw;
+    }
+    text += '}';
+    return text;
+}
+
+void PartialJsonReader::BeginValue() {
+    capture_ = -1;
+    for (size_t k = 0; k < slots_.size(); ++k) {
+        if (!slots_[k].found && slots_[k].key == key_) {
+            capture_ = static_cast<int>(k);
+            break;
+        }
+    }
+}
+
+void PartialJsonReader::EndValue() {
+    state_ = State::AfterValue;
+    if (capture_ < 0) return;
+    slots_[capture_].found = true;
+    capture_ = -1;
+    if (--remaining_ == 0) state_ = State::End;
+}
+
+void PartialJsonReader::Capture(std::string_view text) {
+    if (capture_ >= 0) slots_[capture_].raw.append(text.data(), text.size());
+}
+
+// Consume input starting at s[i] in the current state; returns the new position
+size_t PartialJsonReader::Step(std::string_view s, size_t i) {
+    const size_t n = s.size();
+    switch (state_) {
+        case State::Start: {
+            // Leading whitespace and a UTF-8 BOM
+            while (i < n && (IsJsonSpace(s[i]) || static_cast<unsigned char>(s[i]) >= 0x80)) ++i;
+            if (i == n) return i;
+            state_ = s[i] == '{' ? State::KeyOrEnd : State::Error;
+            return i + 1;
+        }
+        case State::KeyOrEnd: {
+            i = JsonSkipSpace(s, i);
+            if (i == n) return i;
+            if (s[i] == '"') {
+                key_.clear();
+                escape_ = false;
+                state_ = State::Key;
+            } else {
+                state_ = s[i] == '}' ? State::End : State::Error;
+            }
+            return i + 1;
+        }
+        case State::Key: {
+            const size_t start = i;
+            for (; i < n; ++i) {
+                if (escape_) {
+                    escape_ = false;
+                } else if (s[i] == '\\') {
+                    escape_ = true;
+                } else if (s[i] == '"') {
+                    key_.append(s.data() + start, i - start);
+                    state_ = State::Colon;
+                    return i + 1;
+                }
+            }
+            key_.append(s.data() + start, n - start);
+            return n;
+        }
+        case State::Colon: {
+            i = JsonSkipSpace(s, i);
+            if (i == n) return i;
+            state_ = s[i] == ':' ? State::Value : State::Error;
+            return i + 1;
+        }
+        case State::Value: {
+            i = JsonSkipSpace(s, i);
+            if (i == n) return i;
+            BeginValue();
+            const char c = s[i];
+            if (c == '{' || c == '[') {
+                depth_ = 1;
+                in_string_ = false;
+                escape_ = false;
+                state_ = State::Container;
+            } else if (c == '"') {
+                escape_ = false;
+                state_ = State::String;
+            } else if (c == ',' || c == '}' || c == ']' || c == ':') {
+                state_ = State::Error;
+                return i;
+            } else {
+                state_ = State::Scalar;
+                return i;
+            }
+            Capture(s.substr(i, 1));
+            return i + 1;
+        }
+        case State::Container: {
+            const size_t start = i;
+            for (; i < n; ++i) {
+                const char c = s[i];
+                if (in_string_) {
+                    if (escape_) {
+                        escape_ = false;
+                    } else if (c == '\\') {
+                        escape_ = true;
+                    } else if (c == '"') {
+                        in_string_ = false;
+                    }
+                    continue;
+                }
+                if (!kStructural[static_cast<unsigned char>(c)]) continue;
+                if (c == '"') {
+                    in_string_ = true;
+                } else if (c == '{' || c == '[') {
+                    ++depth_;
+                } else if (--depth_ == 0) {
+                    Capture(s.substr(start, i + 1 - start));
+                    EndValue();
+                    return i + 1;
+                }
+            }
+            Capture(s.substr(start));
+            return n;
+        }
+        case State::String: {
+            const size_t start = i;
+            for (; i < n; ++i) {
+                if (escape_) {
+                    escape_ = false;
+                } else if (s[i] == '\\') {
+                    escape_ = true;
+                } else if (s[i] == '"') {
+                    Capture(s.substr(start, i + 1 - start));
+                    EndValue();
+                    return i + 1;
+                }
+            }
+            Capture(s.substr(start));
+            return n;
+        }
+        case State::Scalar: {
+            const size_t start = i;
+            while (i < n && s[i] != ',' && s[i] != '}' && s[i] != ']' && !IsJsonSpace(s[i])) ++i;
+            Capture(s.substr(start, i - start));
+            if (i < n) EndValue();
+            return i;
+        }
+        case State::AfterValue: {
+            i = JsonSkipSpace(s, i);
+            if (i == n) return i;
+            if (s[i] == ',') {
+                state_ = State::KeyOrEnd;
+            } else {
+                state_ = s[i] == '}' ? State::End : State::Error;
+            }
+            return i + 1;
+        }
+        case State::End:
+        case State::Error:
+            break;
+    }
+    return n;
+}
@@ -0,0 +1,172 @@
+// json_partial_reader.h - Streaming reader for selected top-level JSON members
+// Reads a JSON object front to back in chunks and keeps only the raw text of
+// the requested top-level members. Everything else (e.g. the "variables" payload
+// of a result file) is skipped by bracket counting without being stored, and
+// reading stops as soon as every requested member has been seen.
+
+#ifndef JSON_PARTIAL_READER_H_
+#define JSON_PARTIAL_READER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//---------------------------------------
+// Raw value helpers (operate on an in-memory buffer, no DOM)
+//---------------------------------------
+
+enum class JsonScanStatus {
+    Done,
+    NeedMore,    // buffer ends inside the part being scanned
+    Malformed,
+    Stopped      // the scan hook asked to stop
+};
+
+constexpr size_t kJsonNpos = std::string_view::npos;
+constexpr size_t kJsonStopped = kJsonNpos - 1;
+
+// Called about every kJsonScanStep bytes while a container is skipped, with the
+// offset reached; returning false stops the scan (progress / cancellation of
+// scans over large payloads)
+using JsonScanHook = std::function<bool(size_t offset)>;
+constexpr size_t kJsonScanStep = 4u * 1024 * 1024;
+
+inline bool IsJsonSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+inline size_t JsonSkipSpace(std::string_view s, size_t i) {
+    while (i < s.size() && IsJsonSpace(s[i])) ++i;
+    return i;
+}
+
+// Index past the value starting at s[i]; containers are skipped by bracket
+// counting. kJsonNpos if the value may continue past the end of the buffer,
+// kJsonStopped if |hook| returned false.
+size_t JsonSkipValue(std::string_view s, size_t i, const JsonScanHook& hook = {});
+
+// Call fn(key, raw_value) for each member of the object starting at s[i]
+// (keys are raw, escapes are not decoded). fn returns false to stop early.
+// |hook| sees the progress through large member values.
+template <typename Fn>
+JsonScanStatus ForEachJsonMember(std::string_view s, size_t i, Fn fn,
+                                 const JsonScanHook& hook = {}) {
+    i = JsonSkipSpace(s, i);
+    if (i >= s.size()) return JsonScanStatus::NeedMore;
+    if (s[i] != '{') return JsonScanStatus::Malformed;
+    ++i;
+
+    while (true) {
+        i = JsonSkipSpace(s, i);
+        if (i >= s.size()) return JsonScanStatus::NeedMore;
+        if (s[i] == '}') return JsonScanStatus::Done;
+        if (s[i] != '"') return JsonScanStatus::Malformed;
+
+        size_t key_end = JsonSkipValue(s, i);
+        if (key_end == kJsonNpos) return JsonScanStatus::NeedMore;
+        std::string_view key = s.substr(i + 1, key_end - i - 2);
+
+        i = JsonSkipSpace(s, key_end);
+        if (i >= s.size()) return JsonScanStatus::NeedMore;
+        if (s[i] != ':') return JsonScanStatus::Malformed;
+        i = JsonSkipSpace(s, i + 1);
+
+        size_t value_end = JsonSkipValue(s, i, hook);
+        if (value_end == kJsonStopped) return JsonScanStatus::Stopped;
+        if (value_end == kJsonNpos) return JsonScanStatus::NeedMore;
+        if (!fn(key, s.substr(i, value_end - i))) return JsonScanStatus::Done;
+
+        i = JsonSkipSpace(s, value_end);
+        if (i >= s.size()) return JsonScanStatus::NeedMore;
+        if (s[i] == ',') {
+            ++i;
+        } else if (s[i] == '}') {
+            return JsonScanStatus::Done;
+        } else {
+            return JsonScanStatus::Malformed;
+        }
+    }
+}
+
+// Raw number -> double (NaN if not a number) / int (0 if not a number)
+double JsonToDouble(std::string_view raw);
+int JsonToInt(std::string_view raw);
+
+// Raw JSON string (with quotes) -> UTF-8 text; \uXXXX escapes are kept verbatim
+std::string JsonToText(std::string_view raw);
+
+//---------------------------------------
+// Streaming top-level member reader
+//---------------------------------------
+
+class PartialJsonReader {
+public:
+    explicit PartialJsonReader(std::vector<std::string> keys);
+
+    // Feed the next chunk of the document. Returns true while more input is
+    // wanted; false once all requested members were read, the top-level object
+    // ended or the input turned out to be malformed.
+    bool Feed(std::string_view chunk);
+
+    // Convenience: feed a whole buffer / a file in fixed-size chunks. Return
+    // false on I/O errors and on malformed or truncated input; members read
+    // before the error stay available.
+    bool ReadBuffer(std::string_view text);
+    bool ReadFile(const std::string& path);
+
+    bool Finished() const { return state_ == State::End || state_ == State::Error; }
+    bool Malformed() const { return state_ == State::Error; }
+    // Every requested member has been read
+    bool Complete() const { return remaining_ == 0; }
+
+    // Raw JSON text of a requested member, nullptr if it has not been read
+    const std::string* Member(std::string_view key) const;
+
+    // Requested members that were found, as a compact JSON object text
+    std::string MembersAsObject() const;
+
+    // Bytes consumed from the input (the reader stops early, so this is
+    // usually far less than the document size)
+    uint64_t BytesConsumed() const { return consumed_; }
+
+private:
+    enum class State : uint8_t {
+        Start,
+        KeyOrEnd,
+        Key,
+        Colon,
+        Value,
+        Container,
+        String,
+        Scalar,
+        AfterValue,
+        End,
+        Error
+    };
+
+    size_t Step(std::string_view s, size_t i);
+    void BeginValue();
+    void EndValue();
+    void Capture(std::string_view text);
+
+    struct Slot {
+        std::string key;
+        std::string raw;
+        bool found = false;
+    };
+
+    std::vector<Slot> slots_;
+    size_t remaining_;
+    State state_;
+    std::string key_;
+    int capture_;         // index into slots_ of the value being read, -1 to skip
+    int depth_;           // bracket depth inside a container value
+    bool in_string_;
+    bool escape_;
+    uint64_t consumed_;
+};
+
+#endif  // JSON_PARTIAL_READER_H_
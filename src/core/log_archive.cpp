@@ -0,0 +1,251 @@
+// log_archive.cpp - Block-compressed solver log implementation
+
+#include "log_archive.h"
+
+#include <QByteArray>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr uint32_t kLogArchiveMagic = 0x5A4C534C;    // "LSLZ"
+constexpr uint32_t kLogArchiveVersion = 1;
+constexpr uint32_t kLogIndexMagic = 0x584C534C;      // "LSLX"
+constexpr int kCompressionLevel = 9;
+constexpr uint64_t kFooterSize = 16;
+
+template <typename T>
+void WritePod(std::ofstream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadPod(std::ifstream& in, T* value) {
+    in.read(reinterpret_cast<char*>(value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+uint32_t CountLines(const char* data, size_t size) {
+    if (size == 0) return 0;
+    const uint32_t breaks = static_cast<uint32_t>(std::count(data, data + size, '\n'));
+    return data[size - 1] == '\n' ? breaks : breaks + 1;
+}
+
+// End of the block starting at |begin|: the last line break within |block_size|,
+// or the first one after it for an overlong line
+size_t BlockEnd(const std::string& text, size_t begin, size_t block_size) {
+    const size_t limit = std::min(text.size(), begin + block_size);
+    if (limit == text.size()) return limit;
+    const size_t last = text.rfind('\n', limit - 1);
+    if (last != std::string::npos && last >= begin) return last + 1;
+    const size_t next = text.find('\n', limit);
+    return next == std::string::npos ? text.size() : next + 1;
+}
+
+}  // namespace
+
+bool IsLogArchivePath(const std::string& path) {
+    const size_t suffix = std::strlen(kLogArchiveSuffix);
+    return path.size() > suffix &&
+           path.compare(path.size() - suffix, suffix, kLogArchiveSuffix) == 0;
+}
+
+bool WriteLogArchive(const std::string& path, const std::string& text, size_t block_size) {
+    std::ofstream out(fs::u8path(path), std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    const uint64_t lines = CountLines(text.data(), text.size());
+    WritePod<uint32_t>(out, kLogArchiveMagic);
+    WritePod<uint32_t>(out, kLogArchiveVersion);
+    WritePod<uint32_t>(out, static_cast<uint32_t>(block_size));
+    WritePod<uint32_t>(out, 0);
+    WritePod<uint64_t>(out, text.size());
+    WritePod<uint64_t>(out, lines);
+
+    std::vector<LogArchiveBlock> blocks;
+    uint64_t offset = 32;
+    uint64_t line = 0;
+    for (size_t begin = 0; begin < text.size();) {
+        const size_t end = BlockEnd(text, begin, block_size);
+        const QByteArray compressed = qCompress(
+            reinterpret_cast<const uchar*>(text.data() + begin),
+            static_cast<qsizetype>(end - begin), kCompressionLevel);
+        out.write(compressed.constData(), compressed.size());
+
+        LogArchiveBlock block;
+        block.offset = offset;
+        block.compressed_size = static_cast<uint32_t>(compressed.size());
+        block.raw_size = static_cast<uint32_t>(end - begin);
+        block.raw_offset = begin;
+        block.first_line = line;
+        block.line_count = CountLines(text.data() + begin, end - begin);
+        blocks.push_back(block);
+
+        offset += block.compressed_size;
+        line += block.line_count;
+        begin = end;
+    }
+
+    for (const auto& block : blocks) {
+        WritePod(out, block.offset);
+        WritePod(out, block.compressed_size);
+        WritePod(out, block.raw_size);
+        WritePod(out, block.raw_offset);
+        WritePod(out, block.first_line);
+        WritePod(out, block.line_count);
+        WritePod<uint32_t>(out, 0);
+    }
+    WritePod<uint64_t>(out, offset);
+    WritePod<uint32_t>(out, static_cast<uint32_t>(blocks.size()));
+    WritePod<uint32_t>(out, kLogIndexMagic);
+    return static_cast<bool>(out);
+}
+
+bool CompressLogFile(const std::string& log_path, const std::string& archive_path,
+                     bool keep_original) {
+    const std::string target = archive_path.empty() ? log_path + "z" : archive_path;
+    std::string text;
+    if (IsLogArchivePath(log_path) || !ReadLogText(log_path, &text)) return false;
+    if (!WriteLogArchive(target, text)) return false;
+
+    // Lossless or nothing: the plain log goes only once the archive reads back equal
+    std::string check;
+    if (!ReadLogText(target, &check) || check != text) {
+        std::error_code ec;
+        fs::remove(fs::u8path(target), ec);
+        return false;
+    }
+    if (!keep_original) {
+        std::error_code ec;
+        fs::remove(fs::u8path(log_path), ec);
+    }
+    return true;
+}
+
+bool ReadLogText(const std::string& path, std::string* text) {
+    if (IsLogArchivePath(path)) {
+        LogArchiveReader reader;
+        return reader.Open(path) && reader.ReadAll(text);
+    }
+    std::ifstream in(fs::u8path(path), std::ios::binary | std::ios::ate);
+    if (!in) return false;
+    const std::streamsize size = in.tellg();
+    in.seekg(0);
+    text->assign(static_cast<size_t>(std::max<std::streamsize>(size, 0)), '\0');
+    return size <= 0 || static_cast<bool>(in.read(&(*text)[0], size));
+}
+
+bool LogArchiveReader::Open(const std::string& path) {
+    Close();
+    in_.open(fs::u8path(path), std::ios::binary | std::ios::ate);
+    if (!in_) return false;
+    const uint64_t file_size = static_cast<uint64_t>(in_.tellg());
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t block_size = 0;
+    uint32_t reserved = 0;
+    in_.seekg(0);
+    bool good = file_size >= 32 + kFooterSize &&
+                ReadPod(in_, &magic) && ReadPod(in_, &version) && ReadPod(in_, &block_size) &&
+                ReadPod(in_, &reserved) && ReadPod(in_, &raw_size_) && ReadPod(in_, &line_count_) &&
+                magic == kLogArchiveMagic && version == kLogArchiveVersion;
+
+    uint64_t index_offset = 0;
+    uint32_t count = 0;
+    uint32_t index_magic = 0;
+    if (good) {
+        in_.seekg(static_cast<std::streamoff>(file_size - kFooterSize));
+        good = ReadPod(in_, &index_offset) && ReadPod(in_, &count) && ReadPod(in_, &index_magic) &&
+               index_magic == kLogIndexMagic && index_offset <= file_size - kFooterSize &&
+               (file_size - kFooterSize - index_offset) / 40 == count;
+    }
+    if (good) {
+        in_.seekg(static_cast<std::streamoff>(index_offset));
+        blocks_.resize(count);
+        for (auto& block : blocks_) {
+            good = good && ReadPod(in_, &block.offset) && ReadPod(in_, &block.compressed_size) &&
+                   ReadPod(in_, &block.raw_size) && ReadPod(in_, &block.raw_offset) &&
+                   ReadPod(in_, &block.first_line) && ReadPod(in_, &block.line_count) &&
+                   ReadPod(in_, &reserved) &&
+                   block.offset + block.compressed_size <= index_offset;
+        }
+    }
+    if (!good) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void LogArchiveReader::Close() {
+    if (in_.is_open()) in_.close();
+    in_.clear();
+    raw_size_ = 0;
+    line_count_ = 0;
+    blocks_.clear();
+}
+
+size_t LogArchiveReader::BlockOfLine(uint64_t line) const {
+    if (line >= line_count_) return blocks_.size();
+    auto it = std::upper_bound(blocks_.begin(), blocks_.end(), line,
+                               [](uint64_t l, const LogArchiveBlock& b) { return l < b.first_line; });
+    return static_cast<size_t>(it - blocks_.begin()) - 1;
+}
+
+size_t LogArchiveReader::BlockOfOffset(uint64_t raw_offset) const {
+    if (raw_offset >= raw_size_) return blocks_.size();
+    auto it = std::upper_bound(blocks_.begin(), blocks_.end(), raw_offset,
+                               [](uint64_t o, const LogArchiveBlock& b) { return o < b.raw_offset; });
+    return static_cast<size_t>(it - blocks_.begin()) - 1;
+}
+
+bool LogArchiveReader::ReadBlock(size_t index, std::string* text) {
+    if (!in_.is_open() || index >= blocks_.size()) return false;
+    const LogArchiveBlock& block = blocks_[index];
+    QByteArray compressed(static_cast<qsizetype>(block.compressed_size), Qt::Uninitialized);
+    in_.clear();
+    in_.seekg(static_cast<std::streamoff>(block.offset));
+    if (!in_.read(compressed.data(), block.compressed_size)) return false;
+
+    const QByteArray raw = qUncompress(compressed);
+    if (static_cast<uint64_t>(raw.size()) != block.raw_size) return false;
+    text->assign(raw.constData(), static_cast<size_t>(raw.size()));
+    return true;
+}
+
+bool LogArchiveReader::ReadLines(uint64_t first, size_t count, std::vector<std::string>* lines) {
+    lines->clear();
+    std::string text;
+    for (size_t b = BlockOfLine(first); b < blocks_.size() && lines->size() < count; ++b) {
+        if (!ReadBlock(b, &text)) return false;
+        uint64_t line = blocks_[b].first_line;
+        size_t p = 0;
+        while (p < text.size() && lines->size() < count) {
+            size_t nl = text.find('\n', p);
+            if (nl == std::string::npos) nl = text.size();
+            if (line >= first) {
+                size_t end = nl;
+                if (end > p && text[end - 1] == '\r') --end;
+                lines->emplace_back(text, p, end - p);
+            }
+            ++line;
+            p = nl + 1;
+        }
+    }
+    return true;
+}
+
+bool LogArchiveReader::ReadAll(std::string* text) {
+    text->clear();
+    text->reserve(static_cast<size_t>(raw_size_));
+    std::string block;
+    for (size_t b = 0; b < blocks_.size(); ++b) {
+        if (!ReadBlock(b, &block)) return false;
+        text->append(block);
+    }
+    return text->size() == raw_size_;
+}
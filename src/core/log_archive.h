@@ -0,0 +1,84 @@
+// log_archive.h - Block-compressed solver logs with a seekable index
+// A finished log is mostly repeated CPLEX headers and node tables, so it is
+// re-encoded as independently compressed blocks of whole lines (.logz):
+//
+//   header   "LSLZ" u32 version, u32 block size, u32 reserved,
+//            u64 raw size, u64 line count
+//   blocks   qCompress (zlib) output of each block, back to back
+//   index    per block: u64 file offset, u32 compressed size, u32 raw size,
+//            u64 raw offset, u64 first line, u32 line count, u32 reserved
+//   footer   u64 index offset, u32 block count, u32 "LSLX"
+//
+// Any line or byte range is reached by a binary search over the index and
+// decompressing only the blocks it spans. Blocks end on a line break (a line
+// longer than the block size gets a block of its own), so each block can be
+// scanned by itself and the original text is the concatenation of all blocks.
+
+#ifndef LOG_ARCHIVE_H_
+#define LOG_ARCHIVE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+constexpr const char* kLogArchiveSuffix = ".logz";
+constexpr size_t kLogArchiveBlockSize = 256 * 1024;
+
+struct LogArchiveBlock {
+    uint64_t offset = 0;            // in the archive
+    uint32_t compressed_size = 0;
+    uint32_t raw_size = 0;
+    uint64_t raw_offset = 0;        // in the original text
+    uint64_t first_line = 0;        // 0-based
+    uint32_t line_count = 0;        // line breaks in the block, plus a final partial line
+};
+
+// True for *.logz
+bool IsLogArchivePath(const std::string& path);
+
+// Compress |text| into the archive at |path|
+bool WriteLogArchive(const std::string& path, const std::string& text,
+                     size_t block_size = kLogArchiveBlockSize);
+
+// Re-encode the plain log |log_path| as |archive_path| (default: log_path + "z"),
+// read it back and compare; only then is the plain log removed (unless
+// |keep_original|). Returns false and leaves the plain log alone on any error.
+bool CompressLogFile(const std::string& log_path, const std::string& archive_path = std::string(),
+                     bool keep_original = false);
+
+// Whole text of a plain log or an archive
+bool ReadLogText(const std::string& path, std::string* text);
+
+// Random access to an archive. Not thread-safe; open one reader per thread.
+class LogArchiveReader {
+public:
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return in_.is_open(); }
+
+    uint64_t RawSize() const { return raw_size_; }
+    uint64_t LineCount() const { return line_count_; }
+    const std::vector<LogArchiveBlock>& Blocks() const { return blocks_; }
+
+    // Block holding line |line| / byte |raw_offset|; Blocks().size() past the end
+    size_t BlockOfLine(uint64_t line) const;
+    size_t BlockOfOffset(uint64_t raw_offset) const;
+
+    // Decompressed text of block |index|
+    bool ReadBlock(size_t index, std::string* text);
+
+    // Lines [first, first + count) without their line breaks (fewer at the end)
+    bool ReadLines(uint64_t first, size_t count, std::vector<std::string>* lines);
+
+    bool ReadAll(std::string* text);
+
+private:
+    std::ifstream in_;
+    uint64_t raw_size_ = 0;
+    uint64_t line_count_ = 0;
+    std::vector<LogArchiveBlock> blocks_;
+};
+
+#endif  // LOG_ARCHIVE_H_
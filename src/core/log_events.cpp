@@ -0,0 +1,647 @@
+// log_events.cpp - Offline solver log parser implementation
+
+#include "log_events.h"
+#include "log_archive.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string_view>
+
+namespace {
+
+constexpr uint32_t kLogEventsMagic = 0x5645534C;  // "LSEV"
+constexpr uint32_t kLogEventsVersion = 1;
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+bool StartsWith(std::string_view s, std::string_view prefix) {
+    return s.size() >= prefix.size() && std::memcmp(s.data(), prefix.data(), prefix.size()) == 0;
+}
+
+std::string_view TrimLeft(std::string_view s) {
+    size_t i = 0;
+    while (i < s.size() && (s[i] == ' ' || s[i] == '\t')) ++i;
+    return s.substr(i);
+}
+
+std::string_view Trim(std::string_view s) {
+    s = TrimLeft(s);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+bool IsDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+// Collect numbers appearing in |s| in order. Non-ASCII bytes (UTF-8 text) are never digits.
+int ExtractNumbers(std::string_view s, double* out, int max_count) {
+    int count = 0;
+    const char* p = s.data();
+    const char* end = p + s.size();
+    while (p < end && count < max_count) {
+        bool starts_number = IsDigit(*p) ||
+            ((*p == '-' || *p == '.') && p + 1 < end && IsDigit(p[1]));
+        if (!starts_number) {
+            ++p;
+            continue;
+        }
+        double value = 0.0;
+        auto result = std::from_chars(p, end, value);
+        if (result.ec != std::errc()) {
+            ++p;
+            continue;
+        }
+        out[count++] = value;
+        p = result.ptr;
+    }
+    return count;
+}
+
+bool ParseNumber(std::string_view token, double* value) {
+    if (!token.empty() && token.back() == '%') token.remove_suffix(1);
+    if (token.empty()) return false;
+    auto result = std::from_chars(token.data(), token.data() + token.size(), *value);
+    return result.ec == std::errc() && result.ptr == token.data() + token.size();
+}
+
+// Days since 1970-01-01 for a proleptic Gregorian date
+int64_t DaysFromCivil(int64_t y, unsigned m, unsigned d) {
+    y -= m <= 2;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int64_t>(doe) - 719468;
+}
+
+int TwoDigits(const char* p) {
+    return (p[0] - '0') * 10 + (p[1] - '0');
+}
+
+// "[2026-01-07 07:50:48] ..." -> seconds since epoch, or -1 if the line has no stamp
+int64_t ParseTimestamp(std::string_view line) {
+    if (line.size() < 21 || line[0] != '[' || line[20] != ']' || line[5] != '-' ||
+        line[11] != ' ' || line[14] != ':') {
+        return -1;
+    }
+    const char* p = line.data() + 1;
+    int year = TwoDigits(p) * 100 + TwoDigits(p + 2);
+    int month = TwoDigits(p + 5);
+    int day = TwoDigits(p + 8);
+    int hour = TwoDigits(p + 11);
+    int minute = TwoDigits(p + 14);
+    int second = TwoDigits(p + 17);
+    return DaysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+}
+
+int32_t ToInt(double v) {
+    if (!(v == v)) return 0;
+    if (v > std::numeric_limits<int32_t>::max()) return std::numeric_limits<int32_t>::max();
+    if (v < std::numeric_limits<int32_t>::min()) return std::numeric_limits<int32_t>::min();
+    return static_cast<int32_t>(v);
+}
+
+bool IsStatusWord(std::string_view token) {
+    return token == "integral" || token == "cutoff" || token == "infeasible" ||
+           token == "unbounded";
+}
+
+// Per-file parsing state
+class LogScanner {
+public:
+    LogScanner(uint32_t file_id, LogEventTable* events, LogRunSummary* summary)
+        : file_id_(file_id), events_(events), summary_(summary) {}
+
+    void ScanLine(std::string_view line) {
+        ++line_no_;
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+
+        int64_t stamp = ParseTimestamp(line);
+        if (stamp >= 0) {
+            timestamp_ = stamp;
+            line.remove_prefix(line.size() > 21 && line[21] == ' ' ? 22 : 21);
+            ScanStampedBody(line);
+            return;
+        }
+        ScanRawLine(line);
+    }
+
+private:
+    void Push(LogEventKind kind, int32_t a0 = 0, int32_t a1 = 0, int32_t a2 = 0,
+              int32_t a3 = 0, double b0 = 0.0, double b1 = 0.0, double b2 = 0.0) {
+        events_->Push(file_id_, line_no_, timestamp_, kind, a0, a1, a2, a3, b0, b1, b2);
+    }
+
+    bool ScanCplexMarker(std::string_view body) {
+        if (!StartsWith(body, "=============== CPLEX ")) return false;
+        body.remove_prefix(22);
+        if (StartsWith(body, "START")) {
+            in_cplex_ = true;
+            in_node_log_ = false;
+            Push(LogEventKind::CplexStart, summary_->cplex_blocks);
+        } else if (StartsWith(body, "END")) {
+            Push(LogEventKind::CplexEnd, summary_->cplex_blocks);
+            ++summary_->cplex_blocks;
+            in_cplex_ = false;
+            in_node_log_ = false;
+        }
+        return true;
+    }
+
+    void ScanStampedBody(std::string_view body) {
+        if (ScanCplexMarker(body)) return;
+
+        double n[8];
+        if (in_summary_ && !StartsWith(body, "[")) {
+            ScanSummaryLine(Trim(body));
+            return;
+        }
+        in_summary_ = false;
+
+        if (StartsWith(TrimLeft(body), "求解结果汇总")) {
+            in_summary_ = true;
+            summary_->has_summary = true;
+            return;
+        }
+        if (body.empty() || body[0] != '[') return;
+
+        size_t close = body.find(']');
+        if (close == std::string_view::npos) return;
+        std::string_view tag = body.substr(1, close - 1);
+        std::string_view rest = TrimLeft(body.substr(close + 1));
+
+        if (tag == "数据") {
+            if (ExtractNumbers(rest, n, 4) == 4) {
+                summary_->n = ToInt(n[0]);
+                summary_->t = ToInt(n[1]);
+                summary_->f = ToInt(n[2]);
+                summary_->g = ToInt(n[3]);
+                Push(LogEventKind::DataLoaded, ToInt(n[0]), ToInt(n[1]), ToInt(n[2]), ToInt(n[3]));
+            }
+        } else if (tag == "合并") {
+            if (StartsWith(rest, "完成") && ExtractNumbers(rest, n, 2) == 2) {
+                summary_->merged_orders = ToInt(n[1]);
+                Push(LogEventKind::OrdersMerged, ToInt(n[0]), ToInt(n[1]));
+            }
+        } else if (tag == "系统") {
+            if (StartsWith(rest, "算法:")) {
+                summary_->algorithm = std::string(Trim(rest.substr(std::strlen("算法:"))));
+            } else if (StartsWith(rest, "输入文件:")) {
+                summary_->input_file = std::string(Trim(rest.substr(std::strlen("输入文件:"))));
+            } else if (StartsWith(rest, "程序正常退出")) {
+                summary_->exited_normally = true;
+            }
+        } else {
+            ScanAlgorithmLine(rest);
+        }
+    }
+
+    // Lines tagged with an algorithm name such as [RF], [FO], [RR]
+    void ScanAlgorithmLine(std::string_view rest) {
+        double n[8];
+        if (StartsWith(rest, "迭代 ")) {
+            if (ExtractNumbers(rest, n, 2) == 2) {
+                Push(LogEventKind::RfIteration, ToInt(n[0]), ToInt(n[1]));
+            }
+        } else if (StartsWith(rest, "子问题:")) {
+            // k=0 W=6 (固定:[0,0) 窗口:[0,6) 放松:[6,30))
+            if (ExtractNumbers(rest, n, 8) == 8) {
+                Push(LogEventKind::RfWindow, ToInt(n[0]), ToInt(n[1]), ToInt(n[4]), ToInt(n[5]));
+            }
+        } else if (StartsWith(rest, "固定周期")) {
+            if (ExtractNumbers(rest, n, 2) == 2) {
+                Push(LogEventKind::RfFixed, ToInt(n[0]), ToInt(n[1]));
+            }
+        } else if (StartsWith(rest, "求解成功:")) {
+            if (ExtractNumbers(rest, n, 2) == 2) {
+                Push(LogEventKind::SolveSuccess, 0, 0, 0, 0, n[0], n[1]);
+            }
+        } else if (StartsWith(rest, "总启动数:")) {
+            if (ExtractNumbers(rest, n, 2) == 2) {
+                summary_->total_setups = ToInt(n[0]);
+                summary_->total_carryovers = ToInt(n[1]);
+                Push(LogEventKind::SetupTotals, ToInt(n[0]), ToInt(n[1]));
+            }
+        } else if (StartsWith(rest, "总迭代:")) {
+            if (ExtractNumbers(rest, n, 1) == 1) summary_->iterations = ToInt(n[0]);
+        } else if (StartsWith(rest, "CPU时间:")) {
+            if (ExtractNumbers(rest, n, 1) == 1) summary_->cpu_time = n[0];
+        }
+    }
+
+    // "  算法:     RF" style lines inside the final summary block
+    void ScanSummaryLine(std::string_view body) {
+        size_t colon = body.find(':');
+        if (colon == std::string_view::npos) return;
+        std::string_view key = body.substr(0, colon);
+        std::string_view value = Trim(body.substr(colon + 1));
+        double n[1];
+        bool has_number = ExtractNumbers(value, n, 1) == 1;
+
+        if (key == "算法") {
+            summary_->algorithm = std::string(value);
+        } else if (key == "目标值" && has_number) {
+            summary_->objective = n[0];
+        } else if (key == "求解时间" && has_number) {
+            summary_->solve_time = n[0];
+        } else if (key == "总耗时" && has_number) {
+            summary_->total_time = n[0];
+        } else if (key == "Gap" && has_number) {
+            summary_->gap = n[0];
+        }
+    }
+
+    // Unstamped lines: CPLEX output between START/END markers
+    void ScanRawLine(std::string_view line) {
+        if (ScanCplexMarker(line)) return;
+        if (!in_cplex_) return;
+
+        double n[4];
+        std::string_view body = TrimLeft(line);
+        if (body.empty()) return;
+
+        if (StartsWith(body, "MIP Presolve eliminated ")) {
+            if (ExtractNumbers(body, n, 2) == 2) {
+                Push(LogEventKind::PresolveEliminated, ToInt(n[0]), ToInt(n[1]));
+            }
+        } else if (StartsWith(body, "Reduced MIP has ")) {
+            int count = ExtractNumbers(body, n, 3);
+            if (body.find("binaries") != std::string_view::npos) {
+                if (count >= 2) Push(LogEventKind::ReducedBinaries, ToInt(n[0]), ToInt(n[1]));
+            } else if (count == 3) {
+                Push(LogEventKind::ReducedMip, ToInt(n[0]), ToInt(n[1]), ToInt(n[2]));
+            }
+        } else if (StartsWith(body, "Presolve time = ")) {
+            if (ExtractNumbers(body, n, 2) == 2) {
+                Push(LogEventKind::PresolveTime, 0, 0, 0, 0, n[0], n[1]);
+            }
+        } else if (StartsWith(body, "Node  Left")) {
+            in_node_log_ = true;
+        } else if (in_node_log_) {
+            ScanNodeRow(body);
+        }
+    }
+
+    // CPLEX node log row, e.g.
+    //   *     0+    0                       400500.6248        0.0000           100.00%
+    //         0     0   250451.3808    25   400500.6248   250451.3808     1317   37.47%
+    //         0     0   250647.1928    12   251025.9134      Cuts: 62     1670    0.15%
+    void ScanNodeRow(std::string_view body) {
+        std::string_view tokens[16];
+        int count = 0;
+        size_t pos = 0;
+        while (pos < body.size() && count < 16) {
+            while (pos < body.size() && body[pos] == ' ') ++pos;
+            if (pos >= body.size()) break;
+            size_t next = body.find(' ', pos);
+            if (next == std::string_view::npos) next = body.size();
+            tokens[count++] = body.substr(pos, next - pos);
+            pos = next;
+        }
+
+        int i = 0;
+        bool incumbent = false;
+        if (count > 0 && (tokens[0] == "*" || tokens[0] == "H")) {
+            incumbent = true;
+            ++i;
+        }
+        if (count - i < 3 || !IsDigit(tokens[i][0]) || !IsDigit(tokens[i + 1][0])) return;
+
+        std::string_view node_token = tokens[i];
+        bool heuristic = node_token.back() == '+';
+        if (heuristic) node_token.remove_suffix(1);
+        double node = 0.0;
+        double left = 0.0;
+        if (!ParseNumber(node_token, &node) || !ParseNumber(tokens[i + 1], &left)) return;
+
+        const std::string_view* rest = tokens + i + 2;
+        int rest_count = count - i - 2;
+
+        double best_integer = kNaN;
+        double best_bound = kNaN;
+        double gap = kNaN;
+        double iterations = 0.0;
+
+        int j = rest_count - 1;
+        if (rest[j].back() == '%' && ParseNumber(rest[j], &gap)) {
+            gap /= 100.0;
+            --j;
+        }
+
+        if (heuristic) {
+            // Heuristic incumbent rows: best integer, best bound [, gap]
+            if (j >= 0) ParseNumber(rest[0], &best_integer);
+            if (j >= 1) ParseNumber(rest[1], &best_bound);
+        } else {
+            bool has_gap = gap == gap;
+            if (j >= 0 && ParseNumber(rest[j], &iterations)) --j;
+            if (j >= 1 && rest[j - 1].back() == ':') {
+                // "Cuts: 62" / "Impl Bds: 4" replace the bound column
+                double scratch = 0.0;
+                j -= 2;
+                while (j >= 0 && !IsStatusWord(rest[j]) && !ParseNumber(rest[j], &scratch)) --j;
+            } else if (j >= 0) {
+                ParseNumber(rest[j], &best_bound);
+                --j;
+            }
+            if (has_gap && j >= 0) ParseNumber(rest[j], &best_integer);
+        }
+
+        Push(LogEventKind::NodeRow, ToInt(node), ToInt(left), incumbent ? 1 : 0,
+             ToInt(iterations), best_integer, best_bound, gap);
+    }
+
+    uint32_t file_id_;
+    LogEventTable* events_;
+    LogRunSummary* summary_;
+    uint32_t line_no_ = 0;
+    int64_t timestamp_ = 0;
+    bool in_cplex_ = false;
+    bool in_node_log_ = false;
+    bool in_summary_ = false;
+};
+
+template <typename T>
+void AppendColumn(std::vector<T>* dst, const std::vector<T>& src) {
+    dst->insert(dst->end(), src.begin(), src.end());
+}
+
+template <typename T>
+void WriteColumn(std::ofstream& out, const std::vector<T>& column) {
+    if (!column.empty()) {
+        out.write(reinterpret_cast<const char*>(column.data()),
+                  static_cast<std::streamsize>(column.size() * sizeof(T)));
+    }
+}
+
+template <typename T>
+bool ReadColumn(std::ifstream& in, std::vector<T>* column, size_t rows) {
+    column->resize(rows);
+    if (rows == 0) return true;
+    in.read(reinterpret_cast<char*>(column->data()),
+            static_cast<std::streamsize>(rows * sizeof(T)));
+    return static_cast<bool>(in);
+}
+
+template <typename T>
+void WritePod(std::ofstream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadPod(std::ifstream& in, T* value) {
+    in.read(reinterpret_cast<char*>(value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+// Text cell, quoted with doubled quotes if it holds a separator, quote or line break
+void WriteCsvText(std::ofstream& out, const std::string& text) {
+    if (text.find_first_of(",\"\r\n") == std::string::npos) {
+        out << text;
+        return;
+    }
+    out << '"';
+    for (char c : text) {
+        if (c == '"') out << '"';
+        out << c;
+    }
+    out << '"';
+}
+
+// Feed whole lines of |data| to |scanner|; |first| skips a UTF-8 BOM
+void ScanLines(const char* data, size_t size, bool first, LogScanner* scanner) {
+    const char* p = data;
+    const char* end = data + size;
+
+    // Skip UTF-8 BOM
+    if (first && size >= 3 && std::memcmp(p, "\xEF\xBB\xBF", 3) == 0) p += 3;
+
+    while (p < end) {
+        const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+        const char* line_end = nl ? nl : end;
+        scanner->ScanLine(std::string_view(p, line_end - p));
+        p = nl ? nl + 1 : end;
+    }
+}
+
+// Archived log: one block in memory at a time (blocks end on line breaks)
+bool ParseLogArchive(const std::string& path, uint32_t file_id,
+                     LogEventTable* events, LogRunSummary* summary) {
+    LogArchiveReader reader;
+    if (!reader.Open(path)) return false;
+    events->Reserve(events->Size() + static_cast<size_t>(reader.RawSize() / 128));
+
+    LogScanner scanner(file_id, events, summary);
+    std::string block;
+    for (size_t b = 0; b < reader.Blocks().size(); ++b) {
+        if (!reader.ReadBlock(b, &block)) return false;
+        ScanLines(block.data(), block.size(), b == 0, &scanner);
+    }
+    return true;
+}
+
+}  // namespace
+
+const char* LogEventKindName(LogEventKind kind) {
+    switch (kind) {
+        case LogEventKind::DataLoaded:         return "data";
+        case LogEventKind::OrdersMerged:       return "merge";
+        case LogEventKind::RfIteration:        return "rf_iter";
+        case LogEventKind::RfWindow:           return "rf_window";
+        case LogEventKind::RfFixed:            return "rf_fixed";
+        case LogEventKind::CplexStart:         return "cplex_start";
+        case LogEventKind::CplexEnd:           return "cplex_end";
+        case LogEventKind::PresolveEliminated: return "presolve_eliminated";
+        case LogEventKind::ReducedMip:         return "reduced_mip";
+        case LogEventKind::ReducedBinaries:    return "reduced_binaries";
+        case LogEventKind::PresolveTime:       return "presolve_time";
+        case LogEventKind::NodeRow:            return "node";
+        case LogEventKind::SolveSuccess:       return "solve_success";
+        case LogEventKind::SetupTotals:        return "setup_totals";
+        default: return "unknown";
+    }
+}
+
+void LogEventTable::Reserve(size_t n) {
+    file.reserve(n);
+    line.reserve(n);
+    time.reserve(n);
+    kind.reserve(n);
+    i0.reserve(n);
+    i1.reserve(n);
+    i2.reserve(n);
+    i3.reserve(n);
+    d0.reserve(n);
+    d1.reserve(n);
+    d2.reserve(n);
+}
+
+void LogEventTable::Clear() {
+    *this = LogEventTable();
+}
+
+void LogEventTable::Append(const LogEventTable& other, uint32_t file_offset) {
+    size_t start = file.size();
+    AppendColumn(&file, other.file);
+    for (size_t i = start; i < file.size(); ++i) file[i] += file_offset;
+    AppendColumn(&line, other.line);
+    AppendColumn(&time, other.time);
+    AppendColumn(&kind, other.kind);
+    AppendColumn(&i0, other.i0);
+    AppendColumn(&i1, other.i1);
+    AppendColumn(&i2, other.i2);
+    AppendColumn(&i3, other.i3);
+    AppendColumn(&d0, other.d0);
+    AppendColumn(&d1, other.d1);
+    AppendColumn(&d2, other.d2);
+}
+
+void LogEventTable::Push(uint32_t file_id, uint32_t line_no, int64_t timestamp, LogEventKind k,
+                         int32_t a0, int32_t a1, int32_t a2, int32_t a3,
+                         double b0, double b1, double b2) {
+    file.push_back(file_id);
+    line.push_back(line_no);
+    time.push_back(timestamp);
+    kind.push_back(static_cast<uint8_t>(k));
+    i0.push_back(a0);
+    i1.push_back(a1);
+    i2.push_back(a2);
+    i3.push_back(a3);
+    d0.push_back(b0);
+    d1.push_back(b1);
+    d2.push_back(b2);
+}
+
+void ParseLogBuffer(const char* data, size_t size, uint32_t file_id,
+                    LogEventTable* events, LogRunSummary* summary) {
+    LogScanner scanner(file_id, events, summary);
+    ScanLines(data, size, true, &scanner);
+}
+
+bool ParseLogFile(const std::string& path, uint32_t file_id,
+                  LogEventTable* events, LogRunSummary* summary) {
+    summary->path = path;
+    if (IsLogArchivePath(path)) return ParseLogArchive(path, file_id, events, summary);
+
+    std::ifstream in(std::filesystem::u8path(path), std::ios::binary | std::ios::ate);
+    if (!in) return false;
+
+    std::streamsize size = in.tellg();
+    in.seekg(0);
+    std::string buffer(static_cast<size_t>(std::max<std::streamsize>(size, 0)), '\0');
+    if (size > 0 && !in.read(&buffer[0], size)) return false;
+
+    // A typical N=300 log yields ~600 events per 100 KB
+    events->Reserve(events->Size() + buffer.size() / 128);
+    ParseLogBuffer(buffer.data(), buffer.size(), file_id, events, summary);
+    return true;
+}
+
+size_t ParseLogFiles(const std::vector<std::string>& paths, int threads,
+                   LogEventTable* events, std::vector<LogRunSummary>* summaries) {
+    const size_t count = paths.size();
+    std::vector<LogEventTable> tables(count);
+    summaries->assign(count, LogRunSummary());
+
+    RunParallel(count, threads, [&](size_t i) {
+        LogRunSummary& summary = (*summaries)[i];
+        summary.readable = ParseLogFile(paths[i], 0, &tables[i], &summary);
+    });
+
+    size_t total = 0;
+    for (const auto& table : tables) total += table.Size();
+    events->Clear();
+    events->Reserve(total);
+    size_t failed = 0;
+    for (size_t i = 0; i < count; ++i) {
+        events->Append(tables[i], static_cast<uint32_t>(i));
+        if (!(*summaries)[i].readable) ++failed;
+    }
+    return failed;
+}
+
+bool WriteLogEvents(const std::string& path, const std::vector<LogRunSummary>& summaries,
+                    const LogEventTable& events) {
+    std::ofstream out(std::filesystem::u8path(path), std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    WritePod<uint32_t>(out, kLogEventsMagic);
+    WritePod<uint32_t>(out, kLogEventsVersion);
+    WritePod<uint32_t>(out, static_cast<uint32_t>(summaries.size()));
+    WritePod<uint64_t>(out, static_cast<uint64_t>(events.Size()));
+    for (const auto& summary : summaries) {
+        WritePod<uint32_t>(out, static_cast<uint32_t>(summary.path.size()));
+        out.write(summary.path.data(), static_cast<std::streamsize>(summary.path.size()));
+    }
+
+    WriteColumn(out, events.file);
+    WriteColumn(out, events.line);
+    WriteColumn(out, events.time);
+    WriteColumn(out, events.kind);
+    WriteColumn(out, events.i0);
+    WriteColumn(out, events.i1);
+    WriteColumn(out, events.i2);
+    WriteColumn(out, events.i3);
+    WriteColumn(out, events.d0);
+    WriteColumn(out, events.d1);
+    WriteColumn(out, events.d2);
+    return static_cast<bool>(out);
+}
+
+bool ReadLogEvents(const std::string& path, std::vector<std::string>* files,
+                   LogEventTable* events) {
+    std::ifstream in(std::filesystem::u8path(path), std::ios::binary);
+    if (!in) return false;
+
+    uint32_t magic = 0, version = 0, file_count = 0;
+    uint64_t rows = 0;
+    if (!ReadPod(in, &magic) || magic != kLogEventsMagic) return false;
+    if (!ReadPod(in, &version) || version != kLogEventsVersion) return false;
+    if (!ReadPod(in, &file_count) || !ReadPod(in, &rows)) return false;
+
+    files->clear();
+    files->reserve(file_count);
+    for (uint32_t i = 0; i < file_count; ++i) {
+        uint32_t length = 0;
+        if (!ReadPod(in, &length)) return false;
+        std::string name(length, '\0');
+        if (length > 0 && !in.read(&name[0], length)) return false;
+        files->push_back(std::move(name));
+    }
+
+    size_t n = static_cast<size_t>(rows);
+    return ReadColumn(in, &events->file, n) && ReadColumn(in, &events->line, n) &&
+           ReadColumn(in, &events->time, n) && ReadColumn(in, &events->kind, n) &&
+           ReadColumn(in, &events->i0, n) && ReadColumn(in, &events->i1, n) &&
+           ReadColumn(in, &events->i2, n) && ReadColumn(in, &events->i3, n) &&
+           ReadColumn(in, &events->d0, n) && ReadColumn(in, &events->d1, n) &&
+           ReadColumn(in, &events->d2, n);
+}
+
+bool WriteLogSummaries(const std::string& path, const std::vector<LogRunSummary>& summaries) {
+    std::ofstream out(std::filesystem::u8path(path), std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    out << "Path,Algorithm,N,T,F,G,MergedOrders,Iterations,CplexBlocks,Setups,Carryovers,"
+           "Objective,SolveTime(s),TotalTime(s),CPUTime(s),Gap,ExitedNormally,Readable\n";
+    out.precision(10);
+    for (const auto& s : summaries) {
+        WriteCsvText(out, s.path);
+        out << ',';
+        WriteCsvText(out, s.algorithm);
+        out << ',' << s.n << ',' << s.t << ',' << s.f << ','
+            << s.g << ',' << s.merged_orders << ',' << s.iterations << ',' << s.cplex_blocks
+            << ',' << s.total_setups << ',' << s.total_carryovers << ',' << s.objective << ','
+            << s.solve_time << ',' << s.total_time << ',' << s.cpu_time << ',' << s.gap << ','
+            << (s.exited_normally ? 1 : 0) << ',' << (s.readable ? 1 : 0) << '\n';
+    }
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,112 @@
+// log_events.h - Offline solver log parser
+// Turns LS-NTGF-All log files into a columnar table of structured events
+
+#ifndef LOG_EVENTS_H_
+#define LOG_EVENTS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Event kinds recognized in solver logs.
+// Integer/double payload meaning per kind is listed on the right.
+enum class LogEventKind : uint8_t {
+    DataLoaded = 1,        // [数据] i0=N i1=T i2=F i3=G
+    OrdersMerged = 2,      // [合并] 完成: i0=original i1=merged
+    RfIteration = 3,       // [RF] 迭代: i0=iteration i1=k
+    RfWindow = 4,          // [RF] 子问题: i0=k i1=W i2=window begin i3=window end
+    RfFixed = 5,           // [RF] 固定周期: i0=begin i1=end
+    CplexStart = 6,        // CPLEX START: i0=block index
+    CplexEnd = 7,          // CPLEX END: i0=block index
+    PresolveEliminated = 8,// i0=rows i1=columns
+    ReducedMip = 9,        // i0=rows i1=columns i2=nonzeros
+    ReducedBinaries = 10,  // i0=binaries i1=generals
+    PresolveTime = 11,     // d0=seconds d1=ticks
+    NodeRow = 12,          // i0=node i1=nodes left i2=incumbent flag i3=iteration count
+                           // d0=best integer d1=best bound d2=gap (fraction)
+    SolveSuccess = 13,     // 求解成功: d0=objective d1=CPU seconds
+    SetupTotals = 14,      // 总启动数/总跨期数: i0=setups i1=carryovers
+};
+
+const char* LogEventKindName(LogEventKind kind);
+
+// Final summary of one log file
+struct LogRunSummary {
+    std::string path;
+    std::string algorithm;
+    std::string input_file;
+    int n = 0;
+    int t = 0;
+    int f = 0;
+    int g = 0;
+    int merged_orders = 0;
+    int iterations = 0;
+    int total_setups = 0;
+    int total_carryovers = 0;
+    int cplex_blocks = 0;
+    double objective = 0.0;
+    double solve_time = 0.0;
+    double total_time = 0.0;
+    double cpu_time = 0.0;
+    double gap = 0.0;
+    bool has_summary = false;  // "求解结果汇总" block was found
+    bool exited_normally = false;
+    bool readable = false;     // the file was opened and read in full
+};
+
+// Column-oriented event storage: one vector per field, all of equal length
+class LogEventTable {
+public:
+    size_t Size() const { return kind.size(); }
+    void Reserve(size_t n);
+    void Clear();
+
+    // Append all rows from another table, rewriting file ids by offset
+    void Append(const LogEventTable& other, uint32_t file_offset);
+
+    void Push(uint32_t file_id, uint32_t line_no, int64_t timestamp, LogEventKind k,
+              int32_t a0 = 0, int32_t a1 = 0, int32_t a2 = 0, int32_t a3 = 0,
+              double b0 = 0.0, double b1 = 0.0, double b2 = 0.0);
+
+    std::vector<uint32_t> file;
+    std::vector<uint32_t> line;
+    std::vector<int64_t> time;  // seconds since epoch (log timestamp, UTC-agnostic)
+    std::vector<uint8_t> kind;
+    std::vector<int32_t> i0;
+    std::vector<int32_t> i1;
+    std::vector<int32_t> i2;
+    std::vector<int32_t> i3;
+    std::vector<double> d0;
+    std::vector<double> d1;
+    std::vector<double> d2;
+};
+
+// Parse one log held in memory. Events are appended to |events| with |file_id|.
+void ParseLogBuffer(const char* data, size_t size, uint32_t file_id,
+                    LogEventTable* events, LogRunSummary* summary);
+
+// Parse one file from disk, a plain log or a block-compressed .logz (see
+// log_archive.h). Returns false if the file cannot be read.
+bool ParseLogFile(const std::string& path, uint32_t file_id,
+                  LogEventTable* events, LogRunSummary* summary);
+
+// Parse many files, one worker thread per file at a time (threads <= 0: hardware
+// concurrency). Results are concatenated in input order, so output is deterministic.
+// Returns the number of files that could not be read (summary.readable == false).
+size_t ParseLogFiles(const std::vector<std::string>& paths, int threads,
+                   LogEventTable* events, std::vector<LogRunSummary>* summaries);
+
+// Columnar binary container (.lsev)
+//   header: "LSEV" u32 version, u32 file_count, u64 row_count
+//   file table: u32 length + UTF-8 path per file
+//   columns: file, line, time, kind, i0..i3, d0..d2 stored back to back
+bool WriteLogEvents(const std::string& path, const std::vector<LogRunSummary>& summaries,
+                    const LogEventTable& events);
+bool ReadLogEvents(const std::string& path, std::vector<std::string>* files,
+                   LogEventTable* events);
+
+// One CSV row per log file; text fields are quoted when they need it (RFC 4180)
+bool WriteLogSummaries(const std::string& path, const std::vector<LogRunSummary>& summaries);
+
+#endif  // LOG_EVENTS_H_
@@ -0,0 +1,62 @@
+// order_merge.cpp - Preview of the solver's order merge implementation
+
+#include "order_merge.h"
+
+#include <algorithm>
+#include <utility>
+
+ModelSize EstimateModelSize(int orders, int t, int g, int f) {
+    const int64_t n = orders;
+    const int64_t periods = t;
+    ModelSize size;
+    size.columns = 2 * n * periods + n + 2 * int64_t{g} * periods + int64_t{f} * periods;
+    size.binaries = n + 2 * int64_t{g} * periods;
+    size.rows = n + 2 * n * periods + periods + int64_t{g} * periods + periods +
+                int64_t{f} * periods;
+    return size;
+}
+
+OrderMergePreview::OrderMergePreview(const InstanceData& instance)
+    : n_(instance.n)
+    , t_(instance.t)
+    , g_(instance.g)
+    , f_(instance.f) {
+    const size_t n = static_cast<size_t>(std::max(instance.n, 0));
+    if (instance.demand.size() != n) return;
+    demands_ = instance.demand;
+    std::sort(demands_.begin(), demands_.end());
+
+    if (instance.flow.size() != n || instance.group.size() != n) return;
+
+    // Smallest demand of each (flow, group) pair
+    std::vector<std::pair<int64_t, double>> keyed(n);
+    for (size_t i = 0; i < n; ++i) {
+        keyed[i] = {(int64_t{instance.flow[i]} << 32) | static_cast<uint32_t>(instance.group[i]),
+                    instance.demand[i]};
+    }
+    std::sort(keyed.begin(), keyed.end());
+    for (size_t i = 0; i < n; ++i) {
+        if (i == 0 || keyed[i].first != keyed[i - 1].first) {
+            pair_minimum_.push_back(keyed[i].second);
+        }
+    }
+    std::sort(pair_minimum_.begin(), pair_minimum_.end());
+}
+
+MergeEstimate OrderMergePreview::Estimate(bool merge_enabled, double big_order_threshold) const {
+    MergeEstimate estimate;
+    estimate.original = n_;
+    estimate.merged = n_;
+    estimate.merge_possible = !pair_minimum_.empty();
+
+    if (merge_enabled && estimate.merge_possible) {
+        auto below = [big_order_threshold](const std::vector<double>& sorted) {
+            return static_cast<int>(std::lower_bound(sorted.begin(), sorted.end(),
+                                                     big_order_threshold) - sorted.begin());
+        };
+        estimate.big_orders = n_ - below(demands_);
+        estimate.merged = estimate.big_orders + below(pair_minimum_);
+    }
+    estimate.size = EstimateModelSize(estimate.merged, t_, g_, f_);
+    return estimate;
+}
@@ -0,0 +1,57 @@
+// order_merge.h - Preview of the solver's order merge and the model it leaves
+// The solver merges orders before building the model ("[合并] 完成: 300 -> 23 订单"):
+// orders with demand at or above the big-order threshold are kept as they are,
+// all other orders of one (flow, group) pair become a single order. Without the
+// flow/group columns, or with merging disabled, every order stays.
+//
+// The preview sorts the demands once per instance: all demands, and the smallest
+// demand of each (flow, group) pair. For any threshold the merged count is then
+//   #(demand >= threshold) + #(pairs whose smallest demand < threshold)
+// two binary searches, so it follows the threshold spin box without delay.
+//
+// Model size of the full (unwindowed) formulation for n' orders:
+//   columns  = X n'T + B n'T + U n' + Y GT + L GT + I FT
+//   binaries = U n' + Y GT + L GT
+//   rows     = demand n' + backlog n'T + setup link n'T + capacity T
+//            + carryover GT + one carryover per period T + inventory FT
+// RF / FO subproblems only hold a window of it; this is the upper bound.
+
+#ifndef ORDER_MERGE_H_
+#define ORDER_MERGE_H_
+
+#include <cstdint>
+#include <vector>
+#include "instance_data.h"
+
+struct ModelSize {
+    int64_t rows = 0;
+    int64_t columns = 0;
+    int64_t binaries = 0;
+};
+
+struct MergeEstimate {
+    int original = 0;       // orders in the instance
+    int merged = 0;         // orders the model is built from
+    int big_orders = 0;     // kept unmerged because of the threshold
+    bool merge_possible = false;   // instance has flow and group columns
+    ModelSize size;
+};
+
+ModelSize EstimateModelSize(int orders, int t, int g, int f);
+
+class OrderMergePreview {
+public:
+    explicit OrderMergePreview(const InstanceData& instance);
+
+    MergeEstimate Estimate(bool merge_enabled, double big_order_threshold) const;
+
+private:
+    int n_;
+    int t_;
+    int g_;
+    int f_;
+    std::vector<double> demands_;       // all orders, ascending
+    std::vector<double> pair_minimum_;  // per (flow, group) with orders, ascending
+};
+
+#endif  // ORDER_MERGE_H_
@@ -0,0 +1,79 @@
+// parallel.h - Index-pulling worker pool and cancellation shared by the core
+// Workers claim the next index from a shared counter, so items of uneven cost
+// balance themselves without a scheduler. The calling thread is one of the
+// workers, so a single-thread run starts no thread at all.
+
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using CancelCheck = std::function<bool()>;
+
+// Workers for |count| items: |threads| (<= 0: hardware concurrency), at most one
+// per item and at least one
+inline int ResolveThreadCount(int threads, size_t count) {
+    if (threads <= 0) {
+        threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    return static_cast<int>(std::max<size_t>(1, std::min<size_t>(static_cast<size_t>(threads), count)));
+}
+
+// Run fn(i) for every i in [0, count) on up to |threads| workers. |cancelled| is
+// polled before each item; once it returns true no further item starts and the
+// result is false.
+template <typename Fn>
+bool RunParallel(size_t count, int threads, Fn&& fn, const CancelCheck& cancelled = {}) {
+    if (count == 0) return !(cancelled && cancelled());
+    threads = ResolveThreadCount(threads, count);
+
+    std::atomic<size_t> next(0);
+    std::atomic<bool> stopped(false);
+    auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++) {
+            if (stopped.load()) return;
+            if (cancelled && cancelled()) {
+                stopped = true;
+                return;
+            }
+            fn(i);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; ++i) pool.emplace_back(worker);
+    worker();
+    for (auto& t : pool) t.join();
+    return !stopped.load();
+}
+
+// Cancellation of numbered requests: cancelling id k cancels every request up to
+// k, so a newer request implicitly supersedes older ones. Thread-safe.
+class RequestCancellation {
+public:
+    void Cancel(int request_id) {
+        int current = cancelled_id_.load();
+        while (current < request_id &&
+               !cancelled_id_.compare_exchange_weak(current, request_id)) {
+        }
+    }
+
+    bool IsCancelled(int request_id) const {
+        return request_id <= cancelled_id_.load();
+    }
+
+    // Poll for |request_id|, for RunParallel and the scanners; |this| must outlive it
+    CancelCheck Check(int request_id) const {
+        return [this, request_id]() { return IsCancelled(request_id); };
+    }
+
+private:
+    std::atomic<int> cancelled_id_{0};
+};
+
+#endif  // PARALLEL_H_
@@ -0,0 +1,76 @@
+// process_usage.cpp - CPU time and peak memory of a running process implementation
+
+#include "process_usage.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <unistd.h>
+#include <fstream>
+#include <sstream>
+#include <string>
+#endif
+
+#if defined(_WIN32)
+
+bool SampleProcessUsage(int64_t pid, ProcessUsage* usage) {
+    HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, static_cast<DWORD>(pid));
+    if (!process) return false;
+
+    FILETIME created, exited, kernel, user;
+    PROCESS_MEMORY_COUNTERS memory = {};
+    const bool ok = GetProcessTimes(process, &created, &exited, &kernel, &user) &&
+                    GetProcessMemoryInfo(process, &memory, sizeof(memory));
+    CloseHandle(process);
+    if (!ok) return false;
+
+    // FILETIME counts 100 ns units
+    auto seconds = [](const FILETIME& time) {
+        const uint64_t ticks = (static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+        return ticks * 1e-7;
+    };
+    usage->cpu_seconds = seconds(user) + seconds(kernel);
+    usage->peak_rss_bytes = static_cast<int64_t>(memory.PeakWorkingSetSize);
+    return true;
+}
+
+#elif defined(__linux__)
+
+bool SampleProcessUsage(int64_t pid, ProcessUsage* usage) {
+    const std::string dir = "/proc/" + std::to_string(pid);
+
+    // Fields after the parenthesised command name; utime / stime are 14 and 15
+    std::ifstream stat(dir + "/stat");
+    std::string line;
+    if (!std::getline(stat, line)) return false;
+    const size_t close = line.rfind(')');
+    if (close == std::string::npos) return false;
+    std::istringstream fields(line.substr(close + 2));
+    std::string field;
+    double ticks = 0.0;
+    for (int index = 3; index <= 15 && fields >> field; ++index) {
+        if (index >= 14) ticks += std::stod(field);
+    }
+    usage->cpu_seconds = ticks / static_cast<double>(sysconf(_SC_CLK_TCK));
+
+    std::ifstream status(dir + "/status");
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            usage->peak_rss_bytes = std::stoll(line.substr(6)) * 1024;   // kB
+            break;
+        }
+    }
+    return true;
+}
+
+#else
+
+bool SampleProcessUsage(int64_t, ProcessUsage*) {
+    return false;
+}
+
+#endif
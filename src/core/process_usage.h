@@ -0,0 +1,23 @@
+// process_usage.h - CPU time and peak memory of a running process
+// Sampled from outside while the process runs (the solver is a child process
+// started through QProcess, whose handle is gone once it has finished):
+//   Windows  GetProcessTimes (user + kernel), PeakWorkingSetSize
+//   Linux    utime + stime of /proc/<pid>/stat, VmHWM of /proc/<pid>/status
+// Peak memory never decreases, so the last sample before exit is the peak; CPU
+// time misses at most one sampling interval.
+
+#ifndef PROCESS_USAGE_H_
+#define PROCESS_USAGE_H_
+
+#include <cstdint>
+
+struct ProcessUsage {
+    double cpu_seconds = 0.0;
+    int64_t peak_rss_bytes = 0;
+};
+
+// Current usage of process |pid|; false if it cannot be read (exited, no access,
+// unsupported platform)
+bool SampleProcessUsage(int64_t pid, ProcessUsage* usage);
+
+#endif  // PROCESS_USAGE_H_
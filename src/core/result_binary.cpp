@@ -0,0 +1,335 @@
+// result_binary.cpp - Columnar binary result files implementation
+
+#include "result_binary.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <climits>
+
+namespace {
+
+constexpr int kWriteBufferSize = 4 * 1024 * 1024;
+
+// Variables written as-is from their bitset words
+bool UseBits(const ResultVariable& var) {
+    return var.storage == ResultVariable::Storage::Bitset;
+}
+
+// Float32 is enough when every nonzero survives the round trip exactly
+bool FitsFloat32(const ResultVariable& var) {
+    bool fits = true;
+    for (int r = 0; r < var.rows && fits; ++r) {
+        var.ForEachNonzero(r, [&fits](int, double v) {
+            fits = fits && static_cast<double>(static_cast<float>(v)) == v;
+        });
+    }
+    return fits;
+}
+
+// Accumulates small writes into large ones
+class BlockWriter {
+public:
+    explicit BlockWriter(QIODevice* device) : device_(device), ok_(true) {
+        buffer_.reserve(kWriteBufferSize);
+    }
+
+    void Write(const void* data, size_t size) {
+        if (buffer_.size() + static_cast<qsizetype>(size) > kWriteBufferSize) Flush();
+        if (size > static_cast<size_t>(kWriteBufferSize)) {
+            ok_ = ok_ && device_->write(static_cast<const char*>(data),
+                                        static_cast<qint64>(size)) == static_cast<qint64>(size);
+            return;
+        }
+        buffer_.append(static_cast<const char*>(data), static_cast<qsizetype>(size));
+    }
+
+    void Pad(size_t size) {
+        static const char kZeros[kResultBinaryAlign] = {};
+        Write(kZeros, ResultBinaryPadding(size));
+    }
+
+    bool Flush() {
+        if (!buffer_.isEmpty()) {
+            ok_ = ok_ && device_->write(buffer_) == buffer_.size();
+            buffer_.clear();
+        }
+        return ok_;
+    }
+
+private:
+    QIODevice* device_;
+    QByteArray buffer_;
+    bool ok_;
+};
+
+void WriteVariableBlock(BlockWriter* writer, const ResultVariable& var,
+                        ResultBinaryEncoding encoding) {
+    if (encoding == ResultBinaryEncoding::Bits) {
+        writer->Write(var.bits.data(), var.bits.size() * sizeof(uint64_t));
+        return;
+    }
+
+    std::vector<double> row(static_cast<size_t>(var.cols));
+    std::vector<float> row32(encoding == ResultBinaryEncoding::Float32 ? row.size() : 0);
+    for (int r = 0; r < var.rows; ++r) {
+        var.CopyRow(r, row.data());
+        if (encoding == ResultBinaryEncoding::Float32) {
+            for (size_t c = 0; c < row.size(); ++c) row32[c] = static_cast<float>(row[c]);
+            writer->Write(row32.data(), row32.size() * sizeof(float));
+        } else {
+            writer->Write(row.data(), row.size() * sizeof(double));
+        }
+    }
+}
+
+}  // namespace
+
+//---------------------------------------
+// Reading
+//---------------------------------------
+
+ResultBinaryFile::ResultBinaryFile()
+    : data_(nullptr)
+    , size_(0) {
+}
+
+ResultBinaryFile::~ResultBinaryFile() {
+    Close();
+}
+
+bool ResultBinaryFile::Open(const QString& path, QString* error) {
+    Close();
+
+    auto file = std::make_unique<QFile>(path);
+    if (!file->open(QIODevice::ReadOnly)) {
+        if (error) *error = QString::fromUtf8("无法打开文件: %1").arg(path);
+        return false;
+    }
+    const qint64 size = file->size();
+    const uchar* data = size > 0 ? file->map(0, size) : nullptr;
+    if (!data) {
+        if (error) *error = QString::fromUtf8("无法映射文件: %1").arg(path);
+        return false;
+    }
+
+    ResultBinaryHeader header;
+    if (!ReadResultBinaryHeader(data, static_cast<size_t>(size), static_cast<uint64_t>(size),
+                                &header)) {
+        file->unmap(const_cast<uchar*>(data));
+        if (error) *error = QString::fromUtf8("不是有效的二进制结果文件: %1").arg(path);
+        return false;
+    }
+
+    path_ = path;
+    file_ = std::move(file);
+    data_ = data;
+    size_ = size;
+
+    QJsonDocument doc = QJsonDocument::fromJson(QByteArray::fromRawData(
+        reinterpret_cast<const char*>(data_ + header.summary_offset),
+        static_cast<qsizetype>(header.summary_size)));
+    if (!doc.isObject()) {
+        Close();
+        if (error) *error = QString::fromUtf8("二进制结果文件概要损坏: %1").arg(path);
+        return false;
+    }
+    summary_ = ResultModel::SummaryFromJson(doc.object());
+
+    if (!ReadIndex(header, error)) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool ResultBinaryFile::ReadIndex(const ResultBinaryHeader& header, QString* error) {
+    const uint64_t end = header.index_offset + header.index_size;
+    uint64_t pos = header.index_offset;
+    variables_.clear();
+    // Every record takes at least its fixed part, so a corrupt count cannot
+    // reserve more than the index holds
+    if (header.variable_count > header.index_size / sizeof(ResultBinaryVariableRecord)) {
+        if (error) *error = QString::fromUtf8("二进制结果文件索引损坏: %1").arg(path_);
+        return false;
+    }
+    variables_.reserve(header.variable_count);
+
+    for (uint32_t i = 0; i < header.variable_count; ++i) {
+        VariableEntry entry;
+        ResultBinaryVariableRecord& rec = entry.record;
+        bool valid = ResultBinaryRangeFits(pos, sizeof(rec), end);
+        if (valid) {
+            std::memcpy(&rec, data_ + pos, sizeof(rec));
+            const size_t record_size = sizeof(rec) + rec.name_size + rec.description_size;
+            const auto encoding = static_cast<ResultBinaryEncoding>(rec.encoding);
+            valid = ResultBinaryRangeFits(pos, record_size, end) &&
+                    rec.encoding >= static_cast<uint8_t>(ResultBinaryEncoding::Bits) &&
+                    rec.encoding <= static_cast<uint8_t>(ResultBinaryEncoding::Float32) &&
+                    rec.rows <= INT_MAX && rec.cols <= INT_MAX &&
+                    rec.offset % kResultBinaryAlign == 0 &&
+                    ResultBinaryRangeFits(rec.offset, rec.size, static_cast<uint64_t>(size_)) &&
+                    rec.size == ResultBinaryBlockSize(encoding, rec.rows, rec.cols);
+            if (valid) {
+                const char* text = reinterpret_cast<const char*>(data_ + pos + sizeof(rec));
+                entry.name = QString::fromUtf8(text, rec.name_size);
+                entry.description = QString::fromUtf8(text + rec.name_size, rec.description_size);
+                pos += record_size + ResultBinaryPadding(record_size);
+            }
+        }
+        if (!valid) {
+            if (error) *error = QString::fromUtf8("二进制结果文件索引损坏: %1").arg(path_);
+            return false;
+        }
+        variables_.push_back(std::move(entry));
+    }
+    return true;
+}
+
+void ResultBinaryFile::Close() {
+    if (file_ && data_) {
+        file_->unmap(const_cast<uchar*>(data_));
+    }
+    file_.reset();
+    data_ = nullptr;
+    size_ = 0;
+    summary_.reset();
+    variables_.clear();
+}
+
+QStringList ResultBinaryFile::VariableNames() const {
+    QStringList names;
+    for (const auto& var : variables_) names << var.name;
+    return names;
+}
+
+int ResultBinaryFile::FindVariable(const QString& name) const {
+    for (size_t i = 0; i < variables_.size(); ++i) {
+        if (variables_[i].name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+ResultVariable ResultBinaryFile::ReadVariable(int index) const {
+    const VariableEntry& entry = variables_[index];
+    const ResultBinaryVariableRecord& rec = entry.record;
+    const uchar* block = data_ + rec.offset;
+    const int rows = static_cast<int>(rec.rows);
+    const int cols = static_cast<int>(rec.cols);
+
+    switch (static_cast<ResultBinaryEncoding>(rec.encoding)) {
+        case ResultBinaryEncoding::Bits: {
+            ResultVariable var;
+            var.name = entry.name;
+            var.description = entry.description;
+            var.rank = rec.rank;
+            var.rows = rows;
+            var.cols = cols;
+            var.storage = ResultVariable::Storage::Bitset;
+            var.words_per_row = (cols + 63) / 64;
+            const uint64_t* words = reinterpret_cast<const uint64_t*>(block);
+            var.bits.assign(words, words + static_cast<size_t>(rows) * var.words_per_row);
+            return var;
+        }
+        case ResultBinaryEncoding::Float32:
+            return ResultModel::VariableFromDense(entry.name, entry.description, rec.rank,
+                                                  rows, cols, reinterpret_cast<const float*>(block));
+        default:
+            return ResultModel::VariableFromDense(entry.name, entry.description, rec.rank,
+                                                  rows, cols, reinterpret_cast<const double*>(block));
+    }
+}
+
+ResultModelPtr ResultBinaryFile::ReadModel() const {
+    if (!summary_) return nullptr;
+    auto model = std::make_shared<ResultModel>(*summary_);
+    model->variables.reserve(variables_.size());
+    for (int i = 0; i < VariableCount(); ++i) {
+        model->variables.push_back(ReadVariable(i));
+    }
+    return model;
+}
+
+bool ResultBinaryFile::IsBinaryResult(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+    uint32_t magic = 0;
+    return file.read(reinterpret_cast<char*>(&magic), sizeof(magic)) == sizeof(magic) &&
+           magic == kResultBinaryMagic;
+}
+
+//---------------------------------------
+// Writing
+//---------------------------------------
+
+bool WriteResultBinary(const QString& path, const ResultModel& model, QString* error) {
+    const QByteArray summary = QJsonDocument(model.SectionsToJson()).toJson(QJsonDocument::Compact);
+
+    // Lay out everything first so the file is written front to back in one pass
+    ResultBinaryHeader header = {};
+    header.magic = kResultBinaryMagic;
+    header.version = kResultBinaryVersion;
+    header.variable_count = static_cast<uint32_t>(model.variables.size());
+    header.summary_offset = sizeof(ResultBinaryHeader);
+    header.summary_size = static_cast<uint64_t>(summary.size());
+
+    uint64_t offset = header.summary_offset + header.summary_size +
+                      ResultBinaryPadding(static_cast<size_t>(header.summary_size));
+    std::vector<ResultBinaryVariableRecord> records(model.variables.size());
+    std::vector<QByteArray> names(model.variables.size());
+    std::vector<QByteArray> descriptions(model.variables.size());
+    uint64_t index_size = 0;
+    for (size_t i = 0; i < model.variables.size(); ++i) {
+        const ResultVariable& var = model.variables[i];
+        ResultBinaryVariableRecord& rec = records[i];
+        const ResultBinaryEncoding encoding = UseBits(var) ? ResultBinaryEncoding::Bits :
+            FitsFloat32(var) ? ResultBinaryEncoding::Float32 : ResultBinaryEncoding::Float64;
+        names[i] = var.name.toUtf8();
+        descriptions[i] = var.description.toUtf8();
+
+        rec.encoding = static_cast<uint8_t>(encoding);
+        rec.rank = static_cast<uint8_t>(var.rank);
+        rec.name_size = static_cast<uint16_t>(names[i].size());
+        rec.description_size = static_cast<uint32_t>(descriptions[i].size());
+        rec.rows = static_cast<uint32_t>(var.rows);
+        rec.cols = static_cast<uint32_t>(var.cols);
+        rec.offset = offset;
+        rec.size = ResultBinaryBlockSize(encoding, rec.rows, rec.cols);
+        offset += rec.size + ResultBinaryPadding(static_cast<size_t>(rec.size));
+
+        const size_t record_size = sizeof(rec) + rec.name_size + rec.description_size;
+        index_size += record_size + ResultBinaryPadding(record_size);
+    }
+    header.index_offset = offset;
+    header.index_size = index_size;
+    header.file_size = offset + index_size;
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        if (error) *error = QString::fromUtf8("无法写入文件: %1").arg(path);
+        return false;
+    }
+
+    BlockWriter writer(&file);
+    writer.Write(&header, sizeof(header));
+    writer.Write(summary.constData(), static_cast<size_t>(summary.size()));
+    writer.Pad(static_cast<size_t>(summary.size()));
+    for (size_t i = 0; i < model.variables.size(); ++i) {
+        WriteVariableBlock(&writer, model.variables[i],
+                           static_cast<ResultBinaryEncoding>(records[i].encoding));
+        writer.Pad(static_cast<size_t>(records[i].size));
+    }
+    for (size_t i = 0; i < records.size(); ++i) {
+        writer.Write(&records[i], sizeof(records[i]));
+        writer.Write(names[i].constData(), static_cast<size_t>(names[i].size()));
+        writer.Write(descriptions[i].constData(), static_cast<size_t>(descriptions[i].size()));
+        writer.Pad(sizeof(records[i]) + names[i].size() + descriptions[i].size());
+    }
+
+    if (!writer.Flush() || !file.commit()) {
+        if (error) *error = QString::fromUtf8("写入文件失败: %1").arg(path);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,72 @@
+// result_binary.h - Columnar binary result files (.lsrb)
+// Writes a ResultModel into the compact layout of result_binary_format.h and
+// reads it back through a memory mapping: opening a file only parses the header,
+// the summary and the variable index; each variable is decoded on request.
+
+#ifndef RESULT_BINARY_H_
+#define RESULT_BINARY_H_
+
+#include <QString>
+#include <QStringList>
+#include <memory>
+#include <vector>
+#include "result_binary_format.h"
+#include "result_model.h"
+
+class QFile;
+
+class ResultBinaryFile {
+public:
+    ResultBinaryFile();
+    ~ResultBinaryFile();
+
+    ResultBinaryFile(const ResultBinaryFile&) = delete;
+    ResultBinaryFile& operator=(const ResultBinaryFile&) = delete;
+
+    // Map |path| and read header, summary and index.
+    // Returns false and sets |error| if the file is missing or not a valid .lsrb.
+    bool Open(const QString& path, QString* error);
+    void Close();
+    bool IsOpen() const { return data_ != nullptr; }
+    QString Path() const { return path_; }
+
+    // Model without variables (summary, problem, metrics)
+    ResultModelPtr Summary() const { return summary_; }
+
+    int VariableCount() const { return static_cast<int>(variables_.size()); }
+    QString VariableName(int index) const { return variables_[index].name; }
+    QStringList VariableNames() const;
+    int FindVariable(const QString& name) const;
+
+    // Decode one variable from the mapping. Thread-safe (read-only access).
+    ResultVariable ReadVariable(int index) const;
+
+    // Summary plus every variable
+    ResultModelPtr ReadModel() const;
+
+    // Cheap check of the magic number (does not validate the rest)
+    static bool IsBinaryResult(const QString& path);
+
+private:
+    struct VariableEntry {
+        QString name;
+        QString description;
+        ResultBinaryVariableRecord record;
+    };
+
+    bool ReadIndex(const ResultBinaryHeader& header, QString* error);
+
+    QString path_;
+    std::unique_ptr<QFile> file_;
+    const uchar* data_;
+    qint64 size_;
+    ResultModelPtr summary_;
+    std::vector<VariableEntry> variables_;
+};
+
+using ResultBinaryFilePtr = std::shared_ptr<const ResultBinaryFile>;
+
+// Write |model| as a .lsrb file (atomically replaces |path|)
+bool WriteResultBinary(const QString& path, const ResultModel& model, QString* error);
+
+#endif  // RESULT_BINARY_H_
@@ -0,0 +1,113 @@
+// result_binary_format.h - On-disk layout of columnar binary result files (.lsrb)
+//
+//   [header, 64 B][summary JSON][variable blocks ...][variable index]
+//
+// The summary block holds the compact "summary"/"problem"/"metrics" JSON of the
+// result. Each variable block is one typed row-major array: Y/L bit-packed in
+// 64-bit words per row (same layout as ResultVariable::bits), real variables
+// as float32 when every value is exactly representable, float64 otherwise.
+// All integers are little-endian and every block starts on an 8-byte boundary,
+// so a memory mapping of the file can be read in place. Reader and writer copy
+// host-order values, so the format is only built for little-endian hosts (every
+// MSVC target is; GCC/Clang are checked below).
+// Plain C++ so the results index can read headers without Qt.
+
+#ifndef RESULT_BINARY_FORMAT_H_
+#define RESULT_BINARY_FORMAT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "The .lsrb format is read in place as little-endian; big-endian hosts are not supported"
+#endif
+
+constexpr uint32_t kResultBinaryMagic = 0x4252534C;  // "LSRB"
+constexpr uint32_t kResultBinaryVersion = 1;
+constexpr size_t kResultBinaryAlign = 8;
+constexpr const char* kResultBinarySuffix = ".lsrb";
+
+enum class ResultBinaryEncoding : uint8_t {
+    Bits = 1,
+    Float64 = 2,
+    Float32 = 3,
+};
+
+struct ResultBinaryHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t variable_count;
+    uint32_t reserved;
+    uint64_t summary_offset;
+    uint64_t summary_size;
+    uint64_t index_offset;
+    uint64_t index_size;
+    uint64_t file_size;      // detects truncated files
+    uint64_t reserved2;
+};
+
+static_assert(sizeof(ResultBinaryHeader) == 64, "ResultBinaryHeader must be 64 bytes");
+
+// Fixed part of one index record; followed by the UTF-8 name and description,
+// then zero padding up to the next 8-byte boundary
+struct ResultBinaryVariableRecord {
+    uint8_t encoding;
+    uint8_t rank;
+    uint16_t name_size;
+    uint32_t description_size;
+    uint32_t rows;
+    uint32_t cols;
+    uint64_t offset;
+    uint64_t size;
+};
+
+static_assert(sizeof(ResultBinaryVariableRecord) == 32,
+              "ResultBinaryVariableRecord must be 32 bytes");
+
+inline size_t ResultBinaryPadding(size_t size) {
+    return (kResultBinaryAlign - size % kResultBinaryAlign) % kResultBinaryAlign;
+}
+
+// [offset, offset + size) lies within [0, limit), without overflowing on
+// corrupt values
+inline bool ResultBinaryRangeFits(uint64_t offset, uint64_t size, uint64_t limit) {
+    return offset <= limit && size <= limit - offset;
+}
+
+// Bytes of a variable block with the given encoding and shape; UINT64_MAX (which
+// no file can hold) if that does not fit in 64 bits
+inline uint64_t ResultBinaryBlockSize(ResultBinaryEncoding encoding, uint32_t rows, uint32_t cols) {
+    uint64_t row_bytes = 0;
+    switch (encoding) {
+        case ResultBinaryEncoding::Bits:
+            row_bytes = (uint64_t(cols) + 63) / 64 * sizeof(uint64_t);
+            break;
+        case ResultBinaryEncoding::Float64:
+            row_bytes = uint64_t(cols) * sizeof(double);
+            break;
+        case ResultBinaryEncoding::Float32:
+            row_bytes = uint64_t(cols) * sizeof(float);
+            break;
+    }
+    if (rows != 0 && row_bytes > std::numeric_limits<uint64_t>::max() / rows) {
+        return std::numeric_limits<uint64_t>::max();
+    }
+    return uint64_t(rows) * row_bytes;
+}
+
+// Copy and validate the header at the start of |data| (|size| bytes available;
+// |file_size| is the real size of the file)
+inline bool ReadResultBinaryHeader(const void* data, size_t size, uint64_t file_size,
+                                   ResultBinaryHeader* header) {
+    if (size < sizeof(ResultBinaryHeader)) return false;
+    std::memcpy(header, data, sizeof(ResultBinaryHeader));
+    return header->magic == kResultBinaryMagic &&
+           header->version == kResultBinaryVersion &&
+           header->file_size == file_size &&
+           ResultBinaryRangeFits(header->summary_offset, header->summary_size, file_size) &&
+           ResultBinaryRangeFits(header->index_offset, header->index_size, file_size);
+}
+
+#endif  // RESULT_BINARY_FORMAT_H_
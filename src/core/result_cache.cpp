@@ -0,0 +1,115 @@
+// result_cache.cpp - LRU cache of opened result files implementation
+
+#include "result_cache.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <algorithm>
+
+ResultCache::ResultCache(size_t byte_limit)
+    : byte_limit_(byte_limit) {
+}
+
+bool ResultCache::Stat(const QString& path, qint64* size, qint64* modified) {
+    QFileInfo info(path);
+    if (!info.isFile()) return false;
+    *size = info.size();
+    *modified = info.lastModified().toMSecsSinceEpoch();
+    return true;
+}
+
+ResultSourcePtr ResultCache::Find(const QString& path) {
+    qint64 size = 0;
+    qint64 modified = 0;
+    const bool exists = Stat(path, &size, &modified);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (it->path != path) continue;
+        if (!exists || it->file_size != size || it->modified != modified) {
+            // Rewritten or removed since it was cached
+            entries_.erase(it);
+            return nullptr;
+        }
+        entries_.splice(entries_.begin(), entries_, it);
+        return entries_.front().source;
+    }
+    return nullptr;
+}
+
+ResultSourcePtr ResultCache::Open(const QString& path, QString* error, bool* hit,
+                                  const CancelCheck& cancelled,
+                                  const ResultSource::ScanProgressFn& progress) {
+    if (ResultSourcePtr cached = Find(path)) {
+        if (hit) *hit = true;
+        return cached;
+    }
+    if (hit) *hit = false;
+
+    Entry entry;
+    entry.path = path;
+    Stat(path, &entry.file_size, &entry.modified);
+    entry.source = ResultSource::Open(path, error, cancelled, progress);
+    if (!entry.source) return nullptr;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Opened concurrently by another thread (e.g. prefetch): keep the first copy
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (it->path == path && it->file_size == entry.file_size &&
+            it->modified == entry.modified) {
+            entries_.splice(entries_.begin(), entries_, it);
+            return entries_.front().source;
+        }
+    }
+    entry.source->SetCacheLimit(std::min(byte_limit_, ResultSource::kDefaultCacheLimit));
+    entries_.push_front(std::move(entry));
+    TrimLocked();
+    return entries_.front().source;
+}
+
+void ResultCache::Trim() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    TrimLocked();
+}
+
+void ResultCache::TrimLocked() {
+    size_t total = 0;
+    for (const auto& entry : entries_) total += entry.source->ByteSize();
+
+    // The most recent source stays; its own variable cache bounds it
+    while (total > byte_limit_ && entries_.size() > 1) {
+        total -= entries_.back().source->ByteSize();
+        entries_.pop_back();
+    }
+}
+
+void ResultCache::SetByteLimit(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    byte_limit_ = bytes;
+    for (auto& entry : entries_) {
+        entry.source->SetCacheLimit(std::min(byte_limit_, ResultSource::kDefaultCacheLimit));
+    }
+    TrimLocked();
+}
+
+size_t ResultCache::ByteLimit() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return byte_limit_;
+}
+
+size_t ResultCache::ByteSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t total = 0;
+    for (const auto& entry : entries_) total += entry.source->ByteSize();
+    return total;
+}
+
+int ResultCache::Count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(entries_.size());
+}
+
+void ResultCache::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+}
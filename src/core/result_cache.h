@@ -0,0 +1,67 @@
+// result_cache.h - LRU cache of opened result files
+// Keeps recently opened ResultSources (summary plus decoded variables) alive
+// across loads so switching back to a file skips the disk read and parse.
+// Entries are checked against the file size and modification time on every
+// lookup, and the cache is bounded by the bytes its sources hold.
+
+#ifndef RESULT_CACHE_H_
+#define RESULT_CACHE_H_
+
+#include <QString>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include "result_source.h"
+
+class ResultCache {
+public:
+    explicit ResultCache(size_t byte_limit = kDefaultByteLimit);
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    // Cached source for |path| if the file is unchanged, otherwise open the file
+    // and insert it. |hit| (optional) tells which case applied. Returns nullptr
+    // and sets |error| if the file cannot be opened or the open was cancelled;
+    // |cancelled| and |progress| are passed on to ResultSource::Open. Thread-safe;
+    // the file is opened without holding the lock.
+    ResultSourcePtr Open(const QString& path, QString* error, bool* hit = nullptr,
+                         const CancelCheck& cancelled = {},
+                         const ResultSource::ScanProgressFn& progress = {});
+
+    // Cached source for |path| if present and unchanged (never opens the file)
+    ResultSourcePtr Find(const QString& path);
+
+    // Re-apply the byte limit; call after variables were decoded into cached
+    // sources, since sources grow after insertion
+    void Trim();
+
+    void SetByteLimit(size_t bytes);
+    size_t ByteLimit() const;
+    size_t ByteSize() const;
+    int Count() const;
+    void Clear();
+
+    static constexpr size_t kDefaultByteLimit = 1024u * 1024 * 1024;
+
+private:
+    struct Entry {
+        QString path;
+        qint64 file_size = 0;
+        qint64 modified = 0;   // ms since epoch
+        ResultSourcePtr source;
+    };
+
+    static bool Stat(const QString& path, qint64* size, qint64* modified);
+    void TrimLocked();
+
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_;   // most recently used first
+    size_t byte_limit_;
+};
+
+using ResultCachePtr = std::shared_ptr<ResultCache>;
+
+#endif  // RESULT_CACHE_H_
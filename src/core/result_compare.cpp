@@ -0,0 +1,178 @@
+// result_compare.cpp - Multi-result comparison implementation
+
+#include "result_compare.h"
+#include "instance_cache.h"
+#include "result_metrics.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// |model| with metrics recomputed from its variables when the file had none
+ResultModelPtr WithDerivedMetrics(const ResultModelPtr& model, const QString& path) {
+    if (model->metrics.present || model->metrics.derived) return model;
+
+    MetricsInputs inputs;
+    inputs.x = model->FindVariable("X");
+    inputs.y = model->FindVariable("Y");
+    inputs.l = model->FindVariable("L");
+    inputs.i = model->FindVariable("I");
+    inputs.b = model->FindVariable("B");
+    inputs.u = model->FindVariable("U");
+
+    const QString instance_path = FindInstanceFile(model->summary.input_file, path);
+    InstanceDataPtr instance;
+    if (!instance_path.isEmpty()) instance = LoadInstanceCached(instance_path, nullptr);
+
+    auto derived = std::make_shared<ResultModel>(*model);
+    derived->metrics = DeriveMetrics(*model, inputs, instance.get(), MetricsParams());
+    return derived;
+}
+
+}  // namespace
+
+const VariableDiff* ResultDiff::FindVariable(const QString& name) const {
+    for (const auto& var : variables) {
+        if (var.name == name) return &var;
+    }
+    return nullptr;
+}
+
+VariableDiff DiffVariable(const ResultVariable& base, const ResultVariable& other) {
+    VariableDiff diff;
+    diff.name = base.name;
+    if (base.rows != other.rows || base.cols != other.cols) return diff;
+    diff.comparable = true;
+
+    // Bitsets: XOR + popcount per 64 cells
+    if (base.IsBinary() && other.IsBinary() && base.words_per_row == other.words_per_row) {
+        diff.binary = true;
+        size_t changed = 0;
+        long long added = 0;
+        for (size_t i = 0; i < base.bits.size(); ++i) {
+            uint64_t x = base.bits[i] ^ other.bits[i];
+            changed += PopCount64(x);
+            added += PopCount64(x & other.bits[i]);
+        }
+        diff.changed_cells = changed;
+        diff.sum_abs_delta = static_cast<double>(changed);
+        diff.sum_delta = static_cast<double>(2 * added - static_cast<long long>(changed));
+        diff.max_abs_delta = changed > 0 ? 1.0 : 0.0;
+        return diff;
+    }
+
+    std::vector<double> a(base.cols);
+    std::vector<double> b(base.cols);
+    for (int r = 0; r < base.rows; ++r) {
+        base.CopyRow(r, a.data());
+        other.CopyRow(r, b.data());
+        for (int c = 0; c < base.cols; ++c) {
+            double d = b[c] - a[c];
+            if (d == 0.0) continue;
+            ++diff.changed_cells;
+            diff.sum_delta += d;
+            diff.sum_abs_delta += std::fabs(d);
+            diff.max_abs_delta = std::max(diff.max_abs_delta, std::fabs(d));
+        }
+    }
+    return diff;
+}
+
+std::vector<float> AbsDeltaMatrix(const ResultVariable& base, const ResultVariable& other) {
+    std::vector<float> delta;
+    if (base.rows != other.rows || base.cols != other.cols) return delta;
+
+    delta.resize(base.CellCount());
+    std::vector<double> a(base.cols);
+    std::vector<double> b(base.cols);
+    for (int r = 0; r < base.rows; ++r) {
+        base.CopyRow(r, a.data());
+        other.CopyRow(r, b.data());
+        float* dst = delta.data() + static_cast<size_t>(r) * base.cols;
+        for (int c = 0; c < base.cols; ++c) {
+            dst[c] = static_cast<float>(std::fabs(b[c] - a[c]));
+        }
+    }
+    return delta;
+}
+
+bool LoadMissingModels(ComparisonSet* set, ResultCache* cache, int threads,
+                       const CancelCheck& cancelled) {
+    const size_t count = static_cast<size_t>(set->paths.size());
+    set->models.resize(count);
+
+    // Loaded models passed in may still lack metrics, so every slot is visited
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < count; ++i) {
+        const ResultModelPtr& model = set->models[i];
+        if (!model || (!model->metrics.present && !model->metrics.derived)) pending.push_back(i);
+    }
+
+    // Workers write distinct slots of pre-sized vectors; QStringList is only
+    // touched on this thread
+    std::vector<QString> errors(count);
+    bool done = RunParallel(pending.size(), threads, [&](size_t k) {
+        const size_t i = pending[k];
+        const QString& path = set->paths.at(static_cast<int>(i));
+        ResultModelPtr model = set->models[i];
+        if (!model) {
+            ResultSourcePtr source = cache ? cache->Open(path, &errors[i], nullptr, cancelled)
+                                           : ResultSource::Open(path, &errors[i], cancelled);
+            if (!source) return;
+            model = source->ReadModel(&errors[i]);
+            if (!model) return;
+        }
+        set->models[i] = WithDerivedMetrics(model, path);
+    }, cancelled);
+
+    set->errors.clear();
+    for (size_t i = 0; i < count; ++i) set->errors << errors[i];
+    return done;
+}
+
+bool DiffAgainstBaseline(ComparisonSet* set, int threads, const CancelCheck& cancelled) {
+    const size_t count = set->models.size();
+    set->diffs.assign(count, ResultDiff());
+    if (set->baseline < 0 || static_cast<size_t>(set->baseline) >= count) return true;
+    const ResultModelPtr base = set->models[set->baseline];
+    if (!base) return true;
+
+    // Scalar deltas inline, variable diffs as (result, variable) work items
+    struct Task {
+        size_t result;
+        size_t variable;
+    };
+    std::vector<Task> tasks;
+    for (size_t i = 0; i < count; ++i) {
+        const ResultModelPtr& model = set->models[i];
+        if (!model) continue;
+
+        ResultDiff& diff = set->diffs[i];
+        diff.objective_delta = model->summary.objective - base->summary.objective;
+        diff.total_time_delta = model->summary.total_time - base->summary.total_time;
+        diff.gap_delta = model->summary.gap - base->summary.gap;
+        diff.has_cost_deltas = (model->metrics.present || model->metrics.derived) &&
+                               (base->metrics.present || base->metrics.derived);
+        diff.cost_production_delta = model->metrics.cost_production - base->metrics.cost_production;
+        diff.cost_setup_delta = model->metrics.cost_setup - base->metrics.cost_setup;
+        diff.cost_inventory_delta = model->metrics.cost_inventory - base->metrics.cost_inventory;
+        diff.cost_backorder_delta = model->metrics.cost_backorder - base->metrics.cost_backorder;
+        diff.cost_unmet_delta = model->metrics.cost_unmet - base->metrics.cost_unmet;
+
+        diff.variables.resize(base->variables.size());
+        for (size_t v = 0; v < base->variables.size(); ++v) {
+            diff.variables[v].name = base->variables[v].name;
+            tasks.push_back({i, v});
+        }
+    }
+
+    return RunParallel(tasks.size(), threads, [&](size_t k) {
+        const Task& task = tasks[k];
+        const ResultVariable& base_var = base->variables[task.variable];
+        const ResultVariable* other = set->models[task.result]->FindVariable(base_var.name);
+        if (other) {
+            set->diffs[task.result].variables[task.variable] = DiffVariable(base_var, *other);
+        }
+    }, cancelled);
+}
@@ -0,0 +1,77 @@
+// result_compare.h - Multi-result comparison
+// Loads several result files in parallel and diffs each one against a baseline
+// (per-variable changed cells / deltas, Hamming distance for bitset Y/L)
+
+#ifndef RESULT_COMPARE_H_
+#define RESULT_COMPARE_H_
+
+#include <QMetaType>
+#include <QString>
+#include <QStringList>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "parallel.h"
+#include "result_cache.h"
+#include "result_model.h"
+
+// One variable of a result compared with the same variable of the baseline
+struct VariableDiff {
+    QString name;
+    bool comparable = false;    // present in both results with the same shape
+    bool binary = false;        // both bitsets: changed_cells is a Hamming distance
+    size_t changed_cells = 0;
+    double sum_delta = 0.0;     // sum(other - base)
+    double sum_abs_delta = 0.0;
+    double max_abs_delta = 0.0;
+};
+
+// One result compared with the baseline (all deltas are result - baseline)
+struct ResultDiff {
+    double objective_delta = 0.0;
+    double total_time_delta = 0.0;
+    double gap_delta = 0.0;
+    double cost_production_delta = 0.0;
+    double cost_setup_delta = 0.0;
+    double cost_inventory_delta = 0.0;
+    double cost_backorder_delta = 0.0;
+    double cost_unmet_delta = 0.0;
+    bool has_cost_deltas = false;         // both results carry (or derived) metrics
+    std::vector<VariableDiff> variables;  // in baseline variable order
+
+    const VariableDiff* FindVariable(const QString& name) const;
+};
+
+// A set of results under comparison. models[i] is nullptr if paths[i] failed to
+// load (errors[i] says why); diffs[i] is relative to models[baseline].
+struct ComparisonSet {
+    QStringList paths;
+    std::vector<ResultModelPtr> models;
+    QStringList errors;
+    int baseline = 0;
+    std::vector<ResultDiff> diffs;
+};
+
+using ComparisonPtr = std::shared_ptr<const ComparisonSet>;
+
+// Compare two variables cell by cell
+VariableDiff DiffVariable(const ResultVariable& base, const ResultVariable& other);
+
+// |other - base| per cell, row-major; empty if the shapes differ
+std::vector<float> AbsDeltaMatrix(const ResultVariable& base, const ResultVariable& other);
+
+// Fill models[i] for every nullptr entry by loading paths[i] through |cache|
+// (nullptr: open the files directly). Models without a "metrics" section get
+// them derived from their variables and instance, as the overview does. Files
+// are spread over |threads| workers (<= 0: hardware concurrency). Returns false
+// if cancelled.
+bool LoadMissingModels(ComparisonSet* set, ResultCache* cache, int threads,
+                       const CancelCheck& cancelled = {});
+
+// Diff every model against models[baseline]; (result, variable) pairs are the
+// unit of work. Returns false if cancelled.
+bool DiffAgainstBaseline(ComparisonSet* set, int threads, const CancelCheck& cancelled = {});
+
+Q_DECLARE_METATYPE(ComparisonPtr)
+
+#endif  // RESULT_COMPARE_H_
@@ -0,0 +1,156 @@
+// result_csv.cpp - CSV export of result variables implementation
+
+#include "result_csv.h"
+#include "parallel.h"
+#include "result_source.h"
+
+#include <QDir>
+#include <QSaveFile>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+constexpr size_t kCsvBufferSize = 1024 * 1024;
+// Longest shortest-round-trip double ("-2.2250738585072014e-308") plus a separator
+constexpr size_t kMaxCellChars = 32;
+
+// Formats cells into a fixed buffer and hands it to the file when nearly full
+class CsvWriter {
+public:
+    explicit CsvWriter(QIODevice* device)
+        : device_(device), buffer_(kCsvBufferSize), used_(0), ok_(true) {
+    }
+
+    void Text(const char* text, size_t size) {
+        if (used_ + size > buffer_.size()) Flush();
+        if (size > buffer_.size()) {
+            ok_ = ok_ && device_->write(text, static_cast<qint64>(size)) == static_cast<qint64>(size);
+            return;
+        }
+        std::copy(text, text + size, buffer_.data() + used_);
+        used_ += size;
+    }
+
+    void Char(char c) {
+        if (used_ == buffer_.size()) Flush();
+        buffer_[used_++] = c;
+    }
+
+    template <typename T>
+    void Number(T value) {
+        if (used_ + kMaxCellChars > buffer_.size()) Flush();
+        char* first = buffer_.data() + used_;
+        used_ = static_cast<size_t>(std::to_chars(first, buffer_.data() + buffer_.size(), value).ptr -
+                                    buffer_.data());
+    }
+
+    // ",0" repeated |count| times (runs of zero cells in sparse rows)
+    void Zeros(int count) {
+        for (; count > 0; --count) {
+            if (used_ + 2 > buffer_.size()) Flush();
+            buffer_[used_++] = ',';
+            buffer_[used_++] = '0';
+        }
+    }
+
+    bool Flush() {
+        if (used_ > 0) {
+            ok_ = ok_ && device_->write(buffer_.data(), static_cast<qint64>(used_)) ==
+                             static_cast<qint64>(used_);
+            used_ = 0;
+        }
+        return ok_;
+    }
+
+private:
+    QIODevice* device_;
+    std::vector<char> buffer_;
+    size_t used_;
+    bool ok_;
+};
+
+}  // namespace
+
+QString VariableRowPrefix(const QString& name) {
+    if (name == "Y" || name == "L") return "G";
+    if (name == "I") return "F";
+    return "i";
+}
+
+bool WriteVariableCsv(const ResultVariable& var, const QString& path, QString* error) {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        if (error) *error = QString::fromUtf8("无法创建文件: %1").arg(path);
+        return false;
+    }
+
+    CsvWriter writer(&file);
+    if (var.rank == 1) {
+        writer.Text(",value\n", 7);
+    } else {
+        for (int c = 0; c < var.cols; ++c) {
+            writer.Text(",t=", 3);
+            writer.Number(c + 1);
+        }
+        writer.Char('\n');
+    }
+
+    // Rows are produced from the nonzero cells; the gaps are filled with zeros
+    const QByteArray prefix = VariableRowPrefix(var.name).toUtf8();
+    for (int r = 0; r < var.rows; ++r) {
+        writer.Text(prefix.constData(), static_cast<size_t>(prefix.size()));
+        writer.Number(r + 1);
+        int next = 0;
+        var.ForEachNonzero(r, [&writer, &next](int c, double value) {
+            writer.Zeros(c - next);
+            writer.Char(',');
+            writer.Number(value);
+            next = c + 1;
+        });
+        writer.Zeros(var.cols - next);
+        writer.Char('\n');
+    }
+
+    if (!writer.Flush() || !file.commit()) {
+        if (error) *error = QString::fromUtf8("写入文件失败: %1").arg(path);
+        return false;
+    }
+    return true;
+}
+
+bool ExportVariablesCsv(const ResultSource& source, const QString& dir,
+                        const QString& file_prefix, int threads,
+                        QString* error, int* files) {
+    if (!QDir().mkpath(dir)) {
+        if (error) *error = QString::fromUtf8("无法创建目录: %1").arg(dir);
+        return false;
+    }
+
+    const QStringList names = source.VariableNames();
+    std::atomic<int> written(0);
+    std::mutex error_mutex;
+    QString first_error;
+    RunParallel(static_cast<size_t>(names.size()), threads, [&](size_t i) {
+        const int k = static_cast<int>(i);
+        QString var_error;
+        ResultVariablePtr var = source.Variable(names[k], &var_error, false);
+        const QString path = QDir(dir).filePath(file_prefix + names[k] + ".csv");
+        if (var && WriteVariableCsv(*var, path, &var_error)) {
+            ++written;
+            return;
+        }
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (first_error.isEmpty()) first_error = var_error;
+    });
+
+    if (files) *files = written.load();
+    if (!first_error.isEmpty()) {
+        if (error) *error = first_error;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,33 @@
+// result_csv.h - CSV export of result variables
+// Streams straight from the compact variable buffers: numbers are formatted with
+// std::to_chars (shortest text that reads back to the same double) into a large
+// buffer that is written in blocks, so no per-cell strings are built.
+//
+// Layout: a header row ",t=1,...,t=T" (",value" for 1D variables), then one row
+// per variable row labelled with its prefix ("G1", "F1", "i1", ...). Totals are
+// not written; they follow from the data.
+
+#ifndef RESULT_CSV_H_
+#define RESULT_CSV_H_
+
+#include <QString>
+#include "result_model.h"
+
+class ResultSource;
+
+// Row label prefix of |name| in tables and CSV files: G (groups) for Y/L,
+// F (flows) for I, i (orders) otherwise
+QString VariableRowPrefix(const QString& name);
+
+// Write |var| to |path| (atomically replaces the file)
+bool WriteVariableCsv(const ResultVariable& var, const QString& path, QString* error);
+
+// Write every variable of |source| into |dir| as <file_prefix><name>.csv, using
+// up to |threads| threads (one file each; 0 = hardware concurrency). Variables
+// are decoded without entering the source's cache. |files| receives the number
+// of files written.
+bool ExportVariablesCsv(const ResultSource& source, const QString& dir,
+                        const QString& file_prefix, int threads,
+                        QString* error, int* files = nullptr);
+
+#endif  // RESULT_CSV_H_
@@ -0,0 +1,359 @@
+// result_index.cpp - Results directory index implementation
+
+#include "result_index.h"
+#include "json_partial_reader.h"
+#include "result_binary_format.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr uint32_t kResultIndexMagic = 0x4952534C;  // "LSRI"
+constexpr uint32_t kResultIndexVersion = 1;
+constexpr size_t kProgressInterval = 64;
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+constexpr size_t kNpos = std::string_view::npos;
+
+// Fill entry fields from the raw "summary" / "problem" objects
+void ReadSummaryMembers(const PartialJsonReader& reader, ResultIndexEntry* entry) {
+    if (const std::string* summary = reader.Member("summary")) {
+        ForEachJsonMember(*summary, 0, [entry](std::string_view k, std::string_view v) {
+            if (k == "algorithm") entry->algorithm = JsonToText(v);
+            else if (k == "input_file") entry->input_file = JsonToText(v);
+            else if (k == "objective") entry->objective = JsonToDouble(v);
+            else if (k == "total_time") entry->wall_time = JsonToDouble(v);
+            else if (k == "cpu_time") entry->cpu_time = JsonToDouble(v);
+            else if (k == "gap") entry->gap = JsonToDouble(v);
+            return true;
+        });
+    }
+    if (const std::string* problem = reader.Member("problem")) {
+        ForEachJsonMember(*problem, 0, [entry](std::string_view k, std::string_view v) {
+            if (k == "N") entry->n = JsonToInt(v);
+            else if (k == "T") entry->t = JsonToInt(v);
+            else if (k == "F") entry->f = JsonToInt(v);
+            else if (k == "G") entry->g = JsonToInt(v);
+            return true;
+        });
+    }
+}
+
+std::vector<std::string_view> SplitCsv(std::string_view line) {
+    std::vector<std::string_view> fields;
+    size_t start = 0;
+    while (true) {
+        size_t comma = line.find(',', start);
+        fields.push_back(line.substr(start, comma == kNpos ? kNpos : comma - start));
+        if (comma == kNpos) break;
+        start = comma + 1;
+    }
+    return fields;
+}
+
+bool IsResultFileName(const std::string& name, ResultFileKind* kind) {
+    if (name.find("_result_") == std::string::npos) return false;
+    auto ends_with = [&name](const char* suffix, size_t len) {
+        return name.size() >= len && name.compare(name.size() - len, len, suffix) == 0;
+    };
+    if (ends_with(".json", 5)) {
+        *kind = ResultFileKind::Json;
+        return true;
+    }
+    if (ends_with(".csv", 4)) {
+        *kind = ResultFileKind::Csv;
+        return true;
+    }
+    if (ends_with(kResultBinarySuffix, 5)) {
+        *kind = ResultFileKind::Binary;
+        return true;
+    }
+    return false;
+}
+
+void ReadEntry(ResultIndexEntry* entry) {
+    const fs::path path = fs::u8path(entry->path);
+    switch (entry->kind) {
+        case ResultFileKind::Json:
+            entry->ok = ReadResultJsonHeader(entry->path, entry);
+            break;
+        case ResultFileKind::Binary:
+            entry->ok = ReadResultBinarySummary(entry->path, entry);
+            break;
+        default:
+            entry->ok = ReadResultCsv(entry->path, entry);
+            break;
+    }
+
+    // CSV results carry no problem size; solution_* folders encode it in their name
+    ParseSolutionDirName(path.parent_path().filename().u8string(), entry);
+}
+
+//---------------------------------------
+// Index file I/O
+//---------------------------------------
+
+template <typename T>
+void WritePod(std::ofstream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadPod(std::ifstream& in, T* value) {
+    in.read(reinterpret_cast<char*>(value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+void WriteString(std::ofstream& out, const std::string& s) {
+    WritePod<uint32_t>(out, static_cast<uint32_t>(s.size()));
+    out.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+bool ReadString(std::ifstream& in, std::string* s) {
+    uint32_t size = 0;
+    if (!ReadPod(in, &size)) return false;
+    s->resize(size);
+    if (size > 0) in.read(&(*s)[0], size);
+    return static_cast<bool>(in);
+}
+
+}  // namespace
+
+ResultIndexEntry::ResultIndexEntry()
+    : objective(kNaN)
+    , wall_time(kNaN)
+    , cpu_time(kNaN)
+    , gap(kNaN) {
+}
+
+bool ReadResultJsonHeaderBuffer(std::string_view text, ResultIndexEntry* entry) {
+    PartialJsonReader reader({"summary", "problem"});
+    reader.ReadBuffer(text);
+    ReadSummaryMembers(reader, entry);
+    return reader.Member("summary") != nullptr;
+}
+
+bool ReadResultJsonHeader(const std::string& path, ResultIndexEntry* entry) {
+    // Stops right after summary + problem (they precede "variables" in solver output)
+    PartialJsonReader reader({"summary", "problem"});
+    reader.ReadFile(path);
+    ReadSummaryMembers(reader, entry);
+    return reader.Member("summary") != nullptr;
+}
+
+bool ReadResultBinarySummary(const std::string& path, ResultIndexEntry* entry) {
+    std::ifstream in(fs::u8path(path), std::ios::binary);
+    if (!in) return false;
+
+    std::error_code ec;
+    const uint64_t file_size = static_cast<uint64_t>(fs::file_size(fs::u8path(path), ec));
+    char raw[sizeof(ResultBinaryHeader)];
+    in.read(raw, sizeof(raw));
+    ResultBinaryHeader header;
+    if (ec || !ReadResultBinaryHeader(raw, static_cast<size_t>(in.gcount()), file_size, &header)) {
+        return false;
+    }
+
+    // The summary block is the compact summary/problem/metrics JSON
+    std::string summary(static_cast<size_t>(header.summary_size), '\0');
+    in.seekg(static_cast<std::streamoff>(header.summary_offset));
+    in.read(&summary[0], static_cast<std::streamsize>(summary.size()));
+    if (!in) return false;
+    return ReadResultJsonHeaderBuffer(summary, entry);
+}
+
+bool ReadResultCsv(const std::string& path, ResultIndexEntry* entry) {
+    std::ifstream in(fs::u8path(path), std::ios::binary);
+    if (!in) return false;
+
+    std::string header;
+    std::string row;
+    if (!std::getline(in, header) || !std::getline(in, row)) return false;
+    if (!header.empty() && header.back() == '\r') header.pop_back();
+    if (!row.empty() && row.back() == '\r') row.pop_back();
+
+    std::vector<std::string_view> names = SplitCsv(header);
+    std::vector<std::string_view> values = SplitCsv(row);
+    bool found = false;
+    for (size_t i = 0; i < names.size() && i < values.size(); ++i) {
+        std::string_view name = names[i];
+        std::string_view value = values[i];
+        if (name == "Algorithm") {
+            entry->algorithm = std::string(value);
+            found = true;
+        } else if (name == "Objective") {
+            entry->objective = JsonToDouble(value);
+            found = true;
+        } else if (name == "WallTime(s)") {
+            entry->wall_time = JsonToDouble(value);
+        } else if (name == "CPUTime(s)") {
+            entry->cpu_time = JsonToDouble(value);
+        } else if (name == "Gap") {
+            entry->gap = JsonToDouble(value);
+        }
+    }
+    return found;
+}
+
+bool ParseSolutionDirName(std::string_view name, ResultIndexEntry* entry) {
+    constexpr std::string_view kPrefix = "solution_";
+    if (name.substr(0, kPrefix.size()) != kPrefix) return false;
+    name.remove_prefix(kPrefix.size());
+
+    size_t sep = name.find('_');
+    if (sep == kNpos) return false;
+    if (entry->algorithm.empty()) entry->algorithm = std::string(name.substr(0, sep));
+
+    // N300T30G5F5: letter followed by digits, any order
+    std::string_view sizes = name.substr(sep + 1);
+    sizes = sizes.substr(0, sizes.find('_'));
+    for (size_t i = 0; i < sizes.size();) {
+        const char letter = sizes[i++];
+        int value = 0;
+        auto result = std::from_chars(sizes.data() + i, sizes.data() + sizes.size(), value);
+        if (result.ptr == sizes.data() + i) return false;
+        i = static_cast<size_t>(result.ptr - sizes.data());
+
+        int* target = letter == 'N' ? &entry->n : letter == 'T' ? &entry->t :
+                      letter == 'G' ? &entry->g : letter == 'F' ? &entry->f : nullptr;
+        if (target && *target == 0) *target = value;
+    }
+    return true;
+}
+
+bool ResultIndex::Load(const std::string& path) {
+    entries_.clear();
+    std::ifstream in(fs::u8path(path), std::ios::binary);
+    if (!in) return false;
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t count = 0;
+    if (!ReadPod(in, &magic) || !ReadPod(in, &version) || !ReadPod(in, &count) ||
+        magic != kResultIndexMagic || version != kResultIndexVersion) {
+        return false;
+    }
+
+    std::vector<ResultIndexEntry> entries(count);
+    for (auto& e : entries) {
+        uint8_t kind = 0;
+        uint8_t ok = 0;
+        bool good = ReadString(in, &e.path) && ReadPod(in, &e.mtime) && ReadPod(in, &e.size) &&
+                    ReadPod(in, &kind) && ReadPod(in, &ok) &&
+                    ReadString(in, &e.algorithm) && ReadString(in, &e.input_file) &&
+                    ReadPod(in, &e.n) && ReadPod(in, &e.t) && ReadPod(in, &e.f) &&
+                    ReadPod(in, &e.g) && ReadPod(in, &e.objective) &&
+                    ReadPod(in, &e.wall_time) && ReadPod(in, &e.cpu_time) && ReadPod(in, &e.gap);
+        if (!good) return false;
+        e.kind = static_cast<ResultFileKind>(kind);
+        e.ok = ok != 0;
+    }
+    entries_ = std::move(entries);
+    std::sort(entries_.begin(), entries_.end(),
+              [](const ResultIndexEntry& a, const ResultIndexEntry& b) { return a.path < b.path; });
+    return true;
+}
+
+bool ResultIndex::Save(const std::string& path) const {
+    std::ofstream out(fs::u8path(path), std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    WritePod<uint32_t>(out, kResultIndexMagic);
+    WritePod<uint32_t>(out, kResultIndexVersion);
+    WritePod<uint32_t>(out, static_cast<uint32_t>(entries_.size()));
+    for (const auto& e : entries_) {
+        WriteString(out, e.path);
+        WritePod(out, e.mtime);
+        WritePod(out, e.size);
+        WritePod<uint8_t>(out, static_cast<uint8_t>(e.kind));
+        WritePod<uint8_t>(out, e.ok ? 1 : 0);
+        WriteString(out, e.algorithm);
+        WriteString(out, e.input_file);
+        WritePod(out, e.n);
+        WritePod(out, e.t);
+        WritePod(out, e.f);
+        WritePod(out, e.g);
+        WritePod(out, e.objective);
+        WritePod(out, e.wall_time);
+        WritePod(out, e.cpu_time);
+        WritePod(out, e.gap);
+    }
+    return static_cast<bool>(out);
+}
+
+ResultScanStats ResultIndex::Scan(const std::string& root, int threads,
+                                  const CancelCheck& cancelled, const ProgressFn& progress) {
+    ResultScanStats stats;
+
+    // Walk the tree; directory entries carry mtime/size without opening files
+    std::vector<ResultIndexEntry> found;
+    std::error_code ec;
+    fs::recursive_directory_iterator it(fs::u8path(root),
+                                        fs::directory_options::skip_permission_denied, ec);
+    for (; !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        if (cancelled && cancelled()) {
+            stats.cancelled = true;
+            return stats;
+        }
+        std::error_code entry_ec;
+        if (!it->is_regular_file(entry_ec)) continue;
+
+        ResultFileKind kind;
+        if (!IsResultFileName(it->path().filename().u8string(), &kind)) continue;
+
+        ResultIndexEntry entry;
+        entry.path = it->path().u8string();
+        entry.kind = kind;
+        entry.mtime = static_cast<int64_t>(it->last_write_time(entry_ec).time_since_epoch().count());
+        entry.size = static_cast<uint64_t>(it->file_size(entry_ec));
+        found.push_back(std::move(entry));
+    }
+    std::sort(found.begin(), found.end(),
+              [](const ResultIndexEntry& a, const ResultIndexEntry& b) { return a.path < b.path; });
+    stats.files = found.size();
+
+    // Reuse unchanged entries (both lists are sorted by path)
+    std::vector<size_t> pending;
+    auto old = entries_.begin();
+    for (size_t i = 0; i < found.size(); ++i) {
+        ResultIndexEntry& entry = found[i];
+        old = std::lower_bound(old, entries_.end(), entry.path,
+                               [](const ResultIndexEntry& e, const std::string& p) { return e.path < p; });
+        if (old != entries_.end() && old->path == entry.path &&
+            old->mtime == entry.mtime && old->size == entry.size) {
+            entry = *old;
+            ++stats.reused;
+        } else {
+            pending.push_back(i);
+        }
+    }
+
+    // Read changed files on a worker pool
+    const size_t count = pending.size();
+    std::atomic<size_t> done(0);
+    const bool complete = RunParallel(count, threads, [&](size_t k) {
+        ReadEntry(&found[pending[k]]);
+        size_t finished = ++done;
+        if (progress && (finished % kProgressInterval == 0 || finished == count)) {
+            progress(finished, count);
+        }
+    }, cancelled);
+
+    if (!complete) {
+        stats.cancelled = true;
+        return stats;
+    }
+
+    stats.parsed = count;
+    for (size_t i : pending) {
+        if (!found[i].ok) ++stats.failed;
+    }
+    entries_ = std::move(found);
+    return stats;
+}
@@ -0,0 +1,89 @@
+// result_index.h - Results directory index
+// Scans a results tree for solver outputs (*_result_*.json / .csv / .lsrb),
+// reads only their summary/problem fields and keeps them in a persistent index
+// keyed by path + mtime + size so rescans only touch changed files
+
+#ifndef RESULT_INDEX_H_
+#define RESULT_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "parallel.h"
+
+enum class ResultFileKind : uint8_t {
+    Json = 1,
+    Csv = 2,
+    Binary = 3,    // .lsrb, see result_binary_format.h
+};
+
+// Summary of one result file. Unknown numbers stay NaN, unknown sizes stay 0.
+struct ResultIndexEntry {
+    std::string path;        // UTF-8
+    int64_t mtime = 0;       // filesystem clock ticks
+    uint64_t size = 0;
+    ResultFileKind kind = ResultFileKind::Json;
+    bool ok = false;         // summary fields could be read
+
+    std::string algorithm;
+    std::string input_file;
+    int n = 0;
+    int t = 0;
+    int f = 0;
+    int g = 0;
+    double objective;
+    double wall_time;
+    double cpu_time;
+    double gap;
+
+    ResultIndexEntry();
+};
+
+struct ResultScanStats {
+    size_t files = 0;        // result files found
+    size_t reused = 0;       // taken from the index unchanged
+    size_t parsed = 0;       // (re)read from disk
+    size_t failed = 0;       // could not be read
+    bool cancelled = false;
+};
+
+// Read "summary" and "problem" of a result JSON without parsing the rest (see
+// PartialJsonReader): scanning stops as soon as both keys have been seen.
+bool ReadResultJsonHeader(const std::string& path, ResultIndexEntry* entry);
+bool ReadResultJsonHeaderBuffer(std::string_view text, ResultIndexEntry* entry);
+
+// Read the summary block of a binary result file
+bool ReadResultBinarySummary(const std::string& path, ResultIndexEntry* entry);
+
+// Read the single row of a result CSV (Algorithm,Objective,WallTime(s),CPUTime(s),Gap)
+bool ReadResultCsv(const std::string& path, ResultIndexEntry* entry);
+
+// solution_<ALGO>_N<n>T<t>G<g>F<f>_<difficulty>_<date>_<time> -> algorithm, N/T/G/F
+bool ParseSolutionDirName(std::string_view name, ResultIndexEntry* entry);
+
+class ResultIndex {
+public:
+    using ProgressFn = std::function<void(size_t done, size_t total)>;
+
+    // Persistent index (binary, see result_index.cpp). Load() of a missing or
+    // outdated file leaves the index empty and returns false.
+    bool Load(const std::string& path);
+    bool Save(const std::string& path) const;
+
+    // Rescan |root| recursively. Unchanged files are taken from the current
+    // entries, everything else is read on |threads| workers (<= 0: hardware
+    // concurrency). Entries of files that disappeared are dropped.
+    ResultScanStats Scan(const std::string& root, int threads,
+                         const CancelCheck& cancelled = {}, const ProgressFn& progress = {});
+
+    const std::vector<ResultIndexEntry>& Entries() const { return entries_; }
+    void Clear() { entries_.clear(); }
+
+private:
+    std::vector<ResultIndexEntry> entries_;  // sorted by path
+};
+
+#endif  // RESULT_INDEX_H_
@@ -0,0 +1,155 @@
+// result_metrics.cpp - Metrics derived from the decision variables implementation
+
+#include "result_metrics.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+// Capacity when neither the result, the instance nor the caller states one
+constexpr double kDefaultCapacity = 1440.0;
+
+// Row sum of a dense row with four independent accumulators, so the loop
+// vectorizes without reassociating a single floating-point chain
+double DenseRowSum(const double* p, int n) {
+    double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    int c = 0;
+    for (; c + 4 <= n; c += 4) {
+        s0 += p[c];
+        s1 += p[c + 1];
+        s2 += p[c + 2];
+        s3 += p[c + 3];
+    }
+    for (; c < n; ++c) s0 += p[c];
+    return (s0 + s1) + (s2 + s3);
+}
+
+double RowSum(const ResultVariable& var, int row) {
+    switch (var.storage) {
+        case ResultVariable::Storage::Bitset:
+            return static_cast<double>(var.RowNonzeroCount(row));
+        case ResultVariable::Storage::Sparse: {
+            const uint32_t first = var.row_ptr[row];
+            return DenseRowSum(var.values.data() + first,
+                               static_cast<int>(var.row_ptr[row + 1] - first));
+        }
+        default:
+            return DenseRowSum(var.dense.data() + static_cast<size_t>(row) * var.cols, var.cols);
+    }
+}
+
+// One weight per row of |var|: the per-entity column if it matches the row
+// count, its mean if it does not (e.g. merged orders), else |fallback|
+std::vector<double> RowWeights(const std::vector<double>& per_entity, int rows, double fallback) {
+    if (per_entity.size() == static_cast<size_t>(rows)) return per_entity;
+    double weight = fallback;
+    if (!per_entity.empty()) {
+        weight = std::accumulate(per_entity.begin(), per_entity.end(), 0.0) /
+                 static_cast<double>(per_entity.size());
+    }
+    return std::vector<double>(static_cast<size_t>(rows), weight);
+}
+
+const std::vector<double>& Column(const InstanceData* instance,
+                                  std::vector<double> InstanceData::*column) {
+    static const std::vector<double> kEmpty;
+    return instance ? instance->*column : kEmpty;
+}
+
+}  // namespace
+
+double WeightedSum(const ResultVariable& var, const std::vector<double>& weights) {
+    double total = 0.0;
+    for (int r = 0; r < var.rows; ++r) {
+        if (weights[r] != 0.0) total += weights[r] * RowSum(var, r);
+    }
+    return total;
+}
+
+void AddWeightedColumnSums(const ResultVariable& var, const std::vector<double>& weights,
+                           double* out) {
+    for (int r = 0; r < var.rows; ++r) {
+        const double w = weights[r];
+        if (w == 0.0) continue;
+        if (var.storage == ResultVariable::Storage::Dense) {
+            // out += w * row: contiguous, no dependency between columns
+            const double* row = var.dense.data() + static_cast<size_t>(r) * var.cols;
+            for (int c = 0; c < var.cols; ++c) out[c] += w * row[c];
+        } else {
+            var.ForEachNonzero(r, [out, w](int c, double v) { out[c] += w * v; });
+        }
+    }
+}
+
+ResultMetrics DeriveMetrics(const ResultModel& summary, const MetricsInputs& inputs,
+                            const InstanceData* instance, const MetricsParams& params) {
+    ResultMetrics metrics;
+    metrics.algorithm_specific = summary.metrics.algorithm_specific;
+    metrics.derived = true;
+
+    // Setup / carryover
+    if (inputs.y) metrics.total_setups = static_cast<int>(inputs.y->NonzeroCount());
+    if (inputs.l) metrics.total_carryovers = static_cast<int>(inputs.l->NonzeroCount());
+
+    // Capacity utilization: processing plus setup time with X, setup time alone
+    // without it (Y and the instance setup times), otherwise unavailable
+    double capacity = params.capacity;
+    if (capacity <= 0.0) capacity = summary.problem.capacity;
+    if (capacity <= 0.0 && instance) capacity = instance->capacity;
+    if (capacity <= 0.0) capacity = kDefaultCapacity;
+
+    const bool has_x = inputs.x && inputs.x->rank == 2;
+    const bool has_setup = inputs.y && inputs.y->rank == 2 && instance &&
+                           !instance->setup_time.empty();
+    if (has_x || has_setup) {
+        const int periods = has_x ? inputs.x->cols : inputs.y->cols;
+        std::vector<double> usage(static_cast<size_t>(periods), 0.0);
+        if (has_x) {
+            AddWeightedColumnSums(*inputs.x,
+                                  RowWeights(Column(instance, &InstanceData::unit_time),
+                                             inputs.x->rows, 1.0),
+                                  usage.data());
+        }
+        if (has_setup && inputs.y->cols == periods) {
+            AddWeightedColumnSums(*inputs.y,
+                                  RowWeights(instance->setup_time, inputs.y->rows, 0.0),
+                                  usage.data());
+        }
+        metrics.utilization_basis = has_x ? UtilizationBasis::Full : UtilizationBasis::SetupOnly;
+
+        metrics.utilization_by_period.reserve(periods);
+        double total = 0.0;
+        for (double u : usage) {
+            const double ratio = u / capacity;
+            metrics.utilization_by_period.append(ratio);
+            total += ratio;
+            metrics.max_utilization = std::max(metrics.max_utilization, ratio);
+        }
+        metrics.avg_utilization = periods > 0 ? total / periods : 0.0;
+    }
+
+    // Cost breakdown
+    if (inputs.x) {
+        metrics.cost_production = WeightedSum(
+            *inputs.x, RowWeights(Column(instance, &InstanceData::unit_cost), inputs.x->rows, 0.0));
+    }
+    if (inputs.y) {
+        metrics.cost_setup = WeightedSum(
+            *inputs.y, RowWeights(Column(instance, &InstanceData::setup_cost), inputs.y->rows, 0.0));
+    }
+    if (inputs.i) {
+        metrics.cost_inventory = WeightedSum(
+            *inputs.i,
+            RowWeights(Column(instance, &InstanceData::holding_cost), inputs.i->rows, 0.0));
+    }
+    if (inputs.b) {
+        metrics.cost_backorder = params.backorder_penalty * WeightedSum(
+            *inputs.b, std::vector<double>(static_cast<size_t>(inputs.b->rows), 1.0));
+    }
+    if (inputs.u) {
+        metrics.cost_unmet = params.unmet_penalty * WeightedSum(
+            *inputs.u, std::vector<double>(static_cast<size_t>(inputs.u->rows), 1.0));
+    }
+    return metrics;
+}
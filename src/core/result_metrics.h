@@ -0,0 +1,52 @@
+// result_metrics.h - Metrics derived from the decision variables
+// Result files written without a "metrics" section (e.g. plain RF runs) only
+// carry summary, problem and variables. This recomputes what the overview and
+// capacity panels show from the variables and, when available, the instance:
+//   setups / carryovers  popcount of Y / L
+//   utilization[t]       (sum_i unit_time_i X[i][t] + sum_g setup_time_g Y[g][t]) / capacity;
+//                        without X only the setup term (needs the instance),
+//                        without either it is marked unavailable
+//   costs                production, setup, inventory from instance cost columns,
+//                        backorder / unmet from the solver penalties
+// All reductions run over whole rows of the compact buffers: dense rows with
+// independent accumulators, CSR and bitset rows over their nonzeros only.
+
+#ifndef RESULT_METRICS_H_
+#define RESULT_METRICS_H_
+
+#include <vector>
+#include "instance_data.h"
+#include "result_model.h"
+
+// Solver settings that are not part of the result (GUI defaults)
+struct MetricsParams {
+    double capacity = 0.0;              // 0: take it from the result or instance
+    double unmet_penalty = 10000.0;
+    double backorder_penalty = 100.0;
+};
+
+// Variables to derive from; any of them may be missing
+struct MetricsInputs {
+    const ResultVariable* x = nullptr;
+    const ResultVariable* y = nullptr;
+    const ResultVariable* l = nullptr;
+    const ResultVariable* i = nullptr;
+    const ResultVariable* b = nullptr;
+    const ResultVariable* u = nullptr;
+};
+
+// Metrics of |summary| recomputed from |inputs|. |instance| may be nullptr, in
+// which case unit times default to 1 and instance costs to 0. Per-order weights
+// are applied only if X has one row per instance order; merged results fall
+// back to the mean over the instance orders.
+ResultMetrics DeriveMetrics(const ResultModel& summary, const MetricsInputs& inputs,
+                            const InstanceData* instance, const MetricsParams& params);
+
+// Sum of |var| weighted by row: sum_r weights[r] * sum_c var[r][c]
+double WeightedSum(const ResultVariable& var, const std::vector<double>& weights);
+
+// Column sums weighted by row, added into |out| (var.cols entries)
+void AddWeightedColumnSums(const ResultVariable& var, const std::vector<double>& weights,
+                           double* out);
+
+#endif  // RESULT_METRICS_H_
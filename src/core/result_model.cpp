@@ -0,0 +1,377 @@
+// result_model.cpp - Immutable result model implementation
+
+#include "result_model.h"
+#include "result_binary.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QJsonValue>
+#include <algorithm>
+
+namespace {
+
+// Variables that are binary in the LS-NTGF model
+bool IsBinaryName(const QString& name) {
+    return name == "Y" || name == "L";
+}
+
+void ReadSections(const QJsonObject& json, ResultModel* model) {
+    QJsonObject summary = json["summary"].toObject();
+    model->summary.algorithm = summary["algorithm"].toString();
+    model->summary.input_file = summary["input_file"].toString();
+    model->summary.objective = summary["objective"].toDouble();
+    model->summary.total_time = summary["total_time"].toDouble();
+    model->summary.solve_time = summary["solve_time"].toDouble();
+    model->summary.gap = summary["gap"].toDouble();
+    model->summary.unmet_count = summary["unmet_count"].toInt();
+
+    QJsonObject problem = json["problem"].toObject();
+    model->problem.n = problem["N"].toInt();
+    model->problem.t = problem["T"].toInt();
+    model->problem.f = problem["F"].toInt();
+    model->problem.g = problem["G"].toInt();
+    model->problem.capacity = problem["capacity"].toInt();
+
+    QJsonObject metrics = json["metrics"].toObject();
+    model->metrics.present = json.contains("metrics");
+    QJsonObject cost = metrics["cost"].toObject();
+    model->metrics.cost_production = cost["production"].toDouble();
+    model->metrics.cost_setup = cost["setup"].toDouble();
+    model->metrics.cost_inventory = cost["inventory"].toDouble();
+    model->metrics.cost_backorder = cost["backorder"].toDouble();
+    model->metrics.cost_unmet = cost["unmet"].toDouble();
+
+    QJsonObject capacity = metrics["capacity"].toObject();
+    model->metrics.avg_utilization = capacity["avg_utilization"].toDouble();
+    model->metrics.max_utilization = capacity["max_utilization"].toDouble();
+    QJsonArray by_period = capacity["by_period"].toArray();
+    model->metrics.utilization_by_period.reserve(by_period.size());
+    for (const QJsonValue& v : by_period) {
+        model->metrics.utilization_by_period.append(v.toDouble());
+    }
+    if (!model->metrics.utilization_by_period.isEmpty()) {
+        model->metrics.utilization_basis = UtilizationBasis::Full;
+    }
+
+    QJsonObject setup_carryover = metrics["setup_carryover"].toObject();
+    model->metrics.total_setups = setup_carryover["total_setups"].toInt();
+    model->metrics.total_carryovers = setup_carryover["total_carryovers"].toInt();
+
+    model->metrics.algorithm_specific = metrics["algorithm_specific"].toObject();
+}
+
+}  // namespace
+
+int ResultVariable::RowNonzeroCount(int row) const {
+    switch (storage) {
+        case Storage::Bitset: {
+            const uint64_t* words = bits.data() + static_cast<size_t>(row) * words_per_row;
+            int count = 0;
+            for (int w = 0; w < words_per_row; ++w) count += PopCount64(words[w]);
+            return count;
+        }
+        case Storage::Sparse:
+            return static_cast<int>(row_ptr[row + 1] - row_ptr[row]);
+        default: {
+            const double* p = dense.data() + static_cast<size_t>(row) * cols;
+            return static_cast<int>(cols - std::count(p, p + cols, 0.0));
+        }
+    }
+}
+
+size_t ResultVariable::NonzeroCount() const {
+    switch (storage) {
+        case Storage::Bitset: {
+            size_t count = 0;
+            for (uint64_t word : bits) count += PopCount64(word);
+            return count;
+        }
+        case Storage::Sparse:
+            return values.size();
+        default:
+            return dense.size() - std::count(dense.begin(), dense.end(), 0.0);
+    }
+}
+
+void ResultVariable::CopyRow(int row, double* out) const {
+    if (storage == Storage::Dense) {
+        const double* p = dense.data() + static_cast<size_t>(row) * cols;
+        std::copy(p, p + cols, out);
+        return;
+    }
+    std::fill(out, out + cols, 0.0);
+    ForEachNonzero(row, [out](int c, double v) { out[c] = v; });
+}
+
+size_t ResultVariable::ByteSize() const {
+    return dense.capacity() * sizeof(double)
+        + row_ptr.capacity() * sizeof(uint32_t)
+        + col_idx.capacity() * sizeof(uint32_t)
+        + values.capacity() * sizeof(double)
+        + bits.capacity() * sizeof(uint64_t);
+}
+
+namespace {
+
+// CSR -> one bit per cell (all stored values are 1)
+void SparseToBitset(ResultVariable* var) {
+    var->words_per_row = (var->cols + 63) / 64;
+    var->bits.assign(static_cast<size_t>(var->rows) * var->words_per_row, 0);
+    for (int r = 0; r < var->rows; ++r) {
+        uint64_t* words = var->bits.data() + static_cast<size_t>(r) * var->words_per_row;
+        for (uint32_t k = var->row_ptr[r]; k < var->row_ptr[r + 1]; ++k) {
+            uint32_t c = var->col_idx[k];
+            words[c >> 6] |= uint64_t(1) << (c & 63);
+        }
+    }
+    std::vector<uint32_t>().swap(var->row_ptr);
+    std::vector<uint32_t>().swap(var->col_idx);
+    std::vector<double>().swap(var->values);
+    var->storage = ResultVariable::Storage::Bitset;
+}
+
+// CSR -> row-major float64
+void SparseToDense(ResultVariable* var) {
+    var->dense.assign(var->CellCount(), 0.0);
+    for (int r = 0; r < var->rows; ++r) {
+        double* dst = var->dense.data() + static_cast<size_t>(r) * var->cols;
+        for (uint32_t k = var->row_ptr[r]; k < var->row_ptr[r + 1]; ++k) {
+            dst[var->col_idx[k]] = var->values[k];
+        }
+    }
+    std::vector<uint32_t>().swap(var->row_ptr);
+    std::vector<uint32_t>().swap(var->col_idx);
+    std::vector<double>().swap(var->values);
+    var->storage = ResultVariable::Storage::Dense;
+}
+
+// Pick the final layout of a variable decoded into CSR from its observed density
+void FinishStorage(ResultVariable* var, bool all_binary) {
+    if (IsBinaryName(var->name) && all_binary) {
+        SparseToBitset(var);
+    } else if (var->values.size() * 2 > var->CellCount()) {
+        // CSR costs 12 bytes per nonzero vs 8 per cell, so dense wins above ~50%
+        SparseToDense(var);
+    } else {
+        var->col_idx.shrink_to_fit();
+        var->values.shrink_to_fit();
+    }
+}
+
+// Row-major array -> CSR -> final layout (same rules as the JSON path)
+template <typename T>
+ResultVariable DenseToVariable(const QString& name, const QString& description,
+                               int rank, int rows, int cols, const T* data) {
+    ResultVariable var;
+    var.name = name;
+    var.description = description;
+    var.rank = rank;
+    var.rows = rows;
+    var.cols = cols;
+    var.storage = ResultVariable::Storage::Sparse;
+
+    // Count first so the CSR arrays are allocated exactly once
+    const size_t cells = var.CellCount();
+    size_t nonzeros = 0;
+    for (size_t i = 0; i < cells; ++i) nonzeros += data[i] != T(0);
+    if (!IsBinaryName(name) && nonzeros * 2 > cells) {
+        var.dense.assign(data, data + cells);
+        var.storage = ResultVariable::Storage::Dense;
+        return var;
+    }
+    var.row_ptr.reserve(static_cast<size_t>(rows) + 1);
+    var.col_idx.reserve(nonzeros);
+    var.values.reserve(nonzeros);
+
+    bool all_binary = true;
+    var.row_ptr.push_back(0);
+    for (int r = 0; r < rows; ++r) {
+        const T* row = data + static_cast<size_t>(r) * cols;
+        for (int c = 0; c < cols; ++c) {
+            if (row[c] == T(0)) continue;
+            var.col_idx.push_back(static_cast<uint32_t>(c));
+            var.values.push_back(static_cast<double>(row[c]));
+            all_binary = all_binary && row[c] == T(1);
+        }
+        var.row_ptr.push_back(static_cast<uint32_t>(var.values.size()));
+    }
+    FinishStorage(&var, all_binary);
+    return var;
+}
+
+}  // namespace
+
+ResultVariable ResultModel::VariableFromJson(const QString& name, const QJsonObject& var_obj) {
+    ResultVariable var;
+    var.name = name;
+    var.description = var_obj["description"].toString();
+
+    QJsonArray dims = var_obj["dimensions"].toArray();
+    QJsonArray data = var_obj["data"].toArray();
+    var.rank = dims.size() == 1 ? 1 : 2;
+    var.rows = dims.size() >= 1 ? dims[0].toInt() : 0;
+    var.cols = dims.size() >= 2 ? dims[1].toInt() : 1;
+    if (dims.size() == 0 || dims.size() > 2 || var.rows < 0 || var.cols < 0) {
+        var.rows = 0;
+        var.cols = 0;
+        var.row_ptr.assign(1, 0);
+        var.storage = ResultVariable::Storage::Sparse;
+        return var;
+    }
+
+    // Decode straight into CSR (solutions are mostly zero), then pick the final
+    // layout from the observed density; missing cells stay zero
+    bool all_binary = true;
+    var.storage = ResultVariable::Storage::Sparse;
+    var.row_ptr.reserve(static_cast<size_t>(var.rows) + 1);
+    var.row_ptr.push_back(0);
+    auto push = [&var, &all_binary](int c, double v) {
+        if (v == 0.0) return;
+        var.col_idx.push_back(static_cast<uint32_t>(c));
+        var.values.push_back(v);
+        all_binary = all_binary && v == 1.0;
+    };
+    const int data_rows = qMin(var.rows, static_cast<int>(data.size()));
+    for (int r = 0; r < var.rows; ++r) {
+        if (r < data_rows) {
+            if (var.rank == 2) {
+                QJsonArray row_arr = data[r].toArray();
+                const int cols = qMin(var.cols, static_cast<int>(row_arr.size()));
+                for (int c = 0; c < cols; ++c) push(c, row_arr[c].toDouble());
+            } else {
+                push(0, data[r].toDouble());
+            }
+        }
+        var.row_ptr.push_back(static_cast<uint32_t>(var.values.size()));
+    }
+
+    FinishStorage(&var, all_binary);
+    return var;
+}
+
+ResultVariable ResultModel::VariableFromDense(const QString& name, const QString& description,
+                                              int rank, int rows, int cols, const double* data) {
+    return DenseToVariable(name, description, rank, rows, cols, data);
+}
+
+ResultVariable ResultModel::VariableFromDense(const QString& name, const QString& description,
+                                              int rank, int rows, int cols, const float* data) {
+    return DenseToVariable(name, description, rank, rows, cols, data);
+}
+
+QJsonObject ResultModel::SectionsToJson() const {
+    QJsonObject summary_obj;
+    summary_obj["algorithm"] = summary.algorithm;
+    summary_obj["input_file"] = summary.input_file;
+    summary_obj["objective"] = summary.objective;
+    summary_obj["total_time"] = summary.total_time;
+    summary_obj["solve_time"] = summary.solve_time;
+    summary_obj["gap"] = summary.gap;
+    summary_obj["unmet_count"] = summary.unmet_count;
+
+    QJsonObject problem_obj;
+    problem_obj["N"] = problem.n;
+    problem_obj["T"] = problem.t;
+    problem_obj["F"] = problem.f;
+    problem_obj["G"] = problem.g;
+    problem_obj["capacity"] = problem.capacity;
+
+    QJsonObject cost;
+    cost["production"] = metrics.cost_production;
+    cost["setup"] = metrics.cost_setup;
+    cost["inventory"] = metrics.cost_inventory;
+    cost["backorder"] = metrics.cost_backorder;
+    cost["unmet"] = metrics.cost_unmet;
+
+    QJsonArray by_period;
+    for (double v : metrics.utilization_by_period) by_period.append(v);
+    QJsonObject capacity;
+    capacity["avg_utilization"] = metrics.avg_utilization;
+    capacity["max_utilization"] = metrics.max_utilization;
+    capacity["by_period"] = by_period;
+
+    QJsonObject setup_carryover;
+    setup_carryover["total_setups"] = metrics.total_setups;
+    setup_carryover["total_carryovers"] = metrics.total_carryovers;
+
+    QJsonObject metrics_obj;
+    metrics_obj["cost"] = cost;
+    metrics_obj["capacity"] = capacity;
+    metrics_obj["setup_carryover"] = setup_carryover;
+    metrics_obj["algorithm_specific"] = metrics.algorithm_specific;
+
+    QJsonObject json;
+    json["summary"] = summary_obj;
+    json["problem"] = problem_obj;
+    if (metrics.present) json["metrics"] = metrics_obj;
+    return json;
+}
+
+std::shared_ptr<const ResultModel> ResultModel::SummaryFromJson(const QJsonObject& json) {
+    auto model = std::make_shared<ResultModel>();
+    ReadSections(json, model.get());
+    return model;
+}
+
+std::shared_ptr<const ResultModel> ResultModel::FromJson(const QJsonObject& json) {
+    auto model = std::make_shared<ResultModel>();
+    ReadSections(json, model.get());
+
+    QJsonObject variables = json["variables"].toObject();
+    model->variables.reserve(variables.size());
+    for (auto it = variables.begin(); it != variables.end(); ++it) {
+        model->variables.push_back(VariableFromJson(it.key(), it.value().toObject()));
+    }
+    return model;
+}
+
+std::shared_ptr<const ResultModel> ResultModel::FromFile(const QString& path, QString* error) {
+    if (ResultBinaryFile::IsBinaryResult(path)) {
+        ResultBinaryFile binary;
+        return binary.Open(path, error) ? binary.ReadModel() : nullptr;
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (error) *error = QString::fromUtf8("无法打开文件: %1").arg(path);
+        return nullptr;
+    }
+
+    QJsonParseError parse_error;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parse_error);
+    file.close();
+    if (parse_error.error != QJsonParseError::NoError) {
+        if (error) {
+            *error = QString::fromUtf8("JSON 解析错误 - 位置 %1: %2")
+                .arg(parse_error.offset).arg(parse_error.errorString());
+        }
+        return nullptr;
+    }
+    if (!doc.isObject()) {
+        if (error) *error = QString::fromUtf8("JSON 文件格式不正确");
+        return nullptr;
+    }
+    return FromJson(doc.object());
+}
+
+const ResultVariable* ResultModel::FindVariable(const QString& name) const {
+    for (const auto& var : variables) {
+        if (var.name == name) return &var;
+    }
+    return nullptr;
+}
+
+QStringList ResultModel::VariableNames() const {
+    QStringList names;
+    for (const auto& var : variables) names << var.name;
+    return names;
+}
+
+size_t ResultModel::ByteSize() const {
+    size_t bytes = sizeof(ResultModel);
+    for (const auto& var : variables) bytes += sizeof(ResultVariable) + var.ByteSize();
+    bytes += static_cast<size_t>(metrics.utilization_by_period.size()) * sizeof(double);
+    return bytes;
+}
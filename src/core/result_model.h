@@ -0,0 +1,212 @@
+// result_model.h - Immutable result model
+// Converts a solver result JSON once into typed, compact buffers (dense, CSR or
+// bitset per variable) that are shared read-only between all analysis panels
+
+#ifndef RESULT_MODEL_H_
+#define RESULT_MODEL_H_
+
+#include <QJsonObject>
+#include <QMetaType>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "bit_ops.h"
+
+// "summary" section
+struct ResultSummary {
+    QString algorithm;
+    QString input_file;
+    double objective = 0.0;
+    double total_time = 0.0;
+    double solve_time = 0.0;
+    double gap = 0.0;
+    int unmet_count = 0;
+};
+
+// "problem" section
+struct ResultProblem {
+    int n = 0;
+    int t = 0;
+    int f = 0;
+    int g = 0;
+    int capacity = 0;
+};
+
+// "metrics" section (all optional in the JSON)
+// What the utilization figures of ResultMetrics cover
+enum class UtilizationBasis : uint8_t {
+    Unavailable,    // no figures: not in the file and not derivable
+    Full,           // processing and setup time
+    SetupOnly,      // derived without X: setup time of Y only
+};
+
+struct ResultMetrics {
+    // Cost breakdown
+    double cost_production = 0.0;
+    double cost_setup = 0.0;
+    double cost_inventory = 0.0;
+    double cost_backorder = 0.0;
+    double cost_unmet = 0.0;
+
+    // Capacity utilization
+    double avg_utilization = 0.0;
+    double max_utilization = 0.0;
+    QVector<double> utilization_by_period;
+    UtilizationBasis utilization_basis = UtilizationBasis::Unavailable;
+
+    // Setup / carryover
+    int total_setups = 0;
+    int total_carryovers = 0;
+
+    // Algorithm specific counters, small and schema-free
+    QJsonObject algorithm_specific;
+
+    // The file had a "metrics" section; otherwise the values above may have
+    // been recomputed from the variables (result_metrics.h)
+    bool present = false;
+    bool derived = false;
+};
+
+// One decision variable as a rows x cols matrix (1D variables have cols == 1).
+// Storage is picked per variable when it is decoded:
+//   Bitset - binary variables (Y, L), one bit per cell, rows padded to 64-bit words
+//   Sparse - CSR for mostly-zero real variables (typically X, B, U)
+//   Dense  - row-major float64 when more than half of the cells are nonzero
+class ResultVariable {
+public:
+    enum class Storage {
+        Dense,
+        Sparse,
+        Bitset
+    };
+
+    QString name;
+    QString description;
+    int rank = 2;
+    int rows = 0;
+    int cols = 0;
+    Storage storage = Storage::Dense;
+
+    // Storage::Dense
+    std::vector<double> dense;
+
+    // Storage::Sparse (row_ptr has rows + 1 entries, col_idx sorted within a row)
+    std::vector<uint32_t> row_ptr;
+    std::vector<uint32_t> col_idx;
+    std::vector<double> values;
+
+    // Storage::Bitset
+    std::vector<uint64_t> bits;
+    int words_per_row = 0;
+
+    size_t CellCount() const { return static_cast<size_t>(rows) * cols; }
+    bool IsBinary() const { return storage == Storage::Bitset; }
+
+    double At(int row, int col) const {
+        switch (storage) {
+            case Storage::Bitset: {
+                uint64_t word = bits[static_cast<size_t>(row) * words_per_row + (col >> 6)];
+                return static_cast<double>((word >> (col & 63)) & 1u);
+            }
+            case Storage::Sparse: {
+                auto first = col_idx.begin() + row_ptr[row];
+                auto last = col_idx.begin() + row_ptr[row + 1];
+                auto it = std::lower_bound(first, last, static_cast<uint32_t>(col));
+                return (it != last && *it == static_cast<uint32_t>(col)) ?
+                    values[it - col_idx.begin()] : 0.0;
+            }
+            default:
+                return dense[static_cast<size_t>(row) * cols + col];
+        }
+    }
+
+    // Visit nonzero cells of one row in column order: fn(int col, double value)
+    template <typename Fn>
+    void ForEachNonzero(int row, Fn&& fn) const {
+        switch (storage) {
+            case Storage::Bitset: {
+                const uint64_t* words = bits.data() + static_cast<size_t>(row) * words_per_row;
+                for (int w = 0; w < words_per_row; ++w) {
+                    for (uint64_t word = words[w]; word != 0; word &= word - 1) {
+                        fn(w * 64 + CountTrailingZeros64(word), 1.0);
+                    }
+                }
+                break;
+            }
+            case Storage::Sparse:
+                for (uint32_t k = row_ptr[row]; k < row_ptr[row + 1]; ++k) {
+                    fn(static_cast<int>(col_idx[k]), values[k]);
+                }
+                break;
+            default: {
+                const double* p = dense.data() + static_cast<size_t>(row) * cols;
+                for (int c = 0; c < cols; ++c) {
+                    if (p[c] != 0.0) fn(c, p[c]);
+                }
+                break;
+            }
+        }
+    }
+
+    // Nonzero counts (popcount for bitsets, row_ptr differences for CSR)
+    int RowNonzeroCount(int row) const;
+    size_t NonzeroCount() const;
+    bool RowHasNonzero(int row) const { return RowNonzeroCount(row) > 0; }
+
+    // Expand one row into |out| (cols doubles)
+    void CopyRow(int row, double* out) const;
+
+    // Heap bytes held by the value buffers
+    size_t ByteSize() const;
+};
+
+class ResultModel {
+public:
+    // Build from a parsed result document. Variables are converted into compact
+    // buffers; the caller can drop the JSON tree afterwards.
+    static std::shared_ptr<const ResultModel> FromJson(const QJsonObject& json);
+
+    // Read and convert a result file (JSON or binary .lsrb) in one go (no progress,
+    // no cancellation). Returns nullptr and sets |error| on failure. Safe to call
+    // from any thread.
+    static std::shared_ptr<const ResultModel> FromFile(const QString& path, QString* error);
+
+    // Same model without variables (summary/problem/metrics only)
+    static std::shared_ptr<const ResultModel> SummaryFromJson(const QJsonObject& json);
+
+    // Decode a single "variables.<name>" object
+    static ResultVariable VariableFromJson(const QString& name, const QJsonObject& var_obj);
+
+    // Build a variable from a row-major rows x cols array (binary result files);
+    // storage is picked with the same rules as for JSON
+    static ResultVariable VariableFromDense(const QString& name, const QString& description,
+                                            int rank, int rows, int cols, const double* data);
+    static ResultVariable VariableFromDense(const QString& name, const QString& description,
+                                            int rank, int rows, int cols, const float* data);
+
+    // summary/problem/metrics back as JSON (inverse of SummaryFromJson)
+    QJsonObject SectionsToJson() const;
+
+    ResultSummary summary;
+    ResultProblem problem;
+    ResultMetrics metrics;
+    std::vector<ResultVariable> variables;
+
+    const ResultVariable* FindVariable(const QString& name) const;
+    QStringList VariableNames() const;
+    bool HasVariables() const { return !variables.empty(); }
+    size_t ByteSize() const;
+};
+
+using ResultModelPtr = std::shared_ptr<const ResultModel>;
+using ResultVariablePtr = std::shared_ptr<const ResultVariable>;
+
+Q_DECLARE_METATYPE(ResultModelPtr)
+Q_DECLARE_METATYPE(ResultVariablePtr)
+
+#endif  // RESULT_MODEL_H_
@@ -0,0 +1,279 @@
+// result_source.cpp - Lazily decoded result file implementation
+
+#include "result_source.h"
+#include "json_partial_reader.h"
+#include "result_binary.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <string>
+#include <string_view>
+
+namespace {
+
+// Top-level members that make up the summary model
+bool IsSectionKey(std::string_view key) {
+    return key == "summary" || key == "problem" || key == "metrics";
+}
+
+std::string_view SkipBom(std::string_view text) {
+    if (text.size() >= 3 && static_cast<unsigned char>(text[0]) == 0xEF &&
+        static_cast<unsigned char>(text[1]) == 0xBB && static_cast<unsigned char>(text[2]) == 0xBF) {
+        text.remove_prefix(3);
+    }
+    return text;
+}
+
+}  // namespace
+
+ResultSource::ResultSource()
+    : data_(nullptr)
+    , size_(0)
+    , cached_bytes_(0)
+    , cache_limit_(kDefaultCacheLimit) {
+}
+
+ResultSource::~ResultSource() = default;
+
+std::shared_ptr<ResultSource> ResultSource::Open(const QString& path, QString* error,
+                                                 const CancelCheck& cancelled,
+                                                 const ScanProgressFn& progress) {
+    std::shared_ptr<ResultSource> source(new ResultSource());
+    source->path_ = path;
+
+    if (ResultBinaryFile::IsBinaryResult(path)) {
+        auto binary = std::make_unique<ResultBinaryFile>();
+        if (!binary->Open(path, error)) return nullptr;
+        source->summary_ = binary->Summary();
+        source->entries_.resize(binary->VariableCount());
+        for (int i = 0; i < binary->VariableCount(); ++i) {
+            source->entries_[i].name = binary->VariableName(i);
+            source->entries_[i].binary_index = i;
+        }
+        source->binary_ = std::move(binary);
+        return source;
+    }
+
+    return source->OpenJson(error, cancelled, progress) ? source : nullptr;
+}
+
+bool ResultSource::OpenJson(QString* error, const CancelCheck& cancelled,
+                            const ScanProgressFn& progress) {
+    file_ = std::make_unique<QFile>(path_);
+    if (!file_->open(QIODevice::ReadOnly)) {
+        if (error) *error = QString::fromUtf8("无法打开文件: %1").arg(path_);
+        return false;
+    }
+
+    // Variables are decoded straight from the mapping later on; fall back to a
+    // plain read where mapping is not possible
+    size_ = file_->size();
+    uchar* mapped = size_ > 0 ? file_->map(0, size_) : nullptr;
+    if (mapped) {
+        data_ = reinterpret_cast<const char*>(mapped);
+    } else {
+        buffer_ = file_->readAll();
+        data_ = buffer_.constData();
+        size_ = buffer_.size();
+    }
+
+    // One structural pass over the top-level object: the sections are kept as
+    // text, the variables payload only as byte spans. The payload is walked
+    // twice (skipped, then indexed), so until its size is known the total is
+    // taken as twice the file.
+    const std::string_view all(data_, static_cast<size_t>(size_));
+    const std::string_view text = SkipBom(all);
+    const qint64 text_size = static_cast<qint64>(text.size());
+    qint64 scan_base = 0;
+    qint64 scan_total = 2 * text_size;
+    JsonScanHook hook;
+    if (cancelled || progress) {
+        hook = [&](size_t offset) {
+            if (cancelled && cancelled()) return false;
+            if (progress) progress(scan_base + static_cast<qint64>(offset), scan_total);
+            return true;
+        };
+    }
+
+    std::string sections = "{";
+    bool bad_variables = false;
+    bool stopped = false;
+    JsonScanStatus status = ForEachJsonMember(text, 0,
+        [&](std::string_view key, std::string_view raw) {
+            if (IsSectionKey(key)) {
+                if (sections.size() > 1) sections += ',';
+                sections += '"';
+                sections.append(key.data(), key.size());
+                sections += "\":";
+                sections.append(raw.data(), raw.size());
+            } else if (key == "variables") {
+                const qint64 raw_size = static_cast<qint64>(raw.size());
+                scan_base = static_cast<qint64>(raw.data() - text.data()) + raw_size;
+                scan_total = text_size + raw_size;
+                JsonScanStatus var_status = ForEachJsonMember(raw, 0,
+                    [&](std::string_view name, std::string_view var_raw) {
+                        Entry entry;
+                        entry.name = QString::fromUtf8(name.data(), static_cast<qsizetype>(name.size()));
+                        entry.offset = static_cast<qint64>(var_raw.data() - all.data());
+                        entry.size = static_cast<qint64>(var_raw.size());
+                        entries_.push_back(entry);
+                        return true;
+                    }, hook);
+                stopped = var_status == JsonScanStatus::Stopped;
+                bad_variables = var_status != JsonScanStatus::Done;
+                if (stopped) return false;
+                scan_base = raw_size;
+            }
+            return true;
+        }, hook);
+    sections += '}';
+
+    if (stopped || status == JsonScanStatus::Stopped) {
+        if (error) *error = QString::fromUtf8("已取消");
+        return false;
+    }
+    if (status == JsonScanStatus::NeedMore) {
+        if (error) *error = QString::fromUtf8("JSON 文件不完整: %1").arg(path_);
+        return false;
+    }
+    if (status == JsonScanStatus::Malformed || bad_variables) {
+        if (error) *error = QString::fromUtf8("JSON 文件格式不正确");
+        return false;
+    }
+
+    QJsonParseError parse_error;
+    QJsonDocument doc = QJsonDocument::fromJson(
+        QByteArray::fromRawData(sections.data(), static_cast<qsizetype>(sections.size())),
+        &parse_error);
+    if (parse_error.error != QJsonParseError::NoError || !doc.isObject()) {
+        if (error) {
+            *error = QString::fromUtf8("JSON 解析错误: %1").arg(parse_error.errorString());
+        }
+        return false;
+    }
+    summary_ = ResultModel::SummaryFromJson(doc.object());
+    return true;
+}
+
+QStringList ResultSource::VariableNames() const {
+    QStringList names;
+    names.reserve(static_cast<qsizetype>(entries_.size()));
+    for (const auto& entry : entries_) {
+        names.append(entry.name);
+    }
+    return names;
+}
+
+int ResultSource::FindEntry(const QString& name) const {
+    for (size_t i = 0; i < entries_.size(); ++i) {
+        if (entries_[i].name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+ResultVariablePtr ResultSource::CachedVariable(const QString& name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+        if (it->first == name) {
+            cache_.splice(cache_.begin(), cache_, it);
+            return cache_.front().second;
+        }
+    }
+    return nullptr;
+}
+
+ResultVariablePtr ResultSource::Variable(const QString& name, QString* error, bool keep) const {
+    if (ResultVariablePtr cached = CachedVariable(name)) return cached;
+
+    const int index = FindEntry(name);
+    if (index < 0) {
+        if (error) *error = QString::fromUtf8("变量 %1 不存在").arg(name);
+        return nullptr;
+    }
+
+    // Decode outside the lock; if another thread decoded the same variable in the
+    // meantime, Insert() hands back that copy
+    QString decode_error;
+    auto var = std::make_shared<const ResultVariable>(Decode(entries_[index], &decode_error));
+    if (!decode_error.isEmpty()) {
+        if (error) *error = decode_error;
+        return nullptr;
+    }
+    return keep ? Insert(name, var) : var;
+}
+
+ResultVariable ResultSource::Decode(const Entry& entry, QString* error) const {
+    if (binary_) return binary_->ReadVariable(entry.binary_index);
+
+    QJsonParseError parse_error;
+    QJsonDocument doc = QJsonDocument::fromJson(
+        QByteArray::fromRawData(data_ + entry.offset, static_cast<qsizetype>(entry.size)),
+        &parse_error);
+    if (parse_error.error != QJsonParseError::NoError || !doc.isObject()) {
+        if (error) {
+            *error = QString::fromUtf8("变量 %1 解析错误 - 位置 %2: %3")
+                .arg(entry.name)
+                .arg(entry.offset + parse_error.offset)
+                .arg(parse_error.errorString());
+        }
+        return ResultVariable();
+    }
+    return ResultModel::VariableFromJson(entry.name, doc.object());
+}
+
+ResultVariablePtr ResultSource::Insert(const QString& name, const ResultVariablePtr& var) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& cached : cache_) {
+        if (cached.first == name) return cached.second;
+    }
+    cache_.emplace_front(name, var);
+    cached_bytes_ += var->ByteSize();
+    Evict();
+    return var;
+}
+
+void ResultSource::Evict() const {
+    while (cached_bytes_ > cache_limit_ && cache_.size() > 1) {
+        cached_bytes_ -= cache_.back().second->ByteSize();
+        cache_.pop_back();
+    }
+}
+
+ResultModelPtr ResultSource::ReadModel(QString* error) const {
+    auto model = std::make_shared<ResultModel>(*summary_);
+    model->variables.reserve(entries_.size());
+    for (const auto& entry : entries_) {
+        if (ResultVariablePtr cached = CachedVariable(entry.name)) {
+            model->variables.push_back(*cached);
+            continue;
+        }
+        QString decode_error;
+        model->variables.push_back(Decode(entry, &decode_error));
+        if (!decode_error.isEmpty()) {
+            if (error) *error = decode_error;
+            return nullptr;
+        }
+    }
+    return model;
+}
+
+void ResultSource::SetCacheLimit(size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_limit_ = bytes;
+    Evict();
+}
+
+size_t ResultSource::CacheLimit() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cache_limit_;
+}
+
+size_t ResultSource::CachedBytes() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cached_bytes_;
+}
+
+size_t ResultSource::ByteSize() const {
+    return summary_->ByteSize() + CachedBytes() + static_cast<size_t>(buffer_.capacity());
+}
@@ -0,0 +1,115 @@
+// result_source.h - Lazily decoded result file
+// Opening a result (JSON or binary .lsrb) only parses summary, problem and
+// metrics and indexes where each variable lives in the file. Variables are
+// decoded on first access and kept in a small LRU cache bounded by bytes.
+
+#ifndef RESULT_SOURCE_H_
+#define RESULT_SOURCE_H_
+
+#include <QByteArray>
+#include <QMetaType>
+#include <QString>
+#include <QStringList>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "parallel.h"
+#include "result_model.h"
+
+class QFile;
+class ResultBinaryFile;
+
+class ResultSource {
+public:
+    ~ResultSource();
+
+    ResultSource(const ResultSource&) = delete;
+    ResultSource& operator=(const ResultSource&) = delete;
+
+    // Bytes of the structural scan done so far and the expected total
+    using ScanProgressFn = std::function<void(qint64 done, qint64 total)>;
+
+    // Map |path| and read everything but the variables. Returns nullptr and sets
+    // |error| if the file cannot be read, is not a result file or |cancelled|
+    // returned true during the scan. |progress| follows the scan of JSON files.
+    static std::shared_ptr<ResultSource> Open(const QString& path, QString* error,
+                                              const CancelCheck& cancelled = {},
+                                              const ScanProgressFn& progress = {});
+
+    QString Path() const { return path_; }
+
+    // Model without variables (summary, problem, metrics)
+    ResultModelPtr Summary() const { return summary_; }
+
+    QStringList VariableNames() const;
+    bool HasVariable(const QString& name) const { return FindEntry(name) >= 0; }
+    bool HasVariables() const { return !entries_.empty(); }
+
+    // Decoded variable if it is in the cache, nullptr otherwise (never decodes)
+    ResultVariablePtr CachedVariable(const QString& name) const;
+
+    // Decode |name| (or take it from the cache). Returns nullptr and sets |error|
+    // if the variable is missing or malformed. With |keep| false a freshly decoded
+    // variable is not put into the cache (one-off bulk reads). Thread-safe.
+    ResultVariablePtr Variable(const QString& name, QString* error = nullptr,
+                               bool keep = true) const;
+
+    // Summary plus every variable (comparison, conversion)
+    ResultModelPtr ReadModel(QString* error = nullptr) const;
+
+    // Upper bound for decoded variables kept alive by the cache. The most
+    // recently used variable is always kept, even if it alone exceeds the limit.
+    void SetCacheLimit(size_t bytes);
+    size_t CacheLimit() const;
+    size_t CachedBytes() const;
+
+    // Heap bytes held by this source: summary, cached variables and the file
+    // copy when it could not be mapped (the mapping itself is not counted)
+    size_t ByteSize() const;
+
+    static constexpr size_t kDefaultCacheLimit = 256u * 1024 * 1024;
+
+private:
+    // Where a variable lives: byte span of its JSON object, or binary index
+    struct Entry {
+        QString name;
+        qint64 offset = 0;
+        qint64 size = 0;
+        int binary_index = -1;
+    };
+
+    ResultSource();
+
+    bool OpenJson(QString* error, const CancelCheck& cancelled,
+                  const ScanProgressFn& progress);
+    int FindEntry(const QString& name) const;
+    ResultVariable Decode(const Entry& entry, QString* error) const;
+    ResultVariablePtr Insert(const QString& name, const ResultVariablePtr& var) const;
+    void Evict() const;
+
+    QString path_;
+    std::unique_ptr<QFile> file_;
+    std::unique_ptr<ResultBinaryFile> binary_;
+    QByteArray buffer_;         // file contents when the file cannot be mapped
+    const char* data_;
+    qint64 size_;
+
+    ResultModelPtr summary_;
+    std::vector<Entry> entries_;
+
+    // LRU cache, most recently used first
+    mutable std::mutex mutex_;
+    mutable std::list<std::pair<QString, ResultVariablePtr>> cache_;
+    mutable size_t cached_bytes_;
+    size_t cache_limit_;
+};
+
+using ResultSourcePtr = std::shared_ptr<ResultSource>;
+
+Q_DECLARE_METATYPE(ResultSourcePtr)
+
+#endif  // RESULT_SOURCE_H_
@@ -0,0 +1,371 @@
+// result_verify.cpp - Feasibility check of a result implementation
+
+#include "result_verify.h"
+#include "bit_ops.h"
+#include "instance_cache.h"
+#include "result_source.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <mutex>
+
+namespace {
+
+// Capacity when neither the params, the result nor the instance state one
+constexpr double kDefaultCapacity = 1440.0;
+
+// Adds violations to a report: everything is counted, the first few are listed
+class Collector {
+public:
+    Collector(VerifyReport* report, size_t max_listed)
+        : report_(report), max_listed_(max_listed) {
+    }
+
+    void Add(ViolationKind kind, int entity, int period, double amount) {
+        const int k = static_cast<int>(kind);
+        ++report_->counts[k];
+        report_->worst[k] = std::max(report_->worst[k], std::fabs(amount));
+        if (period >= 0 && period < static_cast<int>(report_->period_counts.size())) {
+            ++report_->period_counts[period];
+        }
+        if (report_->violations.size() < max_listed_) {
+            report_->violations.push_back({kind, entity, period, amount});
+        }
+    }
+
+private:
+    VerifyReport* report_;
+    size_t max_listed_;
+};
+
+double Tolerance(const VerifyParams& params, double rhs) {
+    return params.tolerance * std::max(1.0, std::fabs(rhs));
+}
+
+bool HasRows(const ResultVariable* var, int rows) {
+    return var && var->rows == rows;
+}
+
+// |rows| bitset rows of |words| words, bit c set where var[r][c] > 0.5. Bitset
+// variables are copied word by word.
+std::vector<uint64_t> BinaryRows(const ResultVariable& var, int rows, int words) {
+    std::vector<uint64_t> bits(static_cast<size_t>(rows) * words, 0);
+    for (int r = 0; r < std::min(rows, var.rows); ++r) {
+        uint64_t* out = bits.data() + static_cast<size_t>(r) * words;
+        if (var.storage == ResultVariable::Storage::Bitset) {
+            const uint64_t* in = var.bits.data() + static_cast<size_t>(r) * var.words_per_row;
+            std::copy(in, in + std::min(words, var.words_per_row), out);
+            continue;
+        }
+        var.ForEachNonzero(r, [out, words](int c, double v) {
+            if (v > 0.5 && (c >> 6) < words) out[c >> 6] |= uint64_t(1) << (c & 63);
+        });
+    }
+    return bits;
+}
+
+bool TestBit(const uint64_t* row, int c) {
+    return (row[c >> 6] >> (c & 63)) & 1u;
+}
+
+void CheckCapacity(const MetricsInputs& inputs, const InstanceData& instance,
+                   const VerifyParams& params, double capacity, int periods,
+                   Collector* out, VerifyReport* report) {
+    // Per-order unit times are needed; a mean over merged orders is no proof
+    if (!HasRows(inputs.x, instance.n) ||
+        instance.unit_time.size() != static_cast<size_t>(instance.n)) {
+        return;
+    }
+    report->checked[static_cast<int>(ViolationKind::Capacity)] = true;
+
+    std::vector<double> usage(static_cast<size_t>(inputs.x->cols), 0.0);
+    AddWeightedColumnSums(*inputs.x, instance.unit_time, usage.data());
+    if (HasRows(inputs.y, instance.g) && inputs.y->cols == inputs.x->cols &&
+        instance.setup_time.size() == static_cast<size_t>(instance.g)) {
+        AddWeightedColumnSums(*inputs.y, instance.setup_time, usage.data());
+    }
+
+    const double limit = capacity + Tolerance(params, capacity);
+    for (int t = 0; t < std::min(periods, inputs.x->cols); ++t) {
+        if (usage[t] > limit) out->Add(ViolationKind::Capacity, -1, t, usage[t] - capacity);
+    }
+}
+
+// Window, demand and setup in one pass over the nonzeros of each X row
+void CheckOrders(const MetricsInputs& inputs, const InstanceData& instance,
+                 const VerifyParams& params, const std::vector<uint64_t>& state, int words,
+                 Collector* out, VerifyReport* report) {
+    if (!HasRows(inputs.x, instance.n)) return;
+    const size_t n = static_cast<size_t>(instance.n);
+    const bool has_window = instance.earliest.size() == n && instance.latest.size() == n;
+    const bool has_demand = instance.demand.size() == n;
+    const bool has_setup = !state.empty() && instance.group.size() == n;
+    const ResultVariable* backorder = HasRows(inputs.b, instance.n) ? inputs.b : nullptr;
+    const ResultVariable* unmet = HasRows(inputs.u, instance.n) ? inputs.u : nullptr;
+    const int groups = words > 0 ? static_cast<int>(state.size() / words) : 0;
+
+    report->checked[static_cast<int>(ViolationKind::Window)] = has_window;
+    report->checked[static_cast<int>(ViolationKind::Demand)] = has_demand;
+    report->checked[static_cast<int>(ViolationKind::Setup)] = has_setup;
+
+    const double eps = params.tolerance;
+    for (int i = 0; i < instance.n; ++i) {
+        const int first = has_window ? instance.earliest[i] : 0;
+        const int last = has_window ? instance.latest[i] : inputs.x->cols - 1;
+        // Late production is how backorders are served
+        const bool late_ok = backorder && backorder->RowHasNonzero(i);
+        const int g = has_setup ? instance.group[i] : -1;
+        const uint64_t* setup_row = (g >= 0 && g < groups) ?
+            state.data() + static_cast<size_t>(g) * words : nullptr;
+
+        double produced = 0.0;
+        inputs.x->ForEachNonzero(i, [&](int t, double v) {
+            produced += v;
+            if (v <= eps) return;
+            if (has_window && (t < first || (t > last && !late_ok))) {
+                out->Add(ViolationKind::Window, i, t, v);
+            }
+            if (has_setup && (!setup_row || (t >> 6) >= words || !TestBit(setup_row, t))) {
+                out->Add(ViolationKind::Setup, i, t, v);
+            }
+        });
+
+        if (!has_demand) continue;
+        double unmet_amount = 0.0;
+        if (unmet) {
+            // Binary U marks the order as dropped; otherwise it is a quantity
+            if (unmet->IsBinary()) {
+                if (unmet->RowHasNonzero(i)) continue;
+            } else {
+                unmet->ForEachNonzero(i, [&unmet_amount](int, double v) { unmet_amount += v; });
+            }
+        }
+        const double deviation = produced + unmet_amount - instance.demand[i];
+        if (std::fabs(deviation) > Tolerance(params, instance.demand[i])) {
+            out->Add(ViolationKind::Demand, i, -1, deviation);
+        }
+    }
+}
+
+// L[g][t] & ~((Y | L)[g] << 1): carryover without a setup state one period earlier
+void CheckCarryover(const std::vector<uint64_t>& carry, const std::vector<uint64_t>& state,
+                    int groups, int words, int periods, Collector* out) {
+    for (int g = 0; g < groups; ++g) {
+        const uint64_t* l = carry.data() + static_cast<size_t>(g) * words;
+        const uint64_t* s = state.data() + static_cast<size_t>(g) * words;
+        for (int w = 0; w < words; ++w) {
+            const uint64_t previous = (s[w] << 1) | (w > 0 ? s[w - 1] >> 63 : 0);
+            for (uint64_t bad = l[w] & ~previous; bad != 0; bad &= bad - 1) {
+                const int t = w * 64 + CountTrailingZeros64(bad);
+                if (t < periods) out->Add(ViolationKind::Carryover, g, t, 1.0);
+            }
+        }
+    }
+}
+
+// Necessary conditions of the flow balance: inventory never negative and never
+// growing by more than the flow produced in the period
+void CheckInventory(const MetricsInputs& inputs, const InstanceData& instance,
+                    const VerifyParams& params, Collector* out, VerifyReport* report) {
+    if (!inputs.i || inputs.i->rank != 2 || !HasRows(inputs.x, instance.n) ||
+        instance.flow.size() != static_cast<size_t>(instance.n)) {
+        return;
+    }
+    const int flows = inputs.i->rows;
+    const int periods = std::min(inputs.i->cols, inputs.x->cols);
+    report->checked[static_cast<int>(ViolationKind::Inventory)] = true;
+
+    // Production per flow and period, accumulated row by row
+    std::vector<double> production(static_cast<size_t>(flows) * inputs.x->cols, 0.0);
+    for (int i = 0; i < instance.n; ++i) {
+        const int f = instance.flow[i];
+        if (f < 0 || f >= flows) continue;
+        double* row = production.data() + static_cast<size_t>(f) * inputs.x->cols;
+        inputs.x->ForEachNonzero(i, [row](int t, double v) { row[t] += v; });
+    }
+
+    std::vector<double> level(static_cast<size_t>(inputs.i->cols));
+    for (int f = 0; f < flows; ++f) {
+        inputs.i->CopyRow(f, level.data());
+        const double* made = production.data() + static_cast<size_t>(f) * inputs.x->cols;
+        double previous = 0.0;
+        for (int t = 0; t < periods; ++t) {
+            const double v = level[t];
+            if (v < -Tolerance(params, 0.0)) {
+                out->Add(ViolationKind::Inventory, f, t, -v);
+            } else {
+                const double growth = v - previous - made[t];
+                if (growth > Tolerance(params, std::max(v, made[t]))) {
+                    out->Add(ViolationKind::Inventory, f, t, growth);
+                }
+            }
+            previous = v;
+        }
+    }
+}
+
+bool VerifySource(const ResultSource& source, const InstanceData& instance,
+                  const VerifyParams& params, VerifyReport* report, QString* error) {
+    // Cached variables are reused; the others are decoded for this check only
+    ResultVariablePtr vars[6];
+    const char* names[6] = {"X", "Y", "L", "I", "B", "U"};
+    for (int k = 0; k < 6; ++k) {
+        if (!source.HasVariable(names[k])) continue;
+        vars[k] = source.Variable(names[k], error, false);
+        if (!vars[k]) return false;
+    }
+
+    MetricsInputs inputs;
+    inputs.x = vars[0].get();
+    inputs.y = vars[1].get();
+    inputs.l = vars[2].get();
+    inputs.i = vars[3].get();
+    inputs.b = vars[4].get();
+    inputs.u = vars[5].get();
+    *report = VerifySolution(*source.Summary(), inputs, instance, params);
+    for (bool checked : report->checked) {
+        if (checked) return true;
+    }
+    if (error) *error = QString::fromUtf8("结果中没有可校验的变量: %1").arg(source.Path());
+    return false;
+}
+
+// Stand-in for an instance that cannot be found: only the families that need
+// no instance data (carryover) run
+const InstanceData& NoInstance() {
+    static const InstanceData empty;
+    return empty;
+}
+
+}  // namespace
+
+QString ViolationKindName(ViolationKind kind) {
+    switch (kind) {
+        case ViolationKind::Capacity: return QString::fromUtf8("产能");
+        case ViolationKind::Window: return QString::fromUtf8("交付窗口");
+        case ViolationKind::Demand: return QString::fromUtf8("需求");
+        case ViolationKind::Setup: return QString::fromUtf8("启动");
+        case ViolationKind::Carryover: return QString::fromUtf8("跨期");
+        case ViolationKind::Inventory: return QString::fromUtf8("库存平衡");
+    }
+    return QString();
+}
+
+int VerifyReport::TotalCount() const {
+    int total = 0;
+    for (int count : counts) total += count;
+    return total;
+}
+
+VerifyReport VerifySolution(const ResultModel& summary, const MetricsInputs& inputs,
+                            const InstanceData& instance, const VerifyParams& params) {
+    VerifyReport report;
+    report.capacity = params.capacity;
+    if (report.capacity <= 0.0) report.capacity = summary.problem.capacity;
+    if (report.capacity <= 0.0) report.capacity = instance.capacity;
+    if (report.capacity <= 0.0) report.capacity = kDefaultCapacity;
+    report.result_orders = inputs.x && inputs.x->rank == 2 ? inputs.x->rows : summary.problem.n;
+    report.instance_orders = instance.n;
+
+    const int periods = inputs.x ? inputs.x->cols :
+                        inputs.y && inputs.y->rank == 2 ? inputs.y->cols : instance.t;
+    report.period_counts.assign(static_cast<size_t>(std::max(periods, 0)), 0);
+    Collector out(&report, params.max_listed);
+
+    // Setup state per group and period: Y | L as bitset rows
+    const int words = (periods + 63) / 64;
+    std::vector<uint64_t> state;
+    std::vector<uint64_t> carry;
+    int groups = 0;
+    if (inputs.y && inputs.y->rank == 2) {
+        groups = inputs.y->rows;
+        state = BinaryRows(*inputs.y, groups, words);
+        if (inputs.l && inputs.l->rows == groups) {
+            carry = BinaryRows(*inputs.l, groups, words);
+            for (size_t w = 0; w < state.size(); ++w) state[w] |= carry[w];
+        }
+    }
+
+    CheckCapacity(inputs, instance, params, report.capacity, periods, &out, &report);
+    CheckOrders(inputs, instance, params, state, words, &out, &report);
+    if (!carry.empty()) {
+        report.checked[static_cast<int>(ViolationKind::Carryover)] = true;
+        CheckCarryover(carry, state, groups, words, periods, &out);
+    }
+    CheckInventory(inputs, instance, params, &out, &report);
+    return report;
+}
+
+bool VerifyResultFile(const QString& path, const QString& instance_file,
+                      const VerifyParams& params, VerifyReport* report, QString* error) {
+    ResultSourcePtr source = ResultSource::Open(path, error);
+    if (!source) return false;
+
+    QString instance_path = instance_file;
+    if (instance_path.isEmpty()) {
+        instance_path = FindInstanceFile(source->Summary()->summary.input_file, path);
+        if (instance_path.isEmpty()) {
+            if (VerifySource(*source, NoInstance(), params, report, nullptr)) return true;
+            if (error) {
+                *error = QString::fromUtf8("找不到算例文件: %1")
+                    .arg(source->Summary()->summary.input_file);
+            }
+            return false;
+        }
+    }
+
+    InstanceDataPtr instance = LoadInstanceCached(instance_path, error);
+    if (!instance) return false;
+    return VerifySource(*source, *instance, params, report, error);
+}
+
+bool VerifyResults(VerifySet* set, int threads, const CancelCheck& cancelled) {
+    const int count = set->paths.size();
+    set->reports.assign(static_cast<size_t>(count), VerifyReport());
+    set->errors.clear();
+    for (int k = 0; k < count; ++k) set->errors << QString();
+
+    // A folder of runs usually shares a handful of instances; they stay loaded
+    // for the whole batch
+    std::mutex instance_mutex;
+    std::map<QString, InstanceDataPtr> instances;
+
+    return RunParallel(static_cast<size_t>(count), threads, [&](size_t i) {
+        const int k = static_cast<int>(i);
+        const QString& path = set->paths[k];
+        QString error;
+        ResultSourcePtr source = ResultSource::Open(path, &error);
+        QString instance_path = set->instance_file;
+        if (source && instance_path.isEmpty()) {
+            instance_path = FindInstanceFile(source->Summary()->summary.input_file, path);
+            if (instance_path.isEmpty()) {
+                error = QString::fromUtf8("找不到算例文件: %1")
+                    .arg(source->Summary()->summary.input_file);
+            }
+        }
+
+        InstanceDataPtr instance;
+        if (error.isEmpty()) {
+            {
+                std::lock_guard<std::mutex> lock(instance_mutex);
+                auto it = instances.find(instance_path);
+                if (it != instances.end()) instance = it->second;
+            }
+            if (!instance) {
+                if (InstanceDataPtr loaded = LoadInstanceCached(instance_path, &error)) {
+                    std::lock_guard<std::mutex> lock(instance_mutex);
+                    instance = instances.emplace(instance_path, loaded).first->second;
+                }
+            }
+        }
+
+        if (instance) {
+            VerifySource(*source, *instance, set->params, &set->reports[k], &error);
+        } else if (source && instance_path.isEmpty() &&
+                   VerifySource(*source, NoInstance(), set->params, &set->reports[k], nullptr)) {
+            error.clear();
+        }
+        set->errors[k] = error;
+    }, cancelled);
+}
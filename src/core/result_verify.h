@@ -0,0 +1,103 @@
+// result_verify.h - Feasibility check of a result against its instance
+// Re-checks the constraint families of LS-NTGF on the decoded variables:
+//   Capacity   sum_i unit_time_i X[i][t] + sum_g setup_time_g Y[g][t] <= capacity
+//   Window     X[i][t] > 0 only for earliest_i <= t <= latest_i (later periods
+//              are allowed while the order has backorders)
+//   Demand     sum_t X[i][t] + unmet_i == demand_i (U binary: skipped order)
+//   Setup      X[i][t] > 0 needs Y or L of the order's group in period t
+//   Carryover  L[g][t] needs Y or L of group g in period t - 1
+//   Inventory  I[f][t] >= 0 and I[f][t] - I[f][t-1] <= production of flow f in t
+// Each family is one pass over whole rows: column sums for capacity, nonzeros of
+// the CSR rows for the per-order checks, 64-bit word operations on the bitset
+// rows of Y / L. Per-order families need X with one row per instance order and
+// are skipped (not failed) for merged results; a result with only Y / L still
+// gets its carryover check, which needs no instance data.
+
+#ifndef RESULT_VERIFY_H_
+#define RESULT_VERIFY_H_
+
+#include <QMetaType>
+#include <QString>
+#include <QStringList>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "instance_data.h"
+#include "parallel.h"
+#include "result_metrics.h"
+
+enum class ViolationKind {
+    Capacity,
+    Window,
+    Demand,
+    Setup,
+    Carryover,
+    Inventory
+};
+
+constexpr int kViolationKindCount = 6;
+
+QString ViolationKindName(ViolationKind kind);
+
+// One violated constraint
+struct Violation {
+    ViolationKind kind = ViolationKind::Capacity;
+    int entity = -1;        // order, group or flow (0-based); -1 for capacity
+    int period = -1;        // 0-based; -1 for order totals (demand)
+    double amount = 0.0;    // by how much the constraint is exceeded
+};
+
+struct VerifyParams {
+    double capacity = 0.0;          // 0: take it from the result or instance
+    double tolerance = 1e-6;        // relative to max(1, |right-hand side|)
+    size_t max_listed = 10000;      // violations kept per result; all are counted
+};
+
+struct VerifyReport {
+    bool checked[kViolationKindCount] = {};
+    int counts[kViolationKindCount] = {};
+    double worst[kViolationKindCount] = {};
+    std::vector<int> period_counts;         // violations per period
+    std::vector<Violation> violations;      // first params.max_listed, in check order
+    double capacity = 0.0;                  // capacity the check used
+    int result_orders = 0;                  // orders in the result (X rows or problem n)
+    int instance_orders = 0;                // orders in the instance (0: no instance)
+
+    int TotalCount() const;
+    bool Feasible() const { return TotalCount() == 0; }
+    // The result was solved on merged orders: the per-order families were
+    // skipped, so Feasible() says nothing about them
+    bool Merged() const {
+        return result_orders > 0 && instance_orders > 0 && result_orders != instance_orders;
+    }
+};
+
+// Check |inputs| against |instance|. |summary| supplies the capacity when the
+// params do not. Missing variables skip the families that need them.
+VerifyReport VerifySolution(const ResultModel& summary, const MetricsInputs& inputs,
+                            const InstanceData& instance, const VerifyParams& params);
+
+// A batch of results to verify. reports[i] is valid if errors[i] is empty.
+struct VerifySet {
+    QStringList paths;
+    QString instance_file;      // empty: the instance recorded in each result
+    VerifyParams params;
+    std::vector<VerifyReport> reports;
+    QStringList errors;
+};
+
+using VerifySetPtr = std::shared_ptr<const VerifySet>;
+
+// Open, decode and verify one result file. Without the instance only carryover is
+// checked; fails when no family can run.
+bool VerifyResultFile(const QString& path, const QString& instance_file,
+                      const VerifyParams& params, VerifyReport* report, QString* error);
+
+// Verify every path of |set|, spread over |threads| workers (<= 0: hardware
+// concurrency). Instances shared by several results are read once. Returns false
+// if cancelled.
+bool VerifyResults(VerifySet* set, int threads, const CancelCheck& cancelled = {});
+
+Q_DECLARE_METATYPE(VerifySetPtr)
+
+#endif  // RESULT_VERIFY_H_
@@ -0,0 +1,495 @@
+// run_history.cpp - Append-only run history implementation
+
+#include "run_history.h"
+
+#include <QStandardPaths>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr uint32_t kHistoryMagic = 0x4852534C;  // "LSRH"
+constexpr uint32_t kHistoryVersion = 1;
+constexpr uint32_t kFrameMagic = 0x4E55521E;    // "\x1eRUN"
+constexpr uint32_t kIndexMagic = 0x5848534C;    // "LSHX"
+constexpr uint32_t kIndexVersion = 1;
+constexpr uint64_t kHeaderSize = 8;
+constexpr uint64_t kFrameHeaderSize = 12;       // magic, payload size, checksum
+constexpr uint32_t kMaxPayload = 64u << 20;
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+uint32_t Checksum(const char* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+//---------------------------------------
+// Record payload
+//---------------------------------------
+
+class PayloadWriter {
+public:
+    explicit PayloadWriter(std::string* out) : out_(out) {}
+
+    template <typename T>
+    void Pod(T value) {
+        out_->append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void String(const std::string& s) {
+        Pod<uint32_t>(static_cast<uint32_t>(s.size()));
+        out_->append(s);
+    }
+
+private:
+    std::string* out_;
+};
+
+class PayloadReader {
+public:
+    PayloadReader(const char* data, size_t size) : p_(data), end_(data + size) {}
+
+    template <typename T>
+    bool Pod(T* value) {
+        if (static_cast<size_t>(end_ - p_) < sizeof(T)) return false;
+        std::memcpy(value, p_, sizeof(T));
+        p_ += sizeof(T);
+        return true;
+    }
+
+    bool String(std::string* s) {
+        uint32_t size = 0;
+        if (!Pod(&size) || static_cast<size_t>(end_ - p_) < size) return false;
+        s->assign(p_, size);
+        p_ += size;
+        return true;
+    }
+
+private:
+    const char* p_;
+    const char* end_;
+};
+
+std::string EncodeRecord(const RunRecord& r) {
+    std::string payload;
+    PayloadWriter out(&payload);
+    out.Pod(r.started);
+    out.Pod(static_cast<uint8_t>(r.status));
+    out.String(r.message);
+    out.String(r.algorithm);
+    out.String(r.instance_path);
+    out.String(r.instance_hash);
+    out.Pod<int32_t>(r.n);
+    out.Pod<int32_t>(r.t);
+    out.Pod<int32_t>(r.g);
+    out.Pod<int32_t>(r.f);
+    out.Pod<uint32_t>(static_cast<uint32_t>(r.arguments.size()));
+    for (const auto& arg : r.arguments) out.String(arg);
+    out.Pod<uint32_t>(static_cast<uint32_t>(r.stages.size()));
+    for (const auto& stage : r.stages) {
+        out.Pod<int32_t>(stage.stage);
+        out.Pod(stage.objective);
+        out.Pod(stage.runtime);
+        out.Pod(stage.gap);
+    }
+    out.Pod(r.wall_seconds);
+    out.Pod(r.cpu_seconds);
+    out.Pod(r.peak_rss_bytes);
+    out.Pod<uint32_t>(static_cast<uint32_t>(r.artifacts.size()));
+    for (const auto& artifact : r.artifacts) out.String(artifact);
+    return payload;
+}
+
+bool DecodeRecord(const char* data, size_t size, RunRecord* r) {
+    PayloadReader in(data, size);
+    uint8_t status = 0;
+    int32_t n = 0, t = 0, g = 0, f = 0;
+    uint32_t count = 0;
+    if (!in.Pod(&r->started) || !in.Pod(&status) || !in.String(&r->message) ||
+        !in.String(&r->algorithm) || !in.String(&r->instance_path) ||
+        !in.String(&r->instance_hash) || !in.Pod(&n) || !in.Pod(&t) || !in.Pod(&g) ||
+        !in.Pod(&f) || !in.Pod(&count)) {
+        return false;
+    }
+    r->status = static_cast<RunStatus>(status);
+    r->n = n;
+    r->t = t;
+    r->g = g;
+    r->f = f;
+    r->arguments.assign(std::min<size_t>(count, size), std::string());
+    for (auto& arg : r->arguments) {
+        if (!in.String(&arg)) return false;
+    }
+    if (!in.Pod(&count)) return false;
+    r->stages.assign(std::min<size_t>(count, size), RunStageRecord());
+    for (auto& stage : r->stages) {
+        int32_t number = 0;
+        if (!in.Pod(&number) || !in.Pod(&stage.objective) || !in.Pod(&stage.runtime) ||
+            !in.Pod(&stage.gap)) {
+            return false;
+        }
+        stage.stage = number;
+    }
+    if (!in.Pod(&r->wall_seconds) || !in.Pod(&r->cpu_seconds) || !in.Pod(&r->peak_rss_bytes) ||
+        !in.Pod(&count)) {
+        return false;
+    }
+    r->artifacts.assign(std::min<size_t>(count, size), std::string());
+    for (auto& artifact : r->artifacts) {
+        if (!in.String(&artifact)) return false;
+    }
+    return true;
+}
+
+RunHistoryEntry MakeEntry(const RunRecord& record, uint64_t offset, uint32_t size) {
+    RunHistoryEntry entry;
+    entry.offset = offset;
+    entry.size = size;
+    entry.started = record.started;
+    entry.status = record.status;
+    entry.algorithm = record.algorithm;
+    entry.instance_hash = record.instance_hash;
+    entry.objective = record.Objective();
+    entry.wall_seconds = record.wall_seconds;
+    entry.config_key = RunConfigKey(record.arguments);
+    return entry;
+}
+
+bool Better(const RunHistoryEntry& a, const RunHistoryEntry& b) {
+    return a.objective < b.objective;
+}
+
+bool Eligible(const RunHistoryEntry& entry) {
+    return entry.status == RunStatus::Success && std::isfinite(entry.objective);
+}
+
+//---------------------------------------
+// Index file I/O
+//---------------------------------------
+
+template <typename T>
+void WritePod(std::ofstream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadPod(std::ifstream& in, T* value) {
+    in.read(reinterpret_cast<char*>(value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+void WriteString(std::ofstream& out, const std::string& s) {
+    WritePod<uint32_t>(out, static_cast<uint32_t>(s.size()));
+    out.write(s.data(), static_cast<std::streamsize>(s.size()));
+}
+
+bool ReadString(std::ifstream& in, std::string* s) {
+    uint32_t size = 0;
+    if (!ReadPod(in, &size)) return false;
+    s->resize(size);
+    if (size > 0) in.read(&(*s)[0], size);
+    return static_cast<bool>(in);
+}
+
+}  // namespace
+
+double RunRecord::Objective() const {
+    return stages.empty() ? kNaN : stages.back().objective;
+}
+
+RunHistoryEntry::RunHistoryEntry()
+    : objective(kNaN) {
+}
+
+uint64_t RunConfigKey(const std::vector<std::string>& arguments) {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const std::string& s) {
+        for (unsigned char c : s) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        hash ^= 0xFF;
+        hash *= 1099511628211ull;
+    };
+    for (size_t i = 1; i < arguments.size(); ++i) {
+        const std::string& arg = arguments[i];
+        if (arg == "-f" || arg == "-o" || arg == "-l") {
+            ++i;
+            continue;
+        }
+        mix(arg);
+    }
+    return hash;
+}
+
+RunHistory::RunHistory(const std::string& path)
+    : path_(path)
+    , index_path_(path + ".idx")
+    , data_size_(0)
+    , unsaved_(0) {
+    Open();
+}
+
+RunHistory::~RunHistory() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (unsaved_ > 0) SaveIndexLocked();
+}
+
+RunHistory& RunHistory::Shared() {
+    static RunHistory history(
+        (QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) +
+         "/run_history.lsrh").toStdString());
+    return history;
+}
+
+void RunHistory::Open() {
+    const fs::path data_path = fs::u8path(path_);
+    std::error_code ec;
+    fs::create_directories(data_path.parent_path(), ec);
+
+    // A file that is not a history is moved aside rather than appended to
+    {
+        std::ifstream in(data_path, std::ios::binary);
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        if (in && (!ReadPod(in, &magic) || !ReadPod(in, &version) ||
+                   magic != kHistoryMagic || version != kHistoryVersion)) {
+            in.close();
+            fs::rename(data_path, fs::u8path(path_ + ".bad"), ec);
+        }
+    }
+    if (!fs::exists(data_path, ec)) {
+        std::ofstream out(data_path, std::ios::binary | std::ios::trunc);
+        WritePod<uint32_t>(out, kHistoryMagic);
+        WritePod<uint32_t>(out, kHistoryVersion);
+    }
+
+    const uint64_t file_size = static_cast<uint64_t>(fs::file_size(data_path, ec));
+    if (ec || file_size < kHeaderSize) return;
+
+    // Index first; whatever it does not cover is read from the data file
+    if (!LoadIndex() || data_size_ > file_size) {
+        entries_.clear();
+        by_instance_.clear();
+        best_.clear();
+        data_size_ = kHeaderSize;
+    }
+    if (data_size_ < file_size) {
+        const size_t indexed = entries_.size();
+        ScanData(data_size_);
+        unsaved_ = static_cast<int>(entries_.size() - indexed);
+        if (unsaved_ > 0) SaveIndexLocked();
+    }
+}
+
+bool RunHistory::LoadIndex() {
+    std::ifstream in(fs::u8path(index_path_), std::ios::binary);
+    if (!in) return false;
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint64_t data_size = 0;
+    uint32_t count = 0;
+    if (!ReadPod(in, &magic) || !ReadPod(in, &version) || !ReadPod(in, &data_size) ||
+        !ReadPod(in, &count) || magic != kIndexMagic || version != kIndexVersion) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        RunHistoryEntry e;
+        uint8_t status = 0;
+        bool good = ReadPod(in, &e.offset) && ReadPod(in, &e.size) && ReadPod(in, &e.started) &&
+                    ReadPod(in, &status) && ReadString(in, &e.algorithm) &&
+                    ReadString(in, &e.instance_hash) && ReadPod(in, &e.objective) &&
+                    ReadPod(in, &e.wall_seconds) && ReadPod(in, &e.config_key);
+        if (!good) return false;
+        e.status = static_cast<RunStatus>(status);
+        AddEntry(e);
+    }
+    data_size_ = data_size;
+    return true;
+}
+
+void RunHistory::ScanData(uint64_t from) {
+    const fs::path data_path = fs::u8path(path_);
+    std::ifstream in(data_path, std::ios::binary);
+    if (!in) return;
+    in.seekg(static_cast<std::streamoff>(from));
+
+    uint64_t offset = from;
+    std::string payload;
+    while (true) {
+        uint32_t magic = 0;
+        uint32_t size = 0;
+        uint32_t checksum = 0;
+        if (!ReadPod(in, &magic) || !ReadPod(in, &size) || !ReadPod(in, &checksum) ||
+            magic != kFrameMagic || size > kMaxPayload) {
+            break;
+        }
+        payload.resize(size);
+        if (size > 0 && !in.read(&payload[0], size)) break;
+        if (Checksum(payload.data(), payload.size()) != checksum) break;
+
+        RunRecord record;
+        if (DecodeRecord(payload.data(), payload.size(), &record)) {
+            AddEntry(MakeEntry(record, offset, size));
+        }
+        offset += kFrameHeaderSize + size;
+    }
+    in.close();
+
+    // Torn or damaged tail: drop it so the next append starts on a frame boundary
+    std::error_code ec;
+    const uint64_t file_size = static_cast<uint64_t>(fs::file_size(data_path, ec));
+    if (!ec && offset < file_size) fs::resize_file(data_path, offset, ec);
+    data_size_ = offset;
+}
+
+void RunHistory::AddEntry(const RunHistoryEntry& entry) {
+    const size_t index = entries_.size();
+    entries_.push_back(entry);
+    if (entry.instance_hash.empty()) return;
+
+    by_instance_[entry.instance_hash].push_back(index);
+    if (Eligible(entry)) {
+        auto it = best_.find(entry.instance_hash);
+        if (it == best_.end()) {
+            best_.emplace(entry.instance_hash, index);
+        } else if (Better(entry, entries_[it->second])) {
+            it->second = index;
+        }
+    }
+}
+
+bool RunHistory::Append(const RunRecord& record) {
+    const std::string payload = EncodeRecord(record);
+    if (payload.size() > kMaxPayload) return false;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (data_size_ < kHeaderSize) return false;
+    std::ofstream out(fs::u8path(path_), std::ios::binary | std::ios::app);
+    if (!out) return false;
+    WritePod<uint32_t>(out, kFrameMagic);
+    WritePod<uint32_t>(out, static_cast<uint32_t>(payload.size()));
+    WritePod<uint32_t>(out, Checksum(payload.data(), payload.size()));
+    out.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+    out.flush();
+    if (!out) return false;
+
+    const uint64_t offset = data_size_;
+    data_size_ += kFrameHeaderSize + payload.size();
+    AddEntry(MakeEntry(record, offset, static_cast<uint32_t>(payload.size())));
+    if (++unsaved_ >= kIndexSaveInterval) SaveIndexLocked();
+    return true;
+}
+
+bool RunHistory::Read(const RunHistoryEntry& entry, RunRecord* record) const {
+    std::ifstream in(fs::u8path(path_), std::ios::binary);
+    if (!in) return false;
+    in.seekg(static_cast<std::streamoff>(entry.offset + kFrameHeaderSize));
+    std::string payload(entry.size, '\0');
+    if (entry.size > 0 && !in.read(&payload[0], entry.size)) return false;
+    return DecodeRecord(payload.data(), payload.size(), record);
+}
+
+size_t RunHistory::Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+std::vector<RunHistoryEntry> RunHistory::Entries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_;
+}
+
+std::vector<RunHistoryEntry> RunHistory::RunsOfInstance(const std::string& hash) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<RunHistoryEntry> runs;
+    auto it = by_instance_.find(hash);
+    if (it == by_instance_.end()) return runs;
+    runs.reserve(it->second.size());
+    for (size_t index : it->second) runs.push_back(entries_[index]);
+    return runs;
+}
+
+int RunHistory::RunCount(const std::string& hash) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = by_instance_.find(hash);
+    return it == by_instance_.end() ? 0 : static_cast<int>(it->second.size());
+}
+
+bool RunHistory::BestRun(const std::string& hash, RunHistoryEntry* best) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = best_.find(hash);
+    if (it == best_.end()) return false;
+    *best = entries_[it->second];
+    return true;
+}
+
+std::vector<RunHistoryEntry> RunHistory::BestPerConfig(const std::string& hash) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::map<uint64_t, size_t> best;
+    auto it = by_instance_.find(hash);
+    if (it != by_instance_.end()) {
+        for (size_t index : it->second) {
+            const RunHistoryEntry& entry = entries_[index];
+            if (!Eligible(entry)) continue;
+            auto slot = best.find(entry.config_key);
+            if (slot == best.end()) {
+                best.emplace(entry.config_key, index);
+            } else if (Better(entry, entries_[slot->second])) {
+                slot->second = index;
+            }
+        }
+    }
+    std::vector<RunHistoryEntry> runs;
+    runs.reserve(best.size());
+    for (const auto& kv : best) runs.push_back(entries_[kv.second]);
+    std::sort(runs.begin(), runs.end(), Better);
+    return runs;
+}
+
+bool RunHistory::SaveIndex() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return SaveIndexLocked();
+}
+
+bool RunHistory::SaveIndexLocked() {
+    // Written aside and renamed: a crash mid-write leaves the old index
+    const std::string temp_path = index_path_ + ".tmp";
+    {
+        std::ofstream out(fs::u8path(temp_path), std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        WritePod<uint32_t>(out, kIndexMagic);
+        WritePod<uint32_t>(out, kIndexVersion);
+        WritePod<uint64_t>(out, data_size_);
+        WritePod<uint32_t>(out, static_cast<uint32_t>(entries_.size()));
+        for (const auto& e : entries_) {
+            WritePod(out, e.offset);
+            WritePod(out, e.size);
+            WritePod(out, e.started);
+            WritePod<uint8_t>(out, static_cast<uint8_t>(e.status));
+            WriteString(out, e.algorithm);
+            WriteString(out, e.instance_hash);
+            WritePod(out, e.objective);
+            WritePod(out, e.wall_seconds);
+            WritePod(out, e.config_key);
+        }
+        if (!out) return false;
+    }
+    std::error_code ec;
+    fs::rename(fs::u8path(temp_path), fs::u8path(index_path_), ec);
+    if (ec) return false;
+    unsaved_ = 0;
+    return true;
+}
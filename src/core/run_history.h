@@ -0,0 +1,135 @@
+// run_history.h - Append-only store of every solver run
+// Each job leaves a log, result files and a line in the GUI log; the history ties
+// them together in one file per user:
+//
+//   run_history.lsrh       header, then one framed record per finished job:
+//                          magic, payload size, FNV-1a checksum, payload
+//   run_history.lsrh.idx   compact entry per record (offset, instance hash,
+//                          status, objective, config key, ...) and the data
+//                          size it covers
+//
+// Records are only ever appended, so a crash can at worst leave a torn last
+// frame, which the next open cuts off. The index is a cache: records past the
+// size it covers are read from the data file on open, and a missing or damaged
+// index is rebuilt from it. Queries work on the in-memory entries (instance ->
+// runs, instance -> best run) and only Read() touches the data file.
+
+#ifndef RUN_HISTORY_H_
+#define RUN_HISTORY_H_
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class RunStatus : uint8_t {
+    Success = 0,
+    Failed = 1,
+    Cancelled = 2,
+};
+
+struct RunStageRecord {
+    int stage = 0;
+    double objective = 0.0;
+    double runtime = 0.0;
+    double gap = 0.0;
+};
+
+// Everything known about one job
+struct RunRecord {
+    int64_t started = 0;            // ms since epoch
+    RunStatus status = RunStatus::Failed;
+    std::string message;
+    std::string algorithm;
+    std::string instance_path;      // UTF-8
+    std::string instance_hash;      // hex MD5 of the instance CSV, empty if unknown
+    int n = 0;
+    int t = 0;
+    int g = 0;
+    int f = 0;
+    std::vector<std::string> arguments;    // solver executable, then its argv
+    std::vector<RunStageRecord> stages;    // StageCompleted, in order
+    double wall_seconds = 0.0;
+    double cpu_seconds = 0.0;
+    int64_t peak_rss_bytes = 0;
+    std::vector<std::string> artifacts;    // log and result files
+
+    // Objective of the last completed stage; NaN without stages
+    double Objective() const;
+};
+
+// Index entry of one record
+struct RunHistoryEntry {
+    uint64_t offset = 0;            // of the frame in the data file
+    uint32_t size = 0;              // payload bytes
+    int64_t started = 0;
+    RunStatus status = RunStatus::Failed;
+    std::string algorithm;
+    std::string instance_hash;
+    double objective;               // NaN without stages
+    double wall_seconds = 0.0;
+    uint64_t config_key = 0;        // see RunConfigKey
+
+    RunHistoryEntry();
+};
+
+// Hash of the solver arguments without the executable and the per-run paths
+// (-f, -o, -l): equal keys mean the same algorithm and parameters
+uint64_t RunConfigKey(const std::vector<std::string>& arguments);
+
+class RunHistory {
+public:
+    // Opens (or creates) the history at |path|; the index sits next to it as
+    // <path>.idx
+    explicit RunHistory(const std::string& path);
+    ~RunHistory();
+
+    RunHistory(const RunHistory&) = delete;
+    RunHistory& operator=(const RunHistory&) = delete;
+
+    // Process-wide history under AppLocalData
+    static RunHistory& Shared();
+
+    // All methods are thread-safe
+    bool Append(const RunRecord& record);
+    bool Read(const RunHistoryEntry& entry, RunRecord* record) const;
+
+    size_t Size() const;
+    std::vector<RunHistoryEntry> Entries() const;
+
+    // Runs of one instance, oldest first
+    std::vector<RunHistoryEntry> RunsOfInstance(const std::string& hash) const;
+    int RunCount(const std::string& hash) const;
+
+    // Successful run with the lowest objective; false if there is none
+    bool BestRun(const std::string& hash, RunHistoryEntry* best) const;
+
+    // Best successful run of each configuration, best first
+    std::vector<RunHistoryEntry> BestPerConfig(const std::string& hash) const;
+
+    // Write the index now (otherwise every kIndexSaveInterval appends and on
+    // destruction)
+    bool SaveIndex();
+
+    static constexpr int kIndexSaveInterval = 16;
+
+private:
+    void Open();
+    bool LoadIndex();
+    void ScanData(uint64_t from);
+    void AddEntry(const RunHistoryEntry& entry);
+    bool SaveIndexLocked();
+
+    std::string path_;
+    std::string index_path_;
+
+    mutable std::mutex mutex_;
+    uint64_t data_size_;                // valid bytes in the data file
+    int unsaved_;                       // appends since the index was written
+    std::vector<RunHistoryEntry> entries_;
+    std::unordered_map<std::string, std::vector<size_t>> by_instance_;
+    std::unordered_map<std::string, size_t> best_;
+};
+
+#endif  // RUN_HISTORY_H_
@@ -0,0 +1,197 @@
+// run_predictor.cpp - Solver run cost predictor implementation
+
+#include "run_predictor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+constexpr uint32_t kPredictorMagic = 0x5052534C;  // "LSRP"
+constexpr uint32_t kPredictorVersion = 1;
+
+// Ridge weight on everything but the intercept: keeps the fit defined while
+// there are fewer runs than features
+constexpr double kRidge = 1e-2;
+
+using Phi = std::array<double, RunPredictor::kFeatureCount>;
+
+Phi Features(const RunFeatures& f) {
+    const double merged = std::log1p(std::max(f.merged, 0));
+    const double periods = std::log1p(std::max(f.t, 0));
+    return {
+        1.0,
+        merged,
+        periods,
+        std::log1p(std::max(f.g, 0)),
+        std::log1p(std::max(f.f, 0)),
+        merged * periods,
+        std::log1p(std::max(f.time_limit, 0.0)),
+        std::log1p(std::max(f.threads, 0)),
+        std::log1p(std::max(f.window, 0)),
+        std::log1p(std::max(f.subproblem_time, 0.0)),
+        std::log1p(std::max(f.rounds, 0)),
+        std::log1p(std::max(f.n, 0)) - merged
+    };
+}
+
+double Dot(const Phi& a, const Phi& b) {
+    double sum = 0.0;
+    for (int i = 0; i < RunPredictor::kFeatureCount; ++i) sum += a[i] * b[i];
+    return sum;
+}
+
+template <typename T>
+void WritePod(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool ReadPod(std::ifstream& in, T* value) {
+    in.read(reinterpret_cast<char*>(value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+}  // namespace
+
+void RunPredictor::Add(const RunFeatures& features, const RunCost& cost) {
+    if (features.algorithm < 0 || features.algorithm >= kAlgorithmCount) return;
+    const Phi phi = Features(features);
+    const double targets[kTargetCount] = {cost.wall_seconds, cost.cpu_seconds, cost.peak_rss_mb};
+
+    for (int k = 0; k < kTargetCount; ++k) {
+        if (!(targets[k] > 0.0)) continue;
+        const double y = std::log(targets[k]);
+        Fit& fit = fits_[features.algorithm][k];
+        ++fit.count;
+        fit.yy += y * y;
+        for (int i = 0; i < kFeatureCount; ++i) {
+            fit.xy[i] += phi[i] * y;
+            for (int j = 0; j < kFeatureCount; ++j) {
+                fit.xx[i * kFeatureCount + j] += phi[i] * phi[j];
+            }
+        }
+    }
+}
+
+bool RunPredictor::Solve(const Fit& fit, std::array<double, kFeatureCount>* weights,
+                         double* residual) {
+    if (fit.count < kMinSamples) return false;
+
+    // Cholesky of (X^T X + ridge), then two triangular solves
+    constexpr int k = kFeatureCount;
+    std::array<double, k * k> a = fit.xx;
+    for (int i = 1; i < k; ++i) a[i * k + i] += kRidge;
+    a[0] += 1e-9;
+    for (int j = 0; j < k; ++j) {
+        double diagonal = a[j * k + j];
+        for (int p = 0; p < j; ++p) diagonal -= a[j * k + p] * a[j * k + p];
+        if (diagonal <= 0.0) return false;
+        diagonal = std::sqrt(diagonal);
+        a[j * k + j] = diagonal;
+        for (int i = j + 1; i < k; ++i) {
+            double value = a[i * k + j];
+            for (int p = 0; p < j; ++p) value -= a[i * k + p] * a[j * k + p];
+            a[i * k + j] = value / diagonal;
+        }
+    }
+    Phi& w = *weights;
+    for (int i = 0; i < k; ++i) {
+        double value = fit.xy[i];
+        for (int p = 0; p < i; ++p) value -= a[i * k + p] * w[p];
+        w[i] = value / a[i * k + i];
+    }
+    for (int i = k - 1; i >= 0; --i) {
+        double value = w[i];
+        for (int p = i + 1; p < k; ++p) value -= a[p * k + i] * w[p];
+        w[i] = value / a[i * k + i];
+    }
+
+    // Residual sum of squares from the statistics: y^T y - 2 w^T X^T y + w^T X^T X w
+    double quadratic = 0.0;
+    for (int i = 0; i < k; ++i) {
+        double row = 0.0;
+        for (int j = 0; j < k; ++j) row += fit.xx[i * k + j] * w[j];
+        quadratic += w[i] * row;
+    }
+    const double sse = std::max(0.0, fit.yy - 2.0 * Dot(w, fit.xy) + quadratic);
+    *residual = std::sqrt(sse / static_cast<double>(std::max<int64_t>(1, fit.count - 1)));
+    return true;
+}
+
+RunPrediction RunPredictor::Predict(const RunFeatures& features) const {
+    RunPrediction prediction;
+    if (features.algorithm < 0 || features.algorithm >= kAlgorithmCount) return prediction;
+    const Phi phi = Features(features);
+
+    double* outputs[kTargetCount] = {&prediction.cost.wall_seconds, &prediction.cost.cpu_seconds,
+                                     &prediction.cost.peak_rss_mb};
+    for (int k = 0; k < kTargetCount; ++k) {
+        const Fit& fit = fits_[features.algorithm][k];
+        Phi weights;
+        double residual = 0.0;
+        if (!Solve(fit, &weights, &residual)) continue;
+        *outputs[k] = std::exp(Dot(weights, phi));
+        if (k == 0) {
+            prediction.valid = true;
+            prediction.samples = static_cast<int>(fit.count);
+            prediction.spread = std::exp(residual);
+        }
+    }
+    return prediction;
+}
+
+int RunPredictor::Samples(int algorithm) const {
+    if (algorithm < 0 || algorithm >= kAlgorithmCount) return 0;
+    return static_cast<int>(fits_[algorithm][0].count);
+}
+
+void RunPredictor::Clear() {
+    for (auto& algorithm : fits_) {
+        for (auto& fit : algorithm) fit = Fit();
+    }
+}
+
+bool RunPredictor::Load(const std::string& path) {
+    Clear();
+    std::ifstream in(std::filesystem::u8path(path), std::ios::binary);
+    if (!in) return false;
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    uint32_t features = 0;
+    if (!ReadPod(in, &magic) || !ReadPod(in, &version) || !ReadPod(in, &features) ||
+        magic != kPredictorMagic || version != kPredictorVersion || features != kFeatureCount) {
+        return false;
+    }
+    for (auto& algorithm : fits_) {
+        for (auto& fit : algorithm) {
+            if (!ReadPod(in, &fit.count) || !ReadPod(in, &fit.yy) ||
+                !ReadPod(in, &fit.xx) || !ReadPod(in, &fit.xy)) {
+                Clear();
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool RunPredictor::Save(const std::string& path) const {
+    std::ofstream out(std::filesystem::u8path(path), std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    WritePod<uint32_t>(out, kPredictorMagic);
+    WritePod<uint32_t>(out, kPredictorVersion);
+    WritePod<uint32_t>(out, kFeatureCount);
+    for (const auto& algorithm : fits_) {
+        for (const auto& fit : algorithm) {
+            WritePod(out, fit.count);
+            WritePod(out, fit.yy);
+            WritePod(out, fit.xx);
+            WritePod(out, fit.xy);
+        }
+    }
+    return static_cast<bool>(out);
+}
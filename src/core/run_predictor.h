@@ -0,0 +1,88 @@
+// run_predictor.h - Wall time / CPU time / peak memory predictor for solver runs
+// One regression per algorithm and target, fitted in log space so that power
+// laws in the problem size become linear:
+//
+//   log(target) ~ w . phi(features)
+//   phi = 1, log1p of merged orders, T, G, F, merged x T (as a product of logs),
+//         time limit, CPLEX threads, window, subproblem time, rounds / iterations,
+//         and log1p(N) - log1p(merged) for how much the merge removed
+//
+// Only the sufficient statistics (phi phi^T, phi y, y^2, count) are kept, so a
+// finished run is added in O(k^2) and the ridge solution is recomputed from
+// them (k = 12); the raw samples never need to be stored. Predictions need
+// kMinSamples runs of the algorithm and come with the residual spread as a
+// multiplicative factor.
+
+#ifndef RUN_PREDICTOR_H_
+#define RUN_PREDICTOR_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+// Problem and configuration of one run. Parameters an algorithm does not use
+// are 0.
+struct RunFeatures {
+    int algorithm = 0;          // AlgorithmType index (RF, RFO, RR, LR)
+    int n = 0;                  // orders in the instance
+    int merged = 0;             // orders after the merge
+    int t = 0;
+    int g = 0;
+    int f = 0;
+    double time_limit = 0.0;    // CPLEX time limit (s)
+    int threads = 0;            // CPLEX threads actually available
+    int window = 0;             // RF / FO window
+    double subproblem_time = 0.0;  // RF / FO time per subproblem (s)
+    int rounds = 0;             // FO rounds or LR iterations
+};
+
+// Measured cost of one run
+struct RunCost {
+    double wall_seconds = 0.0;
+    double cpu_seconds = 0.0;
+    double peak_rss_mb = 0.0;
+};
+
+struct RunPrediction {
+    bool valid = false;         // enough runs of this algorithm
+    int samples = 0;
+    RunCost cost;
+    double spread = 1.0;        // typical factor between prediction and outcome
+};
+
+class RunPredictor {
+public:
+    static constexpr int kAlgorithmCount = 4;
+    static constexpr int kTargetCount = 3;      // wall, cpu, memory
+    static constexpr int kFeatureCount = 12;
+    static constexpr int kMinSamples = 3;
+
+    // Learn from one finished run. Non-positive targets are not learned.
+    void Add(const RunFeatures& features, const RunCost& cost);
+
+    RunPrediction Predict(const RunFeatures& features) const;
+
+    int Samples(int algorithm) const;
+    void Clear();
+
+    // Persistent state (binary, see run_predictor.cpp). Load() of a missing or
+    // outdated file leaves the predictor empty and returns false.
+    bool Load(const std::string& path);
+    bool Save(const std::string& path) const;
+
+private:
+    struct Fit {
+        int64_t count = 0;
+        double yy = 0.0;
+        std::array<double, kFeatureCount * kFeatureCount> xx = {};
+        std::array<double, kFeatureCount> xy = {};
+    };
+
+    // Ridge solution of |fit|; false if it has too few samples
+    static bool Solve(const Fit& fit, std::array<double, kFeatureCount>* weights,
+                      double* residual);
+
+    Fit fits_[kAlgorithmCount][kTargetCount];
+};
+
+#endif  // RUN_PREDICTOR_H_
@@ -58,6 +58,8 @@ void CplexSettingsWidget::SetupUi() {
 
     layout->addWidget(threads_label);
     layout->addWidget(threads_spin_);
+    connect(threads_spin_, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, &CplexSettingsWidget::ThreadsChanged);
 
     layout->addStretch();
 }
@@ -19,6 +19,9 @@ public:
     int GetWorkMem() const;
     int GetThreads() const;
 
+signals:
+    void ThreadsChanged(int threads);
+
 private slots:
     void OnBrowseWorkDir();
 
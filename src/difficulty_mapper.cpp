@@ -86,24 +86,24 @@ QString DifficultyMapper::EstimateGap(const GeneratorConfig& config) {
 }
 
 double DifficultyMapper::EstimateDifficultyScore(const GeneratorConfig& config) {
-    // Difficulty scoring formula from analysis document
-    double score = 0.0;
-
-    // Capacity utilization (weight: 0.30)
-    score += 0.30 * (config.capacity_utilization / 0.70);
-
-    // Time window tightness (weight: 0.20)
-    double avg_window = 2.0 * config.time_window_offset + 1.0;
-    score += 0.20 * (1.0 - avg_window / config.T);
-
-    // Problem scale (weight: 0.20)
-    score += 0.20 * (static_cast<double>(config.N) * config.T / 3000.0);
-
-    // Demand variability (weight: 0.15)
-    score += 0.15 * (config.peak_multiplier / 2.0);
-
-    // Group complexity (weight: 0.15)
-    score += 0.15 * (static_cast<double>(config.G) / 5.0);
+    // Same formula the generator writes into file names
+    return InstanceDifficultyScore(ToGenParams(config));
+}
 
-    return score;
+InstanceGenParams DifficultyMapper::ToGenParams(const GeneratorConfig& config) {
+    InstanceGenParams params;
+    params.n = config.N;
+    params.t = config.T;
+    params.f = config.F;
+    params.g = config.G;
+    params.capacity_utilization = config.capacity_utilization;
+    params.time_window_offset = config.time_window_offset;
+    params.demand_cv = config.demand_cv;
+    params.peak_ratio = config.peak_ratio;
+    params.peak_multiplier = config.peak_multiplier;
+    params.urgent_ratio = config.urgent_ratio;
+    params.flexible_ratio = config.flexible_ratio;
+    params.cost_correlation = config.cost_correlation;
+    params.zoom = config.zoom;
+    return params;
 }
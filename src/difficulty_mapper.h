@@ -6,6 +6,7 @@
 #define DIFFICULTY_MAPPER_H_
 
 #include <QString>
+#include "core/instance_generator.h"
 
 // Difficulty preset levels
 enum class DifficultyLevel {
@@ -45,6 +46,7 @@ struct GeneratorConfig {
     int seed;       // Random seed (0 = auto)
     int count;      // Number of instances to generate
     QString output_path;  // Output directory
+    bool native = false;  // Built-in generator instead of OrderGenCap (experimental)
 };
 
 // Difficulty mapper utility class
@@ -65,6 +67,9 @@ public:
     // Estimate difficulty score (0.0-2.5)
     static double EstimateDifficultyScore(const GeneratorConfig& config);
 
+    // Model parameters for the native generator
+    static InstanceGenParams ToGenParams(const GeneratorConfig& config);
+
 private:
     // Base parameter values for each difficulty level
     static constexpr double kCapacityUtil[] = {0.55, 0.70, 0.85, 0.95};
@@ -87,6 +87,12 @@ void GeneratorWidget::SetupUi() {
     path_layout->addWidget(browse_button_);
     common_layout->addRow(QString::fromUtf8("\u8f93\u51fa\u8def\u5f84:"), path_layout);
 
+    // Off: the LS-NTGF-Data-Cap generator (OrderGenCap) is run as before
+    native_check_ = new QCheckBox(QString::fromUtf8(
+        "\u4f7f\u7528\u5185\u7f6e\u751f\u6210\u5668 (\u5b9e\u9a8c\u6027)"));
+    native_check_->setChecked(false);
+    common_layout->addRow(native_check_);
+
     main_layout->addWidget(common_group);
 
     // Preview label
@@ -168,14 +174,14 @@ void GeneratorWidget::SetupManualModeUi(QGroupBox* group) {
     // Row 1: N and T
     layout->addWidget(new QLabel(QString::fromUtf8("订单数(N)")), row, 0, Qt::AlignRight);
     n_spin_ = new QSpinBox();
-    n_spin_->setRange(10, 2000);
+    n_spin_->setRange(10, 1000000);
     n_spin_->setValue(100);
     n_spin_->setMinimumWidth(70);
     layout->addWidget(n_spin_, row, 1);
 
     layout->addWidget(new QLabel(QString::fromUtf8("周期数(T)")), row, 2, Qt::AlignRight);
     t_spin_ = new QSpinBox();
-    t_spin_->setRange(5, 90);
+    t_spin_->setRange(5, 365);
     t_spin_->setValue(30);
     t_spin_->setMinimumWidth(70);
     layout->addWidget(t_spin_, row, 3);
@@ -415,6 +421,7 @@ GeneratorConfig GeneratorWidget::GetConfig() const {
     config.seed = seed_spin_->value();
     config.count = count_spin_->value();
     config.output_path = output_edit_->text();
+    config.native = native_check_->isChecked();
 
     return config;
 }
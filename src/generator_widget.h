@@ -92,6 +92,7 @@ private:
     QSpinBox* count_spin_;
     QLineEdit* output_edit_;
     QPushButton* browse_button_;
+    QCheckBox* native_check_;
 
     // Preview
     QLabel* preview_label_;
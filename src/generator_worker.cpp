@@ -3,13 +3,17 @@
 #include "generator_worker.h"
 
 #include <QCoreApplication>
+#include <QDateTime>
 #include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
+#include <QRandomGenerator>
 #include <QTextStream>
 #include <QRegularExpression>
 
 GeneratorWorker::GeneratorWorker(QObject* parent)
     : QObject(parent)
+    , threads_(0)
     , generator_process_(nullptr)
     , current_instance_(0)
     , cancel_requested_(false) {
@@ -27,6 +31,10 @@ void GeneratorWorker::SetConfig(const GeneratorConfig& config) {
     config_ = config;
 }
 
+void GeneratorWorker::SetThreads(int threads) {
+    threads_ = threads;
+}
+
 QString GeneratorWorker::GetGeneratorExePath() const {
     // Look for the generator executable relative to GUI location
     QString app_dir = QCoreApplication::applicationDirPath();
@@ -82,6 +90,11 @@ void GeneratorWorker::RunGeneration() {
     generated_files_.clear();
     current_instance_ = 0;
 
+    if (config_.native) {
+        RunNativeGeneration();
+        return;
+    }
+
     QString exe_path = GetGeneratorExePath();
     if (exe_path.isEmpty()) {
         emit GenerationFinished(false, "Generator executable not found", QStringList());
@@ -97,6 +110,8 @@ void GeneratorWorker::RunGeneration() {
 
     // The current generator doesn't support command-line config,
     // so we run it directly with hardcoded params.
+    emit LogMessage("OrderGenCap uses its own configuration; the settings above apply "
+                    "to the built-in generator only");
     // For now, run the generator once (it generates based on its internal config)
     generator_process_ = new QProcess(this);
 
@@ -119,11 +134,66 @@ void GeneratorWorker::RunGeneration() {
     }
 }
 
+void GeneratorWorker::RunNativeGeneration() {
+    // Seed 0 means "auto": draw one and report it, so the batch can be reproduced
+    // (within the range the seed box accepts)
+    const int seed = config_.seed > 0 ? config_.seed
+                                      : QRandomGenerator::system()->bounded(1, 1000000);
+
+    InstanceGenBatch batch;
+    batch.params = DifficultyMapper::ToGenParams(config_);
+    batch.seed = static_cast<uint64_t>(seed);
+    batch.count = config_.count;
+    batch.output_dir = config_.output_path.toStdString();
+    batch.base_name = InstanceBaseName(
+        batch.params, QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss").toStdString());
+
+    emit GenerationStarted(config_.count);
+    emit LogMessage("Generator: built-in (experimental)");
+    emit LogMessage(QString("Output: %1").arg(config_.output_path));
+    emit LogMessage(QString("Config: N=%1 T=%2 F=%3 G=%4 util=%5 count=%6 seed=%7")
+        .arg(config_.N).arg(config_.T).arg(config_.F).arg(config_.G)
+        .arg(config_.capacity_utilization, 0, 'f', 2).arg(config_.count).arg(seed));
+
+    // Files are reported in completion order; their content depends only on the
+    // seed and their index, not on the thread count
+    std::atomic<int> done(0);
+    QElapsedTimer timer;
+    timer.start();
+    const bool ok = GenerateInstances(
+        &batch, threads_,
+        [this]() { return cancel_requested_.load(); },
+        [this, &done](int, const std::string& path) {
+            emit InstanceGenerated(++done, QString::fromStdString(path));
+        });
+
+    QStringList files;
+    for (size_t i = 0; i < batch.files.size(); ++i) {
+        if (batch.written[i]) files << QString::fromStdString(batch.files[i]);
+    }
+
+    QString message;
+    if (cancel_requested_) {
+        message = QString("Generation cancelled (%1 of %2 written)").arg(files.size()).arg(batch.count);
+    } else if (ok) {
+        message = QString("Generated %1 instance(s) in %2s")
+            .arg(files.size()).arg(timer.elapsed() / 1000.0, 0, 'f', 2);
+    } else {
+        message = QString("Generation failed: %1 of %2 file(s) could not be written to %3")
+            .arg(batch.count - files.size()).arg(batch.count).arg(config_.output_path);
+    }
+    emit GenerationFinished(ok, message, files);
+}
+
 void GeneratorWorker::RequestCancel() {
     cancel_requested_ = true;
-    if (generator_process_ && generator_process_->state() == QProcess::Running) {
-        generator_process_->kill();
-    }
+
+    // The process belongs to this worker's thread
+    QMetaObject::invokeMethod(this, [this]() {
+        if (generator_process_ && generator_process_->state() == QProcess::Running) {
+            generator_process_->kill();
+        }
+    }, Qt::QueuedConnection);
 }
 
 void GeneratorWorker::OnProcessOutput() {
@@ -139,12 +209,14 @@ void GeneratorWorker::OnProcessOutput() {
     for (const QString& line : lines) {
         emit LogMessage(line.trimmed());
 
-        // Check for file output
+        // Check for file output; the generator reports paths relative to its
+        // working directory
         if (line.contains("data/") && line.contains(".csv")) {
             QRegularExpression rx("(data/[^\\s]+\\.csv)");
             QRegularExpressionMatch match = rx.match(line);
             if (match.hasMatch()) {
-                QString filename = match.captured(1);
+                QString filename = QDir(generator_process_->workingDirectory())
+                    .absoluteFilePath(match.captured(1));
                 generated_files_.append(filename);
                 emit InstanceGenerated(generated_files_.size(), filename);
             }
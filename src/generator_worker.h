@@ -1,12 +1,16 @@
 // generator_worker.h - Background Generator Worker
 //
-// Runs the LS-NTGF-Data-Cap generator as a subprocess
+// Runs the LS-NTGF-Data-Cap generator (OrderGenCap) as a subprocess. With
+// GeneratorConfig::native set, instances are generated in-process instead by the
+// experimental native generator (core/instance_generator), several at a time on
+// a thread pool
 
 #ifndef GENERATOR_WORKER_H_
 #define GENERATOR_WORKER_H_
 
 #include <QObject>
 #include <QString>
+#include <QStringList>
 #include <QProcess>
 #include <atomic>
 #include "difficulty_mapper.h"
@@ -20,8 +24,12 @@ public:
 
     void SetConfig(const GeneratorConfig& config);
 
+    // Native generator workers; 0 (default): one per hardware thread
+    void SetThreads(int threads);
+
 public slots:
     void RunGeneration();
+    // Direct call from any thread: the native generator blocks this worker's thread
     void RequestCancel();
 
 signals:
@@ -35,10 +43,12 @@ private slots:
     void OnProcessFinished(int exitCode, QProcess::ExitStatus status);
 
 private:
+    void RunNativeGeneration();
     QString GetGeneratorExePath() const;
     QString BuildConfigFile() const;
 
     GeneratorConfig config_;
+    int threads_;
     QProcess* generator_process_;
     QStringList generated_files_;
     int current_instance_;
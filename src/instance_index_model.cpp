@@ -0,0 +1,237 @@
+// instance_index_model.cpp - Instance library index table model implementation
+
+#include "instance_index_model.h"
+#include "core/run_history.h"
+
+#include <QColor>
+#include <QDir>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+QString FormatNumber(double value, int decimals) {
+    return std::isfinite(value) ? QString::number(value, 'f', decimals) : QString("--");
+}
+
+QString FormatCount(int value) {
+    return value > 0 ? QString::number(value) : QString("--");
+}
+
+QString FormatSize(uint64_t bytes) {
+    if (bytes >= (1u << 20)) return QString("%1 MB").arg(bytes / 1048576.0, 0, 'f', 1);
+    return QString("%1 KB").arg(bytes / 1024.0, 0, 'f', 1);
+}
+
+// Displayed hash prefix; the tooltip has all of it
+constexpr int kHashShown = 8;
+
+}  // namespace
+
+InstanceIndexModel::InstanceIndexModel(QObject* parent)
+    : QAbstractTableModel(parent) {
+}
+
+void InstanceIndexModel::SetEntries(const InstanceIndexEntriesPtr& entries) {
+    beginResetModel();
+    entries_ = entries;
+    LoadHistory();
+    endResetModel();
+}
+
+void InstanceIndexModel::Clear() {
+    beginResetModel();
+    entries_.reset();
+    history_.clear();
+    endResetModel();
+}
+
+void InstanceIndexModel::RefreshHistory() {
+    if (rowCount() == 0) return;
+    LoadHistory();
+    emit dataChanged(index(0, kColRuns), index(rowCount() - 1, kColBest));
+}
+
+void InstanceIndexModel::LoadHistory() {
+    // Two indexed lookups per row
+    const RunHistory& history = RunHistory::Shared();
+    const size_t rows = entries_ ? entries_->size() : 0;
+    history_.assign(rows, RowHistory());
+    for (size_t i = 0; i < rows; ++i) {
+        const InstanceIndexEntry& entry = (*entries_)[i];
+        RowHistory& row = history_[i];
+        row.best = std::numeric_limits<double>::quiet_NaN();
+        if (entry.hash.empty()) continue;
+        row.runs = history.RunCount(entry.hash);
+        RunHistoryEntry best;
+        if (row.runs > 0 && history.BestRun(entry.hash, &best)) {
+            row.best = best.objective;
+            row.algorithm = QString::fromStdString(best.algorithm);
+        }
+    }
+}
+
+const InstanceIndexEntry* InstanceIndexModel::Entry(int row) const {
+    if (!entries_ || row < 0 || row >= static_cast<int>(entries_->size())) return nullptr;
+    return &(*entries_)[row];
+}
+
+QString InstanceIndexModel::Path(int row) const {
+    const InstanceIndexEntry* entry = Entry(row);
+    return entry ? QString::fromStdString(entry->path) : QString();
+}
+
+int InstanceIndexModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid() || !entries_) return 0;
+    return static_cast<int>(entries_->size());
+}
+
+int InstanceIndexModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : kColumnCount;
+}
+
+QVariant InstanceIndexModel::SortValue(int row, int column) const {
+    auto number = [](double value) { return std::isfinite(value) ? QVariant(value) : QVariant(); };
+    const InstanceIndexEntry& entry = (*entries_)[row];
+    switch (column) {
+        case kColN: return entry.n;
+        case kColT: return entry.t;
+        case kColG: return entry.g;
+        case kColF: return entry.f;
+        case kColDifficulty: return number(entry.difficulty);
+        case kColCapacity: return number(entry.capacity);
+        case kColRuns: return history_[row].runs;
+        case kColBest: return number(history_[row].best);
+        case kColSize: return static_cast<qulonglong>(entry.size);
+        case kColHash: return QString::fromStdString(entry.hash);
+        default: return QVariant();
+    }
+}
+
+QVariant InstanceIndexModel::data(const QModelIndex& index, int role) const {
+    const InstanceIndexEntry* entry = Entry(index.row());
+    if (!entry || !index.isValid()) return QVariant();
+
+    const QFileInfo info(QString::fromStdString(entry->path));
+    if (role == kSortRole) {
+        switch (index.column()) {
+            case kColFile: return info.fileName();
+            case kColFolder: return info.dir().dirName();
+            default: return SortValue(index.row(), index.column());
+        }
+    }
+
+    switch (role) {
+        case Qt::DisplayRole:
+            switch (index.column()) {
+                case kColFile: return info.fileName();
+                case kColN: return FormatCount(entry->n);
+                case kColT: return FormatCount(entry->t);
+                case kColG: return FormatCount(entry->g);
+                case kColF: return FormatCount(entry->f);
+                case kColDifficulty: return FormatNumber(entry->difficulty, 2);
+                case kColCapacity: return FormatNumber(entry->capacity, 0);
+                case kColRuns: return FormatCount(history_[index.row()].runs);
+                case kColBest: return FormatNumber(history_[index.row()].best, 2);
+                case kColSize: return FormatSize(entry->size);
+                case kColHash: return QString::fromStdString(entry->hash.substr(0, kHashShown));
+                case kColFolder: return info.dir().dirName();
+                default: return QVariant();
+            }
+        case Qt::TextAlignmentRole:
+            if (index.column() == kColFile || index.column() == kColFolder) {
+                return static_cast<int>(Qt::AlignLeft | Qt::AlignVCenter);
+            }
+            return static_cast<int>(Qt::AlignCenter);
+        case Qt::ToolTipRole: {
+            QString tip = QString::fromStdString(entry->path);
+            tip += QString::fromUtf8("\nMD5: %1").arg(QString::fromStdString(entry->hash));
+            if (!entry->ok) tip += QString::fromUtf8("\n(不是算例文件)");
+            const RowHistory& row = history_[index.row()];
+            if (std::isfinite(row.best)) {
+                tip += QString::fromUtf8("\n历史最优: %1 (%2)").arg(row.best, 0, 'f', 2).arg(row.algorithm);
+            }
+            return tip;
+        }
+        case Qt::ForegroundRole:
+            if (!entry->ok) return QColor("#adb5bd");
+            return QVariant();
+        default:
+            return QVariant();
+    }
+}
+
+QVariant InstanceIndexModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+    switch (section) {
+        case kColFile: return QString::fromUtf8("文件");
+        case kColN: return "N";
+        case kColT: return "T";
+        case kColG: return "G";
+        case kColF: return "F";
+        case kColDifficulty: return QString::fromUtf8("难度");
+        case kColCapacity: return QString::fromUtf8("产能");
+        case kColRuns: return QString::fromUtf8("运行");
+        case kColBest: return QString::fromUtf8("最优目标");
+        case kColSize: return QString::fromUtf8("大小");
+        case kColHash: return "MD5";
+        case kColFolder: return QString::fromUtf8("目录");
+        default: return QVariant();
+    }
+}
+
+//---------------------------------------
+// InstanceFilterProxy
+//---------------------------------------
+
+InstanceFilterProxy::InstanceFilterProxy(QObject* parent)
+    : QSortFilterProxyModel(parent) {
+}
+
+void InstanceFilterProxy::SetFilterText(const QString& text) {
+    static const QRegularExpression kCondition(
+        "^([NTGFDntgfd])(<=|>=|=|<|>)(\\d+(?:\\.\\d+)?)$");
+
+    conditions_.clear();
+    words_.clear();
+    const QStringList terms = text.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
+    for (const QString& term : terms) {
+        QRegularExpressionMatch match = kCondition.match(term);
+        if (match.hasMatch()) {
+            conditions_.push_back({match.captured(1).toUpper().at(0).toLatin1(),
+                                   match.captured(2), match.captured(3).toDouble()});
+        } else {
+            words_ << term;
+        }
+    }
+    invalidateFilter();
+}
+
+bool InstanceFilterProxy::filterAcceptsRow(int source_row, const QModelIndex&) const {
+    auto* model = static_cast<const InstanceIndexModel*>(sourceModel());
+    const InstanceIndexEntry* entry = model->Entry(source_row);
+    if (!entry) return false;
+
+    for (const Condition& c : conditions_) {
+        const double value = c.key == 'N' ? entry->n : c.key == 'T' ? entry->t :
+                             c.key == 'G' ? entry->g : c.key == 'F' ? entry->f :
+                             entry->difficulty;
+        if (!std::isfinite(value)) return false;
+        const bool holds = c.op == "=" ? std::abs(value - c.value) < 1e-9 :
+                           c.op == "<" ? value < c.value :
+                           c.op == "<=" ? value <= c.value :
+                           c.op == ">" ? value > c.value : value >= c.value;
+        if (!holds) return false;
+    }
+
+    if (words_.isEmpty()) return true;
+    const QString path = model->Path(source_row);
+    const QFileInfo info(path);
+    const QString name = info.fileName() + ' ' + info.dir().dirName();
+    for (const QString& word : words_) {
+        if (!name.contains(word, Qt::CaseInsensitive)) return false;
+    }
+    return true;
+}
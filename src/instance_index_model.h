@@ -0,0 +1,94 @@
+// instance_index_model.h - Table model over the instance library index
+// Display text is formatted on demand; kSortRole exposes raw values for sorting.
+// InstanceFilterProxy filters on words and size conditions, e.g. "N>=300 T=30 D<1.2".
+
+#ifndef INSTANCE_INDEX_MODEL_H_
+#define INSTANCE_INDEX_MODEL_H_
+
+#include <QAbstractTableModel>
+#include <QSortFilterProxyModel>
+#include <QString>
+#include <QStringList>
+#include <vector>
+#include "instance_index_worker.h"
+
+class InstanceIndexModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column {
+        kColFile = 0,
+        kColN,
+        kColT,
+        kColG,
+        kColF,
+        kColDifficulty,
+        kColCapacity,
+        kColRuns,
+        kColBest,
+        kColSize,
+        kColHash,
+        kColFolder,
+        kColumnCount
+    };
+
+    static const int kSortRole = Qt::UserRole + 1;
+
+    explicit InstanceIndexModel(QObject* parent = nullptr);
+
+    void SetEntries(const InstanceIndexEntriesPtr& entries);
+    void Clear();
+
+    // Re-read run count and best objective of every row from the run history
+    void RefreshHistory();
+
+    const InstanceIndexEntry* Entry(int row) const;
+    QString Path(int row) const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+private:
+    // Run history of one row, looked up by content hash
+    struct RowHistory {
+        int runs = 0;
+        double best;            // NaN without a successful run
+        QString algorithm;      // of the best run
+    };
+
+    QVariant SortValue(int row, int column) const;
+    void LoadHistory();
+
+    InstanceIndexEntriesPtr entries_;
+    std::vector<RowHistory> history_;
+};
+
+class InstanceFilterProxy : public QSortFilterProxyModel {
+    Q_OBJECT
+
+public:
+    explicit InstanceFilterProxy(QObject* parent = nullptr);
+
+    // Whitespace separated terms, all of which must hold: "<key><op><number>"
+    // with key N/T/G/F/D (difficulty) and op one of = < <= > >=; any other term
+    // must occur in the file or folder name (case-insensitive)
+    void SetFilterText(const QString& text);
+
+protected:
+    bool filterAcceptsRow(int source_row, const QModelIndex& source_parent) const override;
+
+private:
+    struct Condition {
+        char key;
+        QString op;
+        double value;
+    };
+
+    std::vector<Condition> conditions_;
+    QStringList words_;
+};
+
+#endif  // INSTANCE_INDEX_MODEL_H_
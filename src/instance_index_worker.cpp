@@ -0,0 +1,90 @@
+// instance_index_worker.cpp - Background Instance Library Scan Worker Implementation
+
+#include "instance_index_worker.h"
+#include "core/instance_cache.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+InstanceIndexWorker::InstanceIndexWorker(QObject* parent)
+    : QObject(parent) {
+    qRegisterMetaType<InstanceIndexEntriesPtr>("InstanceIndexEntriesPtr");
+    qRegisterMetaType<BatchInstancesPtr>("BatchInstancesPtr");
+}
+
+void InstanceIndexWorker::RequestCancel(int request_id) {
+    cancellation_.Cancel(request_id);
+}
+
+void InstanceIndexWorker::RequestBatchCancel(int request_id) {
+    batch_cancellation_.Cancel(request_id);
+}
+
+QString InstanceIndexWorker::IndexPathFor(const QString& root) {
+    QString canonical = QDir::cleanPath(QFileInfo(root).absoluteFilePath());
+    QByteArray key = QCryptographicHash::hash(canonical.toUtf8(), QCryptographicHash::Md5).toHex();
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)
+        + "/instance_index";
+    return QString("%1/%2.lsii").arg(dir, QString::fromLatin1(key));
+}
+
+void InstanceIndexWorker::Scan(int request_id, const QString& root) {
+    if (cancellation_.IsCancelled(request_id)) {
+        emit ScanCancelled(request_id);
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Switch roots: start from the persisted index of the new root (if any)
+    const QString index_path = IndexPathFor(root);
+    if (root != index_root_) {
+        index_.Load(index_path.toStdString());
+        index_root_ = root;
+    }
+
+    auto cancelled = cancellation_.Check(request_id);
+    auto progress = [this, request_id](size_t done, size_t total) {
+        emit ScanProgress(request_id, static_cast<int>(done), static_cast<int>(total));
+    };
+    InstanceScanStats stats = index_.Scan(root.toStdString(), 0, cancelled, progress);
+    if (stats.cancelled) {
+        emit ScanCancelled(request_id);
+        return;
+    }
+
+    QDir().mkpath(QFileInfo(index_path).absolutePath());
+    index_.Save(index_path.toStdString());
+
+    auto entries = std::make_shared<std::vector<InstanceIndexEntry>>(index_.Entries());
+    QString message = QString::fromUtf8("共 %1 个算例文件 (复用 %2, 读取 %3, 非算例 %4), 用时 %5 s")
+        .arg(stats.files)
+        .arg(stats.reused)
+        .arg(stats.parsed)
+        .arg(stats.failed)
+        .arg(timer.elapsed() / 1000.0, 0, 'f', 2);
+    emit ScanFinished(request_id, entries, message);
+}
+
+void InstanceIndexWorker::LoadBatch(int request_id, const QStringList& paths, bool merge_enabled,
+                                    double big_order_threshold) {
+    // A superseded request is dropped without an answer; the newer one replies
+    auto instances = std::make_shared<std::vector<BatchInstance>>(static_cast<size_t>(paths.size()));
+    bool done = RunParallel(instances->size(), 0, [&](size_t k) {
+        BatchInstance& item = (*instances)[k];
+        item.path = paths.at(static_cast<int>(k));
+        InstanceDataPtr instance = LoadInstanceCached(item.path, &item.error);
+        if (!instance) return;
+        item.n = instance->n;
+        item.t = instance->t;
+        item.g = instance->g;
+        item.f = instance->f;
+        item.merge = OrderMergePreview(*instance).Estimate(merge_enabled, big_order_threshold);
+    }, batch_cancellation_.Check(request_id));
+    if (!done) return;
+    emit BatchLoaded(request_id, instances);
+}
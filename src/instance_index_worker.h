@@ -0,0 +1,74 @@
+// instance_index_worker.h - Background Instance Library Scan Worker
+//
+// Keeps an InstanceIndex per data root, loads/saves it under the application
+// data directory and rescans the tree off the GUI thread. Also reads the
+// instances of a batch solve, so queueing many large files does not block the UI.
+
+#ifndef INSTANCE_INDEX_WORKER_H_
+#define INSTANCE_INDEX_WORKER_H_
+
+#include <QObject>
+#include <QMetaType>
+#include <QString>
+#include <QStringList>
+#include <memory>
+#include <vector>
+#include "core/instance_index.h"
+#include "core/order_merge.h"
+#include "core/parallel.h"
+
+using InstanceIndexEntriesPtr = std::shared_ptr<const std::vector<InstanceIndexEntry>>;
+
+// One instance of a batch solve: counts and the merged model estimate. Only
+// these are kept, the instance itself is released once read.
+struct BatchInstance {
+    QString path;
+    int n = 0;
+    int t = 0;
+    int g = 0;
+    int f = 0;
+    MergeEstimate merge;
+    QString error;      // set if the instance could not be read
+};
+
+using BatchInstancesPtr = std::shared_ptr<const std::vector<BatchInstance>>;
+
+Q_DECLARE_METATYPE(InstanceIndexEntriesPtr)
+Q_DECLARE_METATYPE(BatchInstancesPtr)
+
+class InstanceIndexWorker : public QObject {
+    Q_OBJECT
+
+public:
+    explicit InstanceIndexWorker(QObject* parent = nullptr);
+
+    // Cancel every request with id <= request_id (thread-safe)
+    void RequestCancel(int request_id);
+    // Same for LoadBatch requests, which are numbered separately
+    void RequestBatchCancel(int request_id);
+
+    // Where the persistent index of |root| is stored
+    static QString IndexPathFor(const QString& root);
+
+public slots:
+    void Scan(int request_id, const QString& root);
+    // Read |paths| in parallel through the instance cache and estimate the merged
+    // model of each with the given merge settings (answers with BatchLoaded)
+    void LoadBatch(int request_id, const QStringList& paths, bool merge_enabled,
+                   double big_order_threshold);
+
+signals:
+    void ScanProgress(int request_id, int done, int total);
+    void ScanFinished(int request_id, const InstanceIndexEntriesPtr& entries, const QString& message);
+    void ScanCancelled(int request_id);
+    // In the order of the requested paths
+    void BatchLoaded(int request_id, const BatchInstancesPtr& instances);
+
+private:
+    RequestCancellation cancellation_;
+    RequestCancellation batch_cancellation_;
+    InstanceIndex index_;
+    QString index_root_;
+};
+
+#endif  // INSTANCE_INDEX_WORKER_H_
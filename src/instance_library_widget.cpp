@@ -0,0 +1,263 @@
+// instance_library_widget.cpp - Instance library browser implementation
+
+#include "instance_library_widget.h"
+#include "instance_index_model.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QItemSelectionModel>
+#include <QLabel>
+#include <QLineEdit>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QTableView>
+#include <QThread>
+#include <algorithm>
+
+InstanceLibraryWidget::InstanceLibraryWidget(QWidget* parent)
+    : QWidget(parent)
+    , scan_thread_(nullptr)
+    , scan_worker_(nullptr)
+    , scan_request_id_(0)
+    , batch_request_id_(0) {
+    SetupUi();
+    SetupWorker();
+}
+
+InstanceLibraryWidget::~InstanceLibraryWidget() {
+    if (scan_thread_) {
+        scan_worker_->RequestCancel(scan_request_id_);
+        scan_worker_->RequestBatchCancel(batch_request_id_);
+        scan_thread_->quit();
+        scan_thread_->wait();
+    }
+}
+
+void InstanceLibraryWidget::SetupUi() {
+    auto* layout = new QVBoxLayout(this);
+    layout->setSpacing(8);
+    layout->setContentsMargins(4, 4, 4, 4);
+
+    // Root directory + scan controls
+    auto* root_layout = new QHBoxLayout();
+    root_layout->addWidget(new QLabel(QString::fromUtf8("算例目录:"), this));
+    root_edit_ = new QLineEdit("D:/YM-Code/LS-NTGF-Data-Cap/data", this);
+    root_layout->addWidget(root_edit_, 1);
+    browse_button_ = new QPushButton(QString::fromUtf8("浏览..."), this);
+    scan_button_ = new QPushButton(QString::fromUtf8("扫描"), this);
+    cancel_button_ = new QPushButton(QString::fromUtf8("取消"), this);
+    cancel_button_->setVisible(false);
+    root_layout->addWidget(browse_button_);
+    root_layout->addWidget(scan_button_);
+    root_layout->addWidget(cancel_button_);
+    layout->addLayout(root_layout);
+
+    // Filter + actions on the selection
+    auto* action_layout = new QHBoxLayout();
+    filter_edit_ = new QLineEdit(this);
+    filter_edit_->setPlaceholderText(QString::fromUtf8("筛选 (文件名/目录, 或 N>=300 T=30 D<1.2 ...)"));
+    filter_edit_->setClearButtonEnabled(true);
+    action_layout->addWidget(filter_edit_, 1);
+    open_button_ = new QPushButton(QString::fromUtf8("载入求解"), this);
+    batch_button_ = new QPushButton(QString::fromUtf8("批量求解"), this);
+    open_button_->setEnabled(false);
+    batch_button_->setEnabled(false);
+    action_layout->addWidget(open_button_);
+    action_layout->addWidget(batch_button_);
+    layout->addLayout(action_layout);
+
+    auto* status_layout = new QHBoxLayout();
+    status_label_ = new QLabel(QString::fromUtf8("未扫描"), this);
+    status_label_->setStyleSheet("color: #6c757d; font-size: 9pt;");
+    count_label_ = new QLabel(this);
+    count_label_->setStyleSheet("color: #6c757d; font-size: 9pt;");
+    status_layout->addWidget(status_label_, 1);
+    status_layout->addWidget(count_label_);
+    layout->addLayout(status_layout);
+
+    progress_bar_ = new QProgressBar(this);
+    progress_bar_->setTextVisible(true);
+    progress_bar_->setVisible(false);
+    layout->addWidget(progress_bar_);
+
+    // Table: model formats on demand, proxy sorts on raw values and filters
+    model_ = new InstanceIndexModel(this);
+    proxy_ = new InstanceFilterProxy(this);
+    proxy_->setSourceModel(model_);
+    proxy_->setSortRole(InstanceIndexModel::kSortRole);
+
+    table_ = new QTableView(this);
+    table_->setModel(proxy_);
+    table_->setSortingEnabled(true);
+    table_->sortByColumn(InstanceIndexModel::kColFile, Qt::AscendingOrder);
+    table_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table_->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table_->setAlternatingRowColors(true);
+    table_->verticalHeader()->setVisible(false);
+    table_->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    table_->verticalHeader()->setDefaultSectionSize(table_->fontMetrics().height() + 8);
+    table_->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    table_->horizontalHeader()->setStretchLastSection(true);
+    table_->setColumnWidth(InstanceIndexModel::kColFile, 280);
+    layout->addWidget(table_, 1);
+
+    // Connections
+    connect(browse_button_, &QPushButton::clicked, this, &InstanceLibraryWidget::OnBrowseRoot);
+    connect(scan_button_, &QPushButton::clicked, this, &InstanceLibraryWidget::OnScan);
+    connect(root_edit_, &QLineEdit::returnPressed, this, &InstanceLibraryWidget::OnScan);
+    connect(cancel_button_, &QPushButton::clicked, this, &InstanceLibraryWidget::OnCancelScan);
+    connect(filter_edit_, &QLineEdit::textChanged, this, &InstanceLibraryWidget::OnFilterChanged);
+    connect(open_button_, &QPushButton::clicked, this, &InstanceLibraryWidget::OnOpenSelected);
+    connect(batch_button_, &QPushButton::clicked, this, &InstanceLibraryWidget::OnBatchSelected);
+    connect(table_, &QTableView::doubleClicked, this, &InstanceLibraryWidget::OnOpenSelected);
+    connect(table_->selectionModel(), &QItemSelectionModel::selectionChanged,
+            this, &InstanceLibraryWidget::OnSelectionChanged);
+}
+
+void InstanceLibraryWidget::SetupWorker() {
+    scan_thread_ = new QThread(this);
+    scan_worker_ = new InstanceIndexWorker();
+    scan_worker_->moveToThread(scan_thread_);
+
+    connect(this, &InstanceLibraryWidget::RequestScan, scan_worker_, &InstanceIndexWorker::Scan);
+    connect(scan_worker_, &InstanceIndexWorker::ScanProgress,
+            this, &InstanceLibraryWidget::OnScanProgress);
+    connect(scan_worker_, &InstanceIndexWorker::ScanFinished,
+            this, &InstanceLibraryWidget::OnScanFinished);
+    connect(scan_worker_, &InstanceIndexWorker::ScanCancelled,
+            this, &InstanceLibraryWidget::OnScanCancelled);
+    connect(this, &InstanceLibraryWidget::RequestLoadBatch,
+            scan_worker_, &InstanceIndexWorker::LoadBatch);
+    connect(scan_worker_, &InstanceIndexWorker::BatchLoaded,
+            this, &InstanceLibraryWidget::OnBatchLoaded);
+
+    connect(scan_thread_, &QThread::finished, scan_worker_, &QObject::deleteLater);
+    scan_thread_->start();
+}
+
+void InstanceLibraryWidget::ScanDirectory(const QString& root) {
+    root_edit_->setText(root);
+    OnScan();
+}
+
+void InstanceLibraryWidget::RefreshHistory() {
+    model_->RefreshHistory();
+}
+
+void InstanceLibraryWidget::LoadBatch(const QStringList& paths, bool merge_enabled,
+                                      double big_order_threshold) {
+    scan_worker_->RequestBatchCancel(batch_request_id_);
+    ++batch_request_id_;
+    status_label_->setText(QString::fromUtf8("读取批量算例: %1 个").arg(paths.size()));
+    emit RequestLoadBatch(batch_request_id_, paths, merge_enabled, big_order_threshold);
+}
+
+void InstanceLibraryWidget::OnBatchLoaded(int request_id, const BatchInstancesPtr& instances) {
+    if (request_id != batch_request_id_) return;
+    status_label_->setText(QString::fromUtf8("批量算例已读取: %1 个").arg(instances->size()));
+    emit BatchLoaded(instances);
+}
+
+void InstanceLibraryWidget::OnBrowseRoot() {
+    QString dir = QFileDialog::getExistingDirectory(
+        this, QString::fromUtf8("选择算例目录"), root_edit_->text());
+    if (!dir.isEmpty()) {
+        ScanDirectory(dir);
+    }
+}
+
+void InstanceLibraryWidget::OnScan() {
+    const QString root = root_edit_->text().trimmed();
+    if (root.isEmpty()) return;
+
+    // Supersede any scan still in flight
+    scan_worker_->RequestCancel(scan_request_id_);
+    ++scan_request_id_;
+
+    status_label_->setText(QString::fromUtf8("扫描中: %1").arg(root));
+    SetScanning(true);
+    emit RequestScan(scan_request_id_, root);
+}
+
+void InstanceLibraryWidget::OnCancelScan() {
+    scan_worker_->RequestCancel(scan_request_id_);
+}
+
+void InstanceLibraryWidget::SetScanning(bool scanning) {
+    progress_bar_->setVisible(scanning);
+    progress_bar_->setRange(0, 0);  // busy until the first progress report
+    cancel_button_->setVisible(scanning);
+    scan_button_->setEnabled(!scanning);
+}
+
+void InstanceLibraryWidget::OnScanProgress(int request_id, int done, int total) {
+    if (request_id != scan_request_id_) return;
+    progress_bar_->setRange(0, total);
+    progress_bar_->setValue(done);
+    progress_bar_->setFormat(QString::fromUtf8("读取算例 %v / %m"));
+}
+
+void InstanceLibraryWidget::OnScanFinished(int request_id, const InstanceIndexEntriesPtr& entries,
+                                           const QString& message) {
+    if (request_id != scan_request_id_) return;
+    SetScanning(false);
+    model_->SetEntries(entries);
+    status_label_->setText(message);
+    OnSelectionChanged();
+}
+
+void InstanceLibraryWidget::OnScanCancelled(int request_id) {
+    if (request_id != scan_request_id_) return;
+    SetScanning(false);
+    status_label_->setText(QString::fromUtf8("扫描已取消"));
+}
+
+void InstanceLibraryWidget::OnFilterChanged(const QString& text) {
+    proxy_->SetFilterText(text);
+    UpdateCountLabel();
+}
+
+void InstanceLibraryWidget::UpdateCountLabel() {
+    count_label_->setText(QString::fromUtf8("显示 %1 / %2, 已选 %3")
+        .arg(proxy_->rowCount())
+        .arg(model_->rowCount())
+        .arg(SelectedPaths().size()));
+}
+
+QStringList InstanceLibraryWidget::SelectedPaths() const {
+    // In table order, so a batch runs the way the list is sorted
+    QModelIndexList rows = table_->selectionModel()->selectedRows();
+    std::sort(rows.begin(), rows.end(),
+              [](const QModelIndex& a, const QModelIndex& b) { return a.row() < b.row(); });
+    QStringList paths;
+    for (const QModelIndex& index : rows) {
+        const int source_row = proxy_->mapToSource(index).row();
+        const InstanceIndexEntry* entry = model_->Entry(source_row);
+        if (entry && entry->ok) paths << model_->Path(source_row);
+    }
+    return paths;
+}
+
+void InstanceLibraryWidget::OnSelectionChanged() {
+    const int count = SelectedPaths().size();
+    open_button_->setEnabled(count == 1);
+    batch_button_->setEnabled(count >= 1);
+    UpdateCountLabel();
+}
+
+void InstanceLibraryWidget::OnOpenSelected() {
+    const QStringList paths = SelectedPaths();
+    if (paths.size() == 1) {
+        emit OpenInstanceRequested(paths.first());
+    }
+}
+
+void InstanceLibraryWidget::OnBatchSelected() {
+    const QStringList paths = SelectedPaths();
+    if (!paths.isEmpty()) {
+        emit BatchSolveRequested(paths);
+    }
+}
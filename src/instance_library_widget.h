@@ -0,0 +1,91 @@
+// instance_library_widget.h - Instance library browser
+// Indexes a data tree in the background and lists every instance CSV with its
+// size, difficulty and content hash in a sortable, filterable table. One
+// instance can be loaded into the solver page, a selection queued as a batch.
+
+#ifndef INSTANCE_LIBRARY_WIDGET_H_
+#define INSTANCE_LIBRARY_WIDGET_H_
+
+#include <QWidget>
+#include <QString>
+#include <QStringList>
+#include "instance_index_worker.h"
+
+class QLabel;
+class QLineEdit;
+class QProgressBar;
+class QPushButton;
+class QTableView;
+class QThread;
+class InstanceIndexModel;
+class InstanceFilterProxy;
+
+class InstanceLibraryWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit InstanceLibraryWidget(QWidget* parent = nullptr);
+    ~InstanceLibraryWidget() override;
+
+    // Scan |root| (uses the persisted index of that root for unchanged files)
+    void ScanDirectory(const QString& root);
+
+    // Runs were added to the run history
+    void RefreshHistory();
+
+    // Read the instances of a batch off the GUI thread (answers with BatchLoaded;
+    // a newer call supersedes one still in flight)
+    void LoadBatch(const QStringList& paths, bool merge_enabled, double big_order_threshold);
+
+signals:
+    void RequestScan(int request_id, const QString& root);
+    void RequestLoadBatch(int request_id, const QStringList& paths, bool merge_enabled,
+                          double big_order_threshold);
+    // User wants to solve one instance / queue several
+    void OpenInstanceRequested(const QString& path);
+    void BatchSolveRequested(const QStringList& paths);
+    void BatchLoaded(const BatchInstancesPtr& instances);
+
+private slots:
+    void OnBrowseRoot();
+    void OnScan();
+    void OnCancelScan();
+    void OnFilterChanged(const QString& text);
+    void OnOpenSelected();
+    void OnBatchSelected();
+    void OnSelectionChanged();
+    void OnScanProgress(int request_id, int done, int total);
+    void OnScanFinished(int request_id, const InstanceIndexEntriesPtr& entries,
+                        const QString& message);
+    void OnScanCancelled(int request_id);
+    void OnBatchLoaded(int request_id, const BatchInstancesPtr& instances);
+
+private:
+    void SetupUi();
+    void SetupWorker();
+    void SetScanning(bool scanning);
+    void UpdateCountLabel();
+    QStringList SelectedPaths() const;
+
+    QLineEdit* root_edit_;
+    QPushButton* browse_button_;
+    QPushButton* scan_button_;
+    QPushButton* cancel_button_;
+    QLineEdit* filter_edit_;
+    QPushButton* open_button_;
+    QPushButton* batch_button_;
+    QLabel* status_label_;
+    QLabel* count_label_;
+    QProgressBar* progress_bar_;
+    QTableView* table_;
+    InstanceIndexModel* model_;
+    InstanceFilterProxy* proxy_;
+
+    // Background scanning
+    QThread* scan_thread_;
+    InstanceIndexWorker* scan_worker_;
+    int scan_request_id_;
+    int batch_request_id_;
+};
+
+#endif  // INSTANCE_LIBRARY_WIDGET_H_
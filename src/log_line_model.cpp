@@ -0,0 +1,137 @@
+// log_line_model.cpp - Virtualized log line model implementation
+
+#include "log_line_model.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace {
+
+// Offsets of the lines in |data|; a final line break does not start a line
+template <typename Offset>
+void IndexLines(const std::string& data, std::vector<Offset>* starts) {
+    starts->clear();
+    if (data.empty()) return;
+    starts->push_back(0);
+    for (size_t p = data.find('\n'); p != std::string::npos && p + 1 < data.size();
+         p = data.find('\n', p + 1)) {
+        starts->push_back(static_cast<Offset>(p + 1));
+    }
+}
+
+// Line [begin, end) of |data| without its line break, and without the UTF-8 BOM
+// on the first line of the file
+QString LineText(const std::string& data, size_t begin, size_t end) {
+    if (begin == 0 && data.compare(0, 3, "\xEF\xBB\xBF") == 0) begin = std::min<size_t>(3, end);
+    if (end > begin && data[end - 1] == '\n') --end;
+    if (end > begin && data[end - 1] == '\r') --end;
+    return QString::fromUtf8(data.data() + begin, static_cast<qsizetype>(end - begin));
+}
+
+}  // namespace
+
+LogLineModel::LogLineModel(QObject* parent)
+    : QAbstractListModel(parent)
+    , line_count_(0) {
+}
+
+bool LogLineModel::Open(const QString& path) {
+    beginResetModel();
+    text_.clear();
+    line_starts_.clear();
+    archive_.reset();
+    cache_.clear();
+    line_count_ = 0;
+
+    const std::string file = path.toStdString();
+    bool ok = false;
+    if (IsLogArchivePath(file)) {
+        auto reader = std::make_unique<LogArchiveReader>();
+        if (reader->Open(file) && reader->LineCount() <= static_cast<uint64_t>(INT_MAX)) {
+            line_count_ = static_cast<int>(reader->LineCount());
+            archive_ = std::move(reader);
+            ok = true;
+        }
+    } else if (ReadLogText(file, &text_)) {
+        IndexLines(text_, &line_starts_);
+        if (line_starts_.size() <= static_cast<size_t>(INT_MAX)) {
+            line_count_ = static_cast<int>(line_starts_.size());
+            ok = true;
+        } else {
+            text_.clear();
+            line_starts_.clear();
+        }
+    }
+    endResetModel();
+    return ok;
+}
+
+void LogLineModel::Clear() {
+    beginResetModel();
+    text_.clear();
+    line_starts_.clear();
+    archive_.reset();
+    cache_.clear();
+    line_count_ = 0;
+    endResetModel();
+}
+
+uint64_t LogLineModel::RawSize() const {
+    return archive_ ? archive_->RawSize() : text_.size();
+}
+
+int LogLineModel::FindNext(const QString& needle, int from, Qt::CaseSensitivity cs) const {
+    if (needle.isEmpty() || line_count_ == 0) return -1;
+    from = (from % line_count_ + line_count_) % line_count_;
+    for (int i = 0; i < line_count_; ++i) {
+        const int row = (from + i) % line_count_;
+        if (LineAt(row).contains(needle, cs)) return row;
+    }
+    return -1;
+}
+
+int LogLineModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : line_count_;
+}
+
+QVariant LogLineModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= line_count_) return QVariant();
+    if (role == Qt::DisplayRole || role == Qt::ToolTipRole) return LineAt(index.row());
+    return QVariant();
+}
+
+QString LogLineModel::LineAt(int row) const {
+    if (!archive_) {
+        const size_t begin = static_cast<size_t>(line_starts_[row]);
+        const size_t end = row + 1 < line_count_ ? static_cast<size_t>(line_starts_[row + 1])
+                                                 : text_.size();
+        return LineText(text_, begin, end);
+    }
+
+    const size_t index = archive_->BlockOfLine(static_cast<uint64_t>(row));
+    const Block* block = CachedBlock(index);
+    if (!block) return QString();
+    const size_t line = static_cast<size_t>(row - archive_->Blocks()[index].first_line);
+    if (line >= block->line_starts.size()) return QString();
+    const size_t begin = block->line_starts[line];
+    const size_t end = line + 1 < block->line_starts.size() ? block->line_starts[line + 1]
+                                                          : block->text.size();
+    return LineText(block->text, begin, end);
+}
+
+const LogLineModel::Block* LogLineModel::CachedBlock(size_t index) const {
+    auto it = std::find_if(cache_.begin(), cache_.end(),
+                           [index](const Block& b) { return b.index == index; });
+    if (it != cache_.end()) {
+        cache_.splice(cache_.begin(), cache_, it);
+        return &cache_.front();
+    }
+
+    Block block;
+    block.index = index;
+    if (!archive_->ReadBlock(index, &block.text)) return nullptr;
+    IndexLines(block.text, &block.line_starts);
+    cache_.push_front(std::move(block));
+    if (cache_.size() > static_cast<size_t>(kCachedBlocks)) cache_.pop_back();
+    return &cache_.front();
+}
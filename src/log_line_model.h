@@ -0,0 +1,61 @@
+// log_line_model.h - Virtualized line model over a solver log
+// A plain log is read once and indexed by line starts; a .logz archive is only
+// opened, and lines are cut out of the few decompressed blocks kept in a small
+// cache, so the view never holds more than it shows
+
+#ifndef LOG_LINE_MODEL_H_
+#define LOG_LINE_MODEL_H_
+
+#include <QAbstractListModel>
+#include <QString>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+#include "core/log_archive.h"
+
+class LogLineModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    explicit LogLineModel(QObject* parent = nullptr);
+
+    // Show the log at |path| (.log or .logz); false leaves the model empty
+    bool Open(const QString& path);
+    void Clear();
+
+    bool IsArchive() const { return archive_ != nullptr; }
+    uint64_t RawSize() const;
+    int LineCount() const { return line_count_; }
+
+    // First row at or after |from| (wrapping around) containing |needle|; -1 if none
+    int FindNext(const QString& needle, int from, Qt::CaseSensitivity cs) const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    static constexpr int kCachedBlocks = 8;
+
+private:
+    struct Block {
+        size_t index = 0;
+        std::string text;
+        std::vector<uint32_t> line_starts;
+    };
+
+    QString LineAt(int row) const;
+    const Block* CachedBlock(size_t index) const;
+
+    // Plain log
+    std::string text_;
+    std::vector<uint64_t> line_starts_;
+
+    // Archive, most recently used block first
+    std::unique_ptr<LogArchiveReader> archive_;
+    mutable std::list<Block> cache_;
+
+    int line_count_;
+};
+
+#endif  // LOG_LINE_MODEL_H_
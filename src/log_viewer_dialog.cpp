@@ -0,0 +1,116 @@
+// log_viewer_dialog.cpp - Log viewer implementation
+
+#include "log_viewer_dialog.h"
+#include "log_line_model.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QFontDatabase>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QListView>
+#include <QPushButton>
+#include <QSpinBox>
+#include <QVBoxLayout>
+#include <algorithm>
+
+LogViewerDialog::LogViewerDialog(QWidget* parent)
+    : QDialog(parent)
+    , model_(nullptr)
+    , view_(nullptr)
+    , info_label_(nullptr)
+    , line_spin_(nullptr)
+    , goto_button_(nullptr)
+    , find_edit_(nullptr)
+    , find_button_(nullptr) {
+    SetupUi();
+    setAttribute(Qt::WA_DeleteOnClose);
+    resize(1000, 650);
+}
+
+void LogViewerDialog::SetupUi() {
+    auto* layout = new QVBoxLayout(this);
+    layout->setSpacing(6);
+
+    auto* tool_layout = new QHBoxLayout();
+    tool_layout->addWidget(new QLabel(QString::fromUtf8("行:"), this));
+    line_spin_ = new QSpinBox(this);
+    line_spin_->setRange(1, 1);
+    line_spin_->setMinimumWidth(100);
+    tool_layout->addWidget(line_spin_);
+    goto_button_ = new QPushButton(QString::fromUtf8("跳转"), this);
+    tool_layout->addWidget(goto_button_);
+    tool_layout->addSpacing(12);
+    find_edit_ = new QLineEdit(this);
+    find_edit_->setPlaceholderText(QString::fromUtf8("查找文本 (不区分大小写)"));
+    tool_layout->addWidget(find_edit_, 1);
+    find_button_ = new QPushButton(QString::fromUtf8("查找下一个"), this);
+    tool_layout->addWidget(find_button_);
+    layout->addLayout(tool_layout);
+
+    // Fixed row height: the view lays out millions of rows without asking for each
+    model_ = new LogLineModel(this);
+    view_ = new QListView(this);
+    view_->setModel(model_);
+    view_->setUniformItemSizes(true);
+    view_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    view_->setSelectionMode(QAbstractItemView::SingleSelection);
+    view_->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    layout->addWidget(view_, 1);
+
+    info_label_ = new QLabel(this);
+    info_label_->setStyleSheet("color: #6c757d; font-size: 9pt;");
+    layout->addWidget(info_label_);
+
+    connect(goto_button_, &QPushButton::clicked, this, &LogViewerDialog::OnGoToLine);
+    connect(line_spin_, &QSpinBox::editingFinished, this, &LogViewerDialog::OnGoToLine);
+    connect(find_button_, &QPushButton::clicked, this, &LogViewerDialog::OnFindNext);
+    connect(find_edit_, &QLineEdit::returnPressed, this, &LogViewerDialog::OnFindNext);
+}
+
+bool LogViewerDialog::OpenLog(const QString& path) {
+    const QFileInfo info(path);
+    setWindowTitle(QString::fromUtf8("日志 - %1").arg(info.fileName()));
+    if (!model_->Open(path)) {
+        info_label_->setText(QString::fromUtf8("无法读取日志: %1").arg(path));
+        return false;
+    }
+
+    line_spin_->setRange(1, std::max(1, model_->LineCount()));
+    QString text = QString::fromUtf8("%1 行, %2 KB")
+                   .arg(model_->LineCount())
+                   .arg(model_->RawSize() / 1024);
+    if (model_->IsArchive() && info.size() > 0) {
+        text += QString::fromUtf8(" (压缩 %1 KB, %2x)")
+                .arg(info.size() / 1024)
+                .arg(static_cast<double>(model_->RawSize()) / info.size(), 0, 'f', 1);
+    }
+    summary_ = text + "  |  " + QDir::toNativeSeparators(path);
+    info_label_->setText(summary_);
+    return true;
+}
+
+void LogViewerDialog::OnGoToLine() {
+    SelectRow(line_spin_->value() - 1);
+}
+
+void LogViewerDialog::OnFindNext() {
+    const QModelIndex current = view_->currentIndex();
+    const int from = current.isValid() ? current.row() + 1 : 0;
+    const int row = model_->FindNext(find_edit_->text(), from, Qt::CaseInsensitive);
+    if (row < 0) {
+        info_label_->setText(QString::fromUtf8("未找到: %1").arg(find_edit_->text()));
+        return;
+    }
+    info_label_->setText(summary_);
+    SelectRow(row);
+}
+
+void LogViewerDialog::SelectRow(int row) {
+    if (row < 0 || row >= model_->LineCount()) return;
+    const QModelIndex index = model_->index(row);
+    view_->setCurrentIndex(index);
+    view_->scrollTo(index, QAbstractItemView::PositionAtCenter);
+    line_spin_->setValue(row + 1);
+}
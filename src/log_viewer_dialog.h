@@ -0,0 +1,45 @@
+// log_viewer_dialog.h - Viewer for plain and compressed solver logs
+// Lines come from a LogLineModel, so even a large .logz opens instantly and
+// only the blocks around the visible rows are decompressed
+
+#ifndef LOG_VIEWER_DIALOG_H_
+#define LOG_VIEWER_DIALOG_H_
+
+#include <QDialog>
+#include <QString>
+
+class QLabel;
+class QLineEdit;
+class QListView;
+class QPushButton;
+class QSpinBox;
+class LogLineModel;
+
+class LogViewerDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    explicit LogViewerDialog(QWidget* parent = nullptr);
+
+    // Show the log at |path|; false if it cannot be read
+    bool OpenLog(const QString& path);
+
+private slots:
+    void OnGoToLine();
+    void OnFindNext();
+
+private:
+    void SetupUi();
+    void SelectRow(int row);
+
+    LogLineModel* model_;
+    QListView* view_;
+    QLabel* info_label_;
+    QSpinBox* line_spin_;
+    QPushButton* goto_button_;
+    QLineEdit* find_edit_;
+    QPushButton* find_button_;
+    QString summary_;    // line count, sizes and path
+};
+
+#endif  // LOG_VIEWER_DIALOG_H_
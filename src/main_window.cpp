@@ -10,6 +10,12 @@
 #include "generator_widget.h"
 #include "generator_worker.h"
 #include "analysis_widget.h"
+#include "results_browser_widget.h"
+#include "instance_library_widget.h"
+#include "log_viewer_dialog.h"
+#include "core/batch_schedule.h"
+#include "core/instance_index.h"
+#include "core/run_history.h"
 
 #include <QMenuBar>
 #include <QTabWidget>
@@ -26,18 +32,67 @@
 #include <QFileInfo>
 #include <QMessageBox>
 #include <QRegularExpression>
+#include <QLocale>
 #include <QStatusBar>
 #include <QFile>
 #include <QTextStream>
+#include <QDateTime>
+#include <QDir>
+#include <QStandardPaths>
+#include <algorithm>
+
+namespace {
+
+// Predictor state under the application data directory
+QString PredictorPath() {
+    return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)
+        + "/run_predictor.bin";
+}
+
+QString FormatSeconds(double seconds) {
+    if (seconds < 120.0) return QString("%1 s").arg(seconds, 0, 'f', seconds < 10.0 ? 1 : 0);
+    if (seconds < 7200.0) return QString("%1 min").arg(seconds / 60.0, 0, 'f', 1);
+    return QString("%1 h").arg(seconds / 3600.0, 0, 'f', 1);
+}
+
+QString FormatMegabytes(double mb) {
+    if (mb < 1024.0) return QString("%1 MB").arg(mb, 0, 'f', 0);
+    return QString("%1 GB").arg(mb / 1024.0, 0, 'f', 1);
+}
+
+// 尝试从文件名提取难度 (格式: N100T30G5F5_0.93_20260106_...)
+double InstanceDifficulty(const QString& path, const InstanceData& instance) {
+    QFileInfo fi(path);
+    QRegularExpression re("_(\\d+\\.\\d+)_\\d{8}_");
+    QRegularExpressionMatch match = re.match(fi.fileName());
+    if (match.hasMatch()) {
+        return match.captured(1).toDouble();
+    }
+    // 使用简化公式计算难度 (默认参数)
+    return 0.30 * 1.0
+        + 0.20 * (1.0 - 11.0 / instance.t)
+        + 0.20 * (static_cast<double>(instance.n) * instance.t / 3000.0)
+        + 0.15 * 1.0
+        + 0.15 * (static_cast<double>(instance.g) / 5.0);
+}
+
+}  // namespace
 
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent)
+    , result_cache_(std::make_shared<ResultCache>())
     , solver_thread_(nullptr)
     , solver_worker_(nullptr)
     , generator_thread_(nullptr)
     , generator_worker_(nullptr)
     , is_running_(false)
-    , total_runtime_(0.0) {
+    , total_runtime_(0.0)
+    , batch_total_(0)
+    , batch_started_(0)
+    , batch_done_(0)
+    , batch_failed_(0) {
+    predictor_.Load(PredictorPath().toStdString());
+
     SetupUi();
     SetupMenuBar();
     SetupConnections();
@@ -48,6 +103,7 @@ MainWindow::MainWindow(QWidget* parent)
 }
 
 MainWindow::~MainWindow() {
+    StopBatchSlots();
     if (solver_thread_) {
         solver_thread_->quit();
         solver_thread_->wait();
@@ -64,7 +120,7 @@ void MainWindow::SetupUi() {
     main_layout->setSpacing(0);
     main_layout->setContentsMargins(0, 0, 0, 0);
 
-    // 顶层Tab: 求解 | 算例生成 | 结果分析
+    // 顶层Tab: 求解 | 算例库 | 算例生成 | 结果分析 | 结果浏览
     mode_tabs_ = new QTabWidget(this);
 
     // ===== Tab 1: 求解页 =====
@@ -101,6 +157,18 @@ void MainWindow::SetupUi() {
     file_info_label_->setStyleSheet("color: #666; font-size: 9pt;");
     file_layout->addWidget(file_info_label_);
 
+    // Size after the solver's order merge, follows the merge parameters
+    merge_info_label_ = new QLabel(this);
+    merge_info_label_->setStyleSheet("color: #666; font-size: 9pt;");
+    merge_info_label_->setVisible(false);
+    file_layout->addWidget(merge_info_label_);
+
+    history_label_ = new QLabel(this);
+    history_label_->setStyleSheet("color: #666; font-size: 9pt;");
+    history_label_->setWordWrap(true);
+    history_label_->setVisible(false);
+    file_layout->addWidget(history_label_);
+
     solver_left_layout->addWidget(file_group_);
 
     // 算法参数
@@ -128,6 +196,14 @@ void MainWindow::SetupUi() {
     status_label_->setStyleSheet("color: #666;");
     control_layout->addWidget(status_label_);
 
+    // Predicted cost of a run with the current instance and settings
+    prediction_label_ = new QLabel(this);
+    prediction_label_->setAlignment(Qt::AlignCenter);
+    prediction_label_->setWordWrap(true);
+    prediction_label_->setStyleSheet("color: #666; font-size: 9pt;");
+    prediction_label_->setVisible(false);
+    control_layout->addWidget(prediction_label_);
+
     solver_left_layout->addWidget(control_group_);
 
     // 结果摘要
@@ -166,7 +242,10 @@ void MainWindow::SetupUi() {
 
     solver_page_layout->addWidget(main_splitter_);
 
-    // ===== Tab 2: 算例生成页 =====
+    // ===== Tab 2: 算例库页 (全宽) =====
+    instance_library_ = new InstanceLibraryWidget();
+
+    // ===== Tab 3: 算例生成页 =====
     auto* generator_page = new QWidget(this);
     auto* generator_page_layout = new QHBoxLayout(generator_page);
     generator_page_layout->setSpacing(8);
@@ -194,13 +273,18 @@ void MainWindow::SetupUi() {
 
     generator_page_layout->addWidget(generator_splitter);
 
-    // ===== Tab 3: 结果分析页 (全宽) =====
-    analysis_widget_ = new AnalysisWidget();
+    // ===== Tab 4: 结果分析页 (全宽) =====
+    analysis_widget_ = new AnalysisWidget(result_cache_);
+
+    // ===== Tab 5: 结果浏览页 (全宽) =====
+    results_browser_ = new ResultsBrowserWidget(result_cache_);
 
-    // 添加三个顶层Tab
+    // 添加五个顶层Tab
     mode_tabs_->addTab(solver_page, QString::fromUtf8("求解"));
+    mode_tabs_->addTab(instance_library_, QString::fromUtf8("算例库"));
     mode_tabs_->addTab(generator_page, QString::fromUtf8("算例生成"));
     mode_tabs_->addTab(analysis_widget_, QString::fromUtf8("结果分析"));
+    mode_tabs_->addTab(results_browser_, QString::fromUtf8("结果浏览"));
 
     main_layout->addWidget(mode_tabs_);
     setCentralWidget(central);
@@ -221,6 +305,10 @@ void MainWindow::SetupMenuBar() {
     connect(export_action, &QAction::triggered, this, &MainWindow::OnExportLog);
     file_menu->addAction(export_action);
 
+    auto* log_action = new QAction(QString::fromUtf8("\u6253\u5f00\u65e5\u5fd7\u6587\u4ef6(&L)..."), this);
+    connect(log_action, &QAction::triggered, this, &MainWindow::OnOpenLogFile);
+    file_menu->addAction(log_action);
+
     file_menu->addSeparator();
 
     auto* exit_action = new QAction(QString::fromUtf8("\u9000\u51fa(&X)"), this);
@@ -253,6 +341,12 @@ void MainWindow::SetupConnections() {
     // Algorithm change
     connect(param_widget_, &ParameterWidget::AlgorithmChanged,
             this, &MainWindow::OnAlgorithmChanged);
+    connect(param_widget_, &ParameterWidget::MergeSettingsChanged,
+            this, &MainWindow::OnMergeSettingsChanged);
+    connect(param_widget_, &ParameterWidget::ParametersChanged,
+            this, &MainWindow::UpdatePrediction);
+    connect(cplex_settings_widget_, &CplexSettingsWidget::ThreadsChanged,
+            this, &MainWindow::UpdatePrediction);
 
     // Setup solver worker thread
     solver_thread_ = new QThread(this);
@@ -267,6 +361,7 @@ void MainWindow::SetupConnections() {
     connect(solver_worker_, &SolverWorker::StageCompleted, this, &MainWindow::OnStageCompleted);
     connect(solver_worker_, &SolverWorker::OptimizationFinished, this, &MainWindow::OnOptimizationFinished);
     connect(solver_worker_, &SolverWorker::LogMessage, this, &MainWindow::OnLogMessage);
+    connect(solver_worker_, &SolverWorker::RunMeasured, this, &MainWindow::OnRunMeasured);
 
     connect(solver_thread_, &QThread::finished, solver_worker_, &QObject::deleteLater);
     solver_thread_->start();
@@ -290,6 +385,22 @@ void MainWindow::SetupConnections() {
     connect(generator_thread_, &QThread::finished, generator_worker_, &QObject::deleteLater);
     generator_thread_->start();
 
+    // Results browser -> analysis
+    connect(results_browser_, &ResultsBrowserWidget::OpenResultRequested,
+            this, &MainWindow::OnOpenResult);
+    connect(results_browser_, &ResultsBrowserWidget::CompareRequested,
+            this, &MainWindow::OnCompareResults);
+    connect(results_browser_, &ResultsBrowserWidget::VerifyRequested,
+            this, &MainWindow::OnVerifyResults);
+
+    // Instance library -> solver
+    connect(instance_library_, &InstanceLibraryWidget::OpenInstanceRequested,
+            this, &MainWindow::OnOpenInstance);
+    connect(instance_library_, &InstanceLibraryWidget::BatchSolveRequested,
+            this, &MainWindow::OnBatchSolve);
+    connect(instance_library_, &InstanceLibraryWidget::BatchLoaded,
+            this, &MainWindow::OnBatchLoaded);
+
     // Initialize results widget with current algorithm
     OnAlgorithmChanged(param_widget_->GetAlgorithmIndex());
 }
@@ -305,6 +416,10 @@ void MainWindow::UpdateUiState(bool is_running) {
     status_label_->setText(is_running ?
         QString::fromUtf8("\u8fd0\u884c\u4e2d...") :
         QString::fromUtf8("\u5c31\u7eea"));
+    if (is_running && batch_total_ > 0) {
+        status_label_->setText(QString::fromUtf8("运行中... (批量 已完成 %1/%2, %3 个并行)")
+            .arg(batch_done_).arg(batch_total_).arg(batch_slots_.size()));
+    }
 }
 
 void MainWindow::ResetState() {
@@ -320,76 +435,142 @@ void MainWindow::OnBrowseFile() {
         QString::fromUtf8("CSV (*.csv);;所有文件 (*)"));
 
     if (!path.isEmpty()) {
-        current_file_path_ = path;
-        // Show only filename in the edit
-        QFileInfo fi(path);
-        file_path_edit_->setText(fi.fileName());
-        file_path_edit_->setToolTip(path);
+        SetCurrentFile(path);
+    }
+}
 
-        // Parse CSV to get NTGF indicators
-        ParseCsvForIndicators(path);
+void MainWindow::SetCurrentFile(const QString& path) {
+    current_file_path_ = path;
+    // Show only filename in the edit
+    QFileInfo fi(path);
+    file_path_edit_->setText(fi.fileName());
+    file_path_edit_->setToolTip(path);
 
-        start_button_->setEnabled(true);
-        log_widget_->AppendLog(QString::fromUtf8("文件: ") + path);
-    }
+    // Read the instance; NTGF indicators come from its scalar lines
+    LoadInstance(path);
+
+    start_button_->setEnabled(true);
+    log_widget_->AppendLog(QString::fromUtf8("文件: ") + path);
 }
 
-void MainWindow::ParseCsvForIndicators(const QString& path) {
-    QFile file(path);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+void MainWindow::LoadInstance(const QString& path) {
+    instance_.reset();
+    merge_preview_.reset();
+    instance_hash_.clear();
+    if (!QFileInfo(path).isReadable()) {
         file_info_label_->setText(QString::fromUtf8("无法读取文件"));
         file_info_label_->setStyleSheet("color: red; font-size: 9pt;");
+        OnMergeSettingsChanged();
+        UpdatePrediction();
+        UpdateHistoryInfo();
         return;
     }
 
-    int n = 0, t = 0, g = 0, f = 0;
-    QTextStream in(&file);
-    while (!in.atEnd()) {
-        QString line = in.readLine().trimmed();
-        if (line.startsWith("T_num,")) {
-            t = line.mid(6).toInt();
-        } else if (line.startsWith("F_num,")) {
-            f = line.mid(6).toInt();
-        } else if (line.startsWith("G_num,")) {
-            g = line.mid(6).toInt();
-        } else if (line.startsWith("Order_Num,")) {
-            n = line.mid(10).toInt();
-        }
-        // Stop after finding all values
-        if (n > 0 && t > 0 && g > 0 && f > 0) break;
-    }
-    file.close();
-
-    if (n > 0 && t > 0) {
+    // Snapshot cache: reopening an unchanged instance skips the CSV parse
+    QString error;
+    InstanceDataPtr instance = LoadInstanceCached(path, &error);
+    InstanceIndexEntry summary;
+    if (instance) {
+        instance_ = instance;
+        const int n = instance->n;
+        const int t = instance->t;
+        const int g = instance->g;
+        const int f = instance->f;
         inst_n_ = n;
         inst_t_ = t;
         inst_g_ = g;
         inst_f_ = f;
 
-        // 尝试从文件名提取难度 (格式: N100T30G5F5_0.93_20260106_...)
-        QFileInfo fi(path);
-        QRegularExpression re("_(\\d+\\.\\d+)_\\d{8}_");
-        QRegularExpressionMatch match = re.match(fi.fileName());
-        if (match.hasMatch()) {
-            inst_difficulty_ = match.captured(1).toDouble();
-        } else {
-            // 使用简化公式计算难度 (默认参数)
-            inst_difficulty_ = 0.30 * 1.0
-                + 0.20 * (1.0 - 11.0 / t)
-                + 0.20 * (static_cast<double>(n) * t / 3000.0)
-                + 0.15 * 1.0
-                + 0.15 * (static_cast<double>(g) / 5.0);
-        }
+        inst_difficulty_ = InstanceDifficulty(path, *instance);
 
         QString info = QString("N=%1  T=%2  G=%3  F=%4").arg(n).arg(t).arg(g).arg(f);
         file_info_label_->setText(info);
+        file_info_label_->setToolTip(QString());
         file_info_label_->setStyleSheet("color: black; font-size: 9pt;");
+        if (!instance->unknown_columns.isEmpty()) {
+            log_widget_->AppendLog(QString::fromUtf8("算例中有未识别的列 (已忽略): %1")
+                .arg(instance->unknown_columns.join(", ")));
+        }
+        merge_preview_ = std::make_unique<OrderMergePreview>(*instance);
+        instance_hash_ = InstanceCache::Shared().ContentHash(path).toHex().toStdString();
+    } else if (ReadInstanceSummary(path.toStdString(), &summary)) {
+        // Counts are readable but the order table is not: the solver page keeps
+        // working from the scalars, order-level views stay off
+        log_widget_->AppendLog(error);
+        inst_n_ = summary.n;
+        inst_t_ = summary.t;
+        inst_g_ = summary.g;
+        inst_f_ = summary.f;
+        InstanceData counts;
+        counts.n = summary.n;
+        counts.t = summary.t;
+        counts.g = summary.g;
+        inst_difficulty_ = InstanceDifficulty(path, counts);
+        file_info_label_->setText(QString::fromUtf8("N=%1  T=%2  G=%3  F=%4 (订单表无法识别)")
+            .arg(summary.n).arg(summary.t).arg(summary.g).arg(summary.f));
+        file_info_label_->setToolTip(error);
+        file_info_label_->setStyleSheet("color: orange; font-size: 9pt;");
+        instance_hash_ = summary.hash;
     } else {
+        log_widget_->AppendLog(error);
         inst_n_ = inst_t_ = inst_g_ = inst_f_ = 0;
         inst_difficulty_ = 0.0;
         file_info_label_->setText(QString::fromUtf8("无法解析文件"));
+        file_info_label_->setToolTip(error);
         file_info_label_->setStyleSheet("color: orange; font-size: 9pt;");
     }
+    OnMergeSettingsChanged();
+    UpdatePrediction();
+    UpdateHistoryInfo();
+}
+
+void MainWindow::UpdateHistoryInfo() {
+    if (instance_hash_.empty()) {
+        history_label_->setVisible(false);
+        return;
+    }
+
+    const RunHistory& history = RunHistory::Shared();
+    const int runs = history.RunCount(instance_hash_);
+    RunHistoryEntry best;
+    if (history.BestRun(instance_hash_, &best)) {
+        const int configs = static_cast<int>(history.BestPerConfig(instance_hash_).size());
+        history_label_->setText(QString::fromUtf8("历史最优: %1 (%2, %3)\n共 %4 次运行, %5 种配置")
+            .arg(best.objective, 0, 'f', 2)
+            .arg(QString::fromStdString(best.algorithm))
+            .arg(QDateTime::fromMSecsSinceEpoch(best.started).toString("yyyy-MM-dd HH:mm"))
+            .arg(runs).arg(configs));
+    } else if (runs > 0) {
+        history_label_->setText(QString::fromUtf8("历史: %1 次运行, 无成功结果").arg(runs));
+    } else {
+        history_label_->setText(QString::fromUtf8("历史: 尚未求解"));
+    }
+    history_label_->setVisible(true);
+}
+
+void MainWindow::OnMergeSettingsChanged() {
+    if (!merge_preview_) {
+        merge_info_label_->setVisible(false);
+        return;
+    }
+
+    const MergeEstimate estimate = merge_preview_->Estimate(
+        param_widget_->GetMergeEnabled(), param_widget_->GetBigOrderThreshold());
+    QString merge;
+    if (!param_widget_->GetMergeEnabled()) {
+        merge = QString::fromUtf8("合并: 未启用, %1 订单").arg(estimate.original);
+    } else if (!estimate.merge_possible) {
+        merge = QString::fromUtf8("合并: 算例无流向/分组列, %1 订单").arg(estimate.original);
+    } else {
+        merge = QString::fromUtf8("合并预估: %1 -> %2 订单 (大订单 %3)")
+            .arg(estimate.original).arg(estimate.merged).arg(estimate.big_orders);
+    }
+    const QLocale locale = QLocale::c();
+    merge_info_label_->setText(merge + QString::fromUtf8("\n模型规模: 行 %1  列 %2  二元 %3")
+        .arg(locale.toString(static_cast<qlonglong>(estimate.size.rows)))
+        .arg(locale.toString(static_cast<qlonglong>(estimate.size.columns)))
+        .arg(locale.toString(static_cast<qlonglong>(estimate.size.binaries))));
+    merge_info_label_->setVisible(true);
 }
 
 void MainWindow::OnStartOptimization() {
@@ -404,10 +585,37 @@ void MainWindow::OnStartOptimization() {
 
     // 设置算法和参数
     int algo_idx = param_widget_->GetAlgorithmIndex();
-    AlgorithmType algo = static_cast<AlgorithmType>(algo_idx);
-    solver_worker_->SetAlgorithm(algo);
+    ApplySolverSettings(solver_worker_);
     solver_worker_->SetDataPath(current_file_path_);
-    solver_worker_->SetParameters(
+    solver_worker_->SetLogTag(QString());
+    solver_worker_->SetInstanceInfo(inst_n_, inst_t_, inst_g_, inst_f_, inst_difficulty_);
+
+    QString algo_names[] = {"RF", "RFO", "RR", "LR"};
+    log_widget_->AppendLog(QString::fromUtf8("开始优化 (算法: %1)...")
+        .arg(algo_names[algo_idx]));
+    if (instance_ && merge_preview_) {
+        const MergeEstimate estimate = merge_preview_->Estimate(
+            param_widget_->GetMergeEnabled(), param_widget_->GetBigOrderThreshold());
+        current_features_ = CurrentFeatures(*instance_, estimate.merged);
+        const RunPrediction prediction = predictor_.Predict(current_features_);
+        if (prediction.valid) {
+            log_widget_->AppendLog(QString::fromUtf8("预计耗时 %1 (CPU %2, 内存 %3)")
+                .arg(FormatSeconds(prediction.cost.wall_seconds))
+                .arg(FormatSeconds(prediction.cost.cpu_seconds))
+                .arg(FormatMegabytes(prediction.cost.peak_rss_mb)));
+        }
+    } else {
+        current_features_ = RunFeatures();
+    }
+    statusBar()->showMessage(QString::fromUtf8("优化中..."));
+
+    log_widget_->StartTimer();
+    emit StartSolver();
+}
+
+void MainWindow::ApplySolverSettings(SolverWorker* worker) const {
+    worker->SetAlgorithm(static_cast<AlgorithmType>(param_widget_->GetAlgorithmIndex()));
+    worker->SetParameters(
         param_widget_->GetRuntimeLimit(),
         param_widget_->GetUPenalty(),
         param_widget_->GetBPenalty(),
@@ -415,47 +623,129 @@ void MainWindow::OnStartOptimization() {
         param_widget_->GetBigOrderThreshold(),
         param_widget_->GetMachineCapacity()
     );
-    solver_worker_->SetCplexParameters(
+    worker->SetCplexParameters(
         cplex_settings_widget_->GetWorkDir(),
         cplex_settings_widget_->GetWorkMem(),
         cplex_settings_widget_->GetThreads()
     );
     // Set advanced algorithm parameters
-    solver_worker_->SetRFParameters(
+    worker->SetRFParameters(
         param_widget_->GetRFWindow(),
         param_widget_->GetRFStep(),
         param_widget_->GetRFTime(),
         param_widget_->GetRFRetries()
     );
-    solver_worker_->SetFOParameters(
+    worker->SetFOParameters(
         param_widget_->GetFOWindow(),
         param_widget_->GetFOStep(),
         param_widget_->GetFORounds(),
         param_widget_->GetFOBuffer(),
         param_widget_->GetFOTime()
     );
-    solver_worker_->SetRRParameters(
+    worker->SetRRParameters(
         param_widget_->GetRRCapacity(),
         param_widget_->GetRRBonus()
     );
-    solver_worker_->SetLRParameters(
+    worker->SetLRParameters(
         param_widget_->GetLRMaxIter(),
         param_widget_->GetLRAlpha0(),
         param_widget_->GetLRDecay(),
         param_widget_->GetLRTol()
     );
-    solver_worker_->SetInstanceInfo(inst_n_, inst_t_, inst_g_, inst_f_, inst_difficulty_);
+}
 
-    QString algo_names[] = {"RF", "RFO", "RR", "LR"};
-    log_widget_->AppendLog(QString::fromUtf8("开始优化 (算法: %1)...")
-        .arg(algo_names[algo_idx]));
-    statusBar()->showMessage(QString::fromUtf8("优化中..."));
+int MainWindow::CplexThreadsPerJob() const {
+    // 0 lets CPLEX take every core
+    const int threads = cplex_settings_widget_->GetThreads();
+    return threads > 0 ? threads : std::max(1, QThread::idealThreadCount());
+}
 
-    log_widget_->StartTimer();
-    emit StartSolver();
+RunFeatures MainWindow::CurrentFeatures(const InstanceData& instance, int merged) const {
+    RunFeatures features;
+    features.algorithm = param_widget_->GetAlgorithmIndex();
+    features.n = instance.n;
+    features.merged = merged;
+    features.t = instance.t;
+    features.g = instance.g;
+    features.f = instance.f;
+    features.time_limit = param_widget_->GetRuntimeLimit();
+    features.threads = CplexThreadsPerJob();
+    switch (static_cast<AlgorithmType>(features.algorithm)) {
+        case AlgorithmType::RF:
+            features.window = param_widget_->GetRFWindow();
+            features.subproblem_time = param_widget_->GetRFTime();
+            break;
+        case AlgorithmType::RFO:
+            features.window = param_widget_->GetRFWindow();
+            features.subproblem_time = param_widget_->GetRFTime();
+            features.rounds = param_widget_->GetFORounds();
+            break;
+        case AlgorithmType::LR:
+            features.rounds = param_widget_->GetLRMaxIter();
+            break;
+        default:
+            break;
+    }
+    return features;
+}
+
+void MainWindow::UpdatePrediction() {
+    if (!instance_ || !merge_preview_) {
+        prediction_label_->setVisible(false);
+        return;
+    }
+
+    const MergeEstimate estimate = merge_preview_->Estimate(
+        param_widget_->GetMergeEnabled(), param_widget_->GetBigOrderThreshold());
+    const RunFeatures features = CurrentFeatures(*instance_, estimate.merged);
+    const RunPrediction prediction = predictor_.Predict(features);
+    if (prediction.valid) {
+        prediction_label_->setText(QString::fromUtf8("预计: 耗时 ~%1  CPU ~%2  内存 ~%3\n(误差约 ×%4, 基于 %5 次运行)")
+            .arg(FormatSeconds(prediction.cost.wall_seconds))
+            .arg(FormatSeconds(prediction.cost.cpu_seconds))
+            .arg(FormatMegabytes(prediction.cost.peak_rss_mb))
+            .arg(prediction.spread, 0, 'f', 1)
+            .arg(prediction.samples));
+    } else {
+        prediction_label_->setText(QString::fromUtf8("预计: 该算法运行样本不足 (%1/%2)")
+            .arg(predictor_.Samples(features.algorithm)).arg(RunPredictor::kMinSamples));
+    }
+    prediction_label_->setVisible(true);
+}
+
+void MainWindow::OnRunMeasured(double wall_seconds, double cpu_seconds, qint64 peak_rss_bytes) {
+    if (current_features_.merged <= 0) return;
+    RecordRun(current_features_, wall_seconds, cpu_seconds, peak_rss_bytes);
+}
+
+void MainWindow::RecordRun(const RunFeatures& features, double wall_seconds, double cpu_seconds,
+                           qint64 peak_rss_bytes) {
+    RunCost cost;
+    cost.wall_seconds = wall_seconds;
+    cost.cpu_seconds = cpu_seconds;
+    cost.peak_rss_mb = static_cast<double>(peak_rss_bytes) / (1024.0 * 1024.0);
+    predictor_.Add(features, cost);
+
+    const QString path = PredictorPath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    predictor_.Save(path.toStdString());
+    UpdatePrediction();
 }
 
 void MainWindow::OnCancelOptimization() {
+    if (batch_total_ > 0) {
+        // Cancelling a batch drops the jobs not yet started and stops the running ones
+        if (!batch_queue_.empty()) {
+            log_widget_->AppendLog(QString::fromUtf8("批量求解: 已取消剩余 %1 个算例")
+                .arg(batch_queue_.size()));
+            batch_queue_.clear();
+        }
+        for (const BatchSlot& slot : batch_slots_) {
+            if (slot.busy) slot.worker->RequestCancel();
+        }
+        log_widget_->AppendLog(QString::fromUtf8("\u53d6\u6d88\u4e2d..."));
+        return;
+    }
     if (solver_worker_) {
         solver_worker_->RequestCancel();
         log_widget_->AppendLog(QString::fromUtf8("\u53d6\u6d88\u4e2d..."));
@@ -484,6 +774,24 @@ void MainWindow::OnExportLog() {
     }
 }
 
+void MainWindow::OnOpenLogFile() {
+    QString path = QFileDialog::getOpenFileName(this,
+        QString::fromUtf8("\u6253\u5f00\u65e5\u5fd7\u6587\u4ef6"),
+        "D:/YM-Code/LS-NTGF-All/logs",
+        QString::fromUtf8("\u6c42\u89e3\u65e5\u5fd7 (*.log *.logz);;\u6240\u6709\u6587\u4ef6 (*)"));
+    if (path.isEmpty()) return;
+
+    // Non-modal, deletes itself on close
+    auto* viewer = new LogViewerDialog(this);
+    if (!viewer->OpenLog(path)) {
+        QMessageBox::warning(this, QString::fromUtf8("\u6253\u5f00\u65e5\u5fd7"),
+            QString::fromUtf8("\u65e0\u6cd5\u8bfb\u53d6\u65e5\u5fd7: ") + path);
+        viewer->deleteLater();
+        return;
+    }
+    viewer->show();
+}
+
 void MainWindow::OnAlgorithmChanged(int index) {
     AlgorithmType algo = static_cast<AlgorithmType>(index);
     results_widget_->SetAlgorithmType(algo);
@@ -501,6 +809,14 @@ void MainWindow::OnDataLoaded(int items, int periods, int flows, int groups) {
 void MainWindow::OnOrdersMerged(int original, int merged) {
     log_widget_->AppendLog(QString::fromUtf8("\u8ba2\u5355\u5408\u5e76: %1 -> %2")
         .arg(original).arg(merged));
+    if (merge_preview_) {
+        const MergeEstimate estimate = merge_preview_->Estimate(
+            param_widget_->GetMergeEnabled(), param_widget_->GetBigOrderThreshold());
+        if (estimate.merged != merged) {
+            log_widget_->AppendLog(QString::fromUtf8("合并预估为 %1 订单, 与求解器不一致")
+                .arg(estimate.merged));
+        }
+    }
     results_widget_->SetMergeInfo(original, merged);
 }
 
@@ -528,6 +844,8 @@ void MainWindow::OnOptimizationFinished(bool success, const QString& message) {
     UpdateUiState(false);
 
     results_widget_->SetTotalRuntime(total_runtime_);
+    UpdateHistoryInfo();
+    instance_library_->RefreshHistory();
 
     if (success) {
         statusBar()->showMessage(QString::fromUtf8("优化完成"));
@@ -578,11 +896,7 @@ void MainWindow::OnGenerationFinished(bool success, const QString& message,
 
         // Offer to load the first generated file
         if (!files.isEmpty()) {
-            QString first_file = files.first();
-            if (!first_file.startsWith("D:")) {
-                first_file = "D:/YM-Code/LS-NTGF-Data-Cap/" + first_file;
-            }
-            generator_log_widget_->AppendLog(QString::fromUtf8("算例已生成，可用于求解: ") + first_file);
+            generator_log_widget_->AppendLog(QString::fromUtf8("算例已生成，可用于求解: ") + files.first());
         }
     } else {
         statusBar()->showMessage(QString::fromUtf8("生成失败"));
@@ -593,3 +907,224 @@ void MainWindow::OnGenerationFinished(bool success, const QString& message,
 void MainWindow::OnGeneratorLogMessage(const QString& message) {
     generator_log_widget_->AppendLog(message);
 }
+
+void MainWindow::OnOpenResult(const QString& path) {
+    if (analysis_widget_->LoadJsonFile(path)) {
+        mode_tabs_->setCurrentWidget(analysis_widget_);
+    }
+}
+
+void MainWindow::OnCompareResults(const QStringList& paths) {
+    analysis_widget_->AddToComparison(paths);
+    mode_tabs_->setCurrentWidget(analysis_widget_);
+}
+
+void MainWindow::OnVerifyResults(const QStringList& paths) {
+    analysis_widget_->VerifyResults(paths);
+    mode_tabs_->setCurrentWidget(analysis_widget_);
+}
+
+// ============================================================================
+// Instance Library Slots
+// ============================================================================
+
+void MainWindow::OnOpenInstance(const QString& path) {
+    if (is_running_) {
+        QMessageBox::warning(this, QString::fromUtf8("算例库"),
+            QString::fromUtf8("求解运行中, 请等待完成或取消"));
+        return;
+    }
+    SetCurrentFile(path);
+    mode_tabs_->setCurrentIndex(0);
+}
+
+void MainWindow::OnBatchSolve(const QStringList& paths) {
+    if (is_running_) {
+        QMessageBox::warning(this, QString::fromUtf8("算例库"),
+            QString::fromUtf8("求解运行中, 请等待完成或取消"));
+        return;
+    }
+    if (paths.isEmpty()) return;
+
+    // The instances are read on the library's worker for the merge estimate and
+    // the prediction; the batch starts in OnBatchLoaded
+    log_widget_->AppendLog(QString::fromUtf8("批量求解: 读取 %1 个算例...").arg(paths.size()));
+    instance_library_->LoadBatch(paths, param_widget_->GetMergeEnabled(),
+                                 param_widget_->GetBigOrderThreshold());
+}
+
+void MainWindow::OnBatchLoaded(const BatchInstancesPtr& instances) {
+    if (is_running_) {
+        QMessageBox::warning(this, QString::fromUtf8("算例库"),
+            QString::fromUtf8("求解运行中, 请等待完成或取消"));
+        return;
+    }
+
+    // Every job runs with the parameters currently set on the solver page
+    std::vector<BatchJob> jobs;
+    std::vector<BatchJobEstimate> estimates;
+    for (const BatchInstance& item : *instances) {
+        if (!item.error.isEmpty()) {
+            log_widget_->AppendLog(QString::fromUtf8("批量求解: %1, 已跳过").arg(item.error));
+            continue;
+        }
+        const MergeEstimate& merge = item.merge;
+        InstanceData counts;
+        counts.n = item.n;
+        counts.t = item.t;
+        counts.g = item.g;
+        counts.f = item.f;
+
+        BatchJob job;
+        job.path = item.path;
+        job.n = item.n;
+        job.t = item.t;
+        job.g = item.g;
+        job.f = item.f;
+        job.difficulty = InstanceDifficulty(item.path, counts);
+        job.features = CurrentFeatures(counts, merge.merged);
+        const RunPrediction prediction = predictor_.Predict(job.features);
+        if (prediction.valid) job.predicted_seconds = prediction.cost.wall_seconds;
+        jobs.push_back(job);
+
+        BatchJobEstimate estimate;
+        estimate.seconds = job.predicted_seconds;
+        estimate.size_key = static_cast<double>(merge.size.columns);
+        estimates.push_back(estimate);
+    }
+    if (jobs.empty()) return;
+
+    // Longest first keeps a long job from starting last on an otherwise idle machine
+    const std::vector<int> order = LongestFirstOrder(estimates);
+    batch_queue_.clear();
+    for (int index : order) batch_queue_.push_back(jobs[index]);
+
+    // As many parallel solvers as the CPLEX thread setting leaves cores for
+    const int cores = std::max(1, QThread::idealThreadCount());
+    const int per_job = cplex_settings_widget_->GetThreads();
+    const int slots = std::min(static_cast<int>(jobs.size()),
+                               per_job > 0 ? std::max(1, cores / per_job) : 1);
+    log_widget_->AppendLog(QString::fromUtf8("批量求解: %1 个算例, %2 个并行 (每个 CPLEX 线程 %3)")
+        .arg(jobs.size()).arg(slots).arg(per_job > 0 ? QString::number(per_job)
+                                                     : QString::fromUtf8("自动")));
+    if (std::all_of(estimates.begin(), estimates.end(),
+                    [](const BatchJobEstimate& e) { return e.seconds > 0.0; })) {
+        log_widget_->AppendLog(QString::fromUtf8("批量求解: 预计总耗时 %1")
+            .arg(FormatSeconds(DispatchMakespan(estimates, order, slots))));
+    }
+
+    batch_slots_.resize(static_cast<size_t>(slots));
+    for (size_t i = 0; i < batch_slots_.size(); ++i) {
+        BatchSlot& slot = batch_slots_[i];
+        slot.thread = new QThread(this);
+        slot.worker = new SolverWorker();
+        slot.worker->moveToThread(slot.thread);
+        connect(slot.worker, &SolverWorker::OptimizationFinished, this,
+                [this, i](bool success, const QString& message) {
+                    OnBatchJobFinished(i, success, message);
+                });
+        connect(slot.worker, &SolverWorker::RunMeasured, this,
+                [this, i](double wall_seconds, double cpu_seconds, qint64 peak_rss_bytes) {
+                    if (i < batch_slots_.size() && batch_slots_[i].busy) {
+                        RecordRun(batch_slots_[i].job.features, wall_seconds, cpu_seconds,
+                                  peak_rss_bytes);
+                    }
+                });
+        connect(slot.thread, &QThread::finished, slot.worker, &QObject::deleteLater);
+        slot.thread->start();
+    }
+
+    batch_total_ = static_cast<int>(jobs.size());
+    batch_started_ = 0;
+    batch_done_ = 0;
+    batch_failed_ = 0;
+    mode_tabs_->setCurrentIndex(0);
+    statusBar()->showMessage(QString::fromUtf8("批量求解中..."));
+    log_widget_->StartTimer();
+    UpdateUiState(true);
+    for (size_t i = 0; i < batch_slots_.size(); ++i) {
+        StartBatchJob(i);
+    }
+}
+
+void MainWindow::StartBatchJob(size_t slot_index) {
+    BatchSlot& slot = batch_slots_[slot_index];
+    if (batch_queue_.empty()) {
+        slot.busy = false;
+        return;
+    }
+
+    slot.job = batch_queue_.front();
+    batch_queue_.pop_front();
+    slot.busy = true;
+    ++batch_started_;
+
+    const BatchJob& job = slot.job;
+    ApplySolverSettings(slot.worker);
+    slot.worker->SetDataPath(job.path);
+    slot.worker->SetInstanceInfo(job.n, job.t, job.g, job.f, job.difficulty);
+    // Parallel jobs of one instance size would otherwise share a log file name
+    slot.worker->SetLogTag(QString("_j%1").arg(batch_started_));
+
+    QString line = QString::fromUtf8("批量求解 %1/%2 [%3]: %4")
+        .arg(batch_started_).arg(batch_total_).arg(slot_index + 1).arg(job.path);
+    if (job.predicted_seconds > 0.0) {
+        line += QString::fromUtf8(" (预计 %1)").arg(FormatSeconds(job.predicted_seconds));
+    }
+    log_widget_->AppendLog(line);
+    QMetaObject::invokeMethod(slot.worker, "RunOptimization", Qt::QueuedConnection);
+}
+
+void MainWindow::OnBatchJobFinished(size_t slot_index, bool success, const QString& message) {
+    if (slot_index >= batch_slots_.size() || !batch_slots_[slot_index].busy) return;
+    BatchSlot& slot = batch_slots_[slot_index];
+    slot.busy = false;
+    ++batch_done_;
+
+    // A failed instance does not hold up the rest of the batch
+    const QString name = QFileInfo(slot.job.path).fileName();
+    if (success) {
+        log_widget_->AppendLog(QString::fromUtf8("批量完成 %1: %2").arg(name, message));
+    } else {
+        ++batch_failed_;
+        log_widget_->AppendLog(QString::fromUtf8("批量停止 %1: %2").arg(name, message));
+    }
+
+    StartBatchJob(slot_index);
+    UpdateUiState(true);
+    UpdateHistoryInfo();
+    instance_library_->RefreshHistory();
+    const bool idle = std::none_of(batch_slots_.begin(), batch_slots_.end(),
+                                   [](const BatchSlot& s) { return s.busy; });
+    if (idle) FinishBatch();
+}
+
+void MainWindow::FinishBatch() {
+    const int total = batch_total_;
+    const int done = batch_done_;
+    StopBatchSlots();
+    batch_queue_.clear();
+    batch_total_ = 0;
+
+    log_widget_->StopTimer();
+    UpdateUiState(false);
+    QString summary = QString::fromUtf8("批量求解完成: %1 个算例, 失败 %2")
+        .arg(done).arg(batch_failed_);
+    if (done < total) {
+        summary += QString::fromUtf8(", 未运行 %1").arg(total - done);
+    }
+    log_widget_->AppendLog(summary);
+    statusBar()->showMessage(summary);
+}
+
+void MainWindow::StopBatchSlots() {
+    for (BatchSlot& slot : batch_slots_) {
+        if (slot.busy) slot.worker->RequestCancel();
+    }
+    for (BatchSlot& slot : batch_slots_) {
+        slot.thread->quit();
+        slot.thread->wait();
+        delete slot.thread;
+    }
+    batch_slots_.clear();
+}
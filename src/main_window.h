@@ -7,7 +7,17 @@
 #include <QMainWindow>
 #include <QThread>
 #include <QString>
+#include <QStringList>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
 #include "difficulty_mapper.h"
+#include "instance_index_worker.h"
+#include "core/instance_cache.h"
+#include "core/order_merge.h"
+#include "core/result_cache.h"
+#include "core/run_predictor.h"
 
 class ParameterWidget;
 class ResultsWidget;
@@ -17,6 +27,8 @@ class SolverWorker;
 class GeneratorWidget;
 class GeneratorWorker;
 class AnalysisWidget;
+class ResultsBrowserWidget;
+class InstanceLibraryWidget;
 class QLineEdit;
 class QLabel;
 class QPushButton;
@@ -39,7 +51,10 @@ private slots:
     void OnStartOptimization();
     void OnCancelOptimization();
     void OnExportLog();
+    void OnOpenLogFile();
     void OnAlgorithmChanged(int index);
+    void OnMergeSettingsChanged();
+    void UpdatePrediction();
 
     // Slots for solver worker signals
     void OnDataLoaded(int items, int periods, int flows, int groups);
@@ -49,6 +64,7 @@ private slots:
     void OnStageCompleted(int stage, double objective, double runtime, double gap);
     void OnOptimizationFinished(bool success, const QString& message);
     void OnLogMessage(const QString& message);
+    void OnRunMeasured(double wall_seconds, double cpu_seconds, qint64 peak_rss_bytes);
 
     // Slots for generator
     void OnGenerateRequested(const GeneratorConfig& config);
@@ -57,13 +73,43 @@ private slots:
     void OnGenerationFinished(bool success, const QString& message, const QStringList& files);
     void OnGeneratorLogMessage(const QString& message);
 
+    // Slots for results browser
+    void OnOpenResult(const QString& path);
+    void OnCompareResults(const QStringList& paths);
+    void OnVerifyResults(const QStringList& paths);
+
+    // Instance library
+    void OnOpenInstance(const QString& path);
+    void OnBatchSolve(const QStringList& paths);
+    void OnBatchLoaded(const BatchInstancesPtr& instances);
+
 private:
     void SetupUi();
     void SetupMenuBar();
     void SetupConnections();
     void UpdateUiState(bool is_running);
     void ResetState();
-    void ParseCsvForIndicators(const QString& path);
+    void LoadInstance(const QString& path);
+    void SetCurrentFile(const QString& path);
+    // Past runs of the loaded instance from the run history
+    void UpdateHistoryInfo();
+
+    // Copy the solver page settings (algorithm, parameters, CPLEX) to |worker|
+    void ApplySolverSettings(SolverWorker* worker) const;
+
+    // Predictor features of the current settings for an instance
+    RunFeatures CurrentFeatures(const InstanceData& instance, int merged) const;
+    int CplexThreadsPerJob() const;
+
+    // Learn from a finished run and persist the predictor
+    void RecordRun(const RunFeatures& features, double wall_seconds, double cpu_seconds,
+                   qint64 peak_rss_bytes);
+
+    // Batch solve over parallel solver slots
+    void StartBatchJob(size_t slot);
+    void OnBatchJobFinished(size_t slot, bool success, const QString& message);
+    void FinishBatch();
+    void StopBatchSlots();
 
     // Main layout
     QSplitter* main_splitter_;
@@ -73,6 +119,8 @@ private:
     QPushButton* browse_button_;
     QLineEdit* file_path_edit_;
     QLabel* file_info_label_;
+    QLabel* merge_info_label_;
+    QLabel* history_label_;
 
     // Left sidebar - Parameters
     ParameterWidget* param_widget_;
@@ -82,6 +130,7 @@ private:
     QPushButton* start_button_;
     QPushButton* cancel_button_;
     QLabel* status_label_;
+    QLabel* prediction_label_;
 
     // Left sidebar - Results summary
     ResultsWidget* results_widget_;
@@ -104,6 +153,15 @@ private:
     // Left sidebar - Analysis tab
     AnalysisWidget* analysis_widget_;
 
+    // Results directory browser tab
+    ResultsBrowserWidget* results_browser_;
+
+    // Instance library tab
+    InstanceLibraryWidget* instance_library_;
+
+    // Opened results shared by the analysis and browser tabs
+    ResultCachePtr result_cache_;
+
     // Tab widget for mode switching
     QTabWidget* mode_tabs_;
 
@@ -118,12 +176,44 @@ private:
     QString current_file_path_;
     double total_runtime_;
 
-    // Instance info (parsed from CSV)
+    // Instance info (parsed from CSV); instance_ holds the whole instance
+    InstanceDataPtr instance_;
+    std::unique_ptr<OrderMergePreview> merge_preview_;
+    std::string instance_hash_;         // hex MD5, key of the run history
     int inst_n_;
     int inst_t_;
     int inst_g_;
     int inst_f_;
     double inst_difficulty_;
+
+    // Run cost prediction, retrained after every finished run
+    RunPredictor predictor_;
+    RunFeatures current_features_;      // of the single run in progress
+
+    // Batch solve: jobs not yet started, longest predicted first; one solver
+    // worker per slot. batch_total_ is 0 outside a batch.
+    struct BatchJob {
+        QString path;
+        int n = 0;
+        int t = 0;
+        int g = 0;
+        int f = 0;
+        double difficulty = 0.0;
+        RunFeatures features;
+        double predicted_seconds = 0.0;     // 0: no prediction
+    };
+    struct BatchSlot {
+        QThread* thread = nullptr;
+        SolverWorker* worker = nullptr;
+        bool busy = false;
+        BatchJob job;
+    };
+    std::deque<BatchJob> batch_queue_;
+    std::vector<BatchSlot> batch_slots_;
+    int batch_total_;
+    int batch_started_;
+    int batch_done_;
+    int batch_failed_;
 };
 
 #endif  // MAIN_WINDOW_H_
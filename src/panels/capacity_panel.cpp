@@ -7,7 +7,6 @@
 #include <QHBoxLayout>
 #include <QGroupBox>
 #include <QLabel>
-#include <QJsonArray>
 
 CapacityPanel::CapacityPanel(QWidget* parent)
     : QWidget(parent) {
@@ -37,6 +36,12 @@ void CapacityPanel::SetupUi() {
 
     layout->addWidget(stats_group);
 
+    note_label_ = new QLabel(this);
+    note_label_->setStyleSheet("color: gray; font-size: 9pt;");
+    note_label_->setWordWrap(true);
+    note_label_->hide();
+    layout->addWidget(note_label_);
+
     // Chart
     auto* chart_group = new QGroupBox(QString::fromUtf8("各周期产能利用率"), this);
     auto* chart_layout = new QVBoxLayout(chart_group);
@@ -49,13 +54,34 @@ void CapacityPanel::SetupUi() {
     layout->addWidget(chart_group, 1);
 }
 
-void CapacityPanel::LoadData(const QJsonObject& json) {
-    QJsonObject metrics = json["metrics"].toObject();
-    QJsonObject capacity = metrics["capacity"].toObject();
+void CapacityPanel::LoadData(const ResultModelPtr& model) {
+    if (!model) {
+        Clear();
+        return;
+    }
+
+    const ResultMetrics& metrics = model->metrics;
+    if (metrics.utilization_basis == UtilizationBasis::Unavailable) {
+        Clear();
+        avg_label_->setText(QString::fromUtf8("不可用"));
+        max_label_->setText(QString::fromUtf8("不可用"));
+        note_label_->setText(metrics.derived
+            ? QString::fromUtf8("结果中没有生产量 X，也找不到算例的启动时间，无法推算产能利用率")
+            : QString::fromUtf8("结果文件没有产能利用率数据"));
+        note_label_->show();
+        return;
+    }
+    if (metrics.utilization_basis == UtilizationBasis::SetupOnly) {
+        note_label_->setText(QString::fromUtf8(
+            "结果中没有生产量 X：由 Y 和算例启动时间推算，只含启动时间占用"));
+        note_label_->show();
+    } else {
+        note_label_->hide();
+    }
 
-    double avg = capacity["avg_utilization"].toDouble();
-    double max = capacity["max_utilization"].toDouble();
-    QJsonArray by_period = capacity["by_period"].toArray();
+    double avg = metrics.avg_utilization;
+    double max = metrics.max_utilization;
+    const QVector<double>& by_period = metrics.utilization_by_period;
 
     avg_label_->setText(QString("%1%").arg(avg * 100, 0, 'f', 1));
     max_label_->setText(QString("%1%").arg(max * 100, 0, 'f', 1));
@@ -63,10 +89,8 @@ void CapacityPanel::LoadData(const QJsonObject& json) {
     // Find max period
     int max_period = 0;
     double max_val = 0.0;
-    QVector<double> values;
     for (int i = 0; i < by_period.size(); ++i) {
-        double val = by_period[i].toDouble();
-        values.append(val);
+        double val = by_period[i];
         if (val > max_val) {
             max_val = val;
             max_period = i + 1;
@@ -80,7 +104,7 @@ void CapacityPanel::LoadData(const QJsonObject& json) {
             .arg(max_period));
     }
 
-    chart_->SetData(values);
+    chart_->SetData(by_period);
 
     // Add reference line at 100%
     chart_->SetReferenceLine(1.0, "100%");
@@ -89,5 +113,6 @@ void CapacityPanel::LoadData(const QJsonObject& json) {
 void CapacityPanel::Clear() {
     avg_label_->setText("--");
     max_label_->setText("--");
+    note_label_->hide();
     chart_->Clear();
 }
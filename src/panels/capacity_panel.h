@@ -5,7 +5,7 @@
 #define CAPACITY_PANEL_H_
 
 #include <QWidget>
-#include <QJsonObject>
+#include "../core/result_model.h"
 
 class LineChart;
 class QLabel;
@@ -17,7 +17,7 @@ class CapacityPanel : public QWidget {
 public:
     explicit CapacityPanel(QWidget* parent = nullptr);
 
-    void LoadData(const QJsonObject& json);
+    void LoadData(const ResultModelPtr& model);
     void Clear();
 
 private:
@@ -25,6 +25,7 @@ private:
 
     QLabel* avg_label_;
     QLabel* max_label_;
+    QLabel* note_label_;    // what the figures cover, when not everything
     LineChart* chart_;
 };
 
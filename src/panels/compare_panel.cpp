@@ -0,0 +1,426 @@
+// compare_panel.cpp - Multi-result comparison panel implementation
+
+#include "compare_panel.h"
+#include "../result_compare_worker.h"
+#include "../widgets/heatmap.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QComboBox>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QSplitter>
+#include <QTableWidget>
+#include <QThread>
+
+namespace {
+
+// Variables shown as changed-cell columns, in display order
+const char* const kCompareVars[] = {"X", "Y", "L", "I", "B", "U"};
+constexpr int kCompareVarCount = 6;
+
+// Fixed columns before the per-variable ones
+enum CompareColumn {
+    kColFile = 0,
+    kColAlgorithm,
+    kColObjective,
+    kColObjectiveDelta,
+    kColProductionDelta,
+    kColSetupDelta,
+    kColInventoryDelta,
+    kColPenaltyDelta,
+    kColTime,
+    kColTimeDelta,
+    kColFirstVariable
+};
+
+QString FormatDelta(double value, int decimals) {
+    if (value == 0.0) return "0";
+    return (value > 0 ? "+" : "") + QString::number(value, 'f', decimals);
+}
+
+QTableWidgetItem* MakeItem(const QString& text) {
+    auto* item = new QTableWidgetItem(text);
+    item->setTextAlignment(Qt::AlignCenter);
+    return item;
+}
+
+}  // namespace
+
+ComparePanel::ComparePanel(const ResultCachePtr& cache, QWidget* parent)
+    : QWidget(parent)
+    , compare_thread_(nullptr)
+    , compare_worker_(nullptr)
+    , cache_(cache)
+    , request_id_(0)
+    , baseline_(0) {
+    SetupUi();
+    SetupWorker();
+}
+
+ComparePanel::~ComparePanel() {
+    if (compare_thread_) {
+        compare_worker_->RequestCancel(request_id_);
+        compare_thread_->quit();
+        compare_thread_->wait();
+    }
+}
+
+void ComparePanel::SetupUi() {
+    auto* layout = new QVBoxLayout(this);
+    layout->setSpacing(8);
+    layout->setContentsMargins(8, 8, 8, 8);
+
+    // Top bar: set management
+    auto* top_layout = new QHBoxLayout();
+    add_button_ = new QPushButton(QString::fromUtf8("添加结果..."), this);
+    remove_button_ = new QPushButton(QString::fromUtf8("移除"), this);
+    baseline_button_ = new QPushButton(QString::fromUtf8("设为基准"), this);
+    clear_button_ = new QPushButton(QString::fromUtf8("清空"), this);
+    remove_button_->setEnabled(false);
+    baseline_button_->setEnabled(false);
+    clear_button_->setEnabled(false);
+
+    top_layout->addWidget(add_button_);
+    top_layout->addWidget(remove_button_);
+    top_layout->addWidget(baseline_button_);
+    top_layout->addWidget(clear_button_);
+    top_layout->addStretch();
+    layout->addLayout(top_layout);
+
+    status_label_ = new QLabel(QString::fromUtf8("添加两个或以上结果文件进行对比"), this);
+    status_label_->setStyleSheet("color: #6c757d; font-size: 9pt;");
+    layout->addWidget(status_label_);
+
+    auto* splitter = new QSplitter(Qt::Vertical, this);
+
+    // Summary table: one row per result, deltas against the baseline
+    table_ = new QTableWidget(this);
+    table_->verticalHeader()->setVisible(false);
+    table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table_->setSelectionMode(QAbstractItemView::SingleSelection);
+    table_->setAlternatingRowColors(true);
+
+    QStringList headers = {
+        QString::fromUtf8("文件"),
+        QString::fromUtf8("算法"),
+        QString::fromUtf8("目标值"),
+        QString::fromUtf8("Δ目标值"),
+        QString::fromUtf8("Δ生产"),
+        QString::fromUtf8("Δ启动"),
+        QString::fromUtf8("Δ库存"),
+        QString::fromUtf8("Δ惩罚"),
+        QString::fromUtf8("时间(s)"),
+        QString::fromUtf8("Δ时间")
+    };
+    for (int v = 0; v < kCompareVarCount; ++v) {
+        headers << QString::fromUtf8("%1 变化").arg(QString(kCompareVars[v]));
+    }
+    table_->setColumnCount(headers.size());
+    table_->setHorizontalHeaderLabels(headers);
+    table_->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    table_->horizontalHeader()->setSectionResizeMode(kColFile, QHeaderView::Stretch);
+    splitter->addWidget(table_);
+
+    // Diff heatmap for the selected result and variable
+    auto* diff_widget = new QWidget(this);
+    auto* diff_layout = new QVBoxLayout(diff_widget);
+    diff_layout->setContentsMargins(0, 0, 0, 0);
+    diff_layout->setSpacing(4);
+
+    auto* diff_bar = new QHBoxLayout();
+    diff_bar->addWidget(new QLabel(QString::fromUtf8("差异变量:"), this));
+    var_combo_ = new QComboBox(this);
+    for (int v = 0; v < kCompareVarCount; ++v) var_combo_->addItem(kCompareVars[v]);
+    diff_bar->addWidget(var_combo_);
+    diff_label_ = new QLabel("--", this);
+    diff_label_->setStyleSheet("color: #6c757d; font-size: 9pt;");
+    diff_bar->addWidget(diff_label_, 1);
+    diff_layout->addLayout(diff_bar);
+
+    diff_heatmap_ = new Heatmap(this);
+    diff_heatmap_->SetColors(QColor("#f1f3f5"), QColor("#fa5252"));
+    diff_layout->addWidget(diff_heatmap_, 1);
+    splitter->addWidget(diff_widget);
+
+    splitter->setStretchFactor(0, 1);
+    splitter->setStretchFactor(1, 2);
+    layout->addWidget(splitter, 1);
+
+    // Connections
+    connect(add_button_, &QPushButton::clicked, this, &ComparePanel::OnAddFiles);
+    connect(remove_button_, &QPushButton::clicked, this, &ComparePanel::OnRemoveSelected);
+    connect(baseline_button_, &QPushButton::clicked, this, &ComparePanel::OnSetBaseline);
+    connect(clear_button_, &QPushButton::clicked, this, &ComparePanel::OnClear);
+    connect(table_, &QTableWidget::itemSelectionChanged,
+            this, &ComparePanel::OnSelectionChanged);
+    connect(var_combo_, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, [this](int) { UpdateDiffView(); });
+}
+
+void ComparePanel::SetupWorker() {
+    compare_thread_ = new QThread(this);
+    compare_worker_ = new ResultCompareWorker(cache_);
+    compare_worker_->moveToThread(compare_thread_);
+
+    connect(this, &ComparePanel::RequestCompare,
+            compare_worker_, &ResultCompareWorker::Compare);
+    connect(compare_worker_, &ResultCompareWorker::CompareProgress,
+            this, &ComparePanel::OnCompareProgress);
+    connect(compare_worker_, &ResultCompareWorker::CompareFinished,
+            this, &ComparePanel::OnCompareFinished);
+    connect(compare_worker_, &ResultCompareWorker::CompareCancelled,
+            this, &ComparePanel::OnCompareCancelled);
+
+    connect(compare_thread_, &QThread::finished, compare_worker_, &QObject::deleteLater);
+    compare_thread_->start();
+}
+
+void ComparePanel::AddResult(const QString& path, const ResultModelPtr& model) {
+    int existing = paths_.indexOf(path);
+    if (existing >= 0) {
+        if (model) models_[existing] = model;
+    } else {
+        paths_ << path;
+        models_.push_back(model);
+    }
+    StartCompare();
+}
+
+void ComparePanel::AddResults(const QStringList& paths) {
+    for (const QString& path : paths) {
+        if (paths_.contains(path)) continue;
+        paths_ << path;
+        models_.push_back(nullptr);
+    }
+    StartCompare();
+}
+
+void ComparePanel::Clear() {
+    compare_worker_->RequestCancel(request_id_);
+    paths_.clear();
+    models_.clear();
+    baseline_ = 0;
+    comparison_.reset();
+
+    table_->setRowCount(0);
+    diff_heatmap_->Clear();
+    diff_label_->setText("--");
+    status_label_->setText(QString::fromUtf8("添加两个或以上结果文件进行对比"));
+    remove_button_->setEnabled(false);
+    baseline_button_->setEnabled(false);
+    clear_button_->setEnabled(false);
+}
+
+void ComparePanel::OnAddFiles() {
+    QString default_dir = "D:/YM-Code/LS-NTGF-All/results";
+    QStringList paths = QFileDialog::getOpenFileNames(
+        this,
+        QString::fromUtf8("添加对比结果"),
+        default_dir,
+        "JSON files (*.json);;All files (*)");
+
+    if (!paths.isEmpty()) {
+        AddResults(paths);
+    }
+}
+
+void ComparePanel::OnRemoveSelected() {
+    int row = SelectedRow();
+    if (row < 0 || row >= paths_.size()) return;
+
+    paths_.removeAt(row);
+    models_.erase(models_.begin() + row);
+    if (row < baseline_ || baseline_ >= paths_.size()) {
+        baseline_ = qMax(0, baseline_ - 1);
+    }
+    if (paths_.isEmpty()) {
+        Clear();
+        return;
+    }
+    StartCompare();
+}
+
+void ComparePanel::OnSetBaseline() {
+    int row = SelectedRow();
+    if (row < 0 || row >= paths_.size() || row == baseline_) return;
+    baseline_ = row;
+    StartCompare();
+}
+
+void ComparePanel::OnClear() {
+    Clear();
+}
+
+int ComparePanel::SelectedRow() const {
+    QList<QTableWidgetItem*> items = table_->selectedItems();
+    return items.isEmpty() ? -1 : items.first()->row();
+}
+
+void ComparePanel::StartCompare() {
+    // Supersede any comparison still in flight
+    compare_worker_->RequestCancel(request_id_);
+    ++request_id_;
+
+    auto request = std::make_shared<ComparisonSet>();
+    request->paths = paths_;
+    request->models = models_;
+    request->baseline = baseline_;
+
+    clear_button_->setEnabled(!paths_.isEmpty());
+    status_label_->setText(QString::fromUtf8("对比中..."));
+    emit RequestCompare(request_id_, request);
+}
+
+void ComparePanel::OnCompareProgress(int request_id, const QString& stage) {
+    if (request_id != request_id_) return;
+    status_label_->setText(QString::fromUtf8("对比中: %1").arg(stage));
+}
+
+void ComparePanel::OnCompareCancelled(int request_id) {
+    if (request_id != request_id_) return;
+    status_label_->setText(QString::fromUtf8("对比已取消"));
+}
+
+void ComparePanel::OnCompareFinished(int request_id, const ComparisonPtr& result) {
+    if (request_id != request_id_) return;
+
+    comparison_ = result;
+    models_ = result->models;  // keep loaded models for the next comparison
+
+    int failed = 0;
+    for (const auto& model : models_) {
+        if (!model) ++failed;
+    }
+    QString status = QString::fromUtf8("%1 个结果，基准: %2")
+        .arg(paths_.size())
+        .arg(QFileInfo(paths_.value(baseline_)).fileName());
+    if (failed > 0) status += QString::fromUtf8("，%1 个加载失败").arg(failed);
+    status_label_->setText(status);
+
+    PopulateTable();
+    UpdateDiffView();
+}
+
+void ComparePanel::PopulateTable() {
+    const ComparisonSet& set = *comparison_;
+    const int rows = set.paths.size();
+
+    int selected = SelectedRow();
+    table_->setRowCount(rows);
+    QFont bold_font = table_->font();
+    bold_font.setBold(true);
+
+    for (int r = 0; r < rows; ++r) {
+        const ResultModelPtr& model = set.models[r];
+        const bool is_baseline = r == set.baseline;
+
+        auto* file_item = new QTableWidgetItem(QFileInfo(set.paths[r]).fileName());
+        file_item->setToolTip(set.paths[r]);
+        if (is_baseline) file_item->setFont(bold_font);
+        table_->setItem(r, kColFile, file_item);
+
+        for (int c = kColAlgorithm; c < table_->columnCount(); ++c) {
+            table_->setItem(r, c, MakeItem("--"));
+        }
+        if (!model) {
+            table_->item(r, kColAlgorithm)->setText(QString::fromUtf8("加载失败"));
+            table_->item(r, kColAlgorithm)->setToolTip(set.errors.value(r));
+            continue;
+        }
+
+        table_->item(r, kColAlgorithm)->setText(model->summary.algorithm);
+        table_->item(r, kColObjective)->setText(QString::number(model->summary.objective, 'f', 2));
+        table_->item(r, kColTime)->setText(QString::number(model->summary.total_time, 'f', 2));
+        if (is_baseline) {
+            table_->item(r, kColObjectiveDelta)->setText(QString::fromUtf8("基准"));
+            continue;
+        }
+        if (!set.models[set.baseline]) continue;
+
+        const ResultDiff& diff = set.diffs[r];
+        table_->item(r, kColObjectiveDelta)->setText(FormatDelta(diff.objective_delta, 2));
+        if (diff.has_cost_deltas) {
+            table_->item(r, kColProductionDelta)->setText(FormatDelta(diff.cost_production_delta, 2));
+            table_->item(r, kColSetupDelta)->setText(FormatDelta(diff.cost_setup_delta, 2));
+            table_->item(r, kColInventoryDelta)->setText(FormatDelta(diff.cost_inventory_delta, 2));
+            table_->item(r, kColPenaltyDelta)->setText(
+                FormatDelta(diff.cost_backorder_delta + diff.cost_unmet_delta, 2));
+        }
+        table_->item(r, kColTimeDelta)->setText(FormatDelta(diff.total_time_delta, 2));
+
+        for (int v = 0; v < kCompareVarCount; ++v) {
+            const VariableDiff* var_diff = diff.FindVariable(kCompareVars[v]);
+            QTableWidgetItem* item = table_->item(r, kColFirstVariable + v);
+            if (!var_diff) continue;
+            if (!var_diff->comparable) {
+                item->setText(QString::fromUtf8("维度不同"));
+                continue;
+            }
+            item->setText(QString::number(var_diff->changed_cells));
+            if (var_diff->changed_cells > 0) item->setForeground(QColor("#e03131"));
+        }
+    }
+
+    // Keep the selection, otherwise select the first non-baseline result
+    if (selected < 0 || selected >= rows) {
+        selected = (set.baseline == 0 && rows > 1) ? 1 : 0;
+    }
+    if (rows > 0) table_->selectRow(selected);
+}
+
+void ComparePanel::OnSelectionChanged() {
+    int row = SelectedRow();
+    remove_button_->setEnabled(row >= 0);
+    baseline_button_->setEnabled(row >= 0 && row != baseline_);
+    UpdateDiffView();
+}
+
+void ComparePanel::UpdateDiffView() {
+    const int row = SelectedRow();
+    const QString name = var_combo_->currentText();
+    if (!comparison_ || row < 0 || row >= static_cast<int>(comparison_->models.size())) {
+        diff_heatmap_->Clear();
+        diff_label_->setText("--");
+        return;
+    }
+
+    const ComparisonSet& set = *comparison_;
+    const ResultModelPtr& base = set.models[set.baseline];
+    const ResultModelPtr& other = set.models[row];
+    if (row == set.baseline || !base || !other) {
+        diff_heatmap_->Clear();
+        diff_label_->setText(row == set.baseline ?
+            QString::fromUtf8("选中的是基准结果") : QString::fromUtf8("结果未加载"));
+        return;
+    }
+
+    const ResultVariable* base_var = base->FindVariable(name);
+    const ResultVariable* other_var = other->FindVariable(name);
+    const VariableDiff* var_diff = set.diffs[row].FindVariable(name);
+    if (!base_var || !other_var || !var_diff || !var_diff->comparable) {
+        diff_heatmap_->Clear();
+        diff_label_->setText(QString::fromUtf8("变量 %1 无法对比").arg(name));
+        return;
+    }
+
+    // Delta matrix is built on demand for the one pair on screen
+    diff_heatmap_->SetLabels(name == "Y" || name == "L" ? "G" : (name == "I" ? "F" : "i"), "t");
+    diff_heatmap_->SetMatrix(base_var->rows, base_var->cols, AbsDeltaMatrix(*base_var, *other_var));
+
+    if (var_diff->binary) {
+        diff_label_->setText(QString::fromUtf8("%1: 汉明距离 %2 / %3 格")
+            .arg(name).arg(var_diff->changed_cells).arg(base_var->CellCount()));
+    } else {
+        diff_label_->setText(QString::fromUtf8("%1: 变化 %2 / %3 格, Σ|Δ| = %4, max|Δ| = %5")
+            .arg(name)
+            .arg(var_diff->changed_cells)
+            .arg(base_var->CellCount())
+            .arg(var_diff->sum_abs_delta, 0, 'f', 2)
+            .arg(var_diff->max_abs_delta, 0, 'f', 2));
+    }
+}
@@ -0,0 +1,78 @@
+// compare_panel.h - Multi-result comparison panel
+// Compares N result files against a baseline: objective/cost deltas, changed
+// cells per variable and a diff heatmap for the selected result
+
+#ifndef COMPARE_PANEL_H_
+#define COMPARE_PANEL_H_
+
+#include <QWidget>
+#include <QStringList>
+#include <vector>
+#include "../core/result_compare.h"
+
+class Heatmap;
+class QComboBox;
+class QLabel;
+class QPushButton;
+class QTableWidget;
+class QThread;
+class ResultCompareWorker;
+
+class ComparePanel : public QWidget {
+    Q_OBJECT
+
+public:
+    // |cache| is the shared result cache the comparison loads files through
+    explicit ComparePanel(const ResultCachePtr& cache, QWidget* parent = nullptr);
+    ~ComparePanel() override;
+
+    // Add a result file; |model| can be passed when it is already loaded
+    void AddResult(const QString& path, const ResultModelPtr& model = nullptr);
+    void AddResults(const QStringList& paths);
+    void Clear();
+
+signals:
+    void RequestCompare(int request_id, const ComparisonPtr& request);
+
+private slots:
+    void OnAddFiles();
+    void OnRemoveSelected();
+    void OnSetBaseline();
+    void OnClear();
+    void OnSelectionChanged();
+    void OnCompareProgress(int request_id, const QString& stage);
+    void OnCompareFinished(int request_id, const ComparisonPtr& result);
+    void OnCompareCancelled(int request_id);
+
+private:
+    void SetupUi();
+    void SetupWorker();
+    void StartCompare();
+    void PopulateTable();
+    void UpdateDiffView();
+    int SelectedRow() const;
+
+    QPushButton* add_button_;
+    QPushButton* remove_button_;
+    QPushButton* baseline_button_;
+    QPushButton* clear_button_;
+    QLabel* status_label_;
+    QTableWidget* table_;
+    QComboBox* var_combo_;
+    QLabel* diff_label_;
+    Heatmap* diff_heatmap_;
+
+    // Background comparison
+    QThread* compare_thread_;
+    ResultCompareWorker* compare_worker_;
+    ResultCachePtr cache_;
+    int request_id_;
+
+    // Comparison set; models_ caches loaded results (nullptr until loaded)
+    QStringList paths_;
+    std::vector<ResultModelPtr> models_;
+    int baseline_;
+    ComparisonPtr comparison_;
+};
+
+#endif  // COMPARE_PANEL_H_
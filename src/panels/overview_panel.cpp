@@ -10,7 +10,6 @@
 #include <QGroupBox>
 #include <QLabel>
 #include <QJsonObject>
-#include <QJsonArray>
 
 OverviewPanel::OverviewPanel(QWidget* parent)
     : QWidget(parent) {
@@ -69,15 +68,20 @@ void OverviewPanel::SetupUi() {
     layout->addStretch();
 }
 
-void OverviewPanel::LoadData(const QJsonObject& json) {
+void OverviewPanel::LoadData(const ResultModelPtr& model) {
+    if (!model) {
+        Clear();
+        return;
+    }
+
     // Summary section
-    QJsonObject summary = json["summary"].toObject();
-    QString algo = summary["algorithm"].toString();
+    const ResultSummary& summary = model->summary;
+    QString algo = summary.algorithm;
 
-    double objective = summary["objective"].toDouble();
-    double solve_time = summary["solve_time"].toDouble();
-    double gap = summary["gap"].toDouble();
-    int unmet_count = summary["unmet_count"].toInt();
+    double objective = summary.objective;
+    double solve_time = summary.solve_time;
+    double gap = summary.gap;
+    int unmet_count = summary.unmet_count;
 
     card_objective_->SetValue(objective, 2);
     card_time_->SetValue(QString("%1s").arg(solve_time, 0, 'f', 2));
@@ -85,38 +89,26 @@ void OverviewPanel::LoadData(const QJsonObject& json) {
     card_unmet_->SetValue(unmet_count);
 
     // Metrics section
-    QJsonObject metrics = json["metrics"].toObject();
+    const ResultMetrics& metrics = model->metrics;
 
     // Setup/Carryover
-    QJsonObject setup_carryover = metrics["setup_carryover"].toObject();
-    int total_setups = setup_carryover["total_setups"].toInt();
-    int total_carryovers = setup_carryover["total_carryovers"].toInt();
-    card_setups_->SetValue(total_setups);
-    card_carryovers_->SetValue(total_carryovers);
+    card_setups_->SetValue(metrics.total_setups);
+    card_carryovers_->SetValue(metrics.total_carryovers);
 
-    // Cost breakdown
-    QJsonObject cost = metrics["cost"].toObject();
-    double cost_production = cost["production"].toDouble();
-    double cost_setup = cost["setup"].toDouble();
-    double cost_inventory = cost["inventory"].toDouble();
-    double cost_backorder = cost["backorder"].toDouble();
-    double cost_unmet = cost["unmet"].toDouble();
-    cost_bar_->SetCosts(cost_production, cost_setup, cost_inventory,
-                        cost_backorder, cost_unmet);
+    // Cost breakdown (recomputed from the variables when the file had no metrics)
+    cost_group_->setTitle(metrics.derived ? QString::fromUtf8("成本构成 (由决策变量推算)") :
+                                            QString::fromUtf8("成本构成"));
+    cost_bar_->SetCosts(metrics.cost_production, metrics.cost_setup, metrics.cost_inventory,
+                        metrics.cost_backorder, metrics.cost_unmet);
 
     // Problem info
-    QJsonObject problem = json["problem"].toObject();
-    int N = problem["N"].toInt();
-    int T = problem["T"].toInt();
-    int G = problem["G"].toInt();
-    int F = problem["F"].toInt();
-    int cap = problem["capacity"].toInt();
+    const ResultProblem& problem = model->problem;
     problem_label_->setText(
         QString("N=%1  T=%2  G=%3  F=%4  Capacity=%5")
-            .arg(N).arg(T).arg(G).arg(F).arg(cap));
+            .arg(problem.n).arg(problem.t).arg(problem.g).arg(problem.f).arg(problem.capacity));
 
     // Algorithm-specific metrics
-    QJsonObject algo_specific = metrics["algorithm_specific"].toObject();
+    const QJsonObject& algo_specific = metrics.algorithm_specific;
     QString algo_text;
 
     if (algo == "RF") {
@@ -178,6 +170,7 @@ void OverviewPanel::Clear() {
     card_setups_->SetValue("--");
     card_carryovers_->SetValue("--");
     cost_bar_->Clear();
+    cost_group_->setTitle(QString::fromUtf8("成本构成"));
     problem_label_->setText("--");
     algo_group_->setTitle(QString::fromUtf8("算法指标"));
     algo_label_->setText("--");
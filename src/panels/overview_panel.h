@@ -5,7 +5,7 @@
 #define OVERVIEW_PANEL_H_
 
 #include <QWidget>
-#include <QJsonObject>
+#include "../core/result_model.h"
 
 class MetricCard;
 class CostBar;
@@ -18,7 +18,7 @@ class OverviewPanel : public QWidget {
 public:
     explicit OverviewPanel(QWidget* parent = nullptr);
 
-    void LoadData(const QJsonObject& json);
+    void LoadData(const ResultModelPtr& model);
     void Clear();
 
 private:
@@ -9,10 +9,13 @@
 #include <QRadioButton>
 #include <QLabel>
 #include <QScrollArea>
-#include <QJsonArray>
+#include <QShowEvent>
+#include <utility>
+#include <vector>
 
 SetupPanel::SetupPanel(QWidget* parent)
-    : QWidget(parent) {
+    : QWidget(parent)
+    , display_pending_(false) {
     SetupUi();
 }
 
@@ -58,63 +61,91 @@ void SetupPanel::SetupUi() {
             this, &SetupPanel::OnMatrixChanged);
 }
 
-void SetupPanel::LoadData(const QJsonObject& json) {
-    variables_ = json["variables"].toObject();
+void SetupPanel::LoadData(const ResultSourcePtr& source) {
+    source_ = source;
 
-    // Display currently selected matrix
-    int current_id = matrix_group_->checkedId();
-    DisplayMatrix(current_id == 0 ? "Y" : "L");
+    // Nothing is decoded until the panel is actually looked at
+    display_pending_ = !isVisible();
+    if (!display_pending_) {
+        DisplayMatrix(CurrentMatrix());
+    }
 }
 
 void SetupPanel::Clear() {
-    variables_ = QJsonObject();
+    source_.reset();
+    display_pending_ = false;
     heatmap_->Clear();
     info_label_->setText("--");
 }
 
+void SetupPanel::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+    if (display_pending_) {
+        display_pending_ = false;
+        DisplayMatrix(CurrentMatrix());
+    }
+}
+
+QString SetupPanel::CurrentMatrix() const {
+    return matrix_group_->checkedId() == 0 ? "Y" : "L";
+}
+
 void SetupPanel::OnMatrixChanged(int id) {
     DisplayMatrix(id == 0 ? "Y" : "L");
 }
 
 void SetupPanel::DisplayMatrix(const QString& name) {
-    if (!variables_.contains(name)) {
+    if (!source_ || !source_->HasVariable(name)) {
         heatmap_->Clear();
         info_label_->setText(QString::fromUtf8("变量 %1 不存在").arg(name));
         return;
     }
 
-    QJsonObject var_obj = variables_[name].toObject();
-    QString desc = var_obj["description"].toString();
-    QJsonArray dims = var_obj["dimensions"].toArray();
-    QJsonArray data = var_obj["data"].toArray();
+    if (ResultVariablePtr var = source_->CachedVariable(name)) {
+        ShowMatrix(name, *var);
+        return;
+    }
+
+    heatmap_->Clear();
+    info_label_->setText(QString::fromUtf8("加载变量 %1...").arg(name));
+    emit VariableRequested(name);
+}
+
+void SetupPanel::ShowVariable(const QString& name, const ResultVariablePtr& var,
+                              const QString& error) {
+    if (!source_ || display_pending_ || name != CurrentMatrix()) return;
+
+    if (!var) {
+        heatmap_->Clear();
+        info_label_->setText(error);
+        return;
+    }
+    ShowMatrix(name, *var);
+}
 
-    if (dims.size() != 2) {
+void SetupPanel::ShowMatrix(const QString& name, const ResultVariable& var) {
+    if (var.rank != 2) {
         heatmap_->Clear();
         info_label_->setText(QString::fromUtf8("数据维度错误"));
         return;
     }
 
-    int rows = dims[0].toInt();
-    int cols = dims[1].toInt();
-
-    // Count non-zeros
-    int nonzero_count = 0;
-    QVector<QVector<int>> matrix_data;
-    for (int r = 0; r < data.size(); ++r) {
-        QJsonArray row_arr = data[r].toArray();
-        QVector<int> row_vec;
-        for (int c = 0; c < row_arr.size(); ++c) {
-            int val = row_arr[c].toInt();
-            row_vec.append(val);
-            if (val > 0) {
-                nonzero_count++;
-            }
-        }
-        matrix_data.append(row_vec);
+    int rows = var.rows;
+    int cols = var.cols;
+
+    // Y/L are bit-packed: the count is a popcount over the row words and only
+    // set bits are visited to fill the matrix
+    const size_t nonzero_count = var.NonzeroCount();
+    std::vector<float> matrix_data(static_cast<size_t>(rows) * cols, 0.0f);
+    for (int r = 0; r < rows; ++r) {
+        float* row_vec = matrix_data.data() + static_cast<size_t>(r) * cols;
+        var.ForEachNonzero(r, [row_vec](int c, double val) {
+            row_vec[c] = static_cast<float>(val);
+        });
     }
 
     info_label_->setText(QString("%1 [%2 x %3] - %4 = %5")
-        .arg(desc)
+        .arg(var.description)
         .arg(rows)
         .arg(cols)
         .arg(QString::fromUtf8("非零元素"))
@@ -127,5 +158,5 @@ void SetupPanel::DisplayMatrix(const QString& name) {
         heatmap_->SetColors(QColor("#f1f3f5"), QColor("#40c057"));  // Green for carryover
     }
 
-    heatmap_->SetData(matrix_data);
+    heatmap_->SetMatrix(rows, cols, std::move(matrix_data));
 }
@@ -1,11 +1,14 @@
 // setup_panel.h - Setup/Carryover visualization panel
-// Displays Y and L matrices as heatmaps
+// Displays Y and L matrices as heatmaps. A matrix is decoded the first time it is
+// shown: uncached variables are requested through VariableRequested and arrive
+// via ShowVariable.
 
 #ifndef SETUP_PANEL_H_
 #define SETUP_PANEL_H_
 
 #include <QWidget>
-#include <QJsonObject>
+#include "../core/result_model.h"
+#include "../core/result_source.h"
 
 class Heatmap;
 class QButtonGroup;
@@ -18,22 +21,34 @@ class SetupPanel : public QWidget {
 public:
     explicit SetupPanel(QWidget* parent = nullptr);
 
-    void LoadData(const QJsonObject& json);
+    void LoadData(const ResultSourcePtr& source);
     void Clear();
 
+    // Decoded answer to VariableRequested (ignored unless |name| is still selected)
+    void ShowVariable(const QString& name, const ResultVariablePtr& var, const QString& error);
+
+signals:
+    void VariableRequested(const QString& name);
+
+protected:
+    void showEvent(QShowEvent* event) override;
+
 private slots:
     void OnMatrixChanged(int id);
 
 private:
     void SetupUi();
+    QString CurrentMatrix() const;
     void DisplayMatrix(const QString& name);
+    void ShowMatrix(const QString& name, const ResultVariable& var);
 
     QButtonGroup* matrix_group_;
     QLabel* info_label_;
     QScrollArea* scroll_area_;
     Heatmap* heatmap_;
 
-    QJsonObject variables_;
+    ResultSourcePtr source_;
+    bool display_pending_;  // source set while hidden, display on next show
 };
 
 #endif  // SETUP_PANEL_H_
@@ -0,0 +1,170 @@
+// variable_table_model.cpp - Virtualized table model implementation
+
+#include "variable_table_model.h"
+
+#include <QBrush>
+#include <QFontMetrics>
+#include <algorithm>
+
+namespace {
+
+const QColor kTotalBackground("#f1f3f5");
+const QColor kGrandTotalBackground("#e9ecef");
+
+}  // namespace
+
+VariableTableModel::VariableTableModel(QObject* parent)
+    : QAbstractTableModel(parent)
+    , nonzero_only_(false)
+    , grand_total_(0.0) {
+    bold_font_.setBold(true);
+}
+
+void VariableTableModel::SetVariable(const ResultVariablePtr& var,
+                                     const QString& row_prefix, const QString& col_prefix,
+                                     const QColor& highlight) {
+    beginResetModel();
+    var_ = var;
+    row_prefix_ = row_prefix;
+    col_prefix_ = col_prefix;
+    highlight_ = highlight;
+
+    // Totals in a single pass over the nonzero cells only
+    const int rows = var_->rows;
+    const int cols = var_->cols;
+    row_totals_.assign(rows, 0.0);
+    col_totals_.assign(cols, 0.0);
+    grand_total_ = 0.0;
+    for (int r = 0; r < rows; ++r) {
+        double row_total = 0.0;
+        var_->ForEachNonzero(r, [this, &row_total](int c, double val) {
+            row_total += val;
+            col_totals_[c] += val;
+        });
+        row_totals_[r] = row_total;
+        grand_total_ += row_total;
+    }
+    RebuildRowMap();
+    endResetModel();
+}
+
+void VariableTableModel::SetNonzeroRowsOnly(bool enabled) {
+    if (nonzero_only_ == enabled) return;
+    beginResetModel();
+    nonzero_only_ = enabled;
+    RebuildRowMap();
+    endResetModel();
+}
+
+void VariableTableModel::RebuildRowMap() {
+    row_map_.clear();
+    if (!var_ || !nonzero_only_) return;
+    for (int r = 0; r < var_->rows; ++r) {
+        if (var_->RowHasNonzero(r)) row_map_.push_back(r);
+    }
+}
+
+int VariableTableModel::SourceRow(int row) const {
+    return nonzero_only_ ? row_map_[row] : row;
+}
+
+void VariableTableModel::Clear() {
+    beginResetModel();
+    var_.reset();
+    row_map_.clear();
+    row_totals_.clear();
+    col_totals_.clear();
+    grand_total_ = 0.0;
+    endResetModel();
+}
+
+int VariableTableModel::DataRows() const {
+    if (!var_) return 0;
+    return nonzero_only_ ? static_cast<int>(row_map_.size()) : var_->rows;
+}
+
+int VariableTableModel::DataCols() const {
+    return var_ ? var_->cols : 0;
+}
+
+int VariableTableModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid() || !var_) return 0;
+    return DataRows() + 1;  // +1 for totals
+}
+
+int VariableTableModel::columnCount(const QModelIndex& parent) const {
+    if (parent.isValid() || !var_) return 0;
+    // 1D variables show a single value column without a totals column
+    return var_->rank == 1 ? 1 : DataCols() + 1;
+}
+
+double VariableTableModel::ValueAt(int row, int col) const {
+    const int rows = DataRows();
+    const int cols = DataCols();
+    if (var_->rank == 1) {
+        return row < rows ? var_->At(SourceRow(row), 0) : grand_total_;
+    }
+    if (row < rows && col < cols) return var_->At(SourceRow(row), col);
+    if (row < rows) return row_totals_[SourceRow(row)];
+    if (col < cols) return col_totals_[col];
+    return grand_total_;
+}
+
+QVariant VariableTableModel::data(const QModelIndex& index, int role) const {
+    if (!var_ || !index.isValid()) return QVariant();
+
+    const int row = index.row();
+    const int col = index.column();
+    const bool total_row = row >= DataRows();
+    const bool total_col = var_->rank == 2 && col >= DataCols();
+
+    switch (role) {
+        case Qt::DisplayRole:
+            return QString::number(ValueAt(row, col), 'f', 0);
+        case Qt::TextAlignmentRole:
+            return static_cast<int>(Qt::AlignCenter);
+        case Qt::BackgroundRole:
+            if (total_row && total_col) return QBrush(kGrandTotalBackground);
+            if (total_row || total_col) return QBrush(kTotalBackground);
+            // Highlight non-zero values
+            if (ValueAt(row, col) > 0.5) return QBrush(highlight_);
+            return QVariant();
+        case Qt::FontRole:
+            if (total_row || total_col) return bold_font_;
+            return QVariant();
+        default:
+            return QVariant();
+    }
+}
+
+QVariant VariableTableModel::headerData(int section, Qt::Orientation orientation,
+                                        int role) const {
+    if (!var_) return QVariant();
+    if (role == Qt::TextAlignmentRole) return static_cast<int>(Qt::AlignCenter);
+    if (role != Qt::DisplayRole) return QVariant();
+
+    if (orientation == Qt::Horizontal) {
+        if (var_->rank == 1) return QString::fromUtf8("值");
+        if (section < DataCols()) return QString("%1=%2").arg(col_prefix_).arg(section + 1);
+        return QString::fromUtf8("合计");
+    }
+    if (section < DataRows()) return QString("%1%2").arg(row_prefix_).arg(SourceRow(section) + 1);
+    return QString::fromUtf8("合计");
+}
+
+int VariableTableModel::EstimateColumnWidth(int column, const QFontMetrics& metrics) const {
+    int width = metrics.horizontalAdvance(headerData(column, Qt::Horizontal).toString());
+    if (!var_) return width + kCellPadding;
+
+    // Sample evenly spaced rows plus the totals row (usually the widest number)
+    const int rows = rowCount();
+    const int step = std::max(1, rows / kWidthSampleRows);
+    QFontMetrics bold_metrics(bold_font_);
+    for (int r = 0; r < rows; r += step) {
+        width = std::max(width, metrics.horizontalAdvance(
+            QString::number(ValueAt(r, column), 'f', 0)));
+    }
+    width = std::max(width, bold_metrics.horizontalAdvance(
+        QString::number(ValueAt(rows - 1, column), 'f', 0)));
+    return width + kCellPadding;
+}
@@ -0,0 +1,69 @@
+// variable_table_model.h - Virtualized table model over a result variable
+// Cells are formatted on demand; row/column totals are precomputed once from the
+// nonzero cells, and zero rows can be hidden
+
+#ifndef VARIABLE_TABLE_MODEL_H_
+#define VARIABLE_TABLE_MODEL_H_
+
+#include <QAbstractTableModel>
+#include <QColor>
+#include <QFont>
+#include <QString>
+#include <vector>
+#include "../core/result_model.h"
+
+class QFontMetrics;
+
+class VariableTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    explicit VariableTableModel(QObject* parent = nullptr);
+
+    // Show |var| (kept alive by the model). Adds one trailing totals row and column.
+    void SetVariable(const ResultVariablePtr& var,
+                     const QString& row_prefix, const QString& col_prefix,
+                     const QColor& highlight);
+    void Clear();
+
+    // Hide rows without any nonzero cell (the totals row is always kept)
+    void SetNonzeroRowsOnly(bool enabled);
+    bool NonzeroRowsOnly() const { return nonzero_only_; }
+    int VisibleDataRows() const { return DataRows(); }
+
+    const ResultVariable* Variable() const { return var_.get(); }
+
+    // Estimate a column width from a sample of rows instead of measuring every cell
+    int EstimateColumnWidth(int column, const QFontMetrics& metrics) const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+private:
+    double ValueAt(int row, int col) const;
+    int DataRows() const;
+    int DataCols() const;
+    int SourceRow(int row) const;
+    void RebuildRowMap();
+
+    ResultVariablePtr var_;
+    QString row_prefix_;
+    QString col_prefix_;
+    QColor highlight_;
+    QFont bold_font_;
+
+    bool nonzero_only_;
+    std::vector<int> row_map_;  // visible row -> variable row when nonzero_only_
+
+    std::vector<double> row_totals_;
+    std::vector<double> col_totals_;
+    double grand_total_;
+
+    static const int kWidthSampleRows = 64;
+    static const int kCellPadding = 16;
+};
+
+#endif  // VARIABLE_TABLE_MODEL_H_
@@ -1,22 +1,26 @@
 // variables_panel.cpp - Variables browser panel implementation
 
 #include "variables_panel.h"
+#include "variable_table_model.h"
+#include "../core/result_csv.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QButtonGroup>
-#include <QTableWidget>
+#include <QCheckBox>
+#include <QTableView>
 #include <QPushButton>
 #include <QLabel>
 #include <QHeaderView>
 #include <QFileDialog>
-#include <QFile>
-#include <QTextStream>
 #include <QMessageBox>
 #include <QColor>
+#include <QFontMetrics>
+#include <QShowEvent>
 
 VariablesPanel::VariablesPanel(QWidget* parent)
-    : QWidget(parent) {
+    : QWidget(parent)
+    , display_pending_(false) {
     SetupUi();
 }
 
@@ -61,11 +65,19 @@ void VariablesPanel::SetupUi() {
 
     top_layout->addStretch();
 
+    nonzero_only_check_ = new QCheckBox(QString::fromUtf8("仅显示非零行"), this);
+    top_layout->addWidget(nonzero_only_check_);
+
     export_button_ = new QPushButton(QString::fromUtf8("导出CSV"), this);
     export_button_->setEnabled(false);
     export_button_->setFixedWidth(80);
     top_layout->addWidget(export_button_);
 
+    export_all_button_ = new QPushButton(QString::fromUtf8("导出全部..."), this);
+    export_all_button_->setEnabled(false);
+    export_all_button_->setToolTip(QString::fromUtf8("将所有决策变量按完整精度导出为 CSV"));
+    top_layout->addWidget(export_all_button_);
+
     layout->addLayout(top_layout);
 
     // Info label
@@ -73,15 +85,21 @@ void VariablesPanel::SetupUi() {
     info_label_->setStyleSheet("color: #6c757d; font-size: 9pt;");
     layout->addWidget(info_label_);
 
-    // Table
-    table_ = new QTableWidget(this);
+    // Table (virtualized: cells are formatted on demand by the model)
+    table_model_ = new VariableTableModel(this);
+    table_ = new QTableView(this);
+    table_->setModel(table_model_);
     table_->setAlternatingRowColors(true);
+    table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
     table_->setStyleSheet(
-        "QTableWidget { gridline-color: #dee2e6; }"
-        "QTableWidget::item { padding: 2px; }"
+        "QTableView { gridline-color: #dee2e6; }"
+        "QTableView::item { padding: 2px; }"
     );
     table_->horizontalHeader()->setDefaultAlignment(Qt::AlignCenter);
     table_->verticalHeader()->setDefaultAlignment(Qt::AlignCenter);
+    // Fixed row heights keep the view from measuring rows it never shows
+    table_->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    table_->verticalHeader()->setDefaultSectionSize(table_->fontMetrics().height() + 8);
     layout->addWidget(table_, 1);
 
     // Connections
@@ -89,181 +107,137 @@ void VariablesPanel::SetupUi() {
             this, &VariablesPanel::OnVariableButtonClicked);
     connect(export_button_, &QPushButton::clicked,
             this, &VariablesPanel::OnExportCsv);
+    connect(export_all_button_, &QPushButton::clicked,
+            this, &VariablesPanel::OnExportAllCsv);
+    connect(nonzero_only_check_, &QCheckBox::toggled,
+            this, &VariablesPanel::OnNonzeroOnlyToggled);
 }
 
-void VariablesPanel::LoadData(const QJsonObject& json) {
-    variables_ = json["variables"].toObject();
-    export_button_->setEnabled(!variables_.isEmpty());
+void VariablesPanel::LoadData(const ResultSourcePtr& source) {
+    source_ = source;
+    table_model_->Clear();
+    export_button_->setEnabled(false);
+    export_all_button_->setEnabled(source_ && source_->HasVariables());
 
-    // Display currently selected variable
-    if (!variables_.isEmpty()) {
-        int checked_id = var_button_group_->checkedId();
-        if (checked_id >= 0 && checked_id < var_names_.size()) {
-            DisplayVariable(var_names_[checked_id]);
-        }
+    // Nothing is decoded until the panel is actually looked at
+    display_pending_ = !isVisible();
+    if (!display_pending_) {
+        DisplayCheckedVariable();
     }
 }
 
 void VariablesPanel::Clear() {
-    variables_ = QJsonObject();
-    table_->clear();
-    table_->setRowCount(0);
-    table_->setColumnCount(0);
+    source_.reset();
+    display_pending_ = false;
+    current_var_.clear();
+    table_model_->Clear();
     info_label_->setText("--");
     export_button_->setEnabled(false);
+    export_all_button_->setEnabled(false);
+}
+
+void VariablesPanel::showEvent(QShowEvent* event) {
+    QWidget::showEvent(event);
+    if (display_pending_) {
+        display_pending_ = false;
+        DisplayCheckedVariable();
+    }
+}
+
+void VariablesPanel::DisplayCheckedVariable() {
+    int checked_id = var_button_group_->checkedId();
+    if (source_ && source_->HasVariables() && checked_id >= 0 && checked_id < var_names_.size()) {
+        DisplayVariable(var_names_[checked_id]);
+    }
 }
 
 void VariablesPanel::OnVariableButtonClicked(int id) {
-    if (!variables_.isEmpty() && id >= 0 && id < var_names_.size()) {
+    if (source_ && source_->HasVariables() && id >= 0 && id < var_names_.size()) {
         DisplayVariable(var_names_[id]);
     }
 }
 
+void VariablesPanel::OnNonzeroOnlyToggled(bool checked) {
+    table_model_->SetNonzeroRowsOnly(checked);
+    if (table_model_->Variable()) {
+        UpdateInfoLabel();
+        ApplyColumnWidths();
+    }
+}
+
 void VariablesPanel::DisplayVariable(const QString& name) {
     current_var_ = name;
 
-    if (!variables_.contains(name)) {
-        table_->clear();
-        table_->setRowCount(0);
-        table_->setColumnCount(0);
+    if (!source_->HasVariable(name)) {
+        table_model_->Clear();
+        export_button_->setEnabled(false);
         info_label_->setText(QString::fromUtf8("变量 %1 不存在").arg(name));
         return;
     }
 
-    QJsonObject var_obj = variables_[name].toObject();
-    QString desc = var_obj["description"].toString();
-    QJsonArray dims = var_obj["dimensions"].toArray();
-    QJsonArray data = var_obj["data"].toArray();
-
-    if (dims.size() == 2) {
-        // 2D variable
-        int rows = dims[0].toInt();
-        int cols = dims[1].toInt();
-        info_label_->setText(QString("%1 [%2 x %3]").arg(desc).arg(rows).arg(cols));
-
-        QString row_prefix = (name == "Y" || name == "L") ? "G" :
-                             (name == "I") ? "F" : "i";
-        PopulateTable2D(data, rows, cols, row_prefix, "t");
-    } else if (dims.size() == 1) {
-        // 1D variable
-        int rows = dims[0].toInt();
-        info_label_->setText(QString("%1 [%2]").arg(desc).arg(rows));
-        PopulateTable1D(data, "i");
+    if (ResultVariablePtr var = source_->CachedVariable(name)) {
+        ShowTable(name, var);
+        return;
     }
+
+    table_model_->Clear();
+    export_button_->setEnabled(false);
+    info_label_->setText(QString::fromUtf8("加载变量 %1...").arg(name));
+    emit VariableRequested(name);
 }
 
-void VariablesPanel::PopulateTable2D(const QJsonArray& data, int rows, int cols,
-                                      const QString& row_prefix,
-                                      const QString& col_prefix) {
-    table_->clear();
-    table_->setRowCount(rows + 1);  // +1 for totals
-    table_->setColumnCount(cols + 1);  // +1 for totals
-
-    // Set headers
-    QStringList h_headers;
-    for (int c = 0; c < cols; ++c) {
-        h_headers << QString("%1=%2").arg(col_prefix).arg(c + 1);
-    }
-    h_headers << QString::fromUtf8("合计");
-    table_->setHorizontalHeaderLabels(h_headers);
+void VariablesPanel::ShowVariable(const QString& name, const ResultVariablePtr& var,
+                                  const QString& error) {
+    if (!source_ || display_pending_ || name != current_var_) return;
 
-    QStringList v_headers;
-    for (int r = 0; r < rows; ++r) {
-        v_headers << QString("%1%2").arg(row_prefix).arg(r + 1);
-    }
-    v_headers << QString::fromUtf8("合计");
-    table_->setVerticalHeaderLabels(v_headers);
-
-    // Fill data and calculate totals
-    QVector<double> col_totals(cols, 0.0);
-    double grand_total = 0.0;
-
-    for (int r = 0; r < rows && r < data.size(); ++r) {
-        QJsonArray row_data = data[r].toArray();
-        double row_total = 0.0;
-
-        for (int c = 0; c < cols && c < row_data.size(); ++c) {
-            double val = row_data[c].toDouble();
-            auto* item = new QTableWidgetItem(QString::number(val, 'f', 0));
-            item->setTextAlignment(Qt::AlignCenter);
-
-            // Highlight non-zero values
-            if (val > 0.5) {
-                item->setBackground(GetHighlightColor());
-            }
-
-            table_->setItem(r, c, item);
-            row_total += val;
-            col_totals[c] += val;
-        }
-
-        // Row total
-        auto* row_total_item = new QTableWidgetItem(QString::number(row_total, 'f', 0));
-        row_total_item->setTextAlignment(Qt::AlignCenter);
-        row_total_item->setBackground(QColor("#f1f3f5"));
-        row_total_item->setFont(QFont("", -1, QFont::Bold));
-        table_->setItem(r, cols, row_total_item);
-        grand_total += row_total;
+    if (!var) {
+        info_label_->setText(error);
+        return;
     }
+    ShowTable(name, var);
+}
 
-    // Column totals row
-    for (int c = 0; c < cols; ++c) {
-        auto* item = new QTableWidgetItem(QString::number(col_totals[c], 'f', 0));
-        item->setTextAlignment(Qt::AlignCenter);
-        item->setBackground(QColor("#f1f3f5"));
-        item->setFont(QFont("", -1, QFont::Bold));
-        table_->setItem(rows, c, item);
+void VariablesPanel::ShowTable(const QString& name, const ResultVariablePtr& var) {
+    table_model_->SetNonzeroRowsOnly(nonzero_only_check_->isChecked());
+    if (var->rank == 2) {
+        // 2D variable
+        table_model_->SetVariable(var, VariableRowPrefix(name), "t", GetHighlightColor());
+    } else {
+        // 1D variable
+        table_model_->SetVariable(var, "i", "t", GetHighlightColor());
     }
-
-    // Grand total
-    auto* grand_item = new QTableWidgetItem(QString::number(grand_total, 'f', 0));
-    grand_item->setTextAlignment(Qt::AlignCenter);
-    grand_item->setBackground(QColor("#e9ecef"));
-    grand_item->setFont(QFont("", -1, QFont::Bold));
-    table_->setItem(rows, cols, grand_item);
-
-    table_->resizeColumnsToContents();
+    export_button_->setEnabled(true);
+    UpdateInfoLabel();
+    ApplyColumnWidths();
 }
 
-void VariablesPanel::PopulateTable1D(const QJsonArray& data,
-                                      const QString& row_prefix) {
-    table_->clear();
-    int rows = data.size();
-    table_->setRowCount(rows + 1);
-    table_->setColumnCount(1);
-
-    table_->setHorizontalHeaderLabels({QString::fromUtf8("值")});
-
-    QStringList v_headers;
-    for (int r = 0; r < rows; ++r) {
-        v_headers << QString("%1%2").arg(row_prefix).arg(r + 1);
+void VariablesPanel::UpdateInfoLabel() {
+    const ResultVariable* var = table_model_->Variable();
+    if (!var) return;
+
+    QString shape = var->rank == 2 ?
+        QString("[%1 x %2]").arg(var->rows).arg(var->cols) :
+        QString("[%1]").arg(var->rows);
+    QString text = QString::fromUtf8("%1 %2  非零 %3")
+        .arg(var->description).arg(shape).arg(var->NonzeroCount());
+    if (table_model_->NonzeroRowsOnly()) {
+        text += QString::fromUtf8("  显示 %1/%2 行")
+            .arg(table_model_->VisibleDataRows()).arg(var->rows);
     }
-    v_headers << QString::fromUtf8("合计");
-    table_->setVerticalHeaderLabels(v_headers);
-
-    double total = 0.0;
-    for (int r = 0; r < rows; ++r) {
-        double val = data[r].toDouble();
-        auto* item = new QTableWidgetItem(QString::number(val, 'f', 0));
-        item->setTextAlignment(Qt::AlignCenter);
-        if (val > 0.5) {
-            item->setBackground(GetHighlightColor());
-        }
-        table_->setItem(r, 0, item);
-        total += val;
-    }
-
-    auto* total_item = new QTableWidgetItem(QString::number(total, 'f', 0));
-    total_item->setTextAlignment(Qt::AlignCenter);
-    total_item->setBackground(QColor("#f1f3f5"));
-    total_item->setFont(QFont("", -1, QFont::Bold));
-    table_->setItem(rows, 0, total_item);
+    info_label_->setText(text);
+}
 
-    table_->resizeColumnsToContents();
+void VariablesPanel::ApplyColumnWidths() {
+    // Widths come from a row sample, never from measuring every cell
+    QFontMetrics metrics(table_->font());
+    for (int c = 0; c < table_model_->columnCount(); ++c) {
+        table_->setColumnWidth(c, table_model_->EstimateColumnWidth(c, metrics));
+    }
 }
 
 void VariablesPanel::OnExportCsv() {
-    if (current_var_.isEmpty() || !variables_.contains(current_var_)) {
+    const ResultVariable* var = table_model_->Variable();
+    if (current_var_.isEmpty() || !var) {
         return;
     }
 
@@ -277,40 +251,34 @@ void VariablesPanel::OnExportCsv() {
         return;
     }
 
-    QFile file(filename);
-    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
-        QMessageBox::warning(this, QString::fromUtf8("错误"),
-                             QString::fromUtf8("无法创建文件: %1").arg(filename));
+    // Full precision straight from the variable buffer (all rows, no totals)
+    QString error;
+    if (!WriteVariableCsv(*var, filename, &error)) {
+        QMessageBox::warning(this, QString::fromUtf8("错误"), error);
         return;
     }
+    QMessageBox::information(this, QString::fromUtf8("成功"),
+                             QString::fromUtf8("已导出到: %1").arg(filename));
+}
 
-    QTextStream out(&file);
-
-    // Write headers
-    QStringList headers;
-    for (int c = 0; c < table_->columnCount(); ++c) {
-        auto* item = table_->horizontalHeaderItem(c);
-        headers << (item ? item->text() : QString::number(c));
+void VariablesPanel::OnExportAllCsv() {
+    if (!source_ || !source_->HasVariables()) {
+        return;
     }
-    out << "," << headers.join(",") << "\n";
-
-    // Write data
-    for (int r = 0; r < table_->rowCount(); ++r) {
-        auto* v_item = table_->verticalHeaderItem(r);
-        QString row_header = v_item ? v_item->text() : QString::number(r);
-
-        QStringList row_data;
-        row_data << row_header;
-        for (int c = 0; c < table_->columnCount(); ++c) {
-            auto* item = table_->item(r, c);
-            row_data << (item ? item->text() : "");
-        }
-        out << row_data.join(",") << "\n";
+
+    QString dir = QFileDialog::getExistingDirectory(
+        this, QString::fromUtf8("选择导出目录"));
+    if (dir.isEmpty()) {
+        return;
     }
 
-    file.close();
-    QMessageBox::information(this, QString::fromUtf8("成功"),
-                             QString::fromUtf8("已导出到: %1").arg(filename));
+    // Decoding every variable can take a while; the load worker does it
+    export_all_button_->setEnabled(false);
+    emit ExportAllRequested(dir);
+}
+
+void VariablesPanel::SetExportAllFinished() {
+    export_all_button_->setEnabled(source_ && source_->HasVariables());
 }
 
 QColor VariablesPanel::GetHighlightColor() const {
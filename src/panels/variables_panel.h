@@ -1,15 +1,18 @@
 // variables_panel.h - Variables browser panel
-// Displays decision variables in a table with export functionality
+// Displays decision variables in a virtualized table with export functionality.
+// Variables are decoded on first selection (VariableRequested -> ShowVariable).
 
 #ifndef VARIABLES_PANEL_H_
 #define VARIABLES_PANEL_H_
 
 #include <QWidget>
-#include <QJsonObject>
-#include <QJsonArray>
+#include "../core/result_model.h"
+#include "../core/result_source.h"
 
 class QButtonGroup;
-class QTableWidget;
+class QCheckBox;
+class QTableView;
+class VariableTableModel;
 class QPushButton;
 class QLabel;
 
@@ -19,28 +22,49 @@ class VariablesPanel : public QWidget {
 public:
     explicit VariablesPanel(QWidget* parent = nullptr);
 
-    void LoadData(const QJsonObject& json);
+    void LoadData(const ResultSourcePtr& source);
     void Clear();
 
+    // Decoded answer to VariableRequested (ignored unless |name| is still selected)
+    void ShowVariable(const QString& name, const ResultVariablePtr& var, const QString& error);
+
+    // Re-enable "export all" once the export requested by ExportAllRequested is done
+    void SetExportAllFinished();
+
+signals:
+    void VariableRequested(const QString& name);
+    // Export every variable of the shown result into |dir|
+    void ExportAllRequested(const QString& dir);
+
+protected:
+    void showEvent(QShowEvent* event) override;
+
 private slots:
     void OnVariableButtonClicked(int id);
     void OnExportCsv();
+    void OnExportAllCsv();
+    void OnNonzeroOnlyToggled(bool checked);
 
 private:
     void SetupUi();
+    void DisplayCheckedVariable();
     void DisplayVariable(const QString& name);
-    void PopulateTable2D(const QJsonArray& data, int rows, int cols,
-                         const QString& row_prefix, const QString& col_prefix);
-    void PopulateTable1D(const QJsonArray& data, const QString& row_prefix);
+    void ShowTable(const QString& name, const ResultVariablePtr& var);
+    void ApplyColumnWidths();
+    void UpdateInfoLabel();
     QColor GetHighlightColor() const;
 
     QButtonGroup* var_button_group_;
     QVector<QPushButton*> var_buttons_;
-    QTableWidget* table_;
+    QTableView* table_;
+    VariableTableModel* table_model_;
+    QCheckBox* nonzero_only_check_;
     QPushButton* export_button_;
+    QPushButton* export_all_button_;
     QLabel* info_label_;
 
-    QJsonObject variables_;
+    ResultSourcePtr source_;
+    bool display_pending_;  // source set while hidden, display on next show
     QString current_var_;
     QStringList var_names_;
 };
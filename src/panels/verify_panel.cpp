@@ -0,0 +1,391 @@
+// verify_panel.cpp - Solution feasibility panel implementation
+
+#include "verify_panel.h"
+#include "../core/result_binary.h"
+#include "../result_verify_worker.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QDirIterator>
+#include <QDoubleSpinBox>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QSplitter>
+#include <QTableWidget>
+#include <QThread>
+
+namespace {
+
+enum FileColumn {
+    kColFile = 0,
+    kColStatus,
+    kColFirstKind
+};
+
+// Periods listed in the per-period summary line
+constexpr int kMaxPeriodsShown = 20;
+
+QTableWidgetItem* MakeItem(const QString& text) {
+    auto* item = new QTableWidgetItem(text);
+    item->setTextAlignment(Qt::AlignCenter);
+    return item;
+}
+
+// Row label of the entity a violation refers to (1-based like the CSV export)
+QString EntityText(const Violation& violation) {
+    if (violation.entity < 0) return "--";
+    switch (violation.kind) {
+        case ViolationKind::Carryover: return QString("G%1").arg(violation.entity + 1);
+        case ViolationKind::Inventory: return QString("F%1").arg(violation.entity + 1);
+        default: return QString("i%1").arg(violation.entity + 1);
+    }
+}
+
+// Result files below |dir|; a .lsrb replaces the JSON it was converted from
+QStringList FindResultFiles(const QString& dir) {
+    QStringList paths;
+    QDirIterator it(dir, {"*_result_*.json", QString("*_result_*") + kResultBinarySuffix},
+                    QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) paths << it.next();
+
+    QStringList kept;
+    for (const QString& path : paths) {
+        if (path.endsWith(".json")) {
+            const QString binary = path.left(path.size() - 5) + kResultBinarySuffix;
+            if (paths.contains(binary)) continue;
+        }
+        kept << path;
+    }
+    kept.sort();
+    return kept;
+}
+
+}  // namespace
+
+VerifyPanel::VerifyPanel(QWidget* parent)
+    : QWidget(parent)
+    , verify_thread_(nullptr)
+    , verify_worker_(nullptr)
+    , request_id_(0) {
+    SetupUi();
+    SetupWorker();
+}
+
+VerifyPanel::~VerifyPanel() {
+    if (verify_thread_) {
+        verify_worker_->RequestCancel(request_id_);
+        verify_thread_->quit();
+        verify_thread_->wait();
+    }
+}
+
+void VerifyPanel::SetupUi() {
+    auto* layout = new QVBoxLayout(this);
+    layout->setSpacing(8);
+    layout->setContentsMargins(8, 8, 8, 8);
+
+    // Top bar: what to check and against which capacity / instance
+    auto* top_layout = new QHBoxLayout();
+    current_button_ = new QPushButton(QString::fromUtf8("校验当前结果"), this);
+    current_button_->setEnabled(false);
+    folder_button_ = new QPushButton(QString::fromUtf8("校验文件夹..."), this);
+    instance_button_ = new QPushButton(QString::fromUtf8("指定算例..."), this);
+    instance_button_->setToolTip(QString::fromUtf8("默认使用结果中记录的算例文件"));
+
+    capacity_spin_ = new QDoubleSpinBox(this);
+    capacity_spin_->setRange(0.0, 1e9);
+    capacity_spin_->setDecimals(0);
+    capacity_spin_->setSingleStep(60.0);
+    capacity_spin_->setSpecialValueText(QString::fromUtf8("自动"));
+    capacity_spin_->setValue(0.0);
+    capacity_spin_->setToolTip(QString::fromUtf8("自动: 取结果或算例中的产能, 否则 1440"));
+
+    top_layout->addWidget(current_button_);
+    top_layout->addWidget(folder_button_);
+    top_layout->addWidget(instance_button_);
+    top_layout->addWidget(new QLabel(QString::fromUtf8("产能:"), this));
+    top_layout->addWidget(capacity_spin_);
+    top_layout->addStretch();
+    layout->addLayout(top_layout);
+
+    status_label_ = new QLabel(QString::fromUtf8("未校验"), this);
+    status_label_->setStyleSheet("color: #6c757d; font-size: 9pt;");
+    layout->addWidget(status_label_);
+
+    auto* splitter = new QSplitter(Qt::Vertical, this);
+
+    // One row per result: violation count per constraint family
+    file_table_ = new QTableWidget(this);
+    file_table_->verticalHeader()->setVisible(false);
+    file_table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    file_table_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    file_table_->setSelectionMode(QAbstractItemView::SingleSelection);
+    file_table_->setAlternatingRowColors(true);
+
+    QStringList headers = {QString::fromUtf8("文件"), QString::fromUtf8("结论")};
+    for (int k = 0; k < kViolationKindCount; ++k) {
+        headers << ViolationKindName(static_cast<ViolationKind>(k));
+    }
+    file_table_->setColumnCount(headers.size());
+    file_table_->setHorizontalHeaderLabels(headers);
+    file_table_->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    file_table_->horizontalHeader()->setSectionResizeMode(kColFile, QHeaderView::Stretch);
+    splitter->addWidget(file_table_);
+
+    // Violations of the selected result
+    auto* detail_widget = new QWidget(this);
+    auto* detail_layout = new QVBoxLayout(detail_widget);
+    detail_layout->setContentsMargins(0, 0, 0, 0);
+    detail_layout->setSpacing(4);
+
+    period_label_ = new QLabel("--", this);
+    period_label_->setStyleSheet("color: #6c757d; font-size: 9pt;");
+    period_label_->setWordWrap(true);
+    detail_layout->addWidget(period_label_);
+
+    violation_table_ = new QTableWidget(this);
+    violation_table_->verticalHeader()->setVisible(false);
+    violation_table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    violation_table_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    violation_table_->setAlternatingRowColors(true);
+    violation_table_->setColumnCount(4);
+    violation_table_->setHorizontalHeaderLabels({
+        QString::fromUtf8("类型"),
+        QString::fromUtf8("对象"),
+        QString::fromUtf8("周期"),
+        QString::fromUtf8("违反量")
+    });
+    violation_table_->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    detail_layout->addWidget(violation_table_, 1);
+    splitter->addWidget(detail_widget);
+
+    splitter->setStretchFactor(0, 1);
+    splitter->setStretchFactor(1, 2);
+    layout->addWidget(splitter, 1);
+
+    // Connections
+    connect(current_button_, &QPushButton::clicked, this, &VerifyPanel::OnVerifyCurrent);
+    connect(folder_button_, &QPushButton::clicked, this, &VerifyPanel::OnVerifyFolder);
+    connect(instance_button_, &QPushButton::clicked, this, &VerifyPanel::OnChooseInstance);
+    connect(file_table_, &QTableWidget::itemSelectionChanged,
+            this, &VerifyPanel::OnSelectionChanged);
+}
+
+void VerifyPanel::SetupWorker() {
+    verify_thread_ = new QThread(this);
+    verify_worker_ = new ResultVerifyWorker();
+    verify_worker_->moveToThread(verify_thread_);
+
+    connect(this, &VerifyPanel::RequestVerify, verify_worker_, &ResultVerifyWorker::Verify);
+    connect(verify_worker_, &ResultVerifyWorker::VerifyProgress,
+            this, &VerifyPanel::OnVerifyProgress);
+    connect(verify_worker_, &ResultVerifyWorker::VerifyFinished,
+            this, &VerifyPanel::OnVerifyFinished);
+    connect(verify_worker_, &ResultVerifyWorker::VerifyCancelled,
+            this, &VerifyPanel::OnVerifyCancelled);
+
+    connect(verify_thread_, &QThread::finished, verify_worker_, &QObject::deleteLater);
+    verify_thread_->start();
+}
+
+void VerifyPanel::SetCurrentResult(const QString& path) {
+    current_file_ = path;
+    current_button_->setEnabled(!path.isEmpty());
+}
+
+void VerifyPanel::VerifyPaths(const QStringList& paths) {
+    if (paths.isEmpty()) return;
+
+    // Supersede any batch still in flight
+    verify_worker_->RequestCancel(request_id_);
+    ++request_id_;
+
+    auto request = std::make_shared<VerifySet>();
+    request->paths = paths;
+    request->instance_file = instance_file_;
+    request->params.capacity = capacity_spin_->value();
+
+    status_label_->setText(QString::fromUtf8("校验中..."));
+    emit RequestVerify(request_id_, request);
+}
+
+void VerifyPanel::OnVerifyCurrent() {
+    if (!current_file_.isEmpty()) VerifyPaths({current_file_});
+}
+
+void VerifyPanel::OnVerifyFolder() {
+    QString default_dir = "D:/YM-Code/LS-NTGF-All/results";
+    QString dir = QFileDialog::getExistingDirectory(
+        this, QString::fromUtf8("选择结果文件夹"), default_dir);
+    if (dir.isEmpty()) return;
+
+    const QStringList paths = FindResultFiles(dir);
+    if (paths.isEmpty()) {
+        status_label_->setText(QString::fromUtf8("文件夹中没有结果文件: %1").arg(dir));
+        return;
+    }
+    VerifyPaths(paths);
+}
+
+void VerifyPanel::OnChooseInstance() {
+    // Cancelling the dialog goes back to the instance recorded in each result
+    QString default_dir = "D:/YM-Code/LS-NTGF-All/data";
+    instance_file_ = QFileDialog::getOpenFileName(
+        this,
+        QString::fromUtf8("指定算例文件"),
+        default_dir,
+        "CSV files (*.csv);;All files (*)");
+
+    if (instance_file_.isEmpty()) {
+        instance_button_->setText(QString::fromUtf8("指定算例..."));
+        instance_button_->setToolTip(QString::fromUtf8("默认使用结果中记录的算例文件"));
+    } else {
+        instance_button_->setText(QFileInfo(instance_file_).fileName());
+        instance_button_->setToolTip(instance_file_);
+    }
+}
+
+int VerifyPanel::SelectedRow() const {
+    QList<QTableWidgetItem*> items = file_table_->selectedItems();
+    return items.isEmpty() ? -1 : items.first()->row();
+}
+
+void VerifyPanel::OnVerifyProgress(int request_id, const QString& stage) {
+    if (request_id != request_id_) return;
+    status_label_->setText(QString::fromUtf8("校验中: %1").arg(stage));
+}
+
+void VerifyPanel::OnVerifyCancelled(int request_id) {
+    if (request_id != request_id_) return;
+    status_label_->setText(QString::fromUtf8("校验已取消"));
+}
+
+void VerifyPanel::OnVerifyFinished(int request_id, const VerifySetPtr& result) {
+    if (request_id != request_id_) return;
+    result_ = result;
+
+    int feasible = 0;
+    int failed = 0;
+    int merged = 0;
+    for (int r = 0; r < result_->paths.size(); ++r) {
+        if (!result_->errors.value(r).isEmpty()) {
+            ++failed;
+            continue;
+        }
+        if (result_->reports[r].Feasible()) ++feasible;
+        if (result_->reports[r].Merged()) ++merged;
+    }
+    QString status = QString::fromUtf8("%1 个结果，可行 %2，不可行 %3")
+        .arg(result_->paths.size())
+        .arg(feasible)
+        .arg(result_->paths.size() - feasible - failed);
+    if (failed > 0) status += QString::fromUtf8("，%1 个无法校验").arg(failed);
+    if (merged > 0) status += QString::fromUtf8("，%1 个订单已合并 (按订单的检查未执行)").arg(merged);
+    status_label_->setText(status);
+
+    PopulateFiles();
+}
+
+void VerifyPanel::PopulateFiles() {
+    const VerifySet& set = *result_;
+    const int rows = set.paths.size();
+    file_table_->setRowCount(rows);
+
+    for (int r = 0; r < rows; ++r) {
+        auto* file_item = new QTableWidgetItem(QFileInfo(set.paths[r]).fileName());
+        file_item->setToolTip(set.paths[r]);
+        file_table_->setItem(r, kColFile, file_item);
+        for (int c = kColStatus; c < file_table_->columnCount(); ++c) {
+            file_table_->setItem(r, c, MakeItem("--"));
+        }
+
+        QTableWidgetItem* status_item = file_table_->item(r, kColStatus);
+        if (!set.errors.value(r).isEmpty()) {
+            status_item->setText(QString::fromUtf8("无法校验"));
+            status_item->setToolTip(set.errors.value(r));
+            continue;
+        }
+
+        // A merged result passes only the families that ran; say so instead of
+        // showing a plain pass
+        const VerifyReport& report = set.reports[r];
+        const QString merged_note = QString::fromUtf8("订单已合并 (结果 %1 个，算例 %2 个)，按订单的检查未执行")
+            .arg(report.result_orders).arg(report.instance_orders);
+        if (!report.Feasible()) {
+            status_item->setText(QString::fromUtf8("不可行"));
+            status_item->setForeground(QColor("#e03131"));
+        } else if (report.Merged()) {
+            status_item->setText(QString::fromUtf8("可行 (订单已合并)"));
+            status_item->setForeground(QColor("#f08c00"));
+        } else {
+            status_item->setText(QString::fromUtf8("可行"));
+            status_item->setForeground(QColor("#2f9e44"));
+        }
+        if (report.Merged()) status_item->setToolTip(merged_note);
+        for (int k = 0; k < kViolationKindCount; ++k) {
+            QTableWidgetItem* item = file_table_->item(r, kColFirstKind + k);
+            if (!report.checked[k]) {
+                if (report.Merged()) {
+                    item->setText(QString::fromUtf8("未检查"));
+                    item->setToolTip(merged_note);
+                } else {
+                    item->setToolTip(QString::fromUtf8("缺少所需的变量或算例数据，未检查"));
+                }
+                continue;
+            }
+            item->setText(QString::number(report.counts[k]));
+            if (report.counts[k] > 0) item->setForeground(QColor("#e03131"));
+        }
+    }
+
+    if (rows > 0) file_table_->selectRow(0);
+    ShowViolations(SelectedRow());
+}
+
+void VerifyPanel::OnSelectionChanged() {
+    ShowViolations(SelectedRow());
+}
+
+void VerifyPanel::ShowViolations(int row) {
+    violation_table_->setRowCount(0);
+    if (!result_ || row < 0 || row >= result_->paths.size() ||
+        !result_->errors.value(row).isEmpty()) {
+        period_label_->setText(result_ && row >= 0 ?
+            result_->errors.value(row) : QString("--"));
+        return;
+    }
+
+    const VerifyReport& report = result_->reports[row];
+    QStringList periods;
+    for (size_t t = 0; t < report.period_counts.size(); ++t) {
+        if (report.period_counts[t] == 0) continue;
+        if (periods.size() == kMaxPeriodsShown) {
+            periods << "...";
+            break;
+        }
+        periods << QString("t=%1: %2").arg(t + 1).arg(report.period_counts[t]);
+    }
+    QString summary = QString::fromUtf8("产能 %1，共 %2 处违反")
+        .arg(report.capacity, 0, 'f', 0)
+        .arg(report.TotalCount());
+    if (!periods.isEmpty()) {
+        summary += QString::fromUtf8("；按周期: ") + periods.join(", ");
+    }
+    if (report.violations.size() < static_cast<size_t>(report.TotalCount())) {
+        summary += QString::fromUtf8("（仅列出前 %1 条）").arg(report.violations.size());
+    }
+    period_label_->setText(summary);
+
+    violation_table_->setRowCount(static_cast<int>(report.violations.size()));
+    for (int r = 0; r < static_cast<int>(report.violations.size()); ++r) {
+        const Violation& violation = report.violations[r];
+        violation_table_->setItem(r, 0, MakeItem(ViolationKindName(violation.kind)));
+        violation_table_->setItem(r, 1, MakeItem(EntityText(violation)));
+        violation_table_->setItem(r, 2, MakeItem(violation.period < 0 ?
+            QString("--") : QString("t=%1").arg(violation.period + 1)));
+        violation_table_->setItem(r, 3, MakeItem(QString::number(violation.amount, 'g', 6)));
+    }
+}
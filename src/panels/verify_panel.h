@@ -0,0 +1,73 @@
+// verify_panel.h - Solution feasibility panel
+// Checks results against their instance (capacity, delivery windows, demand,
+// setup/carryover linking, inventory balance) and lists the violations per
+// period and order. The shown result, a browser selection or a whole folder can
+// be checked; the files of a batch are verified in parallel.
+
+#ifndef VERIFY_PANEL_H_
+#define VERIFY_PANEL_H_
+
+#include <QWidget>
+#include <QString>
+#include <QStringList>
+#include "../core/result_verify.h"
+
+class QDoubleSpinBox;
+class QLabel;
+class QPushButton;
+class QTableWidget;
+class QThread;
+class ResultVerifyWorker;
+
+class VerifyPanel : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit VerifyPanel(QWidget* parent = nullptr);
+    ~VerifyPanel() override;
+
+    // Result shown in the analysis tab (empty: none); checked on request
+    void SetCurrentResult(const QString& path);
+
+    // Verify |paths| as one batch, replacing the previous list
+    void VerifyPaths(const QStringList& paths);
+
+signals:
+    void RequestVerify(int request_id, const VerifySetPtr& request);
+
+private slots:
+    void OnVerifyCurrent();
+    void OnVerifyFolder();
+    void OnChooseInstance();
+    void OnSelectionChanged();
+    void OnVerifyProgress(int request_id, const QString& stage);
+    void OnVerifyFinished(int request_id, const VerifySetPtr& result);
+    void OnVerifyCancelled(int request_id);
+
+private:
+    void SetupUi();
+    void SetupWorker();
+    void PopulateFiles();
+    void ShowViolations(int row);
+    int SelectedRow() const;
+
+    QPushButton* current_button_;
+    QPushButton* folder_button_;
+    QPushButton* instance_button_;
+    QDoubleSpinBox* capacity_spin_;
+    QLabel* status_label_;
+    QTableWidget* file_table_;
+    QLabel* period_label_;
+    QTableWidget* violation_table_;
+
+    // Background verification
+    QThread* verify_thread_;
+    ResultVerifyWorker* verify_worker_;
+    int request_id_;
+
+    QString current_file_;
+    QString instance_file_;     // empty: the instance recorded in each result
+    VerifySetPtr result_;
+};
+
+#endif  // VERIFY_PANEL_H_
@@ -34,6 +34,18 @@ void ParameterWidget::SetupUi() {
 
     // Set initial visibility based on default algorithm (RF)
     UpdateParamGroupStates(0);
+
+    for (auto* spin : findChildren<QSpinBox*>()) {
+        connect(spin, QOverload<int>::of(&QSpinBox::valueChanged),
+                this, &ParameterWidget::ParametersChanged);
+    }
+    for (auto* spin : findChildren<QDoubleSpinBox*>()) {
+        connect(spin, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+                this, &ParameterWidget::ParametersChanged);
+    }
+    connect(algorithm_combo_, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &ParameterWidget::ParametersChanged);
+    connect(merge_checkbox_, &QCheckBox::toggled, this, &ParameterWidget::ParametersChanged);
 }
 
 void ParameterWidget::SetupBasicParams(QVBoxLayout* layout) {
@@ -91,6 +103,9 @@ void ParameterWidget::SetupBasicParams(QVBoxLayout* layout) {
     connect(algorithm_combo_, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &ParameterWidget::OnAlgorithmChanged);
     connect(merge_checkbox_, &QCheckBox::toggled, big_order_threshold_spin_, &QWidget::setEnabled);
+    connect(merge_checkbox_, &QCheckBox::toggled, this, &ParameterWidget::MergeSettingsChanged);
+    connect(big_order_threshold_spin_, QOverload<double>::of(&QDoubleSpinBox::valueChanged),
+            this, &ParameterWidget::MergeSettingsChanged);
 }
 
 void ParameterWidget::SetupAlgorithmParams(QVBoxLayout* layout) {
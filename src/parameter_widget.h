@@ -56,6 +56,10 @@ public:
 
 signals:
     void AlgorithmChanged(int index);
+    // Merge switch or big-order threshold edited
+    void MergeSettingsChanged();
+    // Any parameter edited (the run cost prediction depends on all of them)
+    void ParametersChanged();
 
 public slots:
     void ResetDefaults();
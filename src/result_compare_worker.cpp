@@ -0,0 +1,37 @@
+// result_compare_worker.cpp - Background Result Comparison Worker Implementation
+
+#include "result_compare_worker.h"
+
+ResultCompareWorker::ResultCompareWorker(const ResultCachePtr& cache, QObject* parent)
+    : QObject(parent)
+    , cache_(cache) {
+    qRegisterMetaType<ComparisonPtr>("ComparisonPtr");
+}
+
+void ResultCompareWorker::RequestCancel(int request_id) {
+    cancellation_.Cancel(request_id);
+}
+
+void ResultCompareWorker::Compare(int request_id, const ComparisonPtr& request) {
+    if (cancellation_.IsCancelled(request_id) || !request) {
+        emit CompareCancelled(request_id);
+        return;
+    }
+
+    auto set = std::make_shared<ComparisonSet>(*request);
+    auto cancelled = cancellation_.Check(request_id);
+
+    emit CompareProgress(request_id, QString::fromUtf8("加载结果文件"));
+    if (!LoadMissingModels(set.get(), cache_.get(), 0, cancelled)) {
+        emit CompareCancelled(request_id);
+        return;
+    }
+
+    emit CompareProgress(request_id, QString::fromUtf8("计算差异"));
+    if (!DiffAgainstBaseline(set.get(), 0, cancelled)) {
+        emit CompareCancelled(request_id);
+        return;
+    }
+
+    emit CompareFinished(request_id, set);
+}
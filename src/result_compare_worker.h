@@ -0,0 +1,40 @@
+// result_compare_worker.h - Background Result Comparison Worker
+//
+// Loads the results of a comparison set in parallel and diffs them against the
+// baseline off the GUI thread
+
+#ifndef RESULT_COMPARE_WORKER_H_
+#define RESULT_COMPARE_WORKER_H_
+
+#include <QObject>
+#include <QString>
+#include "core/parallel.h"
+#include "core/result_cache.h"
+#include "core/result_compare.h"
+
+class ResultCompareWorker : public QObject {
+    Q_OBJECT
+
+public:
+    // Files not yet loaded are opened through |cache| (shared with the viewers)
+    explicit ResultCompareWorker(const ResultCachePtr& cache, QObject* parent = nullptr);
+
+    // Cancel every request with id <= request_id (thread-safe)
+    void RequestCancel(int request_id);
+
+public slots:
+    // |request| carries paths, the baseline index and any models that are
+    // already loaded (nullptr entries are read from disk)
+    void Compare(int request_id, const ComparisonPtr& request);
+
+signals:
+    void CompareProgress(int request_id, const QString& stage);
+    void CompareFinished(int request_id, const ComparisonPtr& result);
+    void CompareCancelled(int request_id);
+
+private:
+    RequestCancellation cancellation_;
+    ResultCachePtr cache_;
+};
+
+#endif  // RESULT_COMPARE_WORKER_H_
@@ -0,0 +1,139 @@
+// result_index_model.cpp - Results directory index table model implementation
+
+#include "result_index_model.h"
+
+#include <QColor>
+#include <QDir>
+#include <QFileInfo>
+#include <cmath>
+
+namespace {
+
+QString FormatNumber(double value, int decimals) {
+    return std::isfinite(value) ? QString::number(value, 'f', decimals) : QString("--");
+}
+
+QString FormatCount(int value) {
+    return value > 0 ? QString::number(value) : QString("--");
+}
+
+}  // namespace
+
+ResultIndexModel::ResultIndexModel(QObject* parent)
+    : QAbstractTableModel(parent) {
+}
+
+void ResultIndexModel::SetEntries(const ResultIndexEntriesPtr& entries) {
+    beginResetModel();
+    entries_ = entries;
+    endResetModel();
+}
+
+void ResultIndexModel::Clear() {
+    beginResetModel();
+    entries_.reset();
+    endResetModel();
+}
+
+const ResultIndexEntry* ResultIndexModel::Entry(int row) const {
+    if (!entries_ || row < 0 || row >= static_cast<int>(entries_->size())) return nullptr;
+    return &(*entries_)[row];
+}
+
+QString ResultIndexModel::Path(int row) const {
+    const ResultIndexEntry* entry = Entry(row);
+    return entry ? QString::fromStdString(entry->path) : QString();
+}
+
+int ResultIndexModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid() || !entries_) return 0;
+    return static_cast<int>(entries_->size());
+}
+
+int ResultIndexModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : kColumnCount;
+}
+
+QVariant ResultIndexModel::SortValue(const ResultIndexEntry& entry, int column) const {
+    auto number = [](double value) { return std::isfinite(value) ? QVariant(value) : QVariant(); };
+    switch (column) {
+        case kColN: return entry.n;
+        case kColT: return entry.t;
+        case kColG: return entry.g;
+        case kColF: return entry.f;
+        case kColObjective: return number(entry.objective);
+        case kColWallTime: return number(entry.wall_time);
+        case kColCpuTime: return number(entry.cpu_time);
+        case kColGap: return number(entry.gap);
+        default: return QVariant();
+    }
+}
+
+QVariant ResultIndexModel::data(const QModelIndex& index, int role) const {
+    const ResultIndexEntry* entry = Entry(index.row());
+    if (!entry || !index.isValid()) return QVariant();
+
+    const QFileInfo info(QString::fromStdString(entry->path));
+    if (role == kSortRole) {
+        switch (index.column()) {
+            case kColFile: return info.fileName();
+            case kColAlgorithm: return QString::fromStdString(entry->algorithm);
+            case kColFolder: return info.dir().dirName();
+            default: return SortValue(*entry, index.column());
+        }
+    }
+
+    switch (role) {
+        case Qt::DisplayRole:
+            switch (index.column()) {
+                case kColFile: return info.fileName();
+                case kColAlgorithm: return QString::fromStdString(entry->algorithm);
+                case kColN: return FormatCount(entry->n);
+                case kColT: return FormatCount(entry->t);
+                case kColG: return FormatCount(entry->g);
+                case kColF: return FormatCount(entry->f);
+                case kColObjective: return FormatNumber(entry->objective, 2);
+                case kColWallTime: return FormatNumber(entry->wall_time, 2);
+                case kColCpuTime: return FormatNumber(entry->cpu_time, 2);
+                case kColGap: return FormatNumber(entry->gap * 100.0, 2) + (std::isfinite(entry->gap) ? "%" : "");
+                case kColFolder: return info.dir().dirName();
+                default: return QVariant();
+            }
+        case Qt::TextAlignmentRole:
+            if (index.column() == kColFile || index.column() == kColFolder) {
+                return static_cast<int>(Qt::AlignLeft | Qt::AlignVCenter);
+            }
+            return static_cast<int>(Qt::AlignCenter);
+        case Qt::ToolTipRole: {
+            QString tip = QString::fromStdString(entry->path);
+            if (!entry->input_file.empty()) {
+                tip += QString::fromUtf8("\n算例: %1").arg(QString::fromStdString(entry->input_file));
+            }
+            if (!entry->ok) tip += QString::fromUtf8("\n(无法读取摘要)");
+            return tip;
+        }
+        case Qt::ForegroundRole:
+            if (!entry->ok) return QColor("#adb5bd");
+            return QVariant();
+        default:
+            return QVariant();
+    }
+}
+
+QVariant ResultIndexModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+    switch (section) {
+        case kColFile: return QString::fromUtf8("文件");
+        case kColAlgorithm: return QString::fromUtf8("算法");
+        case kColN: return "N";
+        case kColT: return "T";
+        case kColG: return "G";
+        case kColF: return "F";
+        case kColObjective: return QString::fromUtf8("目标值");
+        case kColWallTime: return QString::fromUtf8("墙钟时间(s)");
+        case kColCpuTime: return QString::fromUtf8("CPU时间(s)");
+        case kColGap: return "Gap";
+        case kColFolder: return QString::fromUtf8("目录");
+        default: return QVariant();
+    }
+}
@@ -0,0 +1,52 @@
+// result_index_model.h - Table model over a results directory index
+// Display text is formatted on demand; kSortRole exposes raw values for sorting
+
+#ifndef RESULT_INDEX_MODEL_H_
+#define RESULT_INDEX_MODEL_H_
+
+#include <QAbstractTableModel>
+#include <QString>
+#include "result_index_worker.h"
+
+class ResultIndexModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    enum Column {
+        kColFile = 0,
+        kColAlgorithm,
+        kColN,
+        kColT,
+        kColG,
+        kColF,
+        kColObjective,
+        kColWallTime,
+        kColCpuTime,
+        kColGap,
+        kColFolder,
+        kColumnCount
+    };
+
+    static const int kSortRole = Qt::UserRole + 1;
+
+    explicit ResultIndexModel(QObject* parent = nullptr);
+
+    void SetEntries(const ResultIndexEntriesPtr& entries);
+    void Clear();
+
+    const ResultIndexEntry* Entry(int row) const;
+    QString Path(int row) const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+private:
+    QVariant SortValue(const ResultIndexEntry& entry, int column) const;
+
+    ResultIndexEntriesPtr entries_;
+};
+
+#endif  // RESULT_INDEX_MODEL_H_
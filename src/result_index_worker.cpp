@@ -0,0 +1,65 @@
+// result_index_worker.cpp - Background Results Directory Scan Worker Implementation
+
+#include "result_index_worker.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QStandardPaths>
+
+ResultIndexWorker::ResultIndexWorker(QObject* parent)
+    : QObject(parent) {
+    qRegisterMetaType<ResultIndexEntriesPtr>("ResultIndexEntriesPtr");
+}
+
+void ResultIndexWorker::RequestCancel(int request_id) {
+    cancellation_.Cancel(request_id);
+}
+
+QString ResultIndexWorker::IndexPathFor(const QString& root) {
+    QString canonical = QDir::cleanPath(QFileInfo(root).absoluteFilePath());
+    QByteArray key = QCryptographicHash::hash(canonical.toUtf8(), QCryptographicHash::Md5).toHex();
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)
+        + "/result_index";
+    return QString("%1/%2.lsri").arg(dir, QString::fromLatin1(key));
+}
+
+void ResultIndexWorker::Scan(int request_id, const QString& root) {
+    if (cancellation_.IsCancelled(request_id)) {
+        emit ScanCancelled(request_id);
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Switch roots: start from the persisted index of the new root (if any)
+    const QString index_path = IndexPathFor(root);
+    if (root != index_root_) {
+        index_.Load(index_path.toStdString());
+        index_root_ = root;
+    }
+
+    auto cancelled = cancellation_.Check(request_id);
+    auto progress = [this, request_id](size_t done, size_t total) {
+        emit ScanProgress(request_id, static_cast<int>(done), static_cast<int>(total));
+    };
+    ResultScanStats stats = index_.Scan(root.toStdString(), 0, cancelled, progress);
+    if (stats.cancelled) {
+        emit ScanCancelled(request_id);
+        return;
+    }
+
+    QDir().mkpath(QFileInfo(index_path).absolutePath());
+    index_.Save(index_path.toStdString());
+
+    auto entries = std::make_shared<std::vector<ResultIndexEntry>>(index_.Entries());
+    QString message = QString::fromUtf8("共 %1 个结果文件 (复用 %2, 读取 %3, 失败 %4), 用时 %5 s")
+        .arg(stats.files)
+        .arg(stats.reused)
+        .arg(stats.parsed)
+        .arg(stats.failed)
+        .arg(timer.elapsed() / 1000.0, 0, 'f', 2);
+    emit ScanFinished(request_id, entries, message);
+}
@@ -0,0 +1,47 @@
+// result_index_worker.h - Background Results Directory Scan Worker
+//
+// Keeps a ResultIndex per results root, loads/saves it under the application
+// data directory and rescans the tree off the GUI thread
+
+#ifndef RESULT_INDEX_WORKER_H_
+#define RESULT_INDEX_WORKER_H_
+
+#include <QObject>
+#include <QMetaType>
+#include <QString>
+#include <memory>
+#include <vector>
+#include "core/parallel.h"
+#include "core/result_index.h"
+
+using ResultIndexEntriesPtr = std::shared_ptr<const std::vector<ResultIndexEntry>>;
+
+Q_DECLARE_METATYPE(ResultIndexEntriesPtr)
+
+class ResultIndexWorker : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ResultIndexWorker(QObject* parent = nullptr);
+
+    // Cancel every request with id <= request_id (thread-safe)
+    void RequestCancel(int request_id);
+
+    // Where the persistent index of |root| is stored
+    static QString IndexPathFor(const QString& root);
+
+public slots:
+    void Scan(int request_id, const QString& root);
+
+signals:
+    void ScanProgress(int request_id, int done, int total);
+    void ScanFinished(int request_id, const ResultIndexEntriesPtr& entries, const QString& message);
+    void ScanCancelled(int request_id);
+
+private:
+    RequestCancellation cancellation_;
+    ResultIndex index_;
+    QString index_root_;
+};
+
+#endif  // RESULT_INDEX_WORKER_H_
@@ -0,0 +1,125 @@
+// result_load_worker.cpp - Background Result Loading Worker Implementation
+
+#include "result_load_worker.h"
+#include "core/instance_cache.h"
+#include "core/result_csv.h"
+#include "core/result_metrics.h"
+
+#include <QFileInfo>
+
+ResultLoadWorker::ResultLoadWorker(const ResultCachePtr& cache, QObject* parent)
+    : QObject(parent)
+    , cache_(cache) {
+    qRegisterMetaType<ResultModelPtr>("ResultModelPtr");
+    qRegisterMetaType<ResultSourcePtr>("ResultSourcePtr");
+    qRegisterMetaType<ResultVariablePtr>("ResultVariablePtr");
+}
+
+void ResultLoadWorker::RequestCancel(int request_id) {
+    cancellation_.Cancel(request_id);
+}
+
+void ResultLoadWorker::LoadFile(int request_id, const QString& path) {
+    if (cancellation_.IsCancelled(request_id)) {
+        emit LoadCancelled(request_id);
+        return;
+    }
+
+    // Mapping plus one structural scan: the summary sections are parsed, the
+    // variables payload is only indexed and decoded when a panel asks for it.
+    // A cached source also brings back the variables decoded last time.
+    // The scan reports the bytes walked (0-90%) and stops when cancelled.
+    emit LoadProgress(request_id, 0, QString::fromUtf8("映射文件"));
+    int last_percent = 0;
+    auto progress = [&](qint64 done, qint64 total) {
+        const int percent = total > 0 ? static_cast<int>(90 * done / total) : 0;
+        if (percent <= last_percent) return;
+        last_percent = percent;
+        emit LoadProgress(request_id, percent, QString::fromUtf8("扫描文件"));
+    };
+    QString error;
+    ResultSourcePtr source = cache_->Open(path, &error, nullptr,
+                                          cancellation_.Check(request_id), progress);
+    if (!source) {
+        if (cancellation_.IsCancelled(request_id)) {
+            emit LoadCancelled(request_id);
+        } else {
+            emit LoadFinished(request_id, false, error);
+        }
+        return;
+    }
+
+    if (cancellation_.IsCancelled(request_id)) {
+        emit LoadCancelled(request_id);
+        return;
+    }
+
+    emit LoadProgress(request_id, 90, QString::fromUtf8("加载概览"));
+    emit SummaryLoaded(request_id, source->Summary());
+    emit SourceLoaded(request_id, source);
+
+    emit LoadProgress(request_id, 100, QString::fromUtf8("完成"));
+    emit LoadFinished(request_id, true, path);
+
+    if (!source->Summary()->metrics.present) {
+        DeriveMissingMetrics(request_id, source);
+    }
+}
+
+void ResultLoadWorker::DeriveMissingMetrics(int request_id, const ResultSourcePtr& source) {
+    // Decoded into the source cache, so the panels' DecodeVariable requests queued
+    // behind this pass are answered from the cache instead of decoding again
+    ResultVariablePtr vars[6];
+    const char* names[6] = {"X", "Y", "L", "I", "B", "U"};
+    for (int k = 0; k < 6; ++k) {
+        if (cancellation_.IsCancelled(request_id)) return;
+        if (source->HasVariable(names[k])) vars[k] = source->Variable(names[k]);
+    }
+    cache_->Trim();
+
+    MetricsInputs inputs;
+    inputs.x = vars[0].get();
+    inputs.y = vars[1].get();
+    inputs.l = vars[2].get();
+    inputs.i = vars[3].get();
+    inputs.b = vars[4].get();
+    inputs.u = vars[5].get();
+
+    ResultModelPtr summary = source->Summary();
+    const QString instance_path = FindInstanceFile(summary->summary.input_file, source->Path());
+    InstanceDataPtr instance;
+    if (!instance_path.isEmpty()) instance = LoadInstanceCached(instance_path, nullptr);
+    if (cancellation_.IsCancelled(request_id)) return;
+
+    auto model = std::make_shared<ResultModel>(*summary);
+    model->metrics = DeriveMetrics(*summary, inputs, instance.get(), MetricsParams());
+    emit MetricsDerived(request_id, model);
+}
+
+void ResultLoadWorker::DecodeVariable(int request_id, const ResultSourcePtr& source,
+                                      const QString& name) {
+    // Not subject to RequestCancel: the shown file stays browsable while another
+    // one loads, and the owner drops answers for sources it no longer shows
+    if (!source) return;
+
+    QString error;
+    ResultVariablePtr var = source->Variable(name, &error);
+    cache_->Trim();
+    emit VariableDecoded(request_id, name, var, error);
+}
+
+void ResultLoadWorker::ExportCsv(int request_id, const ResultSourcePtr& source,
+                                 const QString& dir) {
+    if (!source) return;
+
+    // One file per variable, written in parallel; the cache is left as it is
+    QString error;
+    int files = 0;
+    const QString prefix = QFileInfo(source->Path()).completeBaseName() + "_";
+    if (!ExportVariablesCsv(*source, dir, prefix, 0, &error, &files)) {
+        emit ExportFinished(request_id, false, error);
+        return;
+    }
+    emit ExportFinished(request_id, true,
+                        QString::fromUtf8("已导出 %1 个变量到: %2").arg(files).arg(dir));
+}
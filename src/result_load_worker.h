@@ -0,0 +1,57 @@
+// result_load_worker.h - Background Result Loading Worker
+//
+// Opens result files (JSON or binary .lsrb) off the GUI thread. Opening only reads
+// the summary and indexes the variables; each variable is decoded later, on request.
+// Opened files go through a shared ResultCache, so reopening one is free.
+
+#ifndef RESULT_LOAD_WORKER_H_
+#define RESULT_LOAD_WORKER_H_
+
+#include <QObject>
+#include <QString>
+#include "core/parallel.h"
+#include "core/result_cache.h"
+#include "core/result_model.h"
+#include "core/result_source.h"
+
+class ResultLoadWorker : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ResultLoadWorker(const ResultCachePtr& cache, QObject* parent = nullptr);
+
+    // Cancel every request with id <= request_id (thread-safe)
+    void RequestCancel(int request_id);
+
+public slots:
+    void LoadFile(int request_id, const QString& path);
+    // Decode one variable of an opened source (answers with VariableDecoded;
+    // |request_id| is passed through)
+    void DecodeVariable(int request_id, const ResultSourcePtr& source, const QString& name);
+    // Write every variable of |source| as CSV into |dir| (answers with ExportFinished)
+    void ExportCsv(int request_id, const ResultSourcePtr& source, const QString& dir);
+
+signals:
+    void LoadProgress(int request_id, int percent, const QString& stage);
+    // Model without variables (summary, problem, metrics)
+    void SummaryLoaded(int request_id, const ResultModelPtr& model);
+    // Opened file; variables are decoded through DecodeVariable or the source itself
+    void SourceLoaded(int request_id, const ResultSourcePtr& source);
+    void LoadFinished(int request_id, bool success, const QString& message);
+    // Summary model with metrics recomputed from the variables (files without a
+    // "metrics" section; follows LoadFinished)
+    void MetricsDerived(int request_id, const ResultModelPtr& model);
+    void LoadCancelled(int request_id);
+    // |var| is nullptr and |error| set if the variable could not be decoded
+    void VariableDecoded(int request_id, const QString& name, const ResultVariablePtr& var,
+                         const QString& error);
+    void ExportFinished(int request_id, bool success, const QString& message);
+
+private:
+    void DeriveMissingMetrics(int request_id, const ResultSourcePtr& source);
+
+    RequestCancellation cancellation_;
+    ResultCachePtr cache_;
+};
+
+#endif  // RESULT_LOAD_WORKER_H_
@@ -0,0 +1,31 @@
+// result_prefetch_worker.cpp - Background Result Prefetch Worker Implementation
+
+#include "result_prefetch_worker.h"
+
+ResultPrefetchWorker::ResultPrefetchWorker(const ResultCachePtr& cache, QObject* parent)
+    : QObject(parent)
+    , cache_(cache) {
+}
+
+void ResultPrefetchWorker::RequestCancel(int request_id) {
+    cancellation_.Cancel(request_id);
+}
+
+void ResultPrefetchWorker::Prefetch(int request_id, const QStringList& paths,
+                                    const QStringList& variables) {
+    for (const QString& path : paths) {
+        if (cancellation_.IsCancelled(request_id)) return;
+
+        // Failures are not reported here; opening the file for real shows them
+        ResultSourcePtr source = cache_->Open(path, nullptr);
+        if (!source) continue;
+
+        for (const QString& name : variables) {
+            if (cancellation_.IsCancelled(request_id)) return;
+            if (source->HasVariable(name) && !source->CachedVariable(name)) {
+                source->Variable(name);
+            }
+        }
+        cache_->Trim();
+    }
+}
@@ -0,0 +1,34 @@
+// result_prefetch_worker.h - Background Result Prefetch Worker
+//
+// Opens result files into the shared ResultCache ahead of use (the files next to
+// the browser selection) and decodes the variables the analysis panels show first
+
+#ifndef RESULT_PREFETCH_WORKER_H_
+#define RESULT_PREFETCH_WORKER_H_
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include "core/parallel.h"
+#include "core/result_cache.h"
+
+class ResultPrefetchWorker : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ResultPrefetchWorker(const ResultCachePtr& cache, QObject* parent = nullptr);
+
+    // Cancel every request with id <= request_id (thread-safe)
+    void RequestCancel(int request_id);
+
+public slots:
+    // Open |paths| in order and decode |variables| of each; files already cached
+    // only have their missing variables decoded
+    void Prefetch(int request_id, const QStringList& paths, const QStringList& variables);
+
+private:
+    RequestCancellation cancellation_;
+    ResultCachePtr cache_;
+};
+
+#endif  // RESULT_PREFETCH_WORKER_H_
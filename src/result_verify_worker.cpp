@@ -0,0 +1,31 @@
+// result_verify_worker.cpp - Background Feasibility Check Worker Implementation
+
+#include "result_verify_worker.h"
+
+ResultVerifyWorker::ResultVerifyWorker(QObject* parent)
+    : QObject(parent) {
+    qRegisterMetaType<VerifySetPtr>("VerifySetPtr");
+}
+
+void ResultVerifyWorker::RequestCancel(int request_id) {
+    cancellation_.Cancel(request_id);
+}
+
+void ResultVerifyWorker::Verify(int request_id, const VerifySetPtr& request) {
+    if (cancellation_.IsCancelled(request_id) || !request) {
+        emit VerifyCancelled(request_id);
+        return;
+    }
+
+    auto set = std::make_shared<VerifySet>(*request);
+    auto cancelled = cancellation_.Check(request_id);
+
+    emit VerifyProgress(request_id,
+                        QString::fromUtf8("校验 %1 个结果").arg(set->paths.size()));
+    if (!VerifyResults(set.get(), 0, cancelled)) {
+        emit VerifyCancelled(request_id);
+        return;
+    }
+
+    emit VerifyFinished(request_id, set);
+}
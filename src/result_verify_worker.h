@@ -0,0 +1,36 @@
+// result_verify_worker.h - Background Feasibility Check Worker
+//
+// Verifies a batch of result files against their instances off the GUI thread;
+// the files of a batch are checked in parallel
+
+#ifndef RESULT_VERIFY_WORKER_H_
+#define RESULT_VERIFY_WORKER_H_
+
+#include <QObject>
+#include <QString>
+#include "core/parallel.h"
+#include "core/result_verify.h"
+
+class ResultVerifyWorker : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ResultVerifyWorker(QObject* parent = nullptr);
+
+    // Cancel every request with id <= request_id (thread-safe)
+    void RequestCancel(int request_id);
+
+public slots:
+    // |request| carries the paths, an optional instance file and the params
+    void Verify(int request_id, const VerifySetPtr& request);
+
+signals:
+    void VerifyProgress(int request_id, const QString& stage);
+    void VerifyFinished(int request_id, const VerifySetPtr& result);
+    void VerifyCancelled(int request_id);
+
+private:
+    RequestCancellation cancellation_;
+};
+
+#endif  // RESULT_VERIFY_WORKER_H_
@@ -0,0 +1,301 @@
+// results_browser_widget.cpp - Results directory browser implementation
+
+#include "results_browser_widget.h"
+#include "result_index_model.h"
+#include "result_prefetch_worker.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QItemSelectionModel>
+#include <QLabel>
+#include <QLineEdit>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QSortFilterProxyModel>
+#include <QTableView>
+#include <QThread>
+
+namespace {
+
+// Files prefetched on each side of the current row
+constexpr int kPrefetchNeighbours = 2;
+
+// What the analysis panels show first (setup: Y, variables: X)
+const QStringList kPrefetchVariables = {"Y", "X"};
+
+}  // namespace
+
+ResultsBrowserWidget::ResultsBrowserWidget(const ResultCachePtr& cache, QWidget* parent)
+    : QWidget(parent)
+    , scan_thread_(nullptr)
+    , scan_worker_(nullptr)
+    , scan_request_id_(0)
+    , cache_(cache)
+    , prefetch_thread_(nullptr)
+    , prefetch_worker_(nullptr)
+    , prefetch_request_id_(0) {
+    SetupUi();
+    SetupWorker();
+}
+
+ResultsBrowserWidget::~ResultsBrowserWidget() {
+    if (scan_thread_) {
+        scan_worker_->RequestCancel(scan_request_id_);
+        scan_thread_->quit();
+        scan_thread_->wait();
+    }
+    if (prefetch_thread_) {
+        prefetch_worker_->RequestCancel(prefetch_request_id_);
+        prefetch_thread_->quit();
+        prefetch_thread_->wait();
+    }
+}
+
+void ResultsBrowserWidget::SetupUi() {
+    auto* layout = new QVBoxLayout(this);
+    layout->setSpacing(8);
+    layout->setContentsMargins(4, 4, 4, 4);
+
+    // Root directory + scan controls
+    auto* root_layout = new QHBoxLayout();
+    root_layout->addWidget(new QLabel(QString::fromUtf8("结果目录:"), this));
+    root_edit_ = new QLineEdit("D:/YM-Code/LS-NTGF-All/results", this);
+    root_layout->addWidget(root_edit_, 1);
+    browse_button_ = new QPushButton(QString::fromUtf8("浏览..."), this);
+    scan_button_ = new QPushButton(QString::fromUtf8("扫描"), this);
+    cancel_button_ = new QPushButton(QString::fromUtf8("取消"), this);
+    cancel_button_->setVisible(false);
+    root_layout->addWidget(browse_button_);
+    root_layout->addWidget(scan_button_);
+    root_layout->addWidget(cancel_button_);
+    layout->addLayout(root_layout);
+
+    // Filter + actions on the selection
+    auto* action_layout = new QHBoxLayout();
+    filter_edit_ = new QLineEdit(this);
+    filter_edit_->setPlaceholderText(QString::fromUtf8("筛选 (文件名/算法/目录...)"));
+    filter_edit_->setClearButtonEnabled(true);
+    action_layout->addWidget(filter_edit_, 1);
+    open_button_ = new QPushButton(QString::fromUtf8("打开分析"), this);
+    compare_button_ = new QPushButton(QString::fromUtf8("加入对比"), this);
+    verify_button_ = new QPushButton(QString::fromUtf8("可行性校验"), this);
+    open_button_->setEnabled(false);
+    compare_button_->setEnabled(false);
+    verify_button_->setEnabled(false);
+    action_layout->addWidget(open_button_);
+    action_layout->addWidget(compare_button_);
+    action_layout->addWidget(verify_button_);
+    layout->addLayout(action_layout);
+
+    status_label_ = new QLabel(QString::fromUtf8("未扫描"), this);
+    status_label_->setStyleSheet("color: #6c757d; font-size: 9pt;");
+    layout->addWidget(status_label_);
+
+    progress_bar_ = new QProgressBar(this);
+    progress_bar_->setTextVisible(true);
+    progress_bar_->setVisible(false);
+    layout->addWidget(progress_bar_);
+
+    // Table: model formats on demand, proxy sorts on raw values
+    model_ = new ResultIndexModel(this);
+    proxy_ = new QSortFilterProxyModel(this);
+    proxy_->setSourceModel(model_);
+    proxy_->setSortRole(ResultIndexModel::kSortRole);
+    proxy_->setFilterKeyColumn(-1);
+    proxy_->setFilterCaseSensitivity(Qt::CaseInsensitive);
+
+    table_ = new QTableView(this);
+    table_->setModel(proxy_);
+    table_->setSortingEnabled(true);
+    table_->sortByColumn(ResultIndexModel::kColFile, Qt::DescendingOrder);
+    table_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table_->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table_->setAlternatingRowColors(true);
+    table_->verticalHeader()->setVisible(false);
+    table_->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    table_->verticalHeader()->setDefaultSectionSize(table_->fontMetrics().height() + 8);
+    table_->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    table_->horizontalHeader()->setStretchLastSection(true);
+    table_->setColumnWidth(ResultIndexModel::kColFile, 240);
+    layout->addWidget(table_, 1);
+
+    // Connections
+    connect(browse_button_, &QPushButton::clicked, this, &ResultsBrowserWidget::OnBrowseRoot);
+    connect(scan_button_, &QPushButton::clicked, this, &ResultsBrowserWidget::OnScan);
+    connect(root_edit_, &QLineEdit::returnPressed, this, &ResultsBrowserWidget::OnScan);
+    connect(cancel_button_, &QPushButton::clicked, this, &ResultsBrowserWidget::OnCancelScan);
+    connect(filter_edit_, &QLineEdit::textChanged, this, &ResultsBrowserWidget::OnFilterChanged);
+    connect(open_button_, &QPushButton::clicked, this, &ResultsBrowserWidget::OnOpenSelected);
+    connect(compare_button_, &QPushButton::clicked,
+            this, &ResultsBrowserWidget::OnCompareSelected);
+    connect(verify_button_, &QPushButton::clicked,
+            this, &ResultsBrowserWidget::OnVerifySelected);
+    connect(table_, &QTableView::doubleClicked, this, &ResultsBrowserWidget::OnOpenSelected);
+    connect(table_->selectionModel(), &QItemSelectionModel::selectionChanged,
+            this, &ResultsBrowserWidget::OnSelectionChanged);
+    connect(table_->selectionModel(), &QItemSelectionModel::currentRowChanged,
+            this, &ResultsBrowserWidget::OnCurrentRowChanged);
+}
+
+void ResultsBrowserWidget::SetupWorker() {
+    scan_thread_ = new QThread(this);
+    scan_worker_ = new ResultIndexWorker();
+    scan_worker_->moveToThread(scan_thread_);
+
+    connect(this, &ResultsBrowserWidget::RequestScan, scan_worker_, &ResultIndexWorker::Scan);
+    connect(scan_worker_, &ResultIndexWorker::ScanProgress,
+            this, &ResultsBrowserWidget::OnScanProgress);
+    connect(scan_worker_, &ResultIndexWorker::ScanFinished,
+            this, &ResultsBrowserWidget::OnScanFinished);
+    connect(scan_worker_, &ResultIndexWorker::ScanCancelled,
+            this, &ResultsBrowserWidget::OnScanCancelled);
+
+    connect(scan_thread_, &QThread::finished, scan_worker_, &QObject::deleteLater);
+    scan_thread_->start();
+
+    prefetch_thread_ = new QThread(this);
+    prefetch_worker_ = new ResultPrefetchWorker(cache_);
+    prefetch_worker_->moveToThread(prefetch_thread_);
+
+    connect(this, &ResultsBrowserWidget::RequestPrefetch,
+            prefetch_worker_, &ResultPrefetchWorker::Prefetch);
+
+    connect(prefetch_thread_, &QThread::finished, prefetch_worker_, &QObject::deleteLater);
+    prefetch_thread_->start();
+}
+
+void ResultsBrowserWidget::ScanDirectory(const QString& root) {
+    root_edit_->setText(root);
+    OnScan();
+}
+
+void ResultsBrowserWidget::OnBrowseRoot() {
+    QString dir = QFileDialog::getExistingDirectory(
+        this, QString::fromUtf8("选择结果目录"), root_edit_->text());
+    if (!dir.isEmpty()) {
+        ScanDirectory(dir);
+    }
+}
+
+void ResultsBrowserWidget::OnScan() {
+    const QString root = root_edit_->text().trimmed();
+    if (root.isEmpty()) return;
+
+    // Supersede any scan still in flight
+    scan_worker_->RequestCancel(scan_request_id_);
+    ++scan_request_id_;
+
+    status_label_->setText(QString::fromUtf8("扫描中: %1").arg(root));
+    SetScanning(true);
+    emit RequestScan(scan_request_id_, root);
+}
+
+void ResultsBrowserWidget::OnCancelScan() {
+    scan_worker_->RequestCancel(scan_request_id_);
+}
+
+void ResultsBrowserWidget::SetScanning(bool scanning) {
+    progress_bar_->setVisible(scanning);
+    progress_bar_->setRange(0, 0);  // busy until the first progress report
+    cancel_button_->setVisible(scanning);
+    scan_button_->setEnabled(!scanning);
+}
+
+void ResultsBrowserWidget::OnScanProgress(int request_id, int done, int total) {
+    if (request_id != scan_request_id_) return;
+    progress_bar_->setRange(0, total);
+    progress_bar_->setValue(done);
+    progress_bar_->setFormat(QString::fromUtf8("读取摘要 %v / %m"));
+}
+
+void ResultsBrowserWidget::OnScanFinished(int request_id, const ResultIndexEntriesPtr& entries,
+                                          const QString& message) {
+    if (request_id != scan_request_id_) return;
+    SetScanning(false);
+    model_->SetEntries(entries);
+    status_label_->setText(message);
+    OnSelectionChanged();
+}
+
+void ResultsBrowserWidget::OnScanCancelled(int request_id) {
+    if (request_id != scan_request_id_) return;
+    SetScanning(false);
+    status_label_->setText(QString::fromUtf8("扫描已取消"));
+}
+
+void ResultsBrowserWidget::OnFilterChanged(const QString& text) {
+    proxy_->setFilterFixedString(text);
+}
+
+QStringList ResultsBrowserWidget::SelectedModelPaths() const {
+    QStringList paths;
+    const QModelIndexList rows = table_->selectionModel()->selectedRows();
+    for (const QModelIndex& index : rows) {
+        const int source_row = proxy_->mapToSource(index).row();
+        const ResultIndexEntry* entry = model_->Entry(source_row);
+        if (entry && entry->kind != ResultFileKind::Csv) {
+            paths << model_->Path(source_row);
+        }
+    }
+    return paths;
+}
+
+QString ResultsBrowserWidget::ModelPathAt(int proxy_row) const {
+    if (proxy_row < 0 || proxy_row >= proxy_->rowCount()) return QString();
+    const int source_row = proxy_->mapToSource(proxy_->index(proxy_row, 0)).row();
+    const ResultIndexEntry* entry = model_->Entry(source_row);
+    return (entry && entry->kind != ResultFileKind::Csv) ? model_->Path(source_row) : QString();
+}
+
+void ResultsBrowserWidget::OnCurrentRowChanged(const QModelIndex& current) {
+    if (!current.isValid()) return;
+
+    // Current file first, then its neighbours nearest first, in table order so
+    // stepping up or down through the list hits the cache
+    QStringList paths;
+    const int row = current.row();
+    for (int offset = 0; offset <= kPrefetchNeighbours; ++offset) {
+        for (int candidate : {row + offset, row - offset}) {
+            QString path = ModelPathAt(candidate);
+            if (!path.isEmpty() && !paths.contains(path)) paths << path;
+        }
+    }
+    if (paths.isEmpty()) return;
+
+    // Only the latest position matters
+    prefetch_worker_->RequestCancel(prefetch_request_id_);
+    ++prefetch_request_id_;
+    emit RequestPrefetch(prefetch_request_id_, paths, kPrefetchVariables);
+}
+
+void ResultsBrowserWidget::OnSelectionChanged() {
+    const int model_count = SelectedModelPaths().size();
+    open_button_->setEnabled(model_count == 1);
+    compare_button_->setEnabled(model_count >= 1);
+    verify_button_->setEnabled(model_count >= 1);
+}
+
+void ResultsBrowserWidget::OnOpenSelected() {
+    // CSV results carry no variables for the analysis panels
+    const QStringList paths = SelectedModelPaths();
+    if (paths.size() == 1) {
+        emit OpenResultRequested(paths.first());
+    }
+}
+
+void ResultsBrowserWidget::OnCompareSelected() {
+    const QStringList paths = SelectedModelPaths();
+    if (!paths.isEmpty()) {
+        emit CompareRequested(paths);
+    }
+}
+
+void ResultsBrowserWidget::OnVerifySelected() {
+    const QStringList paths = SelectedModelPaths();
+    if (!paths.isEmpty()) {
+        emit VerifyRequested(paths);
+    }
+}
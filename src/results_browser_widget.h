@@ -0,0 +1,93 @@
+// results_browser_widget.h - Results directory browser
+// Scans a results tree in the background and lists every result file with its
+// summary in a sortable, filterable table. The files around the current row are
+// prefetched into the shared result cache so opening them is instant.
+
+#ifndef RESULTS_BROWSER_WIDGET_H_
+#define RESULTS_BROWSER_WIDGET_H_
+
+#include <QWidget>
+#include <QString>
+#include <QStringList>
+#include "core/result_cache.h"
+#include "result_index_worker.h"
+
+class QLabel;
+class QModelIndex;
+class QLineEdit;
+class QProgressBar;
+class QPushButton;
+class QSortFilterProxyModel;
+class QTableView;
+class QThread;
+class ResultIndexModel;
+class ResultPrefetchWorker;
+
+class ResultsBrowserWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    // |cache| is shared with the analysis tab, which opens the prefetched files
+    explicit ResultsBrowserWidget(const ResultCachePtr& cache, QWidget* parent = nullptr);
+    ~ResultsBrowserWidget() override;
+
+    // Scan |root| (uses the persisted index of that root for unchanged files)
+    void ScanDirectory(const QString& root);
+
+signals:
+    void RequestScan(int request_id, const QString& root);
+    void RequestPrefetch(int request_id, const QStringList& paths, const QStringList& variables);
+    // User wants to analyze one result / compare or verify several
+    void OpenResultRequested(const QString& path);
+    void CompareRequested(const QStringList& paths);
+    void VerifyRequested(const QStringList& paths);
+
+private slots:
+    void OnBrowseRoot();
+    void OnScan();
+    void OnCancelScan();
+    void OnFilterChanged(const QString& text);
+    void OnOpenSelected();
+    void OnCompareSelected();
+    void OnVerifySelected();
+    void OnSelectionChanged();
+    void OnCurrentRowChanged(const QModelIndex& current);
+    void OnScanProgress(int request_id, int done, int total);
+    void OnScanFinished(int request_id, const ResultIndexEntriesPtr& entries,
+                        const QString& message);
+    void OnScanCancelled(int request_id);
+
+private:
+    void SetupUi();
+    void SetupWorker();
+    void SetScanning(bool scanning);
+    QStringList SelectedModelPaths() const;
+    QString ModelPathAt(int proxy_row) const;
+
+    QLineEdit* root_edit_;
+    QPushButton* browse_button_;
+    QPushButton* scan_button_;
+    QPushButton* cancel_button_;
+    QLineEdit* filter_edit_;
+    QPushButton* open_button_;
+    QPushButton* compare_button_;
+    QPushButton* verify_button_;
+    QLabel* status_label_;
+    QProgressBar* progress_bar_;
+    QTableView* table_;
+    ResultIndexModel* model_;
+    QSortFilterProxyModel* proxy_;
+
+    // Background scanning
+    QThread* scan_thread_;
+    ResultIndexWorker* scan_worker_;
+    int scan_request_id_;
+
+    // Background prefetch of neighbouring results
+    ResultCachePtr cache_;
+    QThread* prefetch_thread_;
+    ResultPrefetchWorker* prefetch_worker_;
+    int prefetch_request_id_;
+};
+
+#endif  // RESULTS_BROWSER_WIDGET_H_
@@ -1,13 +1,15 @@
 // solver_worker.cpp - Background Solver Worker (Subprocess) Implementation
 
 #include "solver_worker.h"
+#include "core/instance_cache.h"
+#include "core/log_archive.h"
 
 #include <QCoreApplication>
 #include <QDateTime>
 #include <QDir>
+#include <QDirIterator>
 #include <QFileInfo>
 #include <QRegularExpression>
-#include <QTextStream>
 
 SolverWorker::SolverWorker(QObject* parent)
     : QObject(parent)
@@ -21,6 +23,7 @@ SolverWorker::SolverWorker(QObject* parent)
     , solver_process_(nullptr)
     , log_reader_(nullptr)
     , log_file_pos_(0)
+    , solver_pid_(0)
     , cancel_requested_(false)
     // RF defaults
     , rf_window_(6)
@@ -56,6 +59,10 @@ void SolverWorker::SetDataPath(const QString& path) {
     data_path_ = path;
 }
 
+void SolverWorker::SetLogTag(const QString& tag) {
+    log_tag_ = tag;
+}
+
 void SolverWorker::SetAlgorithm(AlgorithmType algo) {
     algorithm_ = algo;
 }
@@ -156,6 +163,18 @@ void SolverWorker::RequestCancel() {
 
 void SolverWorker::RunOptimization() {
     cancel_requested_ = false;
+    record_ = RunRecord();
+    record_.started = QDateTime::currentMSecsSinceEpoch();
+    record_.algorithm = GetAlgorithmName().toStdString();
+    record_.instance_path = data_path_.toStdString();
+    record_.n = inst_n_;
+    record_.t = inst_t_;
+    record_.g = inst_g_;
+    record_.f = inst_f_;
+    results_dir_.clear();
+    file_base_.clear();
+    output_paths_.clear();
+    log_file_path_.clear();
 
     // Get solver executable path
     QString exe_path = GetSolverExePath();
@@ -163,6 +182,7 @@ void SolverWorker::RunOptimization() {
 
     if (!exe_info.exists()) {
         emit LogMessage(QString::fromUtf8("错误: 找不到求解器: %1").arg(exe_path));
+        RecordRun(RunStatus::Failed, QString::fromUtf8("找不到求解器可执行文件"), 0.0);
         emit OptimizationFinished(false, QString::fromUtf8("找不到求解器可执行文件"));
         return;
     }
@@ -182,9 +202,11 @@ void SolverWorker::RunOptimization() {
     QString file_base = QString("N%1T%2G%3F%4_%5_%6")
         .arg(inst_n_).arg(inst_t_).arg(inst_g_).arg(inst_f_)
         .arg(inst_difficulty_, 0, 'f', 2)
-        .arg(timestamp);
+        .arg(timestamp) + log_tag_;
 
     QString log_base = logs_dir + "/log_" + GetAlgorithmName() + "_" + file_base;
+    results_dir_ = results_dir;
+    file_base_ = file_base;
 
     log_file_path_ = log_base + ".log";
     log_file_pos_ = 0;
@@ -244,6 +266,8 @@ void SolverWorker::RunOptimization() {
     }
 
     emit LogMessage(QString::fromUtf8("参数: %1").arg(args.join(" ")));
+    record_.arguments.push_back(exe_path.toStdString());
+    for (const QString& arg : args) record_.arguments.push_back(arg.toStdString());
 
     // Create and configure process
     if (solver_process_) {
@@ -266,6 +290,7 @@ void SolverWorker::RunOptimization() {
     }
     log_reader_ = new QTimer(this);
     connect(log_reader_, &QTimer::timeout, this, &SolverWorker::OnReadLogFile);
+    connect(log_reader_, &QTimer::timeout, this, &SolverWorker::OnSampleUsage);
     log_reader_->start(500);  // Read log every 500ms
 
     // Start the solver process
@@ -273,12 +298,27 @@ void SolverWorker::RunOptimization() {
 
     if (!solver_process_->waitForStarted(5000)) {
         emit LogMessage(QString::fromUtf8("错误: 无法启动求解器进程"));
+        RecordRun(RunStatus::Failed, QString::fromUtf8("无法启动求解器"), 0.0);
         emit OptimizationFinished(false, QString::fromUtf8("无法启动求解器"));
         return;
     }
 
     emit LogMessage(QString::fromUtf8("求解器进程已启动 (PID: %1)")
                     .arg(solver_process_->processId()));
+    run_timer_.start();
+    solver_pid_ = solver_process_->processId();
+    usage_ = ProcessUsage();
+
+    // Hashed while the solver runs; usually taken from the instance cache
+    record_.instance_hash = InstanceCache::Shared().ContentHash(data_path_).toHex().toStdString();
+}
+
+void SolverWorker::OnSampleUsage() {
+    // The last sample before exit holds the peak; the process is gone afterwards
+    ProcessUsage sample;
+    if (solver_pid_ > 0 && SampleProcessUsage(solver_pid_, &sample)) {
+        usage_ = sample;
+    }
 }
 
 void SolverWorker::OnProcessOutput() {
@@ -315,31 +355,98 @@ void SolverWorker::OnProcessFinished(int exitCode, QProcess::ExitStatus status)
     if (log_reader_) {
         log_reader_->stop();
     }
+    const double wall_seconds = run_timer_.isValid() ? run_timer_.elapsed() / 1000.0 : 0.0;
+    solver_pid_ = 0;
 
-    // Read any remaining log content
+    // Read any remaining log content, then archive it
     OnReadLogFile();
+    CompressLog();
 
     if (cancel_requested_) {
+        RecordRun(RunStatus::Cancelled, QString::fromUtf8("已被用户取消"), wall_seconds);
         emit OptimizationFinished(false, QString::fromUtf8("已被用户取消"));
         return;
     }
 
     if (status == QProcess::CrashExit) {
         emit LogMessage(QString::fromUtf8("求解器进程崩溃"));
+        RecordRun(RunStatus::Failed, QString::fromUtf8("求解器崩溃"), wall_seconds);
         emit OptimizationFinished(false, QString::fromUtf8("求解器崩溃"));
         return;
     }
 
     if (exitCode != 0) {
         emit LogMessage(QString::fromUtf8("求解器退出, 代码 %1").arg(exitCode));
-        emit OptimizationFinished(false, QString::fromUtf8("求解器失败 (退出代码 %1)").arg(exitCode));
+        const QString message = QString::fromUtf8("求解器失败 (退出代码 %1)").arg(exitCode);
+        RecordRun(RunStatus::Failed, message, wall_seconds);
+        emit OptimizationFinished(false, message);
         return;
     }
 
     emit LogMessage(QString::fromUtf8("求解器成功完成"));
+    RecordRun(RunStatus::Success, QString::fromUtf8("完成"), wall_seconds);
+    emit RunMeasured(wall_seconds, usage_.cpu_seconds, usage_.peak_rss_bytes);
     emit OptimizationFinished(true, QString::fromUtf8("完成"));
 }
 
+void SolverWorker::RecordRun(RunStatus status, const QString& message, double wall_seconds) {
+    record_.status = status;
+    record_.message = message.toStdString();
+    record_.wall_seconds = wall_seconds;
+    record_.cpu_seconds = usage_.cpu_seconds;
+    record_.peak_rss_bytes = usage_.peak_rss_bytes;
+    record_.artifacts = CollectArtifacts();
+    if (!RunHistory::Shared().Append(record_)) {
+        emit LogMessage(QString::fromUtf8("警告: 运行记录写入失败"));
+    }
+}
+
+void SolverWorker::CompressLog() {
+    if (log_file_path_.isEmpty() || !QFileInfo::exists(log_file_path_)) return;
+
+    // The plain log is only removed once the archive reads back identical
+    const QString archive = log_file_path_ + "z";
+    const qint64 raw_size = QFileInfo(log_file_path_).size();
+    if (!CompressLogFile(log_file_path_.toStdString(), archive.toStdString())) {
+        emit LogMessage(QString::fromUtf8("警告: 日志压缩失败, 保留原始日志"));
+        return;
+    }
+    const qint64 packed_size = QFileInfo(archive).size();
+    emit LogMessage(QString::fromUtf8("日志已压缩: %1 (%2 KB -> %3 KB)")
+                    .arg(QFileInfo(archive).fileName())
+                    .arg(raw_size / 1024)
+                    .arg(packed_size / 1024));
+    log_file_path_ = archive;
+}
+
+std::vector<std::string> SolverWorker::CollectArtifacts() const {
+    std::vector<std::string> artifacts;
+    if (!log_file_path_.isEmpty() && QFileInfo::exists(log_file_path_)) {
+        artifacts.push_back(log_file_path_.toStdString());
+    }
+
+    // The solver's log names what it wrote (rf_result_<date>_<time>_<ms>.json and
+    // the like carry no run-specific token), so parallel runs never claim each
+    // other's files
+    for (const QString& path : output_paths_) {
+        if (QFileInfo::exists(path)) artifacts.push_back(path.toStdString());
+    }
+    if (!output_paths_.isEmpty() || results_dir_.isEmpty() || file_base_.isEmpty()) {
+        return artifacts;
+    }
+
+    // Log without those lines: only entries named after this run's file base
+    // (timestamp + log tag are unique)
+    QDirIterator it(results_dir_, QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
+    while (it.hasNext()) {
+        it.next();
+        if (it.fileName().contains(file_base_)) {
+            artifacts.push_back(it.fileInfo().absoluteFilePath().toStdString());
+        }
+    }
+    return artifacts;
+}
+
 void SolverWorker::OnReadLogFile() {
     QFile file(log_file_path_);
     if (!file.exists()) return;
@@ -349,11 +456,18 @@ void SolverWorker::OnReadLogFile() {
     // Seek to last read position
     file.seek(log_file_pos_);
 
-    QTextStream in(&file);
-    in.setEncoding(QStringConverter::Utf8);
-
-    while (!in.atEnd()) {
-        QString line = in.readLine();
+    // While the solver runs, a line still being written is left for the next
+    // read, so a path is never parsed cut short
+    while (!file.atEnd()) {
+        const qint64 start = file.pos();
+        QByteArray raw = file.readLine();
+        if (!raw.endsWith('\n') && solver_pid_ > 0) {
+            file.seek(start);
+            break;
+        }
+        QString line = QString::fromUtf8(raw);
+        while (line.endsWith('\n') || line.endsWith('\r')) line.chop(1);
+        ParseOutputLine(line);
         emit LogMessage(line);
     }
 
@@ -361,6 +475,26 @@ void SolverWorker::OnReadLogFile() {
     file.close();
 }
 
+void SolverWorker::ParseOutputLine(const QString& line) {
+    // [2026-01-07 07:50:48] [系统] 输出目录: D:/.../results/solution_RF_N300T30G5F5_...
+    // [2026-01-07 07:50:52] [保存] 结果已保存: D:/.../results/rf_result_20260107_075052_209.json
+    static const QString kSaved = QString::fromUtf8("结果已保存: ");
+    static const QString kOutputDir = QString::fromUtf8("输出目录: ");
+
+    int pos = line.indexOf(kSaved);
+    if (pos >= 0) {
+        output_paths_ << QDir::cleanPath(line.mid(pos + kSaved.size()).trimmed());
+        return;
+    }
+
+    // Only a folder of this run: the shared results directory is not an artifact
+    pos = line.indexOf(kOutputDir);
+    if (pos >= 0) {
+        const QString dir = QDir::cleanPath(line.mid(pos + kOutputDir.size()).trimmed());
+        if (QFileInfo(dir).fileName().startsWith("solution_")) output_paths_ << dir;
+    }
+}
+
 void SolverWorker::ParseStatusLine(const QString& line) {
     // Parse status codes from solver stdout
     // Format examples:
@@ -428,6 +562,12 @@ void SolverWorker::ParseStatusLine(const QString& line) {
         double objective = match.captured(2).toDouble();
         double runtime = match.captured(3).toDouble();
         double gap = match.captured(4).toDouble();
+        RunStageRecord record;
+        record.stage = stage;
+        record.objective = objective;
+        record.runtime = runtime;
+        record.gap = gap;
+        record_.stages.push_back(record);
         emit StageCompleted(stage, objective, runtime, gap);
         return;
     }
@@ -7,10 +7,14 @@
 
 #include <QObject>
 #include <QString>
+#include <QStringList>
 #include <QProcess>
 #include <QTimer>
 #include <QFile>
+#include <QElapsedTimer>
 #include <atomic>
+#include "core/process_usage.h"
+#include "core/run_history.h"
 
 // 算法类型
 enum class AlgorithmType {
@@ -34,6 +38,8 @@ public:
                        int machine_capacity);
     void SetCplexParameters(const QString& workdir, int workmem, int threads);
     void SetInstanceInfo(int n, int t, int g, int f, double difficulty);
+    // Appended to the log file name: keeps the logs of parallel batch jobs apart
+    void SetLogTag(const QString& tag);
 
     // Advanced algorithm parameters
     void SetRFParameters(int window, int step, double time, int retries);
@@ -53,6 +59,9 @@ signals:
     void MergeSkipped();
     void StageStarted(int stage, const QString& name);
     void StageCompleted(int stage, double objective, double runtime, double gap);
+    // Cost of a successful run, sampled from the solver process (peak_rss_bytes
+    // is 0 where it cannot be read); emitted just before OptimizationFinished
+    void RunMeasured(double wall_seconds, double cpu_seconds, qint64 peak_rss_bytes);
     void OptimizationFinished(bool success, const QString& message);
     void LogMessage(const QString& message);
 
@@ -61,12 +70,22 @@ private slots:
     void OnProcessError();
     void OnProcessFinished(int exitCode, QProcess::ExitStatus status);
     void OnReadLogFile();
+    void OnSampleUsage();
 
 private:
     void ParseStatusLine(const QString& line);
+    // Remember the output folder / result files a solver log line reports
+    void ParseOutputLine(const QString& line);
     QString GetSolverExePath() const;
     QString GetAlgorithmName() const;
 
+    // Complete record_ and append it to the run history
+    void RecordRun(RunStatus status, const QString& message, double wall_seconds);
+    // Replace the finished log by its .logz archive
+    void CompressLog();
+    // Log file and the result files / solution folder this run wrote
+    std::vector<std::string> CollectArtifacts() const;
+
     QString data_path_;
     AlgorithmType algorithm_;
     double runtime_limit_;
@@ -110,11 +129,23 @@ private:
     int inst_g_;
     int inst_f_;
     double inst_difficulty_;
+    QString log_tag_;
 
     QProcess* solver_process_;
     QTimer* log_reader_;
     QString log_file_path_;
     qint64 log_file_pos_;
+    QString results_dir_;
+    QString file_base_;
+    QStringList output_paths_;      // reported in this run's log
+
+    // Resource use of the running solver
+    QElapsedTimer run_timer_;
+    qint64 solver_pid_;
+    ProcessUsage usage_;
+
+    // History record of the current run, filled in as it progresses
+    RunRecord record_;
 
     std::atomic<bool> cancel_requested_;
 };
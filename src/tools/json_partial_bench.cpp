@@ -0,0 +1,215 @@
+// json_partial_bench.cpp - Benchmark: partial result JSON reads vs QJsonDocument
+//
+// Usage:
+//   LS-NTGF-JsonBench [-r repeats] [-g MB[,MB...]] [-d dir] [result.json...]
+//
+// -g writes synthetic result files of the given sizes (solver layout: summary,
+// problem, then a large "variables" payload) into -d (default: temp dir) and
+// benchmarks them together with any files given on the command line.
+// For each file it reports the best of -r runs of
+//   head  - PartialJsonReader for summary + problem (what the results index reads)
+//   scan  - PartialJsonReader over the whole file (requested key absent)
+//   qjson - QFile::readAll + QJsonDocument::fromJson
+
+#include "core/json_partial_reader.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonParseError>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr int kColumns = 30;
+
+void PrintUsage() {
+    std::fprintf(stderr,
+        "Usage: LS-NTGF-JsonBench [-r repeats] [-g MB[,MB...]] [-d dir] [result.json...]\n");
+}
+
+std::vector<int> ParseSizes(const std::string& list) {
+    std::vector<int> sizes;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        int mb = std::atoi(item.c_str());
+        if (mb > 0) sizes.push_back(mb);
+    }
+    return sizes;
+}
+
+// Pretty-printed rows like the solver writes them
+std::string FormatRow(std::mt19937& rng, bool binary) {
+    std::uniform_int_distribution<int> value(0, 999);
+    std::string row = "        [";
+    for (int c = 0; c < kColumns; ++c) {
+        if (c > 0) row += ", ";
+        int v = value(rng);
+        if (binary) {
+            row += v < 100 ? '1' : '0';
+        } else {
+            row += v < 700 ? "0" : std::to_string(v) + ".5";
+        }
+    }
+    row += ']';
+    return row;
+}
+
+void WriteVariable(std::ofstream& out, const char* name, int rows, std::mt19937& rng,
+                   bool binary, bool last) {
+    out << "    \"" << name << "\": {\n"
+        << "      \"description\": \"synthetic\",\n"
+        << "      \"dimensions\": [" << rows << ", " << kColumns << "],\n"
+        << "      \"data\": [\n";
+    for (int r = 0; r < rows; ++r) {
+        out << FormatRow(rng, binary) << (r + 1 < rows ? ",\n" : "\n");
+    }
+    out << "      ]\n    }" << (last ? "\n" : ",\n");
+}
+
+bool GenerateResult(const std::string& path, int megabytes) {
+    std::ofstream out(fs::u8path(path), std::ios::binary | std::ios::trunc);
+    if (!out) return false;
+
+    std::mt19937 rng(static_cast<unsigned>(megabytes));
+    const size_t row_bytes = FormatRow(rng, false).size() + 2;
+    const int rows = std::max(1, static_cast<int>(megabytes * 1024.0 * 1024.0 / row_bytes / 2));
+
+    out << "{\n"
+        << "  \"summary\": {\n"
+        << "    \"algorithm\": \"RF\",\n"
+        << "    \"input_file\": \"synthetic.csv\",\n"
+        << "    \"objective\": 252334.0,\n"
+        << "    \"total_time\": 3.99,\n"
+        << "    \"gap\": 0.0\n"
+        << "  },\n"
+        << "  \"problem\": {\n"
+        << "    \"N\": " << rows << ",\n"
+        << "    \"T\": " << kColumns << ",\n"
+        << "    \"F\": 5,\n"
+        << "    \"G\": 5\n"
+        << "  },\n"
+        << "  \"variables\": {\n";
+    WriteVariable(out, "X", rows, rng, false, false);
+    WriteVariable(out, "Y", rows, rng, true, true);
+    out << "  }\n}\n";
+    return static_cast<bool>(out);
+}
+
+// Best wall time of |repeats| runs in milliseconds
+double BestOf(int repeats, const std::function<bool()>& run, bool* ok) {
+    double best = 0.0;
+    *ok = true;
+    for (int i = 0; i < repeats; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        bool good = run();
+        double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        if (!good) *ok = false;
+        if (i == 0 || ms < best) best = ms;
+    }
+    return best;
+}
+
+void BenchFile(const std::string& path, int repeats) {
+    std::error_code ec;
+    const double mb = static_cast<double>(fs::file_size(fs::u8path(path), ec)) / (1024.0 * 1024.0);
+
+    uint64_t head_bytes = 0;
+    bool head_ok = false;
+    double head_ms = BestOf(repeats, [&]() {
+        PartialJsonReader reader({"summary", "problem"});
+        reader.ReadFile(path);
+        head_bytes = reader.BytesConsumed();
+        return reader.Complete();
+    }, &head_ok);
+
+    bool scan_ok = false;
+    double scan_ms = BestOf(repeats, [&]() {
+        PartialJsonReader reader({"__absent__"});
+        return reader.ReadFile(path);
+    }, &scan_ok);
+
+    QString qjson_error;
+    bool qjson_ok = false;
+    double qjson_ms = BestOf(repeats, [&]() {
+        QFile file(QString::fromStdString(path));
+        if (!file.open(QIODevice::ReadOnly)) return false;
+        QJsonParseError error;
+        QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
+        if (error.error != QJsonParseError::NoError) qjson_error = error.errorString();
+        return doc.isObject();
+    }, &qjson_ok);
+
+    std::printf("%-48s %9.1f | %9.3f %9llu | %9.1f %8.0f | ",
+                fs::u8path(path).filename().u8string().c_str(), mb,
+                head_ok ? head_ms : -1.0, static_cast<unsigned long long>(head_bytes),
+                scan_ok ? scan_ms : -1.0, scan_ok && scan_ms > 0 ? mb * 1000.0 / scan_ms : 0.0);
+    if (qjson_ok) {
+        std::printf("%9.1f %8.0f\n", qjson_ms, qjson_ms > 0 ? mb * 1000.0 / qjson_ms : 0.0);
+    } else {
+        std::printf("failed (%s)\n", qPrintable(qjson_error));
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int repeats = 3;
+    std::vector<int> generate_sizes;
+    std::string generate_dir = fs::temp_directory_path().u8string();
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-r" && i + 1 < argc) {
+            repeats = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "-g" && i + 1 < argc) {
+            generate_sizes = ParseSizes(argv[++i]);
+        } else if (arg == "-d" && i + 1 < argc) {
+            generate_dir = argv[++i];
+        } else if (arg == "-h" || arg == "--help") {
+            PrintUsage();
+            return 0;
+        } else {
+            paths.push_back(arg);
+        }
+    }
+
+    for (int mb : generate_sizes) {
+        std::string path = (fs::u8path(generate_dir) /
+                            ("bench_result_" + std::to_string(mb) + "mb.json")).u8string();
+        std::printf("Generating %s ...\n", path.c_str());
+        if (!GenerateResult(path, mb)) {
+            std::fprintf(stderr, "Cannot write %s\n", path.c_str());
+            return 1;
+        }
+        paths.push_back(path);
+    }
+
+    if (paths.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::printf("%-48s %9s | %9s %9s | %9s %8s | %9s %8s\n", "file", "MB",
+                "head ms", "bytes", "scan ms", "MB/s", "qjson ms", "MB/s");
+    for (const auto& path : paths) {
+        BenchFile(path, repeats);
+    }
+    return 0;
+}
@@ -0,0 +1,149 @@
+// log_events_main.cpp - Command line front end for the offline log parser
+//
+// Usage:
+//   LS-NTGF-LogEvents [-j threads] [-o events.lsev] [-s summary.csv] <log file|directory>...
+//   LS-NTGF-LogEvents --compress [--keep] <log file|directory>...
+//
+// Directories are scanned recursively for *.log and *.logz files (a plain log
+// whose archive sits next to it is skipped). --compress re-encodes plain logs as
+// .logz archives instead, removing each original once its archive reads back
+// identical (--keep leaves them). Logs that cannot be read are listed on stderr
+// and make the exit status 1.
+
+#include "core/log_archive.h"
+#include "core/log_events.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+void PrintUsage() {
+    std::fprintf(stderr,
+        "Usage: LS-NTGF-LogEvents [-j threads] [-o events.lsev] [-s summary.csv] "
+        "<log file|directory>...\n"
+        "       LS-NTGF-LogEvents --compress [--keep] <log file|directory>...\n");
+}
+
+void CollectLogs(const fs::path& root, std::vector<std::string>* paths) {
+    std::error_code ec;
+    if (fs::is_directory(root, ec)) {
+        for (fs::recursive_directory_iterator it(root, ec), end; it != end; it.increment(ec)) {
+            if (ec) break;
+            if (!it->is_regular_file(ec)) continue;
+            const fs::path& path = it->path();
+            if (path.extension() == ".logz" ||
+                (path.extension() == ".log" && !fs::exists(fs::path(path).concat("z"), ec))) {
+                paths->push_back(path.u8string());
+            }
+        }
+    } else if (fs::is_regular_file(root, ec)) {
+        paths->push_back(root.u8string());
+    }
+}
+
+// Archive every plain log in |paths|
+int CompressLogs(const std::vector<std::string>& paths, bool keep) {
+    uint64_t raw_total = 0;
+    uint64_t packed_total = 0;
+    int compressed = 0;
+    int failed = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& path : paths) {
+        if (IsLogArchivePath(path)) continue;
+        std::error_code ec;
+        const uint64_t raw_size = fs::file_size(fs::u8path(path), ec);
+        if (!CompressLogFile(path, std::string(), keep)) {
+            std::fprintf(stderr, "Cannot compress %s\n", path.c_str());
+            ++failed;
+            continue;
+        }
+        raw_total += raw_size;
+        packed_total += fs::file_size(fs::u8path(path + "z"), ec);
+        ++compressed;
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("Compressed %d log(s), %.1f MB -> %.1f MB (%.1fx) in %.3fs\n",
+                compressed, raw_total / 1048576.0, packed_total / 1048576.0,
+                packed_total > 0 ? static_cast<double>(raw_total) / packed_total : 0.0, elapsed);
+    return failed == 0 ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int threads = 0;
+    std::string events_path = "events.lsev";
+    std::string summary_path;
+    bool compress = false;
+    bool keep = false;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-j" && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+        } else if (arg == "-o" && i + 1 < argc) {
+            events_path = argv[++i];
+        } else if (arg == "-s" && i + 1 < argc) {
+            summary_path = argv[++i];
+        } else if (arg == "--compress") {
+            compress = true;
+        } else if (arg == "--keep") {
+            keep = true;
+        } else if (arg == "-h" || arg == "--help") {
+            PrintUsage();
+            return 0;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (inputs.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::vector<std::string> paths;
+    for (const auto& input : inputs) {
+        CollectLogs(fs::u8path(input), &paths);
+    }
+    std::sort(paths.begin(), paths.end());
+    if (paths.empty()) {
+        std::fprintf(stderr, "No log files found\n");
+        return 1;
+    }
+    if (compress) {
+        return CompressLogs(paths, keep);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    LogEventTable events;
+    std::vector<LogRunSummary> summaries;
+    const size_t unreadable = ParseLogFiles(paths, threads, &events, &summaries);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (!WriteLogEvents(events_path, summaries, events)) {
+        std::fprintf(stderr, "Cannot write %s\n", events_path.c_str());
+        return 1;
+    }
+    if (!summary_path.empty() && !WriteLogSummaries(summary_path, summaries)) {
+        std::fprintf(stderr, "Cannot write %s\n", summary_path.c_str());
+        return 1;
+    }
+
+    for (const auto& summary : summaries) {
+        if (!summary.readable) std::fprintf(stderr, "Cannot read %s\n", summary.path.c_str());
+    }
+    std::printf("Parsed %zu log(s), %zu event(s) in %.3fs -> %s\n",
+                paths.size() - unreadable, events.Size(), elapsed, events_path.c_str());
+    return unreadable == 0 ? 0 : 1;
+}
@@ -0,0 +1,179 @@
+// result_convert_main.cpp - Convert result JSON files into binary .lsrb files or CSV
+//
+// Usage:
+//   LS-NTGF-ResultConvert [-t lsrb|csv] [-j threads] [-o output dir] [-f]
+//                         <result.json|directory>...
+//
+// Directories are scanned recursively for *_result_*.json. Each file is written
+// next to its source (or into -o): with the .lsrb suffix, or with -t csv as a
+// <name>_csv directory holding one full-precision CSV per variable. Outputs newer
+// than the JSON are skipped unless -f is given. Files are converted in parallel,
+// one per thread.
+
+#include "core/parallel.h"
+#include "core/result_binary.h"
+#include "core/result_csv.h"
+#include "core/result_source.h"
+
+#include <QString>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+void PrintUsage() {
+    std::fprintf(stderr,
+        "Usage: LS-NTGF-ResultConvert [-t lsrb|csv] [-j threads] [-o output dir] [-f] "
+        "<result.json|directory>...\n");
+}
+
+bool IsResultJson(const fs::path& path) {
+    return path.extension() == ".json" &&
+           path.filename().u8string().find("_result_") != std::string::npos;
+}
+
+void CollectResults(const fs::path& root, std::vector<fs::path>* paths) {
+    std::error_code ec;
+    if (fs::is_directory(root, ec)) {
+        for (fs::recursive_directory_iterator it(root, ec), end; it != end; it.increment(ec)) {
+            if (ec) break;
+            if (it->is_regular_file(ec) && IsResultJson(it->path())) {
+                paths->push_back(it->path());
+            }
+        }
+    } else if (fs::is_regular_file(root, ec)) {
+        paths->push_back(root);
+    }
+}
+
+uint64_t OutputSize(const fs::path& target) {
+    std::error_code ec;
+    if (!fs::is_directory(target, ec)) return fs::file_size(target, ec);
+    uint64_t bytes = 0;
+    for (fs::directory_iterator it(target, ec), end; it != end; it.increment(ec)) {
+        if (ec) break;
+        if (it->is_regular_file(ec)) bytes += it->file_size(ec);
+    }
+    return bytes;
+}
+
+bool IsUpToDate(const fs::path& source, const fs::path& target) {
+    std::error_code ec;
+    if (!fs::exists(target, ec)) return false;
+    return fs::last_write_time(target, ec) >= fs::last_write_time(source, ec) && !ec;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int threads = 0;
+    std::string output_dir;
+    bool force = false;
+    bool csv = false;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-t" && i + 1 < argc) {
+            std::string format = argv[++i];
+            if (format != "lsrb" && format != "csv") {
+                PrintUsage();
+                return 1;
+            }
+            csv = format == "csv";
+        } else if (arg == "-j" && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+        } else if (arg == "-o" && i + 1 < argc) {
+            output_dir = argv[++i];
+        } else if (arg == "-f") {
+            force = true;
+        } else if (arg == "-h" || arg == "--help") {
+            PrintUsage();
+            return 0;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (inputs.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::vector<fs::path> sources;
+    for (const auto& input : inputs) {
+        CollectResults(fs::u8path(input), &sources);
+    }
+    std::sort(sources.begin(), sources.end());
+    if (sources.empty()) {
+        std::fprintf(stderr, "No result files found\n");
+        return 1;
+    }
+    if (!output_dir.empty()) {
+        std::error_code ec;
+        fs::create_directories(fs::u8path(output_dir), ec);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::atomic<size_t> converted(0);
+    std::atomic<size_t> skipped(0);
+    std::atomic<size_t> failed(0);
+    std::atomic<uint64_t> bytes_in(0);
+    std::atomic<uint64_t> bytes_out(0);
+    std::mutex print_mutex;
+
+    RunParallel(sources.size(), threads, [&](size_t k) {
+        const fs::path& source = sources[k];
+        fs::path target = source;
+        if (csv) {
+            target = source.parent_path() / fs::u8path(source.stem().u8string() + "_csv");
+        } else {
+            target.replace_extension(kResultBinarySuffix);
+        }
+        if (!output_dir.empty()) target = fs::u8path(output_dir) / target.filename();
+
+        if (!force && IsUpToDate(source, target)) {
+            ++skipped;
+            return;
+        }
+
+        QString error;
+        const QString source_path = QString::fromStdString(source.u8string());
+        const QString target_path = QString::fromStdString(target.u8string());
+        if (csv) {
+            // Files are already spread over the threads; one per variable here
+            ResultSourcePtr result = ResultSource::Open(source_path, &error);
+            if (result) ExportVariablesCsv(*result, target_path, QString(), 1, &error);
+        } else {
+            ResultModelPtr model = ResultModel::FromFile(source_path, &error);
+            if (model) WriteResultBinary(target_path, *model, &error);
+        }
+        if (!error.isEmpty()) {
+            ++failed;
+            std::lock_guard<std::mutex> lock(print_mutex);
+            std::fprintf(stderr, "%s: %s\n", source.u8string().c_str(), qPrintable(error));
+            return;
+        }
+
+        std::error_code ec;
+        bytes_in += fs::file_size(source, ec);
+        bytes_out += OutputSize(target);
+        ++converted;
+    });
+
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("Converted %zu file(s) (%.1f MB -> %.1f MB), skipped %zu, failed %zu in %.3fs\n",
+                converted.load(), bytes_in.load() / (1024.0 * 1024.0),
+                bytes_out.load() / (1024.0 * 1024.0), skipped.load(), failed.load(), elapsed);
+    return failed.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,171 @@
+// result_verify_main.cpp - Check result files for feasibility against their instances
+//
+// Usage:
+//   LS-NTGF-Verify [-j threads] [--capacity value] [-i instance.csv] [-v]
+//                  <result.json|result.lsrb|directory>...
+//
+// Directories are scanned recursively for *_result_*.json / *_result_*.lsrb. Each
+// result is checked against the instance it records (or -i) for capacity, delivery
+// windows, demand, setup/carryover linking and inventory balance; files are checked
+// in parallel. -v lists every violation. Exits with 1 if any result is infeasible
+// or could not be checked.
+
+#include "core/result_binary.h"
+#include "core/result_verify.h"
+
+#include <QString>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char* const kKindKeys[kViolationKindCount] = {
+    "capacity", "window", "demand", "setup", "carryover", "inventory"
+};
+
+void PrintUsage() {
+    std::fprintf(stderr,
+        "Usage: LS-NTGF-Verify [-j threads] [--capacity value] [-i instance.csv] [-v] "
+        "<result.json|result.lsrb|directory>...\n");
+}
+
+bool IsResultFile(const fs::path& path) {
+    return (path.extension() == ".json" || path.extension() == kResultBinarySuffix) &&
+           path.filename().u8string().find("_result_") != std::string::npos;
+}
+
+void CollectResults(const fs::path& root, std::vector<fs::path>* paths) {
+    std::error_code ec;
+    if (fs::is_directory(root, ec)) {
+        for (fs::recursive_directory_iterator it(root, ec), end; it != end; it.increment(ec)) {
+            if (ec) break;
+            if (it->is_regular_file(ec) && IsResultFile(it->path())) {
+                paths->push_back(it->path());
+            }
+        }
+    } else if (fs::is_regular_file(root, ec)) {
+        paths->push_back(root);
+    }
+}
+
+// A .lsrb converted from a JSON result is the same result; check it once
+void DropConvertedDuplicates(std::vector<fs::path>* paths) {
+    std::vector<fs::path> kept;
+    for (const auto& path : *paths) {
+        if (path.extension() == ".json") {
+            fs::path binary = path;
+            binary.replace_extension(kResultBinarySuffix);
+            if (std::binary_search(paths->begin(), paths->end(), binary)) continue;
+        }
+        kept.push_back(path);
+    }
+    paths->swap(kept);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    int threads = 0;
+    bool verbose = false;
+    std::string instance_file;
+    VerifyParams params;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-j" && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+        } else if (arg == "--capacity" && i + 1 < argc) {
+            params.capacity = std::atof(argv[++i]);
+        } else if (arg == "-i" && i + 1 < argc) {
+            instance_file = argv[++i];
+        } else if (arg == "-v") {
+            verbose = true;
+        } else if (arg == "-h" || arg == "--help") {
+            PrintUsage();
+            return 0;
+        } else {
+            inputs.push_back(arg);
+        }
+    }
+
+    if (inputs.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    std::vector<fs::path> sources;
+    for (const auto& input : inputs) {
+        CollectResults(fs::u8path(input), &sources);
+    }
+    std::sort(sources.begin(), sources.end());
+    DropConvertedDuplicates(&sources);
+    if (sources.empty()) {
+        std::fprintf(stderr, "No result files found\n");
+        return 1;
+    }
+
+    VerifySet set;
+    for (const auto& source : sources) set.paths << QString::fromStdString(source.u8string());
+    set.instance_file = QString::fromStdString(instance_file);
+    set.params = params;
+    if (verbose) set.params.max_listed = static_cast<size_t>(-1);
+
+    auto start = std::chrono::steady_clock::now();
+    VerifyResults(&set, threads);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    size_t feasible = 0;
+    size_t infeasible = 0;
+    size_t failed = 0;
+    for (size_t k = 0; k < sources.size(); ++k) {
+        const std::string name = sources[k].u8string();
+        const QString& error = set.errors[static_cast<int>(k)];
+        if (!error.isEmpty()) {
+            ++failed;
+            std::fprintf(stderr, "%s: %s\n", name.c_str(), qPrintable(error));
+            continue;
+        }
+
+        const VerifyReport& report = set.reports[k];
+        if (report.Feasible() && report.Merged()) {
+            ++feasible;
+            std::printf("OK    %s (merged orders %d of %d: per-order families not checked)\n",
+                        name.c_str(), report.result_orders, report.instance_orders);
+        } else if (report.Feasible()) {
+            ++feasible;
+            std::printf("OK    %s\n", name.c_str());
+        } else {
+            ++infeasible;
+            std::printf("FAIL  %s:", name.c_str());
+            for (int c = 0; c < kViolationKindCount; ++c) {
+                if (report.counts[c] > 0) std::printf(" %s %d", kKindKeys[c], report.counts[c]);
+            }
+            std::printf("\n");
+        }
+        if (!verbose) continue;
+
+        // Entities and periods 1-based, as in the CSV export
+        for (const Violation& v : report.violations) {
+            std::printf("      %-9s", kKindKeys[static_cast<int>(v.kind)]);
+            if (v.entity >= 0) std::printf(" entity %d", v.entity + 1);
+            if (v.period >= 0) std::printf(" period %d", v.period + 1);
+            std::printf(" amount %g\n", v.amount);
+        }
+        for (int c = 0; c < kViolationKindCount; ++c) {
+            if (!report.checked[c]) std::printf("      %s not checked\n", kKindKeys[c]);
+        }
+    }
+
+    std::printf("Verified %zu result(s): %zu feasible, %zu infeasible, %zu failed in %.3fs\n",
+                sources.size(), feasible, infeasible, failed, elapsed);
+    return infeasible == 0 && failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+// run_history_main.cpp - Query the run history written by the GUI
+//
+// Usage:
+//   LS-NTGF-History [-d history.lsrh] [--best] [-v] [instance.csv|md5]...
+//
+// Without instances: one line per instance in the history (runs, best objective,
+// algorithm and the instance file of the best run). With instances (a CSV is
+// hashed, anything else is taken as its MD5): every run of it, oldest first, or
+// with --best the best run of each configuration. -v adds the solver arguments
+// and artifact paths. The history defaults to the GUI's own (AppLocalData).
+
+#include "core/run_history.h"
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFile>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char* const kStatusNames[] = {"ok", "failed", "cancelled"};
+
+void PrintUsage() {
+    std::fprintf(stderr,
+        "Usage: LS-NTGF-History [-d history.lsrh] [--best] [-v] [instance.csv|md5]...\n");
+}
+
+// MD5 of a CSV, or the argument itself if it is no file
+std::string InstanceKey(const std::string& arg) {
+    QFile file(QString::fromStdString(arg));
+    if (!file.open(QIODevice::ReadOnly)) return arg;
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(&file);
+    return hash.result().toHex().toStdString();
+}
+
+std::string FormatTime(int64_t ms) {
+    return QDateTime::fromMSecsSinceEpoch(ms).toString("yyyy-MM-dd HH:mm:ss").toStdString();
+}
+
+void PrintRun(const RunHistory& history, const RunHistoryEntry& entry, bool verbose) {
+    std::printf("%s  %-4s %-9s objective %-14.2f wall %8.1fs\n",
+                FormatTime(entry.started).c_str(), entry.algorithm.c_str(),
+                kStatusNames[std::min<int>(static_cast<int>(entry.status), 2)],
+                entry.objective, entry.wall_seconds);
+    if (!verbose) return;
+
+    RunRecord record;
+    if (!history.Read(entry, &record)) {
+        std::printf("    (record unreadable)\n");
+        return;
+    }
+    std::string args;
+    for (const auto& arg : record.arguments) args += (args.empty() ? "" : " ") + arg;
+    std::printf("    args: %s\n", args.c_str());
+    for (const auto& stage : record.stages) {
+        std::printf("    stage %d: objective %.2f, %.3fs, gap %.4f%%\n",
+                    stage.stage, stage.objective, stage.runtime, stage.gap * 100.0);
+    }
+    for (const auto& artifact : record.artifacts) {
+        std::printf("    file: %s\n", artifact.c_str());
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    // Same AppLocalData directory as the GUI
+    QCoreApplication::setApplicationName("LS-NTGF-RR Optimizer");
+    QCoreApplication::setOrganizationName("YM-Code");
+
+    std::string path;
+    bool best_only = false;
+    bool verbose = false;
+    std::vector<std::string> instances;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-d" && i + 1 < argc) {
+            path = argv[++i];
+        } else if (arg == "--best") {
+            best_only = true;
+        } else if (arg == "-v") {
+            verbose = true;
+        } else if (arg == "-h" || arg == "--help") {
+            PrintUsage();
+            return 0;
+        } else {
+            instances.push_back(arg);
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::unique_ptr<RunHistory> own;
+    if (!path.empty()) {
+        if (!fs::exists(fs::u8path(path))) {
+            std::fprintf(stderr, "%s: not found\n", path.c_str());
+            return 1;
+        }
+        own = std::make_unique<RunHistory>(path);
+    }
+    const RunHistory& history = own ? *own : RunHistory::Shared();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::fprintf(stderr, "%zu run(s), opened in %.3fs\n", history.Size(), elapsed);
+
+    if (instances.empty()) {
+        // Instances in order of their first run
+        std::vector<std::string> order;
+        std::map<std::string, bool> seen;
+        for (const auto& entry : history.Entries()) {
+            if (!entry.instance_hash.empty() && !seen[entry.instance_hash]) {
+                seen[entry.instance_hash] = true;
+                order.push_back(entry.instance_hash);
+            }
+        }
+        for (const auto& hash : order) {
+            RunHistoryEntry best;
+            RunRecord record;
+            if (history.BestRun(hash, &best) && history.Read(best, &record)) {
+                std::printf("%s  runs %-4d best %-14.2f %-4s %s\n", hash.c_str(),
+                            history.RunCount(hash), best.objective, best.algorithm.c_str(),
+                            record.instance_path.c_str());
+            } else {
+                std::printf("%s  runs %-4d no successful run\n", hash.c_str(),
+                            history.RunCount(hash));
+            }
+        }
+        return 0;
+    }
+
+    int missing = 0;
+    for (const auto& instance : instances) {
+        const std::string hash = InstanceKey(instance);
+        std::printf("%s (%s)\n", instance.c_str(), hash.c_str());
+        const std::vector<RunHistoryEntry> runs =
+            best_only ? history.BestPerConfig(hash) : history.RunsOfInstance(hash);
+        if (runs.empty()) {
+            std::printf("  no runs\n");
+            ++missing;
+            continue;
+        }
+        for (const auto& entry : runs) {
+            std::printf("  ");
+            PrintRun(history, entry, verbose);
+        }
+    }
+    return missing == 0 ? 0 : 1;
+}
@@ -3,17 +3,74 @@
 #include "heatmap.h"
 #include <QPainter>
 #include <QPaintEvent>
+#include <QResizeEvent>
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr double kZoomStep = 1.25;          // per wheel notch
+constexpr int kMinColLabelSpacing = 24;     // pixels between period labels
+constexpr int kMinRowLabelSpacing = 12;     // pixels between row labels
+
+// Smallest 1/2/5 x 10^k step that is >= min_step
+int NiceStep(double min_step) {
+    int base = 1;
+    while (true) {
+        for (int m : {1, 2, 5}) {
+            if (base * m >= min_step) return base * m;
+        }
+        base *= 10;
+    }
+}
+
+QRgb Blend(const QColor& from, const QColor& to, float t) {
+    return qRgb(from.red() + static_cast<int>((to.red() - from.red()) * t),
+                from.green() + static_cast<int>((to.green() - from.green()) * t),
+                from.blue() + static_cast<int>((to.blue() - from.blue()) * t));
+}
+
+}  // namespace
 
 Heatmap::Heatmap(QWidget* parent)
     : QWidget(parent)
+    , rows_(0)
+    , cols_(0)
+    , max_value_(0.0f)
     , zero_color_(QColor("#f1f3f5"))
-    , one_color_(QColor("#228be6")) {
+    , one_color_(QColor("#228be6"))
+    , lod_valid_(false)
+    , zoom_(1.0)
+    , dragging_(false) {
     setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
     setMinimumSize(150, 100);
 }
 
 void Heatmap::SetData(const QVector<QVector<int>>& data) {
-    data_ = data;
+    const int rows = static_cast<int>(data.size());
+    const int cols = rows > 0 ? static_cast<int>(data[0].size()) : 0;
+    std::vector<float> values(static_cast<size_t>(rows) * cols, 0.0f);
+    for (int r = 0; r < rows; ++r) {
+        const int n = qMin(cols, static_cast<int>(data[r].size()));
+        std::copy(data[r].begin(), data[r].begin() + n,
+                  values.begin() + static_cast<size_t>(r) * cols);
+    }
+    SetMatrix(rows, cols, std::move(values));
+}
+
+void Heatmap::SetMatrix(int rows, int cols, std::vector<float> values) {
+    rows_ = qMax(0, rows);
+    cols_ = qMax(0, cols);
+    values_ = std::move(values);
+    values_.resize(static_cast<size_t>(rows_) * cols_, 0.0f);
+    max_value_ = values_.empty() ? 0.0f : *std::max_element(values_.begin(), values_.end());
+
+    zoom_ = 1.0;
+    view_origin_ = QPointF(0.0, 0.0);
+    RebuildBaseImage();
+    InvalidateLod();
     updateGeometry();
     update();
 }
@@ -21,6 +78,8 @@ void Heatmap::SetData(const QVector<QVector<int>>& data) {
 void Heatmap::SetColors(const QColor& zero_color, const QColor& one_color) {
     zero_color_ = zero_color;
     one_color_ = one_color;
+    RebuildBaseImage();
+    InvalidateLod();
     update();
 }
 
@@ -30,8 +89,24 @@ void Heatmap::SetLabels(const QString& row_label, const QString& col_label) {
     update();
 }
 
+void Heatmap::ResetView() {
+    zoom_ = 1.0;
+    view_origin_ = QPointF(0.0, 0.0);
+    InvalidateLod();
+    update();
+}
+
 void Heatmap::Clear() {
-    data_.clear();
+    rows_ = 0;
+    cols_ = 0;
+    values_.clear();
+    values_.shrink_to_fit();
+    max_value_ = 0.0f;
+    base_image_ = QImage();
+    lod_image_ = QImage();
+    zoom_ = 1.0;
+    view_origin_ = QPointF(0.0, 0.0);
+    InvalidateLod();
     updateGeometry();
     update();
 }
@@ -41,64 +116,226 @@ QSize Heatmap::sizeHint() const {
     return QSize(400, 300);
 }
 
+QRgb Heatmap::ColorFor(float value) const {
+    if (value <= 0.0f) return zero_color_.rgb();
+    float t = max_value_ > 0.0f ? qMin(1.0f, value / max_value_) : 1.0f;
+    return Blend(zero_color_, one_color_, t);
+}
+
+void Heatmap::RebuildBaseImage() {
+    if (!HasData()) {
+        base_image_ = QImage();
+        return;
+    }
+    base_image_ = QImage(cols_, rows_, QImage::Format_RGB32);
+    for (int r = 0; r < rows_; ++r) {
+        auto* line = reinterpret_cast<QRgb*>(base_image_.scanLine(r));
+        const float* src = values_.data() + static_cast<size_t>(r) * cols_;
+        for (int c = 0; c < cols_; ++c) line[c] = ColorFor(src[c]);
+    }
+}
+
+void Heatmap::RebuildLodImage(const QRect& plot) {
+    // One output pixel per plot pixel; each pixel covers a block of cells that is
+    // reduced to its maximum separably (rows into a column buffer, then columns)
+    const QRectF win = ViewWindow();
+    const int out_w = plot.width();
+    const int out_h = plot.height();
+    const double sx = win.width() / out_w;
+    const double sy = win.height() / out_h;
+
+    const int c_first = qBound(0, static_cast<int>(win.left()), cols_ - 1);
+    const int c_last = qBound(c_first + 1, static_cast<int>(std::ceil(win.right())), cols_);
+    std::vector<float> col_acc(c_last - c_first);
+
+    lod_image_ = QImage(out_w, out_h, QImage::Format_RGB32);
+    for (int py = 0; py < out_h; ++py) {
+        int r0 = qBound(0, static_cast<int>(win.top() + py * sy), rows_ - 1);
+        int r1 = qBound(r0 + 1, static_cast<int>(win.top() + (py + 1) * sy), rows_);
+
+        std::fill(col_acc.begin(), col_acc.end(), 0.0f);
+        for (int r = r0; r < r1; ++r) {
+            const float* src = values_.data() + static_cast<size_t>(r) * cols_ + c_first;
+            for (size_t i = 0; i < col_acc.size(); ++i) {
+                col_acc[i] = qMax(col_acc[i], src[i]);
+            }
+        }
+
+        auto* line = reinterpret_cast<QRgb*>(lod_image_.scanLine(py));
+        for (int px = 0; px < out_w; ++px) {
+            int c0 = qBound(c_first, static_cast<int>(win.left() + px * sx), c_last - 1);
+            int c1 = qBound(c0 + 1, static_cast<int>(win.left() + (px + 1) * sx), c_last);
+            float acc = 0.0f;
+            for (int c = c0; c < c1; ++c) {
+                float v = col_acc[c - c_first];
+                acc = qMax(acc, v);
+            }
+            line[px] = ColorFor(acc);
+        }
+    }
+    lod_valid_ = true;
+}
+
+QRect Heatmap::PlotRect() const {
+    const QRectF win = ViewWindow();
+    int available_w = qMax(1, width() - kMarginLeft - kMarginRight);
+    int available_h = qMax(1, height() - kMarginTop - kMarginBottom);
+
+    // Cells never grow beyond kMaxCellSize; they may shrink below one pixel
+    int plot_w = static_cast<int>(qMin<double>(available_w, win.width() * kMaxCellSize));
+    int plot_h = static_cast<int>(qMin<double>(available_h, win.height() * kMaxCellSize));
+    return QRect(kMarginLeft, kMarginTop, qMax(1, plot_w), qMax(1, plot_h));
+}
+
+QRectF Heatmap::ViewWindow() const {
+    return QRectF(view_origin_, QSizeF(cols_ / zoom_, rows_ / zoom_));
+}
+
+void Heatmap::ClampView() {
+    const QRectF win = ViewWindow();
+    view_origin_.setX(qBound(0.0, view_origin_.x(), cols_ - win.width()));
+    view_origin_.setY(qBound(0.0, view_origin_.y(), rows_ - win.height()));
+}
+
+void Heatmap::resizeEvent(QResizeEvent* event) {
+    QWidget::resizeEvent(event);
+    InvalidateLod();
+}
+
+void Heatmap::wheelEvent(QWheelEvent* event) {
+    if (!HasData()) {
+        event->ignore();
+        return;
+    }
+
+    // Zoom around the cell under the cursor
+    const QRect plot = PlotRect();
+    const QRectF win = ViewWindow();
+    const QPointF pos = event->position();
+    const double fx = qBound(0.0, (pos.x() - plot.left()) / plot.width(), 1.0);
+    const double fy = qBound(0.0, (pos.y() - plot.top()) / plot.height(), 1.0);
+    const QPointF anchor(win.left() + fx * win.width(), win.top() + fy * win.height());
+
+    const double max_zoom = qMax(1.0, qMin(rows_, cols_) / static_cast<double>(kMinVisibleCells));
+    const double steps = event->angleDelta().y() / 120.0;
+    const double zoom = qBound(1.0, zoom_ * std::pow(kZoomStep, steps), max_zoom);
+    if (zoom == zoom_) {
+        event->accept();
+        return;
+    }
+    zoom_ = zoom;
+
+    const QRectF new_win = ViewWindow();
+    view_origin_ = QPointF(anchor.x() - fx * new_win.width(), anchor.y() - fy * new_win.height());
+    ClampView();
+    InvalidateLod();
+    update();
+    event->accept();
+}
+
+void Heatmap::mousePressEvent(QMouseEvent* event) {
+    if (event->button() == Qt::LeftButton && HasData() && zoom_ > 1.0) {
+        dragging_ = true;
+        drag_start_ = event->position().toPoint();
+        drag_origin_ = view_origin_;
+        setCursor(Qt::ClosedHandCursor);
+        event->accept();
+        return;
+    }
+    QWidget::mousePressEvent(event);
+}
+
+void Heatmap::mouseMoveEvent(QMouseEvent* event) {
+    if (!dragging_) {
+        QWidget::mouseMoveEvent(event);
+        return;
+    }
+    const QRect plot = PlotRect();
+    const QRectF win = ViewWindow();
+    const QPoint delta = event->position().toPoint() - drag_start_;
+    view_origin_ = QPointF(drag_origin_.x() - delta.x() * win.width() / plot.width(),
+                           drag_origin_.y() - delta.y() * win.height() / plot.height());
+    ClampView();
+    InvalidateLod();
+    update();
+}
+
+void Heatmap::mouseReleaseEvent(QMouseEvent* event) {
+    if (dragging_ && event->button() == Qt::LeftButton) {
+        dragging_ = false;
+        unsetCursor();
+        return;
+    }
+    QWidget::mouseReleaseEvent(event);
+}
+
+void Heatmap::mouseDoubleClickEvent(QMouseEvent* event) {
+    Q_UNUSED(event);
+    ResetView();
+}
+
 void Heatmap::paintEvent(QPaintEvent* event) {
     Q_UNUSED(event);
 
     QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
 
     // Background
     painter.fillRect(rect(), Qt::white);
 
-    if (data_.isEmpty()) {
+    if (!HasData()) {
         painter.setPen(QColor("#adb5bd"));
         painter.drawText(rect(), Qt::AlignCenter, QString::fromUtf8("--"));
         return;
     }
 
-    int rows = data_.size();
-    int cols = data_[0].size();
-
-    // 根据可用空间计算单元格大小
-    int availableW = width() - kMarginLeft - kMarginRight;
-    int availableH = height() - kMarginTop - kMarginBottom;
+    const QRect plot = PlotRect();
+    const QRectF win = ViewWindow();
+    const double cell_w = plot.width() / win.width();
+    const double cell_h = plot.height() / win.height();
 
-    int cellW = availableW / cols;
-    int cellH = availableH / rows;
+    // Cells: blit the cached image (nearest-neighbour scaling, no antialiasing).
+    // When cells are smaller than a pixel use the per-pixel aggregate instead.
+    if (cell_w < 1.0 || cell_h < 1.0) {
+        if (!lod_valid_ || lod_image_.size() != plot.size()) RebuildLodImage(plot);
+        painter.drawImage(plot.topLeft(), lod_image_);
+    } else {
+        painter.drawImage(QRectF(plot), base_image_, win);
+    }
 
-    // 限制单元格大小范围
-    cellW = qBound(kMinCellSize, cellW, kMaxCellSize);
-    cellH = qBound(kMinCellSize, cellH, kMaxCellSize);
+    // Cell separators once cells are large enough to tell apart
+    if (cell_w >= kGridMinCellSize && cell_h >= kGridMinCellSize) {
+        painter.setPen(Qt::white);
+        for (int c = static_cast<int>(std::ceil(win.left())); c <= win.right(); ++c) {
+            int x = plot.left() + static_cast<int>((c - win.left()) * cell_w) - 1;
+            painter.drawLine(x, plot.top(), x, plot.bottom());
+        }
+        for (int r = static_cast<int>(std::ceil(win.top())); r <= win.bottom(); ++r) {
+            int y = plot.top() + static_cast<int>((r - win.top()) * cell_h) - 1;
+            painter.drawLine(plot.left(), y, plot.right(), y);
+        }
+    }
 
     // Draw column headers (period numbers)
     painter.setPen(QColor("#6c757d"));
     painter.setFont(QFont("", 7));
-    int labelStep = cols > 20 ? 5 : (cols > 10 ? 2 : 1);
-    for (int c = 0; c < cols; c += labelStep) {
-        int x = kMarginLeft + c * cellW + cellW / 2;
-        painter.drawText(QRect(x - 10, 2, 20, kMarginTop - 4),
+    int col_step = NiceStep(kMinColLabelSpacing / cell_w);
+    int first_col = static_cast<int>(std::ceil(win.left() / col_step)) * col_step;
+    for (int c = first_col; c < win.right(); c += col_step) {
+        int x = plot.left() + static_cast<int>((c + 0.5 - win.left()) * cell_w);
+        painter.drawText(QRect(x - 15, 2, 30, kMarginTop - 4),
                          Qt::AlignCenter, QString::number(c + 1));
     }
 
-    // Draw row headers (group numbers) and cells
-    for (int r = 0; r < rows; ++r) {
-        int y = kMarginTop + r * cellH;
-
-        // Row label
-        painter.setPen(QColor("#6c757d"));
-        painter.drawText(QRect(2, y, kMarginLeft - 4, cellH),
+    // Draw row headers (group numbers)
+    const QString row_prefix = row_label_.isEmpty() ? QString("G") : row_label_;
+    int row_step = NiceStep(kMinRowLabelSpacing / cell_h);
+    int first_row = static_cast<int>(std::ceil(win.top() / row_step)) * row_step;
+    int label_h = qMax(kMinRowLabelSpacing, static_cast<int>(cell_h));
+    for (int r = first_row; r < win.bottom(); r += row_step) {
+        int y = plot.top() + static_cast<int>((r + 0.5 - win.top()) * cell_h);
+        painter.drawText(QRect(2, y - label_h / 2, kMarginLeft - 4, label_h),
                          Qt::AlignRight | Qt::AlignVCenter,
-                         QString("G%1").arg(r + 1));
-
-        // Cells
-        for (int c = 0; c < cols && c < data_[r].size(); ++c) {
-            int x = kMarginLeft + c * cellW;
-            int val = data_[r][c];
-
-            painter.setPen(Qt::NoPen);
-            painter.setBrush(val > 0 ? one_color_ : zero_color_);
-            painter.drawRect(x, y, cellW - 1, cellH - 1);
-        }
+                         QString("%1%2").arg(row_prefix).arg(r + 1));
     }
 
     // Draw legend
@@ -115,5 +352,13 @@ void Heatmap::paintEvent(QPaintEvent* event) {
     painter.setBrush(one_color_);
     painter.drawRect(kMarginLeft + 50, legendY, 12, 12);
     painter.setPen(QColor("#495057"));
-    painter.drawText(kMarginLeft + 66, legendY + 10, "= 1");
+    painter.drawText(kMarginLeft + 66, legendY + 10,
+                     QString("= %1").arg(max_value_ > 0.0f ? max_value_ : 1.0f, 0, 'g', 4));
+
+    if (zoom_ > 1.0) {
+        int text_w = qMax(0, width() - kMarginLeft - kMarginRight - 100);
+        painter.drawText(QRect(kMarginLeft + 100, legendY, text_w, 14),
+                         Qt::AlignRight | Qt::AlignVCenter,
+                         QString::fromUtf8("缩放 %1x (双击复位)").arg(zoom_, 0, 'f', 1));
+    }
 }
@@ -1,5 +1,9 @@
 // heatmap.h - Heatmap widget for matrix visualization
-// Displays a 2D matrix as colored cells
+// Displays a 2D matrix as colored cells. The matrix is rendered once into a
+// cached image (1 pixel per cell) that is scaled on paint; when more cells are
+// visible than pixels, each pixel shows the maximum of its cells, so a single
+// set cell in a large binary matrix stays visible.
+// Mouse wheel zooms around the cursor, dragging pans, double click resets.
 
 #ifndef HEATMAP_H_
 #define HEATMAP_H_
@@ -8,6 +12,12 @@
 #include <QVector>
 #include <QString>
 #include <QColor>
+#include <QImage>
+#include <QPoint>
+#include <QPointF>
+#include <QRect>
+#include <QRectF>
+#include <vector>
 
 class Heatmap : public QWidget {
     Q_OBJECT
@@ -17,23 +27,59 @@ public:
 
     // Set data as 2D matrix [rows][cols]
     void SetData(const QVector<QVector<int>>& data);
+    // Set data as a row-major rows x cols buffer
+    void SetMatrix(int rows, int cols, std::vector<float> values);
     void SetColors(const QColor& zero_color, const QColor& one_color);
     void SetLabels(const QString& row_label, const QString& col_label);
+    void ResetView();
     void Clear();
 
 protected:
     void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void wheelEvent(QWheelEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    void mouseDoubleClickEvent(QMouseEvent* event) override;
     QSize sizeHint() const override;
 
 private:
-    QVector<QVector<int>> data_;
+    bool HasData() const { return rows_ > 0 && cols_ > 0; }
+    QRgb ColorFor(float value) const;
+    void RebuildBaseImage();
+    void RebuildLodImage(const QRect& plot);
+    QRect PlotRect() const;
+    QRectF ViewWindow() const;   // visible cells, in cell coordinates
+    void ClampView();
+    void InvalidateLod() { lod_valid_ = false; }
+
+    // Matrix
+    int rows_;
+    int cols_;
+    std::vector<float> values_;
+    float max_value_;
+
     QColor zero_color_;
     QColor one_color_;
     QString row_label_;
     QString col_label_;
 
-    static const int kMinCellSize = 8;
+    // Cached renders: 1 px per cell, and a per-pixel aggregate for the current view
+    QImage base_image_;
+    QImage lod_image_;
+    bool lod_valid_;
+
+    // View: zoom factor (1 = whole matrix) and top-left visible cell
+    double zoom_;
+    QPointF view_origin_;
+    bool dragging_;
+    QPoint drag_start_;
+    QPointF drag_origin_;
+
     static const int kMaxCellSize = 32;
+    static const int kGridMinCellSize = 6;   // draw cell separators from this size up
+    static const int kMinVisibleCells = 4;   // zoom limit
     static const int kMarginLeft = 35;
     static const int kMarginTop = 20;
     static const int kMarginRight = 10;
@@ -2,10 +2,29 @@
 
 #include "line_chart.h"
 #include <QPainter>
-#include <QPainterPath>
 #include <QPaintEvent>
+#include <QPolygonF>
+#include <algorithm>
 #include <cmath>
 
+namespace {
+
+const QColor kSeriesColor("#228be6");
+constexpr int kMinLabelSpacing = 30;   // pixels between X axis labels
+
+// Smallest 1/2/5 x 10^k step that is >= min_step
+qint64 NiceStep(double min_step) {
+    qint64 base = 1;
+    while (true) {
+        for (int m : {1, 2, 5}) {
+            if (base * m >= min_step) return base * m;
+        }
+        base *= 10;
+    }
+}
+
+}  // namespace
+
 LineChart::LineChart(QWidget* parent)
     : QWidget(parent)
     , y_min_(0.0)
@@ -16,10 +35,41 @@ LineChart::LineChart(QWidget* parent)
 }
 
 void LineChart::SetData(const QVector<double>& values) {
-    values_ = values;
+    series_ = Series();
+    for (double v : values) Append(v);
     update();
 }
 
+void LineChart::Append(double value) {
+    ++series_.count;
+    if (!series_.buckets.empty() && series_.last_fill < series_.bucket_size) {
+        Bucket& b = series_.buckets.back();
+        b.last = value;
+        b.min = qMin(b.min, value);
+        b.max = qMax(b.max, value);
+        ++series_.last_fill;
+        return;
+    }
+    if (static_cast<int>(series_.buckets.size()) == kMaxBuckets) Compact();
+    series_.buckets.push_back({value, value, value, value});
+    series_.last_fill = 1;
+}
+
+void LineChart::Compact() {
+    // Merge bucket pairs; only called when every bucket is full, so the merged
+    // buckets are full at the doubled size as well
+    std::vector<Bucket>& buckets = series_.buckets;
+    const size_t half = buckets.size() / 2;
+    for (size_t i = 0; i < half; ++i) {
+        const Bucket& a = buckets[2 * i];
+        const Bucket& b = buckets[2 * i + 1];
+        buckets[i] = {a.first, b.last, qMin(a.min, b.min), qMax(a.max, b.max)};
+    }
+    buckets.resize(half);
+    series_.bucket_size *= 2;
+    series_.last_fill = series_.bucket_size;
+}
+
 void LineChart::SetYRange(double min_val, double max_val) {
     y_min_ = min_val;
     y_max_ = max_val;
@@ -40,22 +90,86 @@ void LineChart::SetAxisLabels(const QString& x_label, const QString& y_label) {
 }
 
 void LineChart::Clear() {
-    values_.clear();
+    series_ = Series();
     has_reference_ = false;
     update();
 }
 
+void LineChart::DrawSeries(QPainter* painter, const QRect& chart_rect, double y_min,
+                           double y_max) const {
+    const Series& series = series_;
+    const qint64 sample_count = series.count;
+    if (sample_count == 0) return;
+
+    const int chartW = chart_rect.width();
+    const int chartH = chart_rect.height();
+    const double x_scale = sample_count > 1 ? static_cast<double>(chartW) / (sample_count - 1) : 0.0;
+    const double y_span = y_max > y_min ? y_max - y_min : 1.0;
+    auto map_y = [&](double v) {
+        double ratio = (qBound(y_min, v, y_max) - y_min) / y_span;
+        return chart_rect.top() + chartH - ratio * chartH;
+    };
+
+    // Reduce buckets per pixel column; each column contributes first/min/max/last
+    QPolygonF line;
+    line.reserve(4 * (chartW + 1));
+    int column = -1;
+    Bucket acc = {0.0, 0.0, 0.0, 0.0};
+    auto flush = [&]() {
+        if (column < 0) return;
+        const double x = chart_rect.left() + column;
+        line << QPointF(x, map_y(acc.first));
+        if (acc.min != acc.max) {
+            line << QPointF(x, map_y(acc.min)) << QPointF(x, map_y(acc.max));
+        }
+        if (acc.last != acc.first) line << QPointF(x, map_y(acc.last));
+    };
+    for (size_t i = 0; i < series.buckets.size(); ++i) {
+        const Bucket& b = series.buckets[i];
+        const qint64 first_sample = static_cast<qint64>(i) * series.bucket_size;
+        const int col = static_cast<int>(first_sample * x_scale);
+        if (col != column) {
+            flush();
+            column = col;
+            acc = b;
+        } else {
+            acc.last = b.last;
+            acc.min = qMin(acc.min, b.min);
+            acc.max = qMax(acc.max, b.max);
+        }
+    }
+    flush();
+
+    // Point markers only while samples are far enough apart to be told apart; a
+    // single sample is only a point
+    const bool sparse = series.bucket_size == 1 &&
+                        (sample_count == 1 || x_scale >= kMinPointSpacing);
+    painter->setRenderHint(QPainter::Antialiasing, sparse);
+    painter->setPen(QPen(kSeriesColor, sparse ? 2 : 1));
+    painter->setBrush(Qt::NoBrush);
+    if (line.size() > 1) painter->drawPolyline(line);
+
+    if (sparse) {
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(kSeriesColor);
+        for (const QPointF& p : line) painter->drawEllipse(p, 3.0, 3.0);
+    }
+}
+
 void LineChart::paintEvent(QPaintEvent* event) {
     Q_UNUSED(event);
 
     QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
 
     int w = width();
     int h = height();
     int chartW = w - kMarginLeft - kMarginRight;
     int chartH = h - kMarginTop - kMarginBottom;
 
+    const qint64 sample_count = series_.count;
+    const double y_min = y_min_;
+    const double y_max = y_max_;
+
     // Background
     painter.fillRect(rect(), Qt::white);
 
@@ -70,11 +184,14 @@ void LineChart::paintEvent(QPaintEvent* event) {
         painter.drawLine(kMarginLeft, y, w - kMarginRight, y);
     }
 
-    // Draw vertical grid lines for each period
-    if (!values_.isEmpty() && values_.size() > 1) {
-        double xStep = static_cast<double>(chartW) / (values_.size() - 1);
+    // Vertical grid lines on the X label positions (every period for short series)
+    const double xStep = sample_count > 1 ? static_cast<double>(chartW) / (sample_count - 1) : 0.0;
+    const qint64 labelStep = sample_count > 10 ?
+        qMax<qint64>(sample_count / 5, NiceStep(kMinLabelSpacing / qMax(xStep, 1e-9))) : 1;
+    if (sample_count > 1) {
+        const qint64 gridStep = xStep >= kMinPointSpacing ? 1 : labelStep;
         painter.setPen(QPen(QColor("#e9ecef"), 1, Qt::SolidLine));
-        for (int i = 0; i < values_.size(); ++i) {
+        for (qint64 i = 0; i < sample_count; i += gridStep) {
             int x = kMarginLeft + static_cast<int>(i * xStep);
             painter.drawLine(x, kMarginTop, x, kMarginTop + chartH);
         }
@@ -85,24 +202,24 @@ void LineChart::paintEvent(QPaintEvent* event) {
     painter.setFont(QFont("", 8));
     for (int i = 0; i <= 5; ++i) {
         int y = kMarginTop + (chartH * i / 5);
-        double val = y_max_ - (y_max_ - y_min_) * i / 5;
+        double val = y_max - (y_max - y_min) * i / 5;
         QString label = QString::number(val, 'f', 0);
-        if (y_max_ <= 1.0) {
+        if (y_max <= 1.0) {
             label = QString::number(val * 100, 'f', 0) + "%";
         }
         painter.drawText(QRect(0, y - 8, kMarginLeft - 4, 16),
                          Qt::AlignRight | Qt::AlignVCenter, label);
     }
 
-    if (values_.isEmpty()) {
+    if (sample_count == 0) {
         painter.setPen(QColor("#adb5bd"));
         painter.drawText(chartRect, Qt::AlignCenter, QString::fromUtf8("--"));
         return;
     }
 
     // Draw reference line
-    if (has_reference_ && ref_value_ >= y_min_ && ref_value_ <= y_max_) {
-        double ratio = (ref_value_ - y_min_) / (y_max_ - y_min_);
+    if (has_reference_ && ref_value_ >= y_min && ref_value_ <= y_max) {
+        double ratio = (ref_value_ - y_min) / (y_max - y_min);
         int refY = kMarginTop + chartH - static_cast<int>(ratio * chartH);
         painter.setPen(QPen(QColor("#ff6b6b"), 1, Qt::DashLine));
         painter.drawLine(kMarginLeft, refY, w - kMarginRight, refY);
@@ -113,46 +230,15 @@ void LineChart::paintEvent(QPaintEvent* event) {
         }
     }
 
-    // Draw line chart
-    if (values_.size() >= 2) {
-        QPainterPath path;
-        double xStep = static_cast<double>(chartW) / (values_.size() - 1);
-
-        for (int i = 0; i < values_.size(); ++i) {
-            double val = qBound(y_min_, values_[i], y_max_);
-            double ratio = (val - y_min_) / (y_max_ - y_min_);
-            int x = kMarginLeft + static_cast<int>(i * xStep);
-            int y = kMarginTop + chartH - static_cast<int>(ratio * chartH);
-
-            if (i == 0) {
-                path.moveTo(x, y);
-            } else {
-                path.lineTo(x, y);
-            }
-        }
-
-        painter.setPen(QPen(QColor("#228be6"), 2));
-        painter.drawPath(path);
-
-        // Draw points
-        painter.setPen(Qt::NoPen);
-        painter.setBrush(QColor("#228be6"));
-        for (int i = 0; i < values_.size(); ++i) {
-            double val = qBound(y_min_, values_[i], y_max_);
-            double ratio = (val - y_min_) / (y_max_ - y_min_);
-            int x = kMarginLeft + static_cast<int>(i * xStep);
-            int y = kMarginTop + chartH - static_cast<int>(ratio * chartH);
-            painter.drawEllipse(QPoint(x, y), 3, 3);
-        }
-    }
+    // Draw series
+    DrawSeries(&painter, chartRect, y_min, y_max);
+    painter.setRenderHint(QPainter::Antialiasing, false);
 
     // Draw X axis labels
     painter.setPen(QColor("#6c757d"));
-    int labelStep = values_.size() > 10 ? values_.size() / 5 : 1;
-    double xStep = static_cast<double>(chartW) / (values_.size() - 1);
-    for (int i = 0; i < values_.size(); i += labelStep) {
+    for (qint64 i = 0; i < sample_count; i += labelStep) {
         int x = kMarginLeft + static_cast<int>(i * xStep);
-        painter.drawText(QRect(x - 15, h - kMarginBottom + 4, 30, 16),
+        painter.drawText(QRect(x - 20, h - kMarginBottom + 4, 40, 16),
                          Qt::AlignCenter, QString::number(i + 1));
     }
 
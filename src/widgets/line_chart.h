@@ -1,5 +1,8 @@
 // line_chart.h - Simple line chart widget
-// Displays a line chart with optional reference line
+// Displays one series with an optional reference line. Samples are folded into
+// at most kMaxBuckets min/max/first/last buckets as they are set, and painting
+// reduces buckets per pixel column, so the draw cost follows the widget width
+// rather than the series length.
 
 #ifndef LINE_CHART_H_
 #define LINE_CHART_H_
@@ -7,6 +10,10 @@
 #include <QWidget>
 #include <QVector>
 #include <QString>
+#include <QRect>
+#include <vector>
+
+class QPainter;
 
 class LineChart : public QWidget {
     Q_OBJECT
@@ -24,7 +31,26 @@ protected:
     void paintEvent(QPaintEvent* event) override;
 
 private:
-    QVector<double> values_;
+    struct Bucket {
+        double first;
+        double last;
+        double min;
+        double max;
+    };
+
+    struct Series {
+        std::vector<Bucket> buckets;
+        int bucket_size = 1;    // samples per bucket, doubles on compaction
+        int last_fill = 0;      // samples in the last bucket
+        qint64 count = 0;
+    };
+
+    void Append(double value);
+    void Compact();
+    void DrawSeries(QPainter* painter, const QRect& chart_rect, double y_min,
+                    double y_max) const;
+
+    Series series_;
     double y_min_;
     double y_max_;
     double ref_value_;
@@ -33,6 +59,8 @@ private:
     QString y_label_;
     bool has_reference_;
 
+    static const int kMaxBuckets = 4096;     // >= any realistic chart width
+    static const int kMinPointSpacing = 6;   // draw point markers from this spacing up
     static const int kMarginLeft = 40;
     static const int kMarginRight = 10;
     static const int kMarginTop = 10;